@@ -0,0 +1,553 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * unit_test_main.cpp
+ *
+ * Unit tests of the timer wheel, inflight command table, GUID index, frame slab, rings and capture filter of AVDECC
+ * Lib. The program prints each failed check and exits with a non-zero status if any check failed.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <vector>
+#include "timer_wheel.h"
+#include "inflight_table.h"
+#include "guid_index.h"
+#include "frame_slab.h"
+#include "spsc_ring.h"
+#include "mpsc_ring.h"
+#include "capture_filter.h"
+
+using namespace avdecc_lib;
+
+static uint32_t check_count = 0;
+static uint32_t failed_count = 0;
+
+#define CHECK(condition) check((condition), #condition, __FILE__, __LINE__)
+
+static void check(bool is_passed, const char *condition, const char *file, int line)
+{
+	check_count++;
+
+	if(!is_passed)
+	{
+		failed_count++;
+		printf("%s:%d: check failed: %s\n", file, line, condition);
+	}
+}
+
+/**
+ * The hash the inflight table and the GUID index use for their home buckets, to build keys that collide.
+ */
+static uint32_t golden_hash(uint64_t key)
+{
+	return (uint32_t)((key * UINT64_C(0x9E3779B97F4A7C15)) >> 32);
+}
+
+static void count_expiry(void *expired_count)
+{
+	(*(uint32_t *)expired_count)++;
+}
+
+/**
+ * Arm a timer in a new wheel and check that it expires within a few milliseconds of its duration, which places it
+ * in the level of the duration and cascades it down through the levels below.
+ */
+static void check_timer_expiry(uint32_t duration_ms)
+{
+	timer_wheel wheel;
+	struct timer_wheel::entry timer;
+	uint32_t expired_count = 0;
+	uint64_t armed_ms = timer_wheel::clk_monotonic_ms();
+
+	timer_wheel::init_entry(&timer, count_expiry, &expired_count);
+	wheel.arm(&timer, duration_ms);
+
+	if(duration_ms > 5)
+	{
+		wheel.expire(armed_ms + duration_ms - 5);
+		CHECK(expired_count == 0);
+		CHECK(wheel.is_armed(&timer));
+	}
+
+	wheel.expire(armed_ms + duration_ms + 5);
+	CHECK(expired_count == 1);
+	CHECK(!wheel.is_armed(&timer));
+	CHECK(wheel.size() == 0);
+}
+
+static void test_timer_wheel()
+{
+	const uint32_t level_span_ms = 1 << timer_wheel::TIMER_WHEEL_SLOT_BITS;
+	const uint32_t wheel_range_ms = 1 << (timer_wheel::TIMER_WHEEL_SLOT_BITS * timer_wheel::TIMER_WHEEL_LEVEL_COUNT);
+	uint32_t durations_ms[] =
+	{
+		1,
+		level_span_ms - 1, level_span_ms, level_span_ms + 1,
+		level_span_ms * level_span_ms - 1, level_span_ms * level_span_ms, level_span_ms * level_span_ms + 1,
+		level_span_ms * level_span_ms * level_span_ms - 1, level_span_ms * level_span_ms * level_span_ms,
+		level_span_ms * level_span_ms * level_span_ms + 1
+	};
+
+	for(uint32_t index_i = 0; index_i < sizeof(durations_ms) / sizeof(durations_ms[0]); index_i++)
+	{
+		check_timer_expiry(durations_ms[index_i]);
+	}
+
+	/**
+	 * A timer beyond the range of the wheel is clamped to its last slot, then cascades down until its real expiry.
+	 */
+	check_timer_expiry(wheel_range_ms + 1000);
+
+	/**
+	 * A cancelled timer does not expire, and timers in the same slot expire together.
+	 */
+	timer_wheel wheel;
+	struct timer_wheel::entry timers[3];
+	uint32_t expired_count = 0;
+	uint64_t armed_ms = timer_wheel::clk_monotonic_ms();
+
+	for(uint32_t index_i = 0; index_i < 3; index_i++)
+	{
+		timer_wheel::init_entry(&timers[index_i], count_expiry, &expired_count);
+		wheel.arm(&timers[index_i], 100);
+	}
+
+	wheel.cancel(&timers[1]);
+	CHECK(wheel.size() == 2);
+	wheel.expire(armed_ms + 105);
+	CHECK(expired_count == 2);
+	CHECK(!wheel.is_armed(&timers[1]));
+}
+
+static void test_inflight_table()
+{
+	const uint32_t bucket_mask = inflight_table::INFLIGHT_TABLE_BUCKET_COUNT - 1;
+	inflight_table table;
+	uint8_t frame[inflight_table::INFLIGHT_FRAME_SIZE + 1];
+	uint64_t target_guid = UINT64_C(0x0001F2FFFE000001);
+	uint16_t seq_ids[3];
+	uint32_t found_count = 0;
+	int notification_ids[3];
+
+	memset(frame, 0xA5, sizeof(frame));
+
+	/**
+	 * Find three sequence ids of a target whose home bucket is the last one, so that their probe sequence wraps
+	 * around to the first buckets.
+	 */
+	for(uint32_t seq_id = 0; (seq_id <= 0xFFFF) && (found_count < 3); seq_id++)
+	{
+		if((golden_hash(target_guid ^ seq_id) & bucket_mask) == bucket_mask)
+		{
+			seq_ids[found_count++] = (uint16_t)seq_id;
+		}
+	}
+
+	CHECK(found_count == 3);
+
+	for(uint32_t index_i = 0; index_i < 3; index_i++)
+	{
+		CHECK(table.insert(target_guid, seq_ids[index_i], &notification_ids[index_i], 0, frame, 64) != NULL);
+	}
+
+	CHECK(table.size() == 3);
+	CHECK(table.insert(target_guid, seq_ids[0], &notification_ids[0], 0, frame, 64) == NULL); // Already inflight
+	CHECK(table.insert(target_guid, 1, &notification_ids[0], 0, frame, sizeof(frame)) == NULL); // Too long
+
+	/**
+	 * Removing the command in the last bucket shifts the commands that wrapped around back over it.
+	 */
+	table.remove(table.find(target_guid, seq_ids[0]));
+	CHECK(table.find(target_guid, seq_ids[0]) == NULL);
+	CHECK(!table.has_notification_id(&notification_ids[0]));
+	CHECK(table.find(target_guid, seq_ids[1]) != NULL);
+	CHECK(table.find(target_guid, seq_ids[2]) != NULL);
+
+	table.remove(table.find(target_guid, seq_ids[1]));
+	CHECK(table.find(target_guid, seq_ids[1]) == NULL);
+	CHECK(table.find(target_guid, seq_ids[2]) != NULL);
+	CHECK(table.find(target_guid, seq_ids[2])->seq_id == seq_ids[2]);
+	CHECK(table.has_notification_id(&notification_ids[2]));
+	CHECK(memcmp(table.find(target_guid, seq_ids[2])->frame, frame, 64) == 0);
+
+	table.remove(table.find(target_guid, seq_ids[2]));
+	CHECK(table.size() == 0);
+
+	/**
+	 * Every entry can be used, and the table is full after that.
+	 */
+	for(uint32_t seq_id = 0; seq_id < inflight_table::INFLIGHT_TABLE_CAPACITY; seq_id++)
+	{
+		CHECK(table.insert(target_guid, (uint16_t)seq_id, &notification_ids[0], 0, frame, 64) != NULL);
+	}
+
+	CHECK(table.insert(target_guid, inflight_table::INFLIGHT_TABLE_CAPACITY, &notification_ids[0], 0, frame, 64) == NULL);
+
+	while(table.size() > 0)
+	{
+		table.remove(table.at(0));
+	}
+
+	CHECK(!table.has_notification_id(&notification_ids[0]));
+}
+
+static void test_guid_index()
+{
+	guid_index growing_index;
+	guid_index fixed_index(32);
+	uint64_t colliding_guids[3];
+	uint32_t found_count = 0;
+	uint32_t index;
+
+	/**
+	 * A table that is not sized up front grows while GUIDs are added.
+	 */
+	for(uint32_t guid_index_i = 0; guid_index_i < 1000; guid_index_i++)
+	{
+		CHECK(growing_index.insert(UINT64_C(0x0001F2FFFE000000) + guid_index_i, guid_index_i) == 0);
+	}
+
+	CHECK(growing_index.size() == 1000);
+
+	for(uint32_t guid_index_i = 0; guid_index_i < 1000; guid_index_i++)
+	{
+		CHECK(growing_index.find(UINT64_C(0x0001F2FFFE000000) + guid_index_i, index) && (index == guid_index_i));
+	}
+
+	CHECK(!growing_index.find(UINT64_C(0x0001F2FFFE100000), index));
+
+	/**
+	 * A table sized up front for 32 GUIDs has 64 slots and refuses a 33rd GUID.
+	 */
+	for(uint64_t guid = 1; found_count < 3; guid++)
+	{
+		if((golden_hash(guid) & 63) == 63)
+		{
+			colliding_guids[found_count++] = guid;
+		}
+	}
+
+	for(uint32_t guid_index_i = 0; guid_index_i < 3; guid_index_i++)
+	{
+		CHECK(fixed_index.insert(colliding_guids[guid_index_i], guid_index_i) == 0);
+	}
+
+	CHECK(fixed_index.insert(colliding_guids[1], 7) == 0); // Changes the index of a GUID already in the table
+	CHECK(fixed_index.find(colliding_guids[1], index) && (index == 7));
+
+	/**
+	 * Removing the GUID in the last slot shifts the GUIDs that wrapped around back over it.
+	 */
+	fixed_index.remove(colliding_guids[0]);
+	CHECK(!fixed_index.find(colliding_guids[0], index));
+	CHECK(fixed_index.find(colliding_guids[1], index) && (index == 7));
+	CHECK(fixed_index.find_concurrent(colliding_guids[2], index) && (index == 2));
+	CHECK(!fixed_index.find_concurrent(colliding_guids[0], index));
+	CHECK(fixed_index.size() == 2);
+
+	for(uint64_t guid = UINT64_C(0x1000); fixed_index.size() < 32; guid++)
+	{
+		CHECK(fixed_index.insert(guid, 0) == 0);
+	}
+
+	CHECK(fixed_index.insert(UINT64_C(0x2000), 0) == -1);
+}
+
+static void test_frame_slab()
+{
+	frame_slab slab(4);
+	uint16_t frame_indices[4];
+	uint16_t frame_index;
+
+	for(uint32_t index_i = 0; index_i < 4; index_i++)
+	{
+		CHECK(slab.alloc(frame_indices[index_i]) == 0);
+	}
+
+	CHECK(slab.alloc(frame_index) == -1);
+	CHECK(slab.get_exhausted_count() == 1);
+	CHECK(slab.get_in_use_count() == 4);
+	CHECK(slab.get_high_watermark() == 4);
+
+	/**
+	 * The free list is a stack, so the frame released last is reused first.
+	 */
+	slab.release(frame_indices[1]);
+	slab.release(frame_indices[3]);
+	CHECK(slab.get_in_use_count() == 2);
+	CHECK((slab.alloc(frame_index) == 0) && (frame_index == frame_indices[3]));
+	CHECK((slab.alloc(frame_index) == 0) && (frame_index == frame_indices[1]));
+	CHECK(slab.alloc(frame_index) == -1);
+	CHECK(slab.get_high_watermark() == 4);
+	CHECK(slab.get_frame(frame_indices[1]) + frame_slab::FRAME_SLAB_FRAME_SIZE == slab.get_frame((uint16_t)(frame_indices[1] + 1)));
+}
+
+static void test_spsc_ring()
+{
+	spsc_ring ring(3, sizeof(uint32_t), false); // Rounded up to 4 entries
+	uint32_t values[8];
+	uint32_t value;
+
+	CHECK(ring.is_empty());
+	CHECK(ring.pop(&value) == -1);
+
+	/**
+	 * Fill and drain the ring several times, so that the positions wrap around its end.
+	 */
+	for(uint32_t round = 0; round < 5; round++)
+	{
+		for(uint32_t index_i = 0; index_i < 4; index_i++)
+		{
+			value = round * 10 + index_i;
+			CHECK(ring.push(&value) == 0);
+		}
+
+		CHECK(ring.push(&value) == -1);
+		CHECK(!ring.is_empty());
+
+		for(uint32_t index_i = 0; index_i < 4; index_i++)
+		{
+			CHECK((ring.pop(&value) == 0) && (value == round * 10 + index_i));
+		}
+
+		CHECK(ring.is_empty());
+
+		value = round;
+		CHECK(ring.push(&value) == 0); // Shifts the next round by one entry
+		CHECK((ring.pop(&value) == 0) && (value == round));
+	}
+
+	for(uint32_t index_i = 0; index_i < 8; index_i++)
+	{
+		values[index_i] = index_i;
+	}
+
+	CHECK(ring.push_batch(values, 8) == 4);
+	CHECK(ring.pop_batch(values, 8) == 4);
+	CHECK((values[0] == 0) && (values[3] == 3));
+	CHECK(ring.pop_batch(values, 8) == 0);
+}
+
+struct mpsc_producer
+{
+	mpsc_ring *ring;
+	uint32_t producer_index;
+	uint32_t push_count;
+};
+
+static void * proc_mpsc_producer(void *lpParam)
+{
+	struct mpsc_producer *producer = (struct mpsc_producer *)lpParam;
+
+	for(uint32_t index_i = 0; index_i < producer->push_count; index_i++)
+	{
+		uint32_t value = (producer->producer_index << 24) | index_i;
+
+		while(producer->ring->push(&value) < 0)
+		{
+			sched_yield(); // Let the consumer free an entry
+		}
+	}
+
+	return NULL;
+}
+
+static void test_mpsc_ring()
+{
+	mpsc_ring ring(4, sizeof(uint32_t), false);
+	uint32_t value;
+
+	CHECK(ring.is_empty());
+	CHECK(ring.pop(&value) == -1);
+
+	for(uint32_t round = 0; round < 5; round++)
+	{
+		for(uint32_t index_i = 0; index_i < 4; index_i++)
+		{
+			value = round * 10 + index_i;
+			CHECK(ring.push(&value) == 0);
+		}
+
+		CHECK(ring.push(&value) == -1);
+
+		for(uint32_t index_i = 0; index_i < 4; index_i++)
+		{
+			CHECK((ring.pop(&value) == 0) && (value == round * 10 + index_i));
+		}
+
+		CHECK(ring.pop(&value) == -1);
+
+		value = round;
+		CHECK(ring.push(&value) == 0);
+		CHECK((ring.pop(&value) == 0) && (value == round));
+	}
+
+	/**
+	 * Producers on several threads each see their own entries consumed in the order they pushed them.
+	 */
+	const uint32_t producer_count = 4;
+	const uint32_t push_count = 20000;
+	mpsc_ring shared_ring(64, sizeof(uint32_t), false);
+	struct mpsc_producer producers[producer_count];
+	pthread_t producer_threads[producer_count];
+	std::vector<uint32_t> next_values(producer_count, 0);
+	bool is_in_order = true;
+
+	for(uint32_t producer_index = 0; producer_index < producer_count; producer_index++)
+	{
+		producers[producer_index].ring = &shared_ring;
+		producers[producer_index].producer_index = producer_index;
+		producers[producer_index].push_count = push_count;
+		pthread_create(&producer_threads[producer_index], NULL, proc_mpsc_producer, &producers[producer_index]);
+	}
+
+	/**
+	 * All the entries are consumed whatever their order, so that every producer finishes.
+	 */
+	for(uint32_t pop_count = 0; pop_count < producer_count * push_count;)
+	{
+		if(shared_ring.pop(&value) == 0)
+		{
+			if(((value >> 24) < producer_count) && ((value & 0xFFFFFF) == next_values.at(value >> 24)))
+			{
+				next_values.at(value >> 24)++;
+			}
+			else
+			{
+				is_in_order = false;
+			}
+
+			pop_count++;
+		}
+		else
+		{
+			sched_yield();
+		}
+	}
+
+	for(uint32_t producer_index = 0; producer_index < producer_count; producer_index++)
+	{
+		pthread_join(producer_threads[producer_index], NULL);
+	}
+
+	CHECK(is_in_order);
+	CHECK(shared_ring.is_empty());
+}
+
+/**
+ * Build an Ethernet frame with a destination MAC address, an Ethernet type and the byte following the header.
+ */
+static void build_frame(uint8_t *frame, uint64_t dest_mac, uint16_t ether_type, uint8_t first_payload_byte)
+{
+	memset(frame, 0, 64);
+
+	for(uint32_t index_i = 0; index_i < 6; index_i++)
+	{
+		frame[index_i] = (uint8_t)(dest_mac >> (40 - 8 * index_i));
+	}
+
+	frame[12] = (uint8_t)(ether_type >> 8);
+	frame[13] = (uint8_t)ether_type;
+	frame[14] = first_payload_byte;
+}
+
+static bool is_accepted(capture_filter &filter, uint8_t *frame)
+{
+	struct bpf_program program = filter.get_program();
+
+	return bpf_filter(program.bf_insns, frame, 64, 64) != 0;
+}
+
+static void test_capture_filter()
+{
+	const uint64_t our_mac = UINT64_C(0x001122334455);
+	const uint64_t other_mac = UINT64_C(0x001122334466);
+	const uint64_t adp_multicast_mac = UINT64_C(0x91E0F0010000);
+	const uint16_t avtp_ether_type = 0x22F0;
+	const uint8_t adp_subtype = 0xFA; // The cd bit and the ADP subtype
+	const uint8_t aecp_subtype = 0xFB;
+	const uint8_t acmp_subtype = 0xFC;
+	capture_filter filter;
+	uint8_t frame[64];
+
+	filter.build(our_mac, true, true, false);
+
+	build_frame(frame, adp_multicast_mac, avtp_ether_type, adp_subtype);
+	CHECK(is_accepted(filter, frame));
+
+	build_frame(frame, our_mac, avtp_ether_type, aecp_subtype);
+	CHECK(is_accepted(filter, frame));
+
+	build_frame(frame, other_mac, avtp_ether_type, aecp_subtype);
+	CHECK(!is_accepted(filter, frame));
+
+	build_frame(frame, UINT64_C(0x991122334455), avtp_ether_type, aecp_subtype); // Differs from our MAC in the first two bytes only
+	CHECK(!is_accepted(filter, frame));
+
+	build_frame(frame, adp_multicast_mac, avtp_ether_type, acmp_subtype);
+	CHECK(!is_accepted(filter, frame));
+
+	build_frame(frame, adp_multicast_mac, 0x0800, adp_subtype);
+	CHECK(!is_accepted(filter, frame));
+
+	build_frame(frame, our_mac, 0x0800, aecp_subtype);
+	CHECK(!is_accepted(filter, frame));
+
+	/**
+	 * The channels built for ADP only and for AECP only reject the frames of the other channel.
+	 */
+	filter.build(our_mac, true, false, false);
+
+	build_frame(frame, adp_multicast_mac, avtp_ether_type, adp_subtype);
+	CHECK(is_accepted(filter, frame));
+
+	build_frame(frame, our_mac, avtp_ether_type, aecp_subtype);
+	CHECK(!is_accepted(filter, frame));
+
+	filter.build(our_mac, false, true, false);
+
+	build_frame(frame, adp_multicast_mac, avtp_ether_type, adp_subtype);
+	CHECK(!is_accepted(filter, frame));
+
+	build_frame(frame, our_mac, avtp_ether_type, aecp_subtype);
+	CHECK(is_accepted(filter, frame));
+}
+
+int main()
+{
+	test_timer_wheel();
+	test_inflight_table();
+	test_guid_index();
+	test_frame_slab();
+	test_spsc_ring();
+	test_mpsc_ring();
+	test_capture_filter();
+
+	printf("%u checks, %u failed\n", check_count, failed_count);
+
+	return (failed_count == 0) ? 0 : 1;
+}
@@ -63,10 +63,31 @@ namespace avdecc_lib
 		AVDECC_CONTROLLER_LIB32_API virtual uint32_t STDCALL get_end_station_count() = 0;
 
 		/**
-		 * \return The corresponding End Station by index.
+		 * \return The corresponding End Station by index. End Stations are kept in the order they were discovered. An
+		 *	   End Station that departs has its connection status set to 'D', and is retired once it has been gone
+		 *	   for 60 s, which moves the End Stations after it down by one. The End Station and its descriptors
+		 *	   stay valid for 60 s after it is retired.
 		 */
 		AVDECC_CONTROLLER_LIB32_API virtual end_station * STDCALL get_end_station_by_index(uint32_t end_station_index) = 0;
 
+		/**
+		 * \return A handle to the End Station at an index, or 0 if the index is out of range. A handle keeps referring
+		 *	   to the same End Station while other End Stations are added or retired, and is no longer valid once
+		 *	   its End Station is retired.
+		 */
+		AVDECC_CONTROLLER_LIB32_API virtual uint64_t STDCALL get_end_station_handle_by_index(uint32_t end_station_index) = 0;
+
+		/**
+		 * \return A handle to the End Station with a GUID, or 0 if no End Station has the GUID.
+		 */
+		AVDECC_CONTROLLER_LIB32_API virtual uint64_t STDCALL get_end_station_handle_by_guid(uint64_t end_station_guid) = 0;
+
+		/**
+		 * \return The corresponding End Station by handle, or NULL if the handle is invalid or its End Station has
+		 *	   been retired.
+		 */
+		AVDECC_CONTROLLER_LIB32_API virtual end_station * STDCALL get_end_station_by_handle(uint64_t end_station_handle) = 0;
+
 		/**
 		 * \return The corresponding Configuration descriptor by index.
 		 */
@@ -77,6 +98,11 @@ namespace avdecc_lib
 		 */
 		AVDECC_CONTROLLER_LIB32_API virtual configuration_descriptor * STDCALL get_config_by_guid(uint64_t end_station_guid, uint16_t entity_index, uint16_t config_index) = 0;
 
+		/**
+		 * \return The corresponding Configuration descriptor by End Station handle.
+		 */
+		AVDECC_CONTROLLER_LIB32_API virtual configuration_descriptor * STDCALL get_config_by_handle(uint64_t end_station_handle, uint16_t entity_index, uint16_t config_index) = 0;
+
 		/**
 		 * Check if the command with the corresponding notification id is in the inflight list.
 		 */
@@ -97,6 +123,19 @@ namespace avdecc_lib
 		 */
 		AVDECC_CONTROLLER_LIB32_API virtual uint32_t STDCALL missed_log_count() = 0;
 
+		/**
+		 * Get the timing statistics of the commands a response has been received for. Only commands with network
+		 * timestamps for both the command and the response are counted, which are only available on Linux.
+		 *
+		 * \param timed_cmd_count The number of commands counted.
+		 * \param avg_wire_rtt_us The average time between the command leaving and the response arriving at the network interface.
+		 * \param max_wire_rtt_us The longest time between the command leaving and the response arriving at the network interface.
+		 * \param avg_library_delay_us The average time spent inside the library before the command was sent and after
+		 *	  the response was received.
+		 */
+		AVDECC_CONTROLLER_LIB32_API virtual void STDCALL get_cmd_timing_stats(uint32_t &timed_cmd_count, uint32_t &avg_wire_rtt_us,
+		                                                                      uint32_t &max_wire_rtt_us, uint32_t &avg_library_delay_us) = 0;
+
 		/**
 		 * Check for End Station connection, command packet, and response packet timeouts.
 		 */
@@ -111,6 +150,11 @@ namespace avdecc_lib
 		 * Send queued packet to the AEM Controller State Machine.
 		 */
 		AVDECC_CONTROLLER_LIB32_API virtual void STDCALL tx_packet_event(void *notification_id, uint32_t notification_flag, uint8_t *frame, uint16_t mem_buf_len) = 0;
+
+		/**
+		 * Record the time a sent packet left the network interface for the corresponding inflight command.
+		 */
+		AVDECC_CONTROLLER_LIB32_API virtual void STDCALL tx_timestamp_event(const uint8_t *frame, uint16_t mem_buf_len, uint64_t tx_timestamp_ns) = 0;
 	};
 
 	/**
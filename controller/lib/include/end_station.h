@@ -67,6 +67,19 @@ namespace avdecc_lib
 		 */
 		AVDECC_CONTROLLER_LIB32_API virtual entity_descriptor * STDCALL get_entity_desc_by_index(uint32_t entity_desc_index) = 0;
 
+		/**
+		 * Get the statistics of the retransmission timeout of the commands sent to the End Station. The timeout
+		 * follows the smoothed round trip time of the responses, and doubles after each timeout up to 4 seconds.
+		 *
+		 * \param srtt_us The smoothed round trip time, 0 until a command has been answered at the first attempt.
+		 * \param rttvar_us The variation of the round trip time.
+		 * \param rto_ms The timeout of the next command sent.
+		 * \param timeout_count The number of times a command or its retry has timed out.
+		 * \param in_progress_count The number of IN_PROGRESS responses received, which postpone the timeout of a command.
+		 */
+		AVDECC_CONTROLLER_LIB32_API virtual void STDCALL get_rto_stats(uint32_t &srtt_us, uint32_t &rttvar_us, uint32_t &rto_ms,
+		                                                               uint32_t &timeout_count, uint32_t &in_progress_count) = 0;
+
 		/**
 		 * Send a READ_DESCRIPTOR command with notification id to read a descriptor from an AVDECC Entity.
 		 */
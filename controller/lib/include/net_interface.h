@@ -64,6 +64,19 @@ namespace avdecc_lib
 	 * Create a public network interface object used for accessing from outside the library.
 	 */
 	extern "C" AVDECC_CONTROLLER_LIB32_API net_interface * STDCALL create_net_interface();
+
+	/**
+	 * Create a public network interface object that replays the frames of a pcap or pcapng capture file in place of
+	 * a live network interface, so the library can be exercised with recorded traffic on a machine with no network.
+	 * The replayed capture file is the only device, with interface number 1.
+	 *
+	 * \param capture_file_path The capture file to replay.
+	 * \param mac The MAC address of the Controller that recorded the capture file, so AECP responses sent to it are admitted.
+	 * \param is_recorded_pace Replay the frames at the pace they were captured if set, otherwise as fast as possible.
+	 * \param tx_file_path A pcap file the frames sent by the library are recorded to, or NULL to discard them.
+	 */
+	extern "C" AVDECC_CONTROLLER_LIB32_API net_interface * STDCALL create_replay_net_interface(const char *capture_file_path, uint64_t mac,
+	                                                                                        bool is_recorded_pace, const char *tx_file_path);
 }
 
 #endif
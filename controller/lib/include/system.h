@@ -45,9 +45,24 @@ namespace avdecc_lib
 		enum system_type
 		{
 		        LAYER2_MULTITHREADED_CALLBACK,
+		        LAYER2_EPOLL, // Linux only, multiplexes capture, transmit, and timer events in a single epoll loop
 		        // Add system types
 		};
 
+		enum thread_role
+		{
+		        THREAD_CAPTURE, // The capture threads of the multithreaded callback System, the epoll System captures on its poll thread
+		        THREAD_POLL, // The engine thread processing received frames, queued commands and timeouts
+		        THREAD_NOTIFICATION,
+		        THREAD_LOG
+		};
+
+		enum thread_policy
+		{
+		        THREAD_POLICY_OTHER, // The default time-sharing scheduling (SCHED_OTHER on Linux)
+		        THREAD_POLICY_FIFO // Real-time scheduling (SCHED_FIFO on Linux, time critical thread priority on Windows)
+		};
+
 		/**
 		 * Deallocate memory
 		 */
@@ -63,6 +78,98 @@ namespace avdecc_lib
 		 */
 		AVDECC_CONTROLLER_LIB32_API virtual int STDCALL get_last_resp_status() = 0;
 
+		/**
+		 * Get the highest number of frame buffers held by the System queues at the same time.
+		 */
+		AVDECC_CONTROLLER_LIB32_API virtual uint32_t STDCALL queue_frame_high_watermark() = 0;
+
+		/**
+		 * Get the number of frames dropped because no frame buffer was free for a System queue.
+		 */
+		AVDECC_CONTROLLER_LIB32_API virtual uint32_t STDCALL missed_queue_frame_count() = 0;
+
+		/**
+		 * Get the receive batch statistics of the engine.
+		 *
+		 * \param batch_count The number of batches of received frames processed.
+		 * \param frame_count The number of received frames processed in all the batches.
+		 * \param max_batch_size The most received frames processed in one batch.
+		 */
+		AVDECC_CONTROLLER_LIB32_API virtual void STDCALL get_rx_batch_stats(uint32_t &batch_count, uint32_t &frame_count, uint32_t &max_batch_size) = 0;
+
+		/**
+		 * Get the ADP load shedding statistics of the capture. While the engine has received frames left to process,
+		 * ENTITY_AVAILABLE advertisements that repeat the last one passed on for the same entity are discarded before
+		 * they are queued, so that command responses are not held up by discovery traffic.
+		 *
+		 * \param adp_frame_count The number of ADP frames captured.
+		 * \param shed_count The number of ADP frames discarded.
+		 */
+		AVDECC_CONTROLLER_LIB32_API virtual void STDCALL get_adp_shed_stats(uint32_t &adp_frame_count, uint32_t &shed_count) = 0;
+
+		/**
+		 * Set the low-latency busy poll mode of the engine. Before blocking, the engine spins checking for events for up to
+		 * spin_budget_us microseconds, and the capture sockets are busy polled in the kernel where supported. The spin
+		 * budget adapts to the traffic: it shrinks while spins find nothing and is restored when a spin finds an event.
+		 *
+		 * \param spin_budget_us The longest time spent spinning before blocking, or 0 to disable the busy poll mode (the default).
+		 */
+		AVDECC_CONTROLLER_LIB32_API virtual int STDCALL set_busy_poll(uint32_t spin_budget_us) = 0;
+
+		/**
+		 * Get the busy poll statistics of the engine.
+		 *
+		 * \param spin_hit_count The number of times an event was found while spinning.
+		 * \param sleep_count The number of times the engine blocked because no event was found while spinning.
+		 */
+		AVDECC_CONTROLLER_LIB32_API virtual void STDCALL get_busy_poll_stats(uint32_t &spin_hit_count, uint32_t &sleep_count) = 0;
+
+		/**
+		 * Pin the threads of a role to a CPU and set their scheduling policy and priority. The settings of the capture and
+		 * poll threads are kept and applied when process_start creates the threads.
+		 *
+		 * \param role The threads the settings are applied to.
+		 * \param cpu The CPU the threads are pinned to, or -1 to let them run on any CPU.
+		 * \param policy The scheduling policy of the threads.
+		 * \param priority The real-time priority for THREAD_POLICY_FIFO (1 to 99 on Linux). For THREAD_POLICY_OTHER, ignored on
+		 *	  Linux and the relative thread priority (-2 to 2) on Windows.
+		 */
+		AVDECC_CONTROLLER_LIB32_API virtual int STDCALL set_thread_sched(thread_role role, int32_t cpu, thread_policy policy, int32_t priority) = 0;
+
+		/**
+		 * Get the effective CPU affinity, scheduling policy and priority of the threads of a role, as reported by the
+		 * operating system, to check that the settings were not refused or changed.
+		 *
+		 * \param role The threads to get the settings of.
+		 * \param cpu The CPU the threads are pinned to, or -1 if they may run on more than one CPU.
+		 * \param policy The scheduling policy of the threads.
+		 * \param priority The priority of the threads, the real-time priority on Linux and the thread priority on Windows.
+		 *
+		 * \return 0 on success, -1 if the threads of the role are not running.
+		 */
+		AVDECC_CONTROLLER_LIB32_API virtual int STDCALL get_thread_sched(thread_role role, int32_t &cpu, thread_policy &policy, int32_t &priority) = 0;
+
+		/**
+		 * Split the engine into shards, each run by its own engine thread with its own inflight commands, timers and End
+		 * Stations. End Stations are assigned to a shard by a hash of their GUID, and the poll thread routes received
+		 * frames and queued commands to the shard of their End Station. Engine threads take the scheduling policy and
+		 * priority set for THREAD_POLL, without its CPU. Has to be called before process_start and before any End Station
+		 * is discovered.
+		 * \param shard_count The number of engine threads, or 1 to run the whole engine on the poll thread (the default).
+		 * \return 0 on success, -1 if the System does not support shards or it is too late to change the shard count.
+		 */
+		AVDECC_CONTROLLER_LIB32_API virtual int STDCALL set_engine_shards(uint32_t shard_count) = 0;
+
+		/**
+		 * Decode the descriptors read during the enumeration of the End Stations on a pool of decode threads, so that
+		 * the engine only matches their responses to the commands. The descriptors of an End Station are decoded by
+		 * the same thread and stored by the engine in the order they were read; the descriptors read by the application
+		 * are still decoded by the engine, before the application is notified. Has to be called before process_start.
+		 * \param worker_count The number of decode threads, or 0 to decode on the engine (the default).
+		 * \return 0 on success, -1 if the System does not support decode threads or it is too late to change them.
+		 */
+		AVDECC_CONTROLLER_LIB32_API virtual int STDCALL set_desc_decode_workers(uint32_t worker_count) = 0;
+
 		/**
 		 * Start point of the system process, which calls the thread initialization function.
 		 */
@@ -31,17 +31,16 @@
 #include "enumeration.h"
 #include "log.h"
 #include "util.h"
+#include "controller_context.h"
 #include "adp.h"
 
 namespace avdecc_lib
 {
-	struct jdksavdecc_eui48 adp::src_mac_addr;
-	struct jdksavdecc_eui48 adp::dest_mac_addr;
-
 	adp::adp() {}
 
-	adp::adp(uint8_t *frame, size_t mem_buf_len)
+	adp::adp(controller_context *context, uint8_t *frame, size_t mem_buf_len)
 	{
+		this->context = context;
 		adp_frame = (uint8_t *)malloc(mem_buf_len * sizeof(uint8_t));
 		memcpy(adp_frame, frame, mem_buf_len);
 
@@ -49,7 +48,7 @@ namespace avdecc_lib
 
 		if(frame_read_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "frame_read error");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "frame_read error");
 			assert(frame_read_returned >= 0);
 		}
 
@@ -57,12 +56,9 @@ namespace avdecc_lib
 
 		if(adpdu_read_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "adpdu_read error");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "adpdu_read error");
 			assert(adpdu_read_returned >= 0);
 		}
-
-		convert_uint64_to_eui48(net_interface_ref->get_mac(), src_mac_addr.value);
-		convert_uint64_to_eui48(net_interface_ref->get_mac(), dest_mac_addr.value);
 	}
 
 	adp::~adp()
@@ -73,12 +69,12 @@ namespace avdecc_lib
 	struct jdksavdecc_eui64 adp::get_controller_guid()
 	{
 		uint64_t mac_guid;
-		mac_guid = ((net_interface_ref->get_mac() & UINT64_C(0xFFFFFF000000)) << 16) | UINT64_C(0x000000FFFF000000) | (net_interface_ref->get_mac() & UINT64_C(0xFFFFFF));
+		mac_guid = ((context->net_interface_ref->get_mac() & UINT64_C(0xFFFFFF000000)) << 16) | UINT64_C(0x000000FFFF000000) | (context->net_interface_ref->get_mac() & UINT64_C(0xFFFFFF));
 
 		return jdksavdecc_eui64_get(&mac_guid, 0);
 	}
 
-	int adp::ether_frame_init(struct jdksavdecc_frame *ether_frame)
+	int adp::ether_frame_init(controller_context *context, struct jdksavdecc_frame *ether_frame)
 	{
 		/*** Offset to write the field to ***/
 		size_t ether_frame_pos = 0x0;
@@ -86,7 +82,7 @@ namespace avdecc_lib
 
 		/********************** Ethernet Frame ***********************/
 		ether_frame->ethertype = JDKSAVDECC_AVTP_ETHERTYPE;
-		ether_frame->src_address = src_mac_addr;
+		convert_uint64_to_eui48(context->net_interface_ref->get_mac(), ether_frame->src_address.value);
 		//ether_frame->dest_address = get_dest_addr();
 		ether_frame->length = ADP_FRAME_LEN; // Length of ADP packet is 82 bytes
 
@@ -96,7 +92,7 @@ namespace avdecc_lib
 		return 0;
 	}
 
-	void adp::common_hdr_init(struct jdksavdecc_frame *ether_frame, uint64_t target_guid)
+	void adp::common_hdr_init(controller_context *context, struct jdksavdecc_frame *ether_frame, uint64_t target_guid)
 	{
 		struct jdksavdecc_adpdu_common_control_header adpdu_common_ctrl_hdr;
 		int adpdu_common_ctrl_hdr_returned;
@@ -119,7 +115,7 @@ namespace avdecc_lib
 
 		if(adpdu_common_ctrl_hdr_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "adpdu_common_ctrl_hdr_write error");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "adpdu_common_ctrl_hdr_write error");
 			assert(adpdu_common_ctrl_hdr_returned >= 0);
 		}
 	}
@@ -35,16 +35,17 @@
 
 namespace avdecc_lib
 {
+	class controller_context;
+
 	class adp
 	{
 	private:
+		controller_context *context; // The Controller the advertisement was received by
 		struct jdksavdecc_frame ether_frame; // Structure containing the Ethernet Frame fields
 		struct jdksavdecc_adpdu adpdu; // Structure containing the ADPDU fields
 		uint8_t *adp_frame; // Point to a raw memory buffer to read from
 		int frame_read_returned; // Status of extracting Ethernet Frame information from a network buffer
 		int adpdu_read_returned; // Status of extracting ADPDU information from a network buffer
-		static struct jdksavdecc_eui48 src_mac_addr;
-		static struct jdksavdecc_eui48 dest_mac_addr;
 
 	public:
 		enum ether_hdr_info
@@ -67,9 +68,10 @@ namespace avdecc_lib
 		adp();
 
 		/**
-		 * Constructor for ADP used for constructing an object with a base pointer and memory buffer length.
+		 * Constructor for ADP used for constructing an object with the Controller receiving the advertisement, a base
+		 * pointer and memory buffer length.
 		 */
-		adp(uint8_t *frame, size_t mem_buf_len);
+		adp(controller_context *context, uint8_t *frame, size_t mem_buf_len);
 
 		/**
 		 * Destructor for ADP used for destroying objects
@@ -106,22 +108,14 @@ namespace avdecc_lib
 		struct jdksavdecc_eui64 get_controller_guid();
 
 		/**
-		 * Get the Source MAC address of the ADP packet.
-		 */
-		static inline struct jdksavdecc_eui48 get_src_mac_addr()
-		{
-			return src_mac_addr;
-		}
-
-		/**
-		 * Initialize and fill Ethernet frame payload with Ethernet frame information for ADP messages.
+		 * Initialize and fill Ethernet frame payload with Ethernet frame information for ADP messages sent by a Controller.
 		 */
-		static int ether_frame_init(struct jdksavdecc_frame *ether_frame);
+		static int ether_frame_init(controller_context *context, struct jdksavdecc_frame *ether_frame);
 
 		/**
 		 * Initialize and fill Ethernet frame payload with 1722 ADP Header information.
 		 */
-		static void common_hdr_init(struct jdksavdecc_frame *ether_frame, uint64_t target_guid);
+		static void common_hdr_init(controller_context *context, struct jdksavdecc_frame *ether_frame, uint64_t target_guid);
 
 		/**
 		 * Get the header field of the ADP object.
@@ -34,23 +34,28 @@
 #include "notification.h"
 #include "log.h"
 #include "adp.h"
+#include "controller_context.h"
 #include "adp_discovery_state_machine.h"
 
 namespace avdecc_lib
 {
-	adp_discovery_state_machine *adp_discovery_state_machine_ref = new adp_discovery_state_machine(); // To have one ADP Discovery State Machine for all end stations
-
-	uint16_t adp_discovery_state_machine::adp_seq_id = 0x0;
-
-	adp_discovery_state_machine::adp_discovery_state_machine()
+	adp_discovery_state_machine::adp_discovery_state_machine(controller_context *context)
 	{
+		this->context = context;
+		adp_seq_id = 0x0;
 		discovery_state_machine_vars.rcvd_avail = false;
 		discovery_state_machine_vars.rcvd_departing = false;
 		discovery_state_machine_vars.do_discover = false;
 		discovery_state_machine_vars.do_terminate = false;
 	}
 
-	adp_discovery_state_machine::~adp_discovery_state_machine() {}
+	adp_discovery_state_machine::~adp_discovery_state_machine()
+	{
+		while(!discovery_state_machine_vars.entities_vector.empty())
+		{
+			adp_discovery_remove_entity(discovery_state_machine_vars.entities_vector.size() - 1);
+		}
+	}
 
 	int adp_discovery_state_machine::adp_discovery_perform_discover(uint64_t entity_id)
 	{
@@ -62,11 +67,11 @@ namespace avdecc_lib
 	int adp_discovery_state_machine::adp_discovery_tx_discover(struct jdksavdecc_frame *ether_frame)
 	{
 		int send_frame_returned;
-		send_frame_returned = net_interface_ref->send_frame(ether_frame->payload, ether_frame->length); // Send the frame with message information
+		send_frame_returned = context->net_interface_ref->send_frame(ether_frame->payload, ether_frame->length); // Send the frame with message information
 
 		if(send_frame_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "netif_send_frame error");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "netif_send_frame error");
 			assert(send_frame_returned >= 0);
 		}
 
@@ -77,7 +82,7 @@ namespace avdecc_lib
 	{
 		for(uint32_t index_i = 0; index_i < discovery_state_machine_vars.entities_vector.size(); index_i++)
 		{
-			if(discovery_state_machine_vars.entities_vector.at(index_i).entity_id == entity_id)
+			if(discovery_state_machine_vars.entities_vector.at(index_i)->entity_id == entity_id)
 			{
 				*entity_index = index_i;
 				return true;
@@ -89,11 +94,11 @@ namespace avdecc_lib
 
 	int adp_discovery_state_machine::adp_discovery_update_entity(uint32_t entity_index)
 	{
-		discovery_state_machine_vars.entities_vector.at(entity_index).avdecc_lib_timer_ref->start(END_STATION_CONNECTION_TIMEOUT);
+		context->timer_wheel_ref->arm(&discovery_state_machine_vars.entities_vector.at(entity_index)->entity_timer, END_STATION_CONNECTION_TIMEOUT);
 		return 0;
 	}
 
-	int adp_discovery_state_machine::adp_discovery_add_entity(struct adp_discovery_state_machine_entities new_entity)
+	int adp_discovery_state_machine::adp_discovery_add_entity(struct adp_discovery_state_machine_entities *new_entity)
 	{
 		discovery_state_machine_vars.entities_vector.push_back(new_entity);
 		return 0;
@@ -101,7 +106,10 @@ namespace avdecc_lib
 
 	int adp_discovery_state_machine::adp_discovery_remove_entity(uint32_t entity_index)
 	{
-		delete discovery_state_machine_vars.entities_vector.at(entity_index).avdecc_lib_timer_ref;
+		struct adp_discovery_state_machine_entities *entity = discovery_state_machine_vars.entities_vector.at(entity_index);
+
+		context->timer_wheel_ref->cancel(&entity->entity_timer);
+		delete entity;
 		discovery_state_machine_vars.entities_vector.erase(discovery_state_machine_vars.entities_vector.begin() + entity_index);
 		return 0;
 	}
@@ -128,8 +136,8 @@ namespace avdecc_lib
 	int adp_discovery_state_machine::adp_discovery_state_discover()
 	{
 		struct jdksavdecc_frame ether_frame;
-		adp::ether_frame_init(&ether_frame);
-		adp::common_hdr_init(&ether_frame, NULL);
+		adp::ether_frame_init(context, &ether_frame);
+		adp::common_hdr_init(context, &ether_frame, NULL);
 		adp_discovery_tx_discover(&ether_frame);
 		discovery_state_machine_vars.do_discover = false;
 
@@ -150,12 +158,13 @@ namespace avdecc_lib
 
 		else
 		{
-			struct adp_discovery_state_machine_entities entity;
-			entity.entity_id = entity_guid;
-			entity.avdecc_lib_timer_ref = new timer();
-			entity.avdecc_lib_timer_ref ->start(END_STATION_CONNECTION_TIMEOUT);
+			struct adp_discovery_state_machine_entities *entity = new struct adp_discovery_state_machine_entities;
+			entity->entity_id = entity_guid;
+			entity->owner = this;
+			timer_wheel::init_entry(&entity->entity_timer, entity_timeout, entity);
+			context->timer_wheel_ref->arm(&entity->entity_timer, END_STATION_CONNECTION_TIMEOUT);
 			adp_discovery_add_entity(entity);
-			avdecc_lib::notification_ref->notifying(avdecc_lib::END_STATION_CONNECTED, entity_guid, 0, 0, 0, 0);
+			context->notification_ref->notifying(avdecc_lib::END_STATION_CONNECTED, entity_guid, 0, 0, 0, 0);
 		}
 
 		discovery_state_machine_vars.rcvd_avail = false;
@@ -173,19 +182,30 @@ namespace avdecc_lib
 		return 0;
 	}
 
+	void adp_discovery_state_machine::entity_timeout(void *entity)
+	{
+		adp_discovery_state_machine *owner = ((struct adp_discovery_state_machine_entities *)entity)->owner;
+		uint64_t entity_guid = ((struct adp_discovery_state_machine_entities *)entity)->entity_id;
+		uint32_t entity_index;
+
+		if(owner->adp_discovery_have_entity(entity_guid, &entity_index))
+		{
+			owner->adp_discovery_state_timeout(entity_index);
+			owner->discovery_state_machine_vars.timed_out_entities.push_back(entity_guid);
+			owner->context->notification_ref->notifying(avdecc_lib::END_STATION_DISCONNECTED, entity_guid, 0, 0, 0, 0);
+		}
+	}
+
 	bool adp_discovery_state_machine::adp_discovery_tick(uint64_t &end_station_guid)
 	{
-		for(uint32_t index_i = 0; index_i < discovery_state_machine_vars.entities_vector.size(); index_i++)
+		if(discovery_state_machine_vars.timed_out_entities.empty())
 		{
-			if(discovery_state_machine_vars.entities_vector.at(index_i).avdecc_lib_timer_ref->timeout())
-			{
-				end_station_guid = discovery_state_machine_vars.entities_vector.at(index_i).entity_id;
-				adp_discovery_state_timeout(index_i);
-				avdecc_lib::notification_ref->notifying(avdecc_lib::END_STATION_DISCONNECTED, end_station_guid, 0, 0, 0, 0);
-				return true;
-			}
+			return false;
 		}
 
-		return false;
+		end_station_guid = discovery_state_machine_vars.timed_out_entities.front();
+		discovery_state_machine_vars.timed_out_entities.erase(discovery_state_machine_vars.timed_out_entities.begin());
+
+		return true;
 	}
 }
@@ -31,12 +31,14 @@
 #ifndef _AVDECC_CONTROLLER_LIB_ADP_DISCOVERY_STATE_MACHINE_H_
 #define _AVDECC_CONTROLLER_LIB_ADP_DISCOVERY_STATE_MACHINE_H_
 
-#include "timer.h"
+#include "timer_wheel.h"
 
 #define END_STATION_CONNECTION_TIMEOUT 62000
 
 namespace avdecc_lib
 {
+	class controller_context;
+
 	class adp_discovery_state_machine
 	{
 	private:
@@ -51,7 +53,8 @@ namespace avdecc_lib
 		{
 			//			struct adp_discovery_state_machine_rcvd_entity_info rcvd_entity_info;
 			uint64_t entity_id;
-			timer *avdecc_lib_timer_ref;
+			adp_discovery_state_machine *owner; // The state machine the entity was discovered by, for the expiry of entity_timer
+			timer_wheel::entry entity_timer; // Restarted by each advertisement of the entity
 		};
 
 		struct adp_discovery_state_machine_vars
@@ -60,19 +63,21 @@ namespace avdecc_lib
 			bool rcvd_departing;
 			bool do_discover;
 			uint64_t discover_id;
-			std::vector<struct adp_discovery_state_machine_entities> entities_vector;
+			std::vector<struct adp_discovery_state_machine_entities *> entities_vector;
+			std::vector<uint64_t> timed_out_entities; // The entities timed out and not yet reported by adp_discovery_tick
 			bool do_terminate;
 		};
 
+		controller_context *context; // The Controller the state machine runs for
 		struct adp_discovery_state_machine_vars discovery_state_machine_vars;
 
 	public:
-		static uint16_t adp_seq_id; // The sequence id used for identifying the ADP command that a response is for
+		uint16_t adp_seq_id; // The sequence id used for identifying the ADP command that a response is for
 
 		/**
-		 * An empty constructor for adp_state_machine
+		 * Constructor for adp_state_machine used for constructing the state machine of a Controller.
 		 */
-		adp_discovery_state_machine();
+		adp_discovery_state_machine(controller_context *context);
 
 		/**
 		 * Destructor for adp_state_machine used for destroying objects
@@ -102,7 +107,7 @@ namespace avdecc_lib
 		/**
 		 * Add a new Entity record to the entities variable.
 		 */
-		int adp_discovery_add_entity(struct adp_discovery_state_machine_entities new_entity);
+		int adp_discovery_add_entity(struct adp_discovery_state_machine_entities *new_entity);
 
 		/**
 		 * Remove an Entity record form the entities variable.
@@ -199,12 +204,18 @@ namespace avdecc_lib
 		}
 
 		/**
-		 * Check timeout for the end stations.
+		 * Get an End Station that has timed out since it was last checked.
+		 *
+		 * \return True if an End Station has timed out, false otherwise.
 		 */
 		bool adp_discovery_tick(uint64_t &end_station_guid);
-	};
 
-	extern adp_discovery_state_machine *adp_discovery_state_machine_ref;
+	private:
+		/**
+		 * Handle the expiry of the timer of an entity.
+		 */
+		static void entity_timeout(void *entity);
+	};
 }
 
 #endif
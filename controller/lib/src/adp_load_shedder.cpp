@@ -0,0 +1,124 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * adp_load_shedder.cpp
+ *
+ * ADP load shedder implementation
+ */
+
+#include "enumeration.h"
+#include "adp.h"
+#include "adp_load_shedder.h"
+
+namespace avdecc_lib
+{
+	adp_load_shedder::adp_load_shedder()
+	{
+		adp_frame_count = 0;
+		shed_count = 0;
+	}
+
+	adp_load_shedder::~adp_load_shedder() {}
+
+	bool adp_load_shedder::is_redundant(const frame_view &rx_frame, bool is_under_pressure, uint64_t now_ms)
+	{
+		uint32_t entity_pos;
+		uint32_t available_index;
+		uint32_t adpdu_hash;
+		bool is_new_info;
+
+		if(rx_frame.subtype() != JDKSAVDECC_SUBTYPE_ADP)
+		{
+			return false;
+		}
+
+		adp_frame_count++;
+
+		/**
+		 * Departing and discover messages are always passed on.
+		 */
+		if((rx_frame.msg_type() != JDKSAVDECC_ADP_MESSAGE_TYPE_ENTITY_AVAILABLE) ||
+		   (rx_frame.length() < adp::ETHER_HDR_SIZE + JDKSAVDECC_ADPDU_LEN))
+		{
+			return false;
+		}
+
+		available_index = jdksavdecc_uint32_get(rx_frame.frame(), adp::ETHER_HDR_SIZE + JDKSAVDECC_ADPDU_OFFSET_AVAILABLE_INDEX);
+		adpdu_hash = hash_adpdu(rx_frame.frame());
+
+		if(!entity_index.find(rx_frame.guid(), entity_pos))
+		{
+			if(entities.size() < ADP_SHED_MAX_ENTITY_COUNT)
+			{
+				struct entity_state entity;
+
+				entity.available_index = available_index;
+				entity.adpdu_hash = adpdu_hash;
+				entity.accepted_ms = now_ms;
+				entity_index.insert(rx_frame.guid(), entities.size());
+				entities.push_back(entity);
+			}
+
+			return false;
+		}
+
+		struct entity_state &entity = entities[entity_pos];
+
+		/**
+		 * The available index only goes back when the entity has restarted.
+		 */
+		is_new_info = (available_index <= entity.available_index) || (adpdu_hash != entity.adpdu_hash) ||
+		              (now_ms - entity.accepted_ms >= ADP_SHED_REFRESH_MS);
+		entity.available_index = available_index;
+
+		if(is_under_pressure && !is_new_info)
+		{
+			shed_count++;
+			return true;
+		}
+
+		entity.adpdu_hash = adpdu_hash;
+		entity.accepted_ms = now_ms;
+
+		return false;
+	}
+
+	uint32_t adp_load_shedder::hash_adpdu(const uint8_t *frame)
+	{
+		uint32_t hash = 2166136261U; // FNV-1a
+
+		for(uint32_t pos = adp::ETHER_HDR_SIZE; pos < adp::ETHER_HDR_SIZE + JDKSAVDECC_ADPDU_LEN; pos++)
+		{
+			if((pos >= adp::ETHER_HDR_SIZE + JDKSAVDECC_ADPDU_OFFSET_AVAILABLE_INDEX) &&
+			   (pos < adp::ETHER_HDR_SIZE + JDKSAVDECC_ADPDU_OFFSET_AVAILABLE_INDEX + 4))
+			{
+				continue;
+			}
+
+			hash = (hash ^ frame[pos]) * 16777619U;
+		}
+
+		return hash;
+	}
+}
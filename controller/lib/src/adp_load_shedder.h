@@ -0,0 +1,114 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * adp_load_shedder.h
+ *
+ * ADP load shedder class, which classifies the frames captured on the ADP channel before they are queued to the
+ * engine, and discards the ENTITY_AVAILABLE advertisements that carry no new information while the engine is behind,
+ * so that discovery traffic does not hold up the processing of command responses.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_ADP_LOAD_SHEDDER_H_
+#define _AVDECC_CONTROLLER_LIB_ADP_LOAD_SHEDDER_H_
+
+#include <stdint.h>
+#include <vector>
+#include "guid_index.h"
+#include "frame_view.h"
+
+namespace avdecc_lib
+{
+	class adp_load_shedder
+	{
+	public:
+		enum adp_load_shedder_sizes
+		{
+		        ADP_SHED_MAX_ENTITY_COUNT = 4096, // Advertisements of the entities seen after this many are never discarded
+		        ADP_SHED_REFRESH_MS = 1000 // An advertisement of an entity is passed on at least this often, so it never times out
+		};
+
+	private:
+		struct entity_state
+		{
+			uint32_t available_index; // The available index of the last advertisement of the entity
+			uint32_t adpdu_hash; // The hash of the last advertisement passed on, without its available index
+			uint64_t accepted_ms; // The time the last advertisement of the entity was passed on
+		};
+
+		std::vector<struct entity_state> entities; // The entities advertised, in the order they were first seen
+		guid_index entity_index; // The position of each entity in entities, by Entity GUID
+		volatile uint32_t adp_frame_count; // The number of ADP frames classified
+		volatile uint32_t shed_count; // The number of ADP frames discarded
+
+	public:
+		/**
+		 * An empty constructor for adp_load_shedder
+		 */
+		adp_load_shedder();
+
+		/**
+		 * Destructor for adp_load_shedder used for destroying objects
+		 */
+		~adp_load_shedder();
+
+		/**
+		 * Classify a captured frame and record the advertisement of an entity. Only called by the thread capturing
+		 * the ADP channel.
+		 *
+		 * \param rx_frame The captured frame.
+		 * \param is_under_pressure Set if the engine has frames left to process, so advertisements can be discarded.
+		 * \param now_ms The current time of the monotonic clock.
+		 *
+		 * \return True if the frame is an advertisement with no new information that is to be discarded: the entity
+		 *         has not restarted, its advertised state has not changed, and an advertisement of the entity has
+		 *         been passed on within ADP_SHED_REFRESH_MS.
+		 */
+		bool is_redundant(const frame_view &rx_frame, bool is_under_pressure, uint64_t now_ms);
+
+		/**
+		 * Get the number of ADP frames classified.
+		 */
+		inline uint32_t get_adp_frame_count()
+		{
+			return adp_frame_count;
+		}
+
+		/**
+		 * Get the number of ADP frames discarded.
+		 */
+		inline uint32_t get_shed_count()
+		{
+			return shed_count;
+		}
+
+	private:
+		/**
+		 * Get a hash of an ADPDU that leaves out its available index, which changes with every advertisement.
+		 */
+		static uint32_t hash_adpdu(const uint8_t *frame);
+	};
+}
+
+#endif
@@ -32,21 +32,24 @@
 #include "log.h"
 #include "util.h"
 #include "adp.h"
+#include "end_station_imp.h"
+#include "controller_context.h"
 #include "aecp.h"
 
 namespace avdecc_lib
 {
 	aecp::aecp() {}
 
-	aecp::aecp(uint8_t *frame, size_t pos, size_t mem_buf_len)
+	aecp::aecp(controller_context *context, uint8_t *frame, size_t pos, size_t mem_buf_len)
 	{
+		this->context = context;
 		aecp_frame = (uint8_t *)malloc(mem_buf_len * sizeof(uint8_t));
 		memcpy(aecp_frame, frame, mem_buf_len);
 		aecpdu_aem_read_returned = jdksavdecc_aecpdu_aem_read(&aecpdu, aecp_frame, pos, mem_buf_len);
 
 		if(aecpdu_aem_read_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aecpdu_aem_read error");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aecpdu_aem_read error");
 			assert(aecpdu_aem_read_returned >= 0);
 		}
 	}
@@ -56,25 +59,19 @@ namespace avdecc_lib
 		free(aecp_frame);
 	}
 
-	int aecp::ether_frame_init(end_station *end_station, struct jdksavdecc_frame *ether_frame)
+	int aecp::ether_frame_init(end_station_imp *end_station, uint8_t *frame)
 	{
-		/*** Offset to write the field to ***/
-		size_t ether_frame_pos = 0x0;
-		jdksavdecc_frame_init(ether_frame);
+		memset(frame, 0, AECP_FRAME_LEN);
 
 		/***************************** Ethernet Frame ****************************/
-		ether_frame->ethertype = JDKSAVDECC_AVTP_ETHERTYPE;
-		convert_uint64_to_eui48(net_interface_ref->get_mac(), ether_frame->src_address.value);
-		convert_uint64_to_eui48(end_station->get_end_station_mac(), ether_frame->dest_address.value);
-		ether_frame->length = AECP_FRAME_LEN; // Length of AECP packet is 64 bytes
-
-		/*********************** Fill frame payload with Ethernet frame information ********************/
-		jdksavdecc_frame_write(ether_frame, ether_frame->payload, ether_frame_pos, adp::ETHER_HDR_SIZE);
+		convert_uint64_to_eui48(end_station->get_end_station_mac(), frame);
+		convert_uint64_to_eui48(end_station->get_context()->net_interface_ref->get_mac(), frame + adp::DEST_MAC_SIZE);
+		jdksavdecc_uint16_set(JDKSAVDECC_AVTP_ETHERTYPE, frame, adp::DEST_MAC_SIZE + adp::SRC_MAC_SIZE);
 
 		return 0;
 	}
 
-	void aecp::common_hdr_init(struct jdksavdecc_frame *ether_frame, uint64_t target_guid)
+	void aecp::common_hdr_init(end_station_imp *end_station, uint8_t *frame, size_t frame_size)
 	{
 		struct jdksavdecc_aecpdu_common_control_header aecpdu_common_ctrl_hdr;
 		int aecpdu_common_ctrl_hdr_returned;
@@ -91,17 +88,17 @@ namespace avdecc_lib
 		aecpdu_common_ctrl_hdr.message_type = JDKSAVDECC_AECP_MESSAGE_TYPE_AEM_COMMAND;
 		aecpdu_common_ctrl_hdr.status = JDKSAVDECC_AEM_STATUS_SUCCESS;
 		aecpdu_common_ctrl_hdr.control_data_length = 20;
-		jdksavdecc_uint64_write(target_guid, &aecpdu_common_ctrl_hdr.target_entity_id, 0, sizeof(uint64_t));
+		jdksavdecc_uint64_write(end_station->get_end_station_guid(), &aecpdu_common_ctrl_hdr.target_entity_id, 0, sizeof(uint64_t));
 
 		/*********************** Fill frame payload with AECP Common Control Header information **********************/
 		aecpdu_common_ctrl_hdr_returned = jdksavdecc_aecpdu_common_control_header_write(&aecpdu_common_ctrl_hdr,
-		                                                                                ether_frame->payload,
+		                                                                                frame,
 		                                                                                aecpdu_common_pos,
-		                                                                                sizeof(ether_frame->payload));
+		                                                                                frame_size);
 
 		if(aecpdu_common_ctrl_hdr_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "adpdu_common_ctrl_hdr_write error");
+			end_station->get_context()->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "adpdu_common_ctrl_hdr_write error");
 			assert(aecpdu_common_ctrl_hdr_returned >= 0);
 		}
 	}
@@ -37,9 +37,13 @@
 
 namespace avdecc_lib
 {
+	class controller_context;
+	class end_station_imp;
+
 	class aecp
 	{
 	private:
+		controller_context *context; // The Controller the AECPDU was received by
 		struct jdksavdecc_aecpdu_aem aecpdu; // Structure containing the AECPDU fields
 		uint8_t *aecp_frame; // Point to a raw memory buffer to read from
 		int aecpdu_aem_read_returned; // Status of extracting AECPDU information from a network buffer
@@ -52,6 +56,8 @@ namespace avdecc_lib
 		        TARGET_GUID_POS = adp::ETHER_HDR_SIZE + adp::PROTOCOL_HDR_SIZE,
 		        SEQ_ID_POS = adp::ETHER_HDR_SIZE + JDKSAVDECC_COMMON_CONTROL_HEADER_LEN + JDKSAVDECC_AECPDU_AEM_OFFSET_SEQUENCE_ID,
 		        CMD_TYPE_POS = adp::ETHER_HDR_SIZE + JDKSAVDECC_COMMON_CONTROL_HEADER_LEN + JDKSAVDECC_AECPDU_AEM_OFFSET_COMMAND_TYPE,
+		        DESC_TYPE_POS = adp::ETHER_HDR_SIZE + JDKSAVDECC_AECPDU_AEM_LEN, // The descriptor type of the commands addressed to a descriptor
+		        DESC_INDEX_POS = adp::ETHER_HDR_SIZE + JDKSAVDECC_AECPDU_AEM_LEN + 2,
 		        READ_DESC_POS = adp::ETHER_HDR_SIZE + JDKSAVDECC_AEM_COMMAND_READ_DESCRIPTOR_RESPONSE_LEN
 		};
 
@@ -64,7 +70,7 @@ namespace avdecc_lib
 		 * Constructor for aecp used for constructing an object with a base pointer, position offest,
 		 * and memory buffer length.
 		 */
-		aecp(uint8_t *frame, size_t pos, size_t mem_buf_len);
+		aecp(controller_context *context, uint8_t *frame, size_t pos, size_t mem_buf_len);
 
 		/**
 		 * Destructor for adp used for destroying objects
@@ -72,14 +78,14 @@ namespace avdecc_lib
 		~aecp();
 
 		/**
-		 * Initialize and fill Ethernet frame payload with Ethernet frame information for AEM commands.
+		 * Initialize an AEM command frame of AECP_FRAME_LEN bytes and fill it with the Ethernet header.
 		 */
-		static int ether_frame_init(end_station *end_station, struct jdksavdecc_frame *ether_frame);
+		static int ether_frame_init(end_station_imp *end_station, uint8_t *frame);
 
 		/**
-		 * Initialize and fill Ethernet frame payload with 1722 AECP Header information.
+		 * Fill an AEM command frame to an End Station with 1722 AECP Header information.
 		 */
-		static void common_hdr_init(struct jdksavdecc_frame *ether_frame, uint64_t target_guid);
+		static void common_hdr_init(end_station_imp *end_station, uint8_t *frame, size_t frame_size);
 
 		/**
 		 * Get the header field of the AECP object.
@@ -36,60 +36,74 @@
 #include "util.h"
 #include "adp.h"
 #include "aecp.h"
+#include "controller_context.h"
 #include "aem_controller_state_machine.h"
 
 namespace avdecc_lib
 {
-	aem_controller_state_machine *aem_controller_state_machine_ref = new aem_controller_state_machine(); // To have one Controller State Machine for all end stations
-
-	uint16_t aem_controller_state_machine::aecp_seq_id = 0x0;
-
-	aem_controller_state_machine::aem_controller_state_machine()
+	aem_controller_state_machine::aem_controller_state_machine(controller_context *context)
 	{
+		this->context = context;
 		controller_state_machine_vars.rcvd_normal_resp = false;
 		controller_state_machine_vars.rcvd_unsolicited_resp = false;
 		controller_state_machine_vars.do_cmd = false;
 		controller_state_machine_vars.do_terminate = false;
+		memset(&timing_stats, 0, sizeof(timing_stats));
+		timing_seq = 0;
 	}
 
 	aem_controller_state_machine::~aem_controller_state_machine() {}
 
-	void aem_controller_state_machine::tx_cmd(void *notification_id, uint32_t notification_flag, struct jdksavdecc_frame *ether_frame)
+	void aem_controller_state_machine::tx_cmd(void *notification_id, uint32_t notification_flag, const uint8_t *frame, uint16_t mem_buf_len)
 	{
-		int inflight_index;
-		bool is_inflight;
-		int send_frame_returned;
-		struct aem_controller_state_machine_inflight_cmd inflight_cmd;
-		inflight_cmd.seq_id = jdksavdecc_uint16_get(ether_frame->payload, aecp::SEQ_ID_POS);
-		inflight_cmd.notification_id = notification_id;
-		inflight_cmd.notification_flag = notification_flag;
-		convert_eui48_to_uint64(ether_frame->payload, inflight_cmd.dest_addr);
-
-		is_inflight = find_inflight_cmd_by_seq_id(inflight_cmd.seq_id, &inflight_index); // Check if the command is inflight
-
-		inflight_cmd.avdecc_lib_timer_ref = new timer(); // Create a timer object
-		inflight_cmd.avdecc_lib_timer_ref->start(AVDECC_MSG_TIMEOUT); // Start the timer
+		uint64_t target_guid = jdksavdecc_uint64_get(frame, aecp::TARGET_GUID_POS);
+		uint16_t seq_id = jdksavdecc_uint16_get(frame, aecp::SEQ_ID_POS);
+		struct inflight_table::inflight_cmd *inflight_cmd;
 
-		send_frame_returned = net_interface_ref->send_frame(ether_frame->payload, ether_frame->length);
-		if(send_frame_returned < 0)
+		if(mem_buf_len > inflight_table::INFLIGHT_FRAME_SIZE)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "netif_send_frame error");
-			assert(send_frame_returned >= 0);
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Command frame of %d bytes too long, command not sent", mem_buf_len);
+			return;
 		}
 
-		callback(notification_id, notification_flag, ether_frame->payload);
+		inflight_cmd = inflight_cmds.find(target_guid, seq_id);
+		if(inflight_cmd)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_WARNING, "Sequence id %d reused while inflight", seq_id);
+			remove_inflight_cmd(inflight_cmd);
+		}
 
-		if(is_inflight)
+		inflight_cmd = inflight_cmds.insert(target_guid, seq_id, notification_id, notification_flag, frame, mem_buf_len);
+		if(!inflight_cmd)
 		{
-			controller_state_machine_vars.inflight_cmds_vector.at(inflight_index).retried = true;
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "No inflight command entry available, command not sent");
+			return;
 		}
-		else
+
+		inflight_cmd->retried = false;
+		inflight_cmd->in_progress = false;
+		inflight_cmd->owner = this;
+		timer_wheel::init_entry(&inflight_cmd->cmd_timer, cmd_timeout, inflight_cmd);
+		send_cmd(inflight_cmd);
+	}
+
+	void aem_controller_state_machine::send_cmd(struct inflight_table::inflight_cmd *inflight_cmd)
+	{
+		int send_frame_returned;
+
+		context->timer_wheel_ref->arm(&inflight_cmd->cmd_timer, targets.at(find_or_add_target(inflight_cmd->target_guid)).rto_ms); // Start the timer
+		inflight_cmd->cmd_time_ns = clk.clk_realtime_ns();
+		inflight_cmd->send_time_us = clk.clk_monotonic_us();
+		inflight_cmd->tx_timestamp_ns = 0;
+
+		send_frame_returned = context->net_interface_ref->send_frame(inflight_cmd->frame, inflight_cmd->frame_len);
+		if(send_frame_returned < 0)
 		{
-			aecp_seq_id++;
-			inflight_cmd.retried = false;
-			memcpy(&inflight_cmd.inflight_cmd_frame, ether_frame, sizeof(struct jdksavdecc_frame));
-			controller_state_machine_vars.inflight_cmds_vector.push_back(inflight_cmd);  // Add the inflight command to the inflight command vector
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "netif_send_frame error");
+			assert(send_frame_returned >= 0);
 		}
+
+		callback(inflight_cmd->notification_id, inflight_cmd->notification_flag, inflight_cmd->frame);
 	}
 
 	//int aem_controller_state_machine::process_unsolicited(struct jdksavdecc_frame *ether_frame)
@@ -97,18 +111,30 @@ namespace avdecc_lib
 	//	return 0;
 	//}
 
-	int aem_controller_state_machine::process_resp(void *&notification_id, uint32_t &notification_flag, struct jdksavdecc_frame *ether_frame)
+	int aem_controller_state_machine::process_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame)
 	{
-		uint16_t seq_id = jdksavdecc_uint16_get(ether_frame->payload, aecp::SEQ_ID_POS);
-		int inflight_index = 0;
+		uint64_t target_guid = rx_frame.guid();
+		struct inflight_table::inflight_cmd *inflight_cmd = inflight_cmds.find(target_guid, rx_frame.seq_id());
 
-		if(find_inflight_cmd_by_seq_id(seq_id, &inflight_index))
+		if(inflight_cmd)
 		{
-			notification_id = controller_state_machine_vars.inflight_cmds_vector.at(inflight_index).notification_id;
-			notification_flag = controller_state_machine_vars.inflight_cmds_vector.at(inflight_index).notification_flag;
-			callback(notification_id, notification_flag, ether_frame->payload);
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG, "Command Success");
-			remove_inflight_cmd(inflight_index);
+			notification_id = inflight_cmd->notification_id;
+			notification_flag = inflight_cmd->notification_flag;
+			update_cmd_timing(*inflight_cmd, rx_frame.rx_timestamp());
+
+			/**
+			 * Only a command answered at the first attempt gives a round trip time sample, as a response to a retry
+			 * may answer either transmission and a response after IN_PROGRESS includes the processing time. The
+			 * sample is taken on the monotonic clock, so that a step of the wall clock does not skew the timeout.
+			 */
+			if(!inflight_cmd->retried && !inflight_cmd->in_progress)
+			{
+				update_rto(targets.at(find_or_add_target(target_guid)), (uint32_t)(clk.clk_monotonic_us() - inflight_cmd->send_time_us));
+			}
+
+			callback(notification_id, notification_flag, rx_frame.frame());
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG, "Command Success");
+			remove_inflight_cmd(inflight_cmd);
 
 			return 1;
 		}
@@ -116,49 +142,75 @@ namespace avdecc_lib
 		return -1;
 	}
 
-	void aem_controller_state_machine::timeout(uint32_t inflight_cmds_vector_index)
+	void aem_controller_state_machine::cmd_timeout(void *inflight_cmd)
+	{
+		struct inflight_table::inflight_cmd *timed_out_cmd = (struct inflight_table::inflight_cmd *)inflight_cmd;
+
+		timed_out_cmd->owner->timeout(timed_out_cmd);
+	}
+
+	void aem_controller_state_machine::timeout(struct inflight_table::inflight_cmd *inflight_cmd)
 	{
-		if(controller_state_machine_vars.inflight_cmds_vector.at(inflight_cmds_vector_index).retried)
+		struct target_state &target = targets.at(find_or_add_target(inflight_cmd->target_guid));
+		uint64_t now_ms = timer_wheel::clk_monotonic_ms();
+
+		/**
+		 * Back off until a command to the target is answered at the first attempt again. The commands pipelined to a
+		 * target time out together, so the timeout is doubled at most once per timeout interval.
+		 */
+		target.timeout_count++;
+
+		if(now_ms >= target.last_backoff_ms + target.rto_ms)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG, "Command timeout");
-			remove_inflight_cmd(inflight_cmds_vector_index);
+			target.rto_ms = (target.rto_ms < RTO_MAX_MS / 2) ? target.rto_ms * 2 : RTO_MAX_MS;
+			target.last_backoff_ms = now_ms;
+		}
+
+		if(inflight_cmd->retried)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG, "Command timeout");
+			remove_inflight_cmd(inflight_cmd);
 			printf("\n>");
 		}
 		else
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG,
-			                             "Resend the command with sequence id = %d",
-			                             controller_state_machine_vars.inflight_cmds_vector.at(inflight_cmds_vector_index).seq_id);
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG,
+			                          "Resend the command with sequence id = %d, timeout %u ms",
+			                          inflight_cmd->seq_id, target.rto_ms);
+
+			inflight_cmd->retried = true;
+			send_cmd(inflight_cmd);
+		}
+	}
 
-			tx_cmd(controller_state_machine_vars.inflight_cmds_vector.at(inflight_cmds_vector_index).notification_id,
-			       controller_state_machine_vars.inflight_cmds_vector.at(inflight_cmds_vector_index).notification_flag,
-			       &controller_state_machine_vars.inflight_cmds_vector.at(inflight_cmds_vector_index).inflight_cmd_frame);
+	void aem_controller_state_machine::aem_controller_state_waiting(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len)
+	{
+		if(controller_state_machine_vars.do_cmd)
+		{
+			uint64_t target_guid = jdksavdecc_uint64_get(frame, aecp::TARGET_GUID_POS);
+			jdksavdecc_uint16_set(next_seq_id(target_guid), frame, aecp::SEQ_ID_POS);
+			aem_controller_state_send_cmd(notification_id, notification_flag, frame, mem_buf_len);
 		}
 	}
 
-	void aem_controller_state_machine::aem_controller_state_waiting(void *&notification_id, uint32_t &notification_flag, struct jdksavdecc_frame *ether_frame)
+	void aem_controller_state_machine::aem_controller_state_waiting(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame)
 	{
 		uint64_t my_entity_id = 0;
 		uint64_t dest_addr_resp = 0;
 
-		if(net_interface_ref != NULL)
+		if(context->net_interface_ref != NULL)
 		{
-			my_entity_id = net_interface_ref->get_mac();
-			convert_eui48_to_uint64(jdksavdecc_eui64_get(ether_frame->payload, 0).value, dest_addr_resp);
+			my_entity_id = context->net_interface_ref->get_mac();
+			convert_eui48_to_uint64(rx_frame.frame(), dest_addr_resp);
 		}
 
-		if(controller_state_machine_vars.do_cmd)
-		{
-			jdksavdecc_uint16_set(aecp_seq_id, ether_frame->payload, aecp::SEQ_ID_POS);
-			aem_controller_state_send_cmd(notification_id, notification_flag, ether_frame);
-		}
-		else if(controller_state_machine_vars.rcvd_unsolicited_resp && dest_addr_resp == my_entity_id)
+		if(controller_state_machine_vars.rcvd_unsolicited_resp && dest_addr_resp == my_entity_id)
 		{
-			//aem_controller_state_rcvd_unsolicited(ether_frame);
+			//aem_controller_state_rcvd_unsolicited(rx_frame);
 		}
 		else if(controller_state_machine_vars.rcvd_normal_resp) // && dest_addr_response == my_entity_id)
 		{
-			aem_controller_state_rcvd_resp(notification_id, notification_flag, ether_frame);
+			aem_controller_state_rcvd_resp(notification_id, notification_flag, rx_frame);
 		}
 		else if((controller_state_machine_vars.rcvd_unsolicited_resp || controller_state_machine_vars.rcvd_normal_resp)
 		        && dest_addr_resp != my_entity_id)
@@ -167,9 +219,9 @@ namespace avdecc_lib
 		else {}
 	}
 
-	void aem_controller_state_machine::aem_controller_state_send_cmd(void *notification_id, uint32_t notification_flag, struct jdksavdecc_frame *ether_frame)
+	void aem_controller_state_machine::aem_controller_state_send_cmd(void *notification_id, uint32_t notification_flag, const uint8_t *frame, uint16_t mem_buf_len)
 	{
-		tx_cmd(notification_id, notification_flag, ether_frame);
+		tx_cmd(notification_id, notification_flag, frame, mem_buf_len);
 		controller_state_machine_vars.do_cmd = false;
 	}
 
@@ -179,45 +231,120 @@ namespace avdecc_lib
 	//	controller_state_machine_vars.rcvd_unsolicited_resp = false;
 	//}
 
-	void aem_controller_state_machine::aem_controller_state_rcvd_resp(void *&notification_id, uint32_t &notification_flag, struct jdksavdecc_frame *ether_frame)
+	void aem_controller_state_machine::aem_controller_state_rcvd_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame)
 	{
-		process_resp(notification_id, notification_flag, ether_frame);
+		process_resp(notification_id, notification_flag, rx_frame);
 		controller_state_machine_vars.rcvd_normal_resp = false;
 	}
 
-	void aem_controller_state_machine::aem_controller_tick()
+	void aem_controller_state_machine::tx_timestamp_event(const uint8_t *frame, uint16_t mem_buf_len, uint64_t tx_timestamp_ns)
 	{
-		for(uint32_t index_i = 0; index_i < controller_state_machine_vars.inflight_cmds_vector.size(); index_i++)
+		struct inflight_table::inflight_cmd *inflight_cmd;
+
+		if((mem_buf_len < aecp::SEQ_ID_POS + 2) ||
+		   (jdksavdecc_subtype_data_get_subtype(jdksavdecc_uint32_get(frame, aecp::CMD_POS)) != JDKSAVDECC_SUBTYPE_AECP) ||
+		   (jdksavdecc_uint8_get(frame, aecp::MSG_TYPE_POS) != JDKSAVDECC_AECP_MESSAGE_TYPE_AEM_COMMAND))
 		{
-			if(controller_state_machine_vars.inflight_cmds_vector.at(index_i).avdecc_lib_timer_ref->timeout())
-			{
-				timeout(index_i);
-			}
+			return;
+		}
+
+		inflight_cmd = inflight_cmds.find(jdksavdecc_uint64_get(frame, aecp::TARGET_GUID_POS), jdksavdecc_uint16_get(frame, aecp::SEQ_ID_POS));
+		if(inflight_cmd)
+		{
+			inflight_cmd->tx_timestamp_ns = tx_timestamp_ns;
 		}
 	}
 
-	int aem_controller_state_machine::update_inflight_for_rcvd_resp(void *&notification_id, uint32_t &notification_flag, uint32_t msg_type, bool u_field, struct jdksavdecc_frame *ether_frame)
+	void aem_controller_state_machine::update_cmd_timing(struct inflight_table::inflight_cmd &inflight_cmd, uint64_t rx_timestamp_ns)
 	{
-		if(msg_type == JDKSAVDECC_AECP_MESSAGE_TYPE_AEM_RESPONSE && u_field == true)
+		uint64_t resp_time_ns = clk.clk_realtime_ns();
+		uint64_t wire_rtt_ns;
+		uint64_t library_delay_ns;
+
+		/**
+		 * A response to a retried command cannot be matched to one of the transmissions, and a wall clock step
+		 * between the timestamps makes them meaningless, so neither is counted.
+		 */
+		if(inflight_cmd.retried || (inflight_cmd.tx_timestamp_ns == 0) || (rx_timestamp_ns == 0) ||
+		   (inflight_cmd.tx_timestamp_ns < inflight_cmd.cmd_time_ns) || (rx_timestamp_ns < inflight_cmd.tx_timestamp_ns) ||
+		   (resp_time_ns < rx_timestamp_ns))
+		{
+			return;
+		}
+
+		wire_rtt_ns = rx_timestamp_ns - inflight_cmd.tx_timestamp_ns;
+		library_delay_ns = (inflight_cmd.tx_timestamp_ns - inflight_cmd.cmd_time_ns) + (resp_time_ns - rx_timestamp_ns);
+
+		timing_seq++;
+		atomic_full_barrier();
+		timing_stats.timed_cmd_count++;
+		timing_stats.total_wire_rtt_ns += wire_rtt_ns;
+		timing_stats.total_library_delay_ns += library_delay_ns;
+
+		if(wire_rtt_ns > timing_stats.max_wire_rtt_ns)
+		{
+			timing_stats.max_wire_rtt_ns = wire_rtt_ns;
+		}
+
+		atomic_full_barrier();
+		timing_seq++;
+
+		context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_VERBOSE, "Sequence id %d wire round trip %u us, library delay %u us",
+		                          inflight_cmd.seq_id, (uint32_t)(wire_rtt_ns / 1000), (uint32_t)(library_delay_ns / 1000));
+	}
+
+	void aem_controller_state_machine::get_cmd_timing_stats(uint32_t &timed_cmd_count, uint32_t &avg_wire_rtt_us, uint32_t &max_wire_rtt_us, uint32_t &avg_library_delay_us)
+	{
+		struct cmd_timing_stats stats;
+		uint32_t seq;
+
+		/**
+		 * The statistics are read from application threads while the engine thread updates them, so the copy is
+		 * retried until it is taken between two updates.
+		 */
+		do
+		{
+			seq = timing_seq & ~1u;
+			atomic_full_barrier();
+			stats = timing_stats;
+			atomic_full_barrier();
+		}
+		while(timing_seq != seq);
+
+		timed_cmd_count = stats.timed_cmd_count;
+		avg_wire_rtt_us = 0;
+		avg_library_delay_us = 0;
+		max_wire_rtt_us = (uint32_t)(stats.max_wire_rtt_ns / 1000);
+
+		if(stats.timed_cmd_count > 0)
+		{
+			avg_wire_rtt_us = (uint32_t)(stats.total_wire_rtt_ns / stats.timed_cmd_count / 1000);
+			avg_library_delay_us = (uint32_t)(stats.total_library_delay_ns / stats.timed_cmd_count / 1000);
+		}
+	}
+
+	int aem_controller_state_machine::update_inflight_for_rcvd_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame)
+	{
+		if(rx_frame.msg_type() == JDKSAVDECC_AECP_MESSAGE_TYPE_AEM_RESPONSE && rx_frame.is_unsolicited())
 		{
 			controller_state_machine_vars.rcvd_unsolicited_resp = true;
-			aem_controller_state_waiting(notification_id, notification_flag, ether_frame);
+			aem_controller_state_waiting(notification_id, notification_flag, rx_frame);
 		}
-		else if(msg_type == JDKSAVDECC_AECP_MESSAGE_TYPE_AEM_RESPONSE && u_field == false)
+		else if(rx_frame.msg_type() == JDKSAVDECC_AECP_MESSAGE_TYPE_AEM_RESPONSE)
 		{
 			controller_state_machine_vars.rcvd_normal_resp = true;
-			aem_controller_state_waiting(notification_id, notification_flag, ether_frame);
+			aem_controller_state_waiting(notification_id, notification_flag, rx_frame);
 		}
 		else
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Invalid message type");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Invalid message type");
 			return -1;
 		}
 
 		return 0;
 	}
 
-	int aem_controller_state_machine::callback(void *notification_id, uint32_t notification_flag, uint8_t *frame)
+	int aem_controller_state_machine::callback(void *notification_id, uint32_t notification_flag, const uint8_t *frame)
 	{
 		uint8_t msg_type = jdksavdecc_uint8_get(frame, aecp::MSG_TYPE_POS);
 		uint16_t cmd_type = jdksavdecc_uint16_get(frame, aecp::CMD_TYPE_POS);
@@ -302,83 +429,214 @@ namespace avdecc_lib
 				desc_index = jdksavdecc_uint16_get(frame, adp::ETHER_HDR_SIZE + JDKSAVDECC_AEM_COMMAND_STOP_STREAMING_RESPONSE_OFFSET_DESCRIPTOR_INDEX);
 				break;
 			default:
-				avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG, "NO_MATCH_FOUND for %s", avdecc_lib::aem_string::cmd_value_to_name(cmd_type));
+				context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG, "NO_MATCH_FOUND for %s", avdecc_lib::aem_string::cmd_value_to_name(cmd_type));
 				break;
 		}
 
 		if((notification_flag == CMD_WITH_NOTIFICATION) && (msg_type == JDKSAVDECC_AECP_MESSAGE_TYPE_AEM_COMMAND))
 		{
-			avdecc_lib::notification_ref->notifying(avdecc_lib::COMMAND_SENT,
-			                                        jdksavdecc_uint64_get(frame, aecp::TARGET_GUID_POS),
-			                                        cmd_type,
-			                                        desc_type,
-			                                        desc_index,
-			                                        notification_id);
+			context->notification_ref->notifying(avdecc_lib::COMMAND_SENT,
+			                                     jdksavdecc_uint64_get(frame, aecp::TARGET_GUID_POS),
+			                                     cmd_type,
+			                                     desc_type,
+			                                     desc_index,
+			                                     notification_id);
 		}
 		else if((notification_flag == CMD_WITH_NOTIFICATION) && (msg_type == JDKSAVDECC_AECP_MESSAGE_TYPE_AEM_RESPONSE))
 		{
-			avdecc_lib::notification_ref->notifying(avdecc_lib::RESPONSE_RECEIVED,
-			                                        jdksavdecc_uint64_get(frame, aecp::TARGET_GUID_POS),
-			                                        cmd_type,
-			                                        desc_type,
-			                                        desc_index,
-			                                        notification_id);
+			context->notification_ref->notifying(avdecc_lib::RESPONSE_RECEIVED,
+			                                     jdksavdecc_uint64_get(frame, aecp::TARGET_GUID_POS),
+			                                     cmd_type,
+			                                     desc_type,
+			                                     desc_index,
+			                                     notification_id);
 		}
 		else if((notification_flag == CMD_WITHOUT_NOTIFICATION) && (msg_type == JDKSAVDECC_AECP_MESSAGE_TYPE_AEM_COMMAND))
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG,
-			                             "COMMAND_SENT, 0x%llx, %s, %s, %d, %d",
-			                             jdksavdecc_uint64_get(frame, aecp::TARGET_GUID_POS),
-			                             avdecc_lib::aem_string::cmd_value_to_name(cmd_type),
-			                             avdecc_lib::aem_string::desc_value_to_name(desc_type),
-			                             desc_index,
-			                             jdksavdecc_uint16_get(frame, aecp::SEQ_ID_POS));
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG,
+			                          "COMMAND_SENT, 0x%llx, %s, %s, %d, %d",
+			                          jdksavdecc_uint64_get(frame, aecp::TARGET_GUID_POS),
+			                          avdecc_lib::aem_string::cmd_value_to_name(cmd_type),
+			                          avdecc_lib::aem_string::desc_value_to_name(desc_type),
+			                          desc_index,
+			                          jdksavdecc_uint16_get(frame, aecp::SEQ_ID_POS));
 		}
 		else if((notification_flag == CMD_WITHOUT_NOTIFICATION) && (msg_type == JDKSAVDECC_AECP_MESSAGE_TYPE_AEM_RESPONSE))
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG,
-			                             "RESPONSE_RECEIVED, 0x%llx, %s, %s, %d, %d",
-			                             jdksavdecc_uint64_get(frame, aecp::TARGET_GUID_POS),
-			                             avdecc_lib::aem_string::cmd_value_to_name(cmd_type),
-			                             avdecc_lib::aem_string::desc_value_to_name(desc_type),
-			                             desc_index,
-			                             jdksavdecc_uint16_get(frame, aecp::SEQ_ID_POS));
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG,
+			                          "RESPONSE_RECEIVED, 0x%llx, %s, %s, %d, %d",
+			                          jdksavdecc_uint64_get(frame, aecp::TARGET_GUID_POS),
+			                          avdecc_lib::aem_string::cmd_value_to_name(cmd_type),
+			                          avdecc_lib::aem_string::desc_value_to_name(desc_type),
+			                          desc_index,
+			                          jdksavdecc_uint16_get(frame, aecp::SEQ_ID_POS));
 		}
 
 		return 0;
 	}
 
-	bool aem_controller_state_machine::find_inflight_cmd_by_seq_id(uint16_t seq_id, int *inflight_index)
+	uint32_t aem_controller_state_machine::find_or_add_target(uint64_t target_guid)
 	{
-		for(uint32_t index_i = 0; index_i < controller_state_machine_vars.inflight_cmds_vector.size(); index_i++)
+		uint32_t target_pos;
+
+		if(!target_index.find(target_guid, target_pos))
 		{
-			if((controller_state_machine_vars.inflight_cmds_vector.at(index_i).seq_id == seq_id))
-			{
-				*inflight_index = index_i;
-				return true;
-			}
+			struct target_state target;
+
+			memset(&target, 0, sizeof(target));
+			target.target_guid = target_guid;
+			target.rto_ms = AVDECC_MSG_TIMEOUT; // Until the first round trip time sample
+			target_pos = (uint32_t)targets.size();
+			targets.push_back(target);
+			target_index.insert(target_guid, target_pos);
 		}
 
-		return false;
+		return target_pos;
 	}
 
-	bool aem_controller_state_machine::find_inflight_cmd_by_notification_id(void *notification_id)
+	void aem_controller_state_machine::remove_target(uint64_t target_guid)
 	{
-		for(uint32_t index_i = 0; index_i < controller_state_machine_vars.inflight_cmds_vector.size(); index_i++)
+		uint32_t target_pos;
+
+		if(!target_index.find(target_guid, target_pos))
 		{
-			if((controller_state_machine_vars.inflight_cmds_vector.at(index_i).notification_id == notification_id))
-			{
-				return true;
-			}
+			return;
 		}
 
-		return false;
+		/**
+		 * Move the last target into the position of the target removed, so that the targets stay contiguous.
+		 */
+		if(target_pos != targets.size() - 1)
+		{
+			targets.at(target_pos) = targets.back();
+			target_index.insert(targets.at(target_pos).target_guid, target_pos);
+		}
+
+		targets.pop_back();
+		target_index.remove(target_guid);
+	}
+
+	uint16_t aem_controller_state_machine::next_seq_id(uint64_t target_guid)
+	{
+		struct target_state &target = targets.at(find_or_add_target(target_guid));
+		uint16_t seq_id = target.next_seq_id;
+
+		/**
+		 * At most INFLIGHT_TABLE_CAPACITY commands are inflight, so a free sequence id is found well within the window.
+		 */
+		while(inflight_cmds.find(target_guid, seq_id))
+		{
+			seq_id++;
+		}
+
+		target.next_seq_id = seq_id + 1;
+
+		return seq_id;
+	}
+
+	void aem_controller_state_machine::update_rto(struct target_state &target, uint32_t rtt_us)
+	{
+		uint32_t rto_us;
+
+		/**
+		 * The estimator of RFC 6298, with the variation weighted by 4 and no clock granularity term.
+		 */
+		if(target.rtt_sample_count == 0)
+		{
+			target.srtt_us = rtt_us;
+			target.rttvar_us = rtt_us / 2;
+		}
+		else
+		{
+			uint32_t rtt_error_us = (target.srtt_us > rtt_us) ? target.srtt_us - rtt_us : rtt_us - target.srtt_us;
+			target.rttvar_us = target.rttvar_us - target.rttvar_us / 4 + rtt_error_us / 4;
+			target.srtt_us = target.srtt_us - target.srtt_us / 8 + rtt_us / 8;
+		}
+
+		target.rtt_sample_count++;
+		rto_us = target.srtt_us + 4 * target.rttvar_us;
+		target.rto_ms = (rto_us + 999) / 1000;
+
+		if(target.rto_ms < RTO_MIN_MS)
+		{
+			target.rto_ms = RTO_MIN_MS;
+		}
+		else if(target.rto_ms > RTO_MAX_MS)
+		{
+			target.rto_ms = RTO_MAX_MS;
+		}
+	}
+
+	bool aem_controller_state_machine::is_seq_id_in_window(uint64_t target_guid, uint16_t seq_id)
+	{
+		uint32_t target_pos;
+		uint16_t seq_id_age;
+
+		if(!target_index.find(target_guid, target_pos))
+		{
+			return false; // No command has been sent to the target
+		}
+
+		seq_id_age = (uint16_t)(targets.at(target_pos).next_seq_id - seq_id);
+
+		return (seq_id_age != 0) && (seq_id_age <= SEQ_ID_WINDOW);
+	}
+
+	int aem_controller_state_machine::extend_inflight_cmd(uint64_t target_guid, uint16_t seq_id)
+	{
+		struct inflight_table::inflight_cmd *inflight_cmd = inflight_cmds.find(target_guid, seq_id);
+		uint32_t extend_ms;
+
+		if(!inflight_cmd)
+		{
+			return -1;
+		}
+
+		struct target_state &target = targets.at(find_or_add_target(target_guid));
+		target.in_progress_count++;
+		inflight_cmd->in_progress = true;
+
+		/**
+		 * The target keeps answering IN_PROGRESS until it is done, so wait at least AVDECC_MSG_TIMEOUT for the next one.
+		 */
+		extend_ms = (target.rto_ms > AVDECC_MSG_TIMEOUT) ? target.rto_ms : AVDECC_MSG_TIMEOUT;
+		context->timer_wheel_ref->arm(&inflight_cmd->cmd_timer, extend_ms);
+		context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG, "Command with sequence id = %d in progress", seq_id);
+
+		return 0;
+	}
+
+	void aem_controller_state_machine::get_rto_stats(uint64_t target_guid, uint32_t &srtt_us, uint32_t &rttvar_us, uint32_t &rto_ms,
+	                                                 uint32_t &timeout_count, uint32_t &in_progress_count)
+	{
+		uint32_t target_pos;
+
+		srtt_us = 0;
+		rttvar_us = 0;
+		rto_ms = AVDECC_MSG_TIMEOUT;
+		timeout_count = 0;
+		in_progress_count = 0;
+
+		if(target_index.find(target_guid, target_pos))
+		{
+			struct target_state &target = targets.at(target_pos);
+			srtt_us = target.srtt_us;
+			rttvar_us = target.rttvar_us;
+			rto_ms = target.rto_ms;
+			timeout_count = target.timeout_count;
+			in_progress_count = target.in_progress_count;
+		}
+	}
+
+	bool aem_controller_state_machine::find_inflight_cmd_by_notification_id(void *notification_id)
+	{
+		return inflight_cmds.has_notification_id(notification_id);
 	}
 
-	int aem_controller_state_machine::remove_inflight_cmd(uint32_t inflight_cmd_index)
+	int aem_controller_state_machine::remove_inflight_cmd(struct inflight_table::inflight_cmd *inflight_cmd)
 	{
-		delete controller_state_machine_vars.inflight_cmds_vector.at(inflight_cmd_index).avdecc_lib_timer_ref;
-		controller_state_machine_vars.inflight_cmds_vector.erase(controller_state_machine_vars.inflight_cmds_vector.begin() + inflight_cmd_index);
+		context->timer_wheel_ref->cancel(&inflight_cmd->cmd_timer);
+		inflight_cmds.remove(inflight_cmd);
 
 		return 0;
 	}
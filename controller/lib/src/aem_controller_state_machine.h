@@ -31,43 +31,73 @@
 #ifndef _AVDECC_CONTROLLER_LIB_AEM_CONTROLLER_STATE_MACHINE_H_
 #define _AVDECC_CONTROLLER_LIB_AEM_CONTROLLER_STATE_MACHINE_H_
 
+#include <vector>
 #include "timer.h"
+#include "guid_index.h"
+#include "inflight_table.h"
+#include "frame_view.h"
 
 namespace avdecc_lib
 {
+	class controller_context;
+
 	class aem_controller_state_machine
 	{
 	private:
-		struct aem_controller_state_machine_inflight_cmd
+		enum seq_id_sizes
+		{
+		        SEQ_ID_WINDOW = 0x7FFF // Responses are accepted for the sequence ids issued up to this many commands back
+		};
+
+		enum rto_limits
+		{
+		        RTO_MIN_MS = 25,
+		        RTO_MAX_MS = 4000 // The cap of the exponential backoff after timeouts
+		};
+
+		struct target_state
+		{
+			uint64_t target_guid;
+			uint16_t next_seq_id; // The sequence id of the next command to the target
+			uint32_t srtt_us; // The smoothed round trip time, 0 until the first sample
+			uint32_t rttvar_us; // The round trip time variation
+			uint32_t rto_ms; // The timeout of the next command to the target
+			uint64_t last_backoff_ms; // The monotonic time rto_ms was last doubled
+			uint32_t rtt_sample_count;
+			uint32_t timeout_count; // The number of times a command or its retry has timed out
+			uint32_t in_progress_count; // The number of IN_PROGRESS responses received
+		};
+
+		struct cmd_timing_stats
 		{
-	//		uint64_t timeout;
-			bool retried;
-			struct jdksavdecc_frame inflight_cmd_frame;
-			uint16_t seq_id;
-			void *notification_id;
-			uint32_t notification_flag;
-			timer *avdecc_lib_timer_ref;
-			uint64_t dest_addr;
+			uint32_t timed_cmd_count; // The number of responses with both wire timestamps known
+			uint64_t total_wire_rtt_ns;
+			uint64_t max_wire_rtt_ns;
+			uint64_t total_library_delay_ns;
 		};
 
 		struct aem_controller_state_machine_variables
 		{
 			bool rcvd_normal_resp;
 			bool rcvd_unsolicited_resp;
-			std::vector<struct aem_controller_state_machine_inflight_cmd> inflight_cmds_vector;
 			bool do_cmd;
 			bool do_terminate;
 		};
 
+		controller_context *context; // The Controller the state machine runs for
 		struct aem_controller_state_machine_variables controller_state_machine_vars;
+		inflight_table inflight_cmds; // The commands waiting for a response, by target GUID and sequence id
+		std::vector<struct target_state> targets; // The sequence ids and retransmission timeout of each target a command was sent to
+		guid_index target_index; // The position of each target in targets, by target GUID
+		timer clk; // The clock the times of the commands and responses are taken with
+		struct cmd_timing_stats timing_stats;
+		volatile uint32_t timing_seq; // Odd while timing_stats is being updated, so that readers on other threads retry
 
 	public:
-		static uint16_t aecp_seq_id; // The sequence id used for identifying the AECP command that a response is for
-
 		/**
-		 * An empty constructor for aem_controller_state_machine
+		 * Constructor for aem_controller_state_machine used for constructing the state machine of a Controller.
 		 */
-		aem_controller_state_machine();
+		aem_controller_state_machine(controller_context *context);
 
 		/**
 		 * Destructor for aem_controller_state_machine used for destroying objects
@@ -77,7 +107,7 @@ namespace avdecc_lib
 		/**
 		 * Transmit an AEM Command.
 		 */
-		void tx_cmd(void *notification_id, uint32_t notification_flag, struct jdksavdecc_frame *ether_frame);
+		void tx_cmd(void *notification_id, uint32_t notification_flag, const uint8_t *frame, uint16_t mem_buf_len);
 
 		/**
 		 * Handle the receipt and processing of a received unsolicited notifying.
@@ -87,22 +117,27 @@ namespace avdecc_lib
 		/**
 		 * Handle the receipt and processing of a received response for a command sent.
 		 */
-		int process_resp(void *&notification_id, uint32_t &notification_flag, struct jdksavdecc_frame *ether_frame);
+		int process_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame);
 
 		/**
-		 * Notify the application that a command has timed out and the retry has timed out.
+		 * Resend a command that has timed out, or notify the application that the retry has timed out.
 		 */
-		void timeout(uint32_t inflight_cmds_vector_index);
+		void timeout(struct inflight_table::inflight_cmd *inflight_cmd);
 
 		/**
-		 * Process the Waiting state of the AEM Controller State Machine.
+		 * Process the Waiting state of the AEM Controller State Machine for a command to send.
 		 */
-		void aem_controller_state_waiting(void *&notification_id, uint32_t &notification_flag, struct jdksavdecc_frame *ether_frame);
+		void aem_controller_state_waiting(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len);
+
+		/**
+		 * Process the Waiting state of the AEM Controller State Machine for a received response.
+		 */
+		void aem_controller_state_waiting(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame);
 
 		/**
 		 * Process the Send Command state of the AEM Controller State Machine.
 		 */
-		void aem_controller_state_send_cmd(void *notification_id, uint32_t notification_flag, struct jdksavdecc_frame *ether_frame);
+		void aem_controller_state_send_cmd(void *notification_id, uint32_t notification_flag, const uint8_t *frame, uint16_t mem_buf_len);
 
 		/**
 		 * Process the Received Unsolicited state of the AEM Controller State Machine.
@@ -112,12 +147,19 @@ namespace avdecc_lib
 		/**
 		 * Process the Received Response state of the AEM Controller State Machine.
 		 */
-		void aem_controller_state_rcvd_resp(void *&notification_id, uint32_t &notification_flag, struct jdksavdecc_frame *ether_frame);
+		void aem_controller_state_rcvd_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame);
+
+		/**
+		 * Record the time a command frame was sent on the wire in the corresponding inflight command.
+		 */
+		void tx_timestamp_event(const uint8_t *frame, uint16_t mem_buf_len, uint64_t tx_timestamp_ns);
 
 		/**
-		 * Check timeout for the inflight commands.
+		 * Get the timing statistics of the commands with a response, with the wire round trip time between the command
+		 * leaving and the response arriving at the network interface, and the time spent inside the library before
+		 * the command was sent and after the response was received.
 		 */
-		void aem_controller_tick();
+		void get_cmd_timing_stats(uint32_t &timed_cmd_count, uint32_t &avg_wire_rtt_us, uint32_t &max_wire_rtt_us, uint32_t &avg_library_delay_us);
 
 		/**
 		 * Get the rcvd_normal_resp field from the aem_controller_state_machine_variables structure.
@@ -186,30 +228,80 @@ namespace avdecc_lib
 		/**
 		 * Update inflight command for the response received.
 		 */
-		int update_inflight_for_rcvd_resp(void *&notification_id, uint32_t &notification_flag, uint32_t msg_type, bool u_field, struct jdksavdecc_frame *ether_frame);
+		int update_inflight_for_rcvd_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame);
 
 		/**
 		 * Call notification or logging callback function for the command sent or response received.
 		 */
-		int callback(void *notification_id, uint32_t notification_flag, uint8_t *frame);
+		int callback(void *notification_id, uint32_t notification_flag, const uint8_t *frame);
+
+		/**
+		 * Check if a response sequence id is within the window of the sequence ids recently issued to its target,
+		 * counting back from the next sequence id of the target so that the check holds across wraparound.
+		 */
+		bool is_seq_id_in_window(uint64_t target_guid, uint16_t seq_id);
+
+		/**
+		 * Restart the timer of an inflight command that the target has answered with IN_PROGRESS, instead of
+		 * resending the command once its timeout expires.
+		 *
+		 * \return 0 if the command is inflight, -1 otherwise.
+		 */
+		int extend_inflight_cmd(uint64_t target_guid, uint16_t seq_id);
 
 		/**
-		 * Check if the command with the corresponding sequence id is already in the inflight command vector.
+		 * Get the retransmission timeout statistics of a target.
 		 */
-		bool find_inflight_cmd_by_seq_id(uint16_t seq_id, int *inflight_index);
+		void get_rto_stats(uint64_t target_guid, uint32_t &srtt_us, uint32_t &rttvar_us, uint32_t &rto_ms,
+		                   uint32_t &timeout_count, uint32_t &in_progress_count);
 
 		/**
-		 * Check if the command with the corresponding notification id is already in the inflight command vector.
+		 * Check if a command with the corresponding notification id is in the inflight command table.
 		 */
 		bool find_inflight_cmd_by_notification_id(void *notification_id);
 
 		/**
-		 * Remove the command from the inflight command vector.
+		 * Remove the command from the inflight command table.
 		 */
-		int remove_inflight_cmd(uint32_t inflight_cmd_index);
-	};
+		int remove_inflight_cmd(struct inflight_table::inflight_cmd *inflight_cmd);
+
+		/**
+		 * Forget the sequence ids and retransmission timeout of a target whose End Station has been retired.
+		 */
+		void remove_target(uint64_t target_guid);
+
+	private:
+		/**
+		 * Handle the expiry of the timer of an inflight command.
+		 */
+		static void cmd_timeout(void *inflight_cmd);
+
+		/**
+		 * Get the position of a target in targets, adding the target if no command has been sent to it yet.
+		 */
+		uint32_t find_or_add_target(uint64_t target_guid);
 
-	extern aem_controller_state_machine *aem_controller_state_machine_ref;
+		/**
+		 * Get the sequence id of the next command to a target, skipping those still inflight after a wraparound.
+		 */
+		uint16_t next_seq_id(uint64_t target_guid);
+
+		/**
+		 * Update the smoothed round trip time and the retransmission timeout of a target with a round trip time sample.
+		 */
+		void update_rto(struct target_state &target, uint32_t rtt_us);
+
+		/**
+		 * Send or resend an inflight command and start its timer.
+		 */
+		void send_cmd(struct inflight_table::inflight_cmd *inflight_cmd);
+
+		/**
+		 * Update the command timing statistics with the inflight command a response has been received for, and the
+		 * time the response was received by the kernel.
+		 */
+		void update_cmd_timing(struct inflight_table::inflight_cmd &inflight_cmd, uint64_t rx_timestamp_ns);
+	};
 }
 
 #endif
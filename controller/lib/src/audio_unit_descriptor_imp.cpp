@@ -33,7 +33,7 @@
 #include "adp.h"
 #include "aecp.h"
 #include "end_station_imp.h"
-#include "system_tx_queue.h"
+#include "controller_context.h"
 #include "aem_controller_state_machine.h"
 #include "audio_unit_descriptor_imp.h"
 
@@ -41,13 +41,13 @@ namespace avdecc_lib
 {
 	audio_unit_descriptor_imp::audio_unit_descriptor_imp() {}
 
-	audio_unit_descriptor_imp::audio_unit_descriptor_imp(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len) : descriptor_base_imp(base_end_station_imp_ref)
+	audio_unit_descriptor_imp::audio_unit_descriptor_imp(end_station_imp *base_end_station_imp_ref, const uint8_t *frame, size_t pos, size_t mem_buf_len) : descriptor_base_imp(base_end_station_imp_ref)
 	{
 		desc_audio_read_returned = jdksavdecc_descriptor_audio_read(&audio_unit_desc, frame, pos, mem_buf_len);
 
 		if(desc_audio_read_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "desc_audio_read error");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "desc_audio_read error");
 			assert(desc_audio_read_returned >= 0);
 		}
 	}
@@ -290,7 +290,7 @@ namespace avdecc_lib
 				break;
 
 			default:
-				avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG, "pull_field_value is not found.");
+				context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG, "pull_field_value is not found.");
 				break;
 		}
 
@@ -310,10 +310,9 @@ namespace avdecc_lib
 
 	int STDCALL audio_unit_descriptor_imp::send_set_sampling_rate_cmd(void *notification_id, uint16_t desc_index, uint32_t new_sampling_rate)
 	{
-		struct jdksavdecc_frame *ether_frame;
+		struct system_tx_slot tx_slot;
 		struct jdksavdecc_aem_command_set_sampling_rate aem_cmd_set_sampling_rate;
 		int aem_cmd_set_sampling_rate_returned;
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
 
 		/***************************************** AECP Common Data ********************************************/
 		aem_cmd_set_sampling_rate.controller_entity_id = base_end_station_imp_ref->get_adp()->get_controller_guid();
@@ -326,65 +325,60 @@ namespace avdecc_lib
 		aem_cmd_set_sampling_rate.sampling_rate = new_sampling_rate;
 
 		/******************************** Fill frame payload with AECP data and send the frame ***************************/
-		aecp::ether_frame_init(base_end_station_imp_ref, ether_frame);
+		if(system_queue_tx_reserve(context, tx_slot) < 0)
+		{
+			return -1;
+		}
+
+		aecp::ether_frame_init(base_end_station_imp_ref, tx_slot.frame);
 		aem_cmd_set_sampling_rate_returned = jdksavdecc_aem_command_set_sampling_rate_write(&aem_cmd_set_sampling_rate,
-		                                                                                    ether_frame->payload,
+		                                                                                    tx_slot.frame,
 		                                                                                    aecp::CMD_POS,
-		                                                                                    sizeof(ether_frame->payload));
+		                                                                                    tx_slot.frame_size);
 
 		if(aem_cmd_set_sampling_rate_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_sampling_rate_write error\n");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_sampling_rate_write error\n");
 			assert(aem_cmd_set_sampling_rate_returned >= 0);
+			system_queue_tx_abort(context, tx_slot);
 			return -1;
 		}
 
-		aecp::common_hdr_init(ether_frame, base_end_station_imp_ref->get_end_station_guid());
-		system_queue_tx(notification_id, avdecc_lib::CMD_WITH_NOTIFICATION, ether_frame->payload, ether_frame->length);
+		aecp::common_hdr_init(base_end_station_imp_ref, tx_slot.frame, tx_slot.frame_size);
+		system_queue_tx_commit(context, tx_slot, notification_id, avdecc_lib::CMD_WITH_NOTIFICATION, AECP_FRAME_LEN);
 
-		free(ether_frame);
 		return 0;
 
 	}
 
-	int audio_unit_descriptor_imp::proc_set_sampling_rate_resp(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status)
+	int audio_unit_descriptor_imp::proc_set_sampling_rate_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
 	{
-		struct jdksavdecc_frame *ether_frame;
 		int aem_cmd_set_sampling_rate_resp_returned;
-		uint32_t msg_type;
-		bool u_field;
-
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
-		memcpy(ether_frame->payload, frame, mem_buf_len);
 
 		aem_cmd_set_sampling_rate_resp_returned = jdksavdecc_aem_command_set_sampling_rate_response_read(&aem_cmd_set_sampling_rate_resp,
-		                                                                                                 frame,
+		                                                                                                 rx_frame.frame(),
 		                                                                                                 aecp::CMD_POS,
-		                                                                                                 mem_buf_len);
+		                                                                                                 rx_frame.length());
 
 		if(aem_cmd_set_sampling_rate_resp_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_sampling_rate_resp_read error\n");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_sampling_rate_resp_read error\n");
 			assert(aem_cmd_set_sampling_rate_resp_returned >= 0);
 			return -1;
 		}
 
-		msg_type = aem_cmd_set_sampling_rate_resp.aem_header.aecpdu_header.header.message_type;
-		status = aem_cmd_set_sampling_rate_resp.aem_header.aecpdu_header.header.status;
-		u_field = aem_cmd_set_sampling_rate_resp.command_type >> 15 & 0x01; // u_field = the msb of the uint16_t command_type
+		status = rx_frame.status();
 
-		aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, msg_type, u_field, ether_frame);
+		context->aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, rx_frame);
 
-		free(ether_frame);
 		return 0;
 	}
 
 	int STDCALL audio_unit_descriptor_imp::send_get_sampling_rate_cmd(void *notification_id, uint16_t desc_index)
 	{
-		struct jdksavdecc_frame *ether_frame;
+		struct system_tx_slot tx_slot;
 		struct jdksavdecc_aem_command_get_sampling_rate aem_cmd_get_sampling_rate;
 		int aem_cmd_get_sampling_rate_returned;
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
 
 		/***************************************** AECP Common Data ********************************************/
 		aem_cmd_get_sampling_rate.controller_entity_id = base_end_station_imp_ref->get_adp()->get_controller_guid();
@@ -396,56 +390,52 @@ namespace avdecc_lib
 		aem_cmd_get_sampling_rate.descriptor_index = desc_index;
 
 		/******************************** Fill frame payload with AECP data and send the frame ***************************/
-		aecp::ether_frame_init(base_end_station_imp_ref, ether_frame);
+		if(system_queue_tx_reserve(context, tx_slot) < 0)
+		{
+			return -1;
+		}
+
+		aecp::ether_frame_init(base_end_station_imp_ref, tx_slot.frame);
 		aem_cmd_get_sampling_rate_returned = jdksavdecc_aem_command_get_sampling_rate_write(&aem_cmd_get_sampling_rate,
-		                                                                                    ether_frame->payload,
+		                                                                                    tx_slot.frame,
 		                                                                                    aecp::CMD_POS,
-		                                                                                    sizeof(ether_frame->payload));
+		                                                                                    tx_slot.frame_size);
 
 		if(aem_cmd_get_sampling_rate_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_sampling_rate_write error\n");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_sampling_rate_write error\n");
 			assert(aem_cmd_get_sampling_rate_returned >= 0);
+			system_queue_tx_abort(context, tx_slot);
 			return -1;
 		}
 
-		aecp::common_hdr_init(ether_frame, base_end_station_imp_ref->get_end_station_guid());
-		system_queue_tx(notification_id, avdecc_lib::CMD_WITH_NOTIFICATION, ether_frame->payload, ether_frame->length);
+		aecp::common_hdr_init(base_end_station_imp_ref, tx_slot.frame, tx_slot.frame_size);
+		system_queue_tx_commit(context, tx_slot, notification_id, avdecc_lib::CMD_WITH_NOTIFICATION, AECP_FRAME_LEN);
 
-		free(ether_frame);
 		return 0;
 	}
 
 
-	int audio_unit_descriptor_imp::proc_get_sampling_rate_resp(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status)
+	int audio_unit_descriptor_imp::proc_get_sampling_rate_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
 	{
-		struct jdksavdecc_frame *ether_frame;
 		int aem_cmd_get_sampling_rate_resp_returned;
-		uint32_t msg_type;
-		bool u_field;
-
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
-		memcpy(ether_frame->payload, frame, mem_buf_len);
 
 		aem_cmd_get_sampling_rate_resp_returned = jdksavdecc_aem_command_get_sampling_rate_response_read(&aem_cmd_get_sampling_rate_resp,
-		                                                                                                 frame,
+		                                                                                                 rx_frame.frame(),
 		                                                                                                 aecp::CMD_POS,
-		                                                                                                 mem_buf_len);
+		                                                                                                 rx_frame.length());
 
 		if(aem_cmd_get_sampling_rate_resp_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_sampling_rate_resp_read error\n");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_sampling_rate_resp_read error\n");
 			assert(aem_cmd_get_sampling_rate_resp_returned >= 0);
 			return -1;
 		}
 
-		msg_type = aem_cmd_get_sampling_rate_resp.aem_header.aecpdu_header.header.message_type;
-		status = aem_cmd_get_sampling_rate_resp.aem_header.aecpdu_header.header.status;
-		u_field = aem_cmd_get_sampling_rate_resp.command_type >> 15 & 0x01; // u_field = the msb of the uint16_t command_type
+		status = rx_frame.status();
 
-		aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, msg_type, u_field, ether_frame);
+		context->aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, rx_frame);
 
-		free(ether_frame);
 		return 0;
 	}
 }
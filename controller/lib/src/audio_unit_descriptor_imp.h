@@ -31,6 +31,7 @@
 #ifndef _AVDECC_CONTROLLER_LIB_AUDIO_UNIT_DESCRIPTOR_IMP_H_
 #define _AVDECC_CONTROLLER_LIB_AUDIO_UNIT_DESCRIPTOR_IMP_H_
 
+#include "frame_view.h"
 #include "descriptor_base_imp.h"
 #include "audio_unit_descriptor.h"
 
@@ -64,7 +65,7 @@ namespace avdecc_lib
 		 * Constructor for audio_unit_descriptor_imp used for constructing an object with a base End Station, frame, position offest,
 		 * and memory buffer length.
 		 */
-		audio_unit_descriptor_imp(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len);
+		audio_unit_descriptor_imp(end_station_imp *base_end_station_imp_ref, const uint8_t *frame, size_t pos, size_t mem_buf_len);
 
 		/**
 		 * Destructor for audio_unit_descriptor_imp used for destroying objects
@@ -296,7 +297,7 @@ namespace avdecc_lib
 		/**
 		 * Process a SET_SAMPLING_RATE response for the SET_SAMPLING_RATE command.
 		 */
-		int proc_set_sampling_rate_resp(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status);
+		int proc_set_sampling_rate_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
 
 		/**
 		 * Send a GET_SAMPLING_RATE command to get the current sampling rate of a port or unit.
@@ -306,7 +307,7 @@ namespace avdecc_lib
 		/**
 		 * Process a GET_SAMPLING_RATE response for the GET_SAMPLING_RATE command.
 		 */
-		int proc_get_sampling_rate_resp(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status);
+		int proc_get_sampling_rate_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
 	};
 }
 
@@ -52,7 +52,7 @@ namespace avdecc_lib
 		 * Constructor for avb_interface_descriptor_imp used for constructing an object with  a base End Station, frame, position offest,
 		 * and memory buffer length.
 		 */
-		avb_interface_descriptor_imp(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len);
+		avb_interface_descriptor_imp(end_station_imp *base_end_station_imp_ref, const uint8_t *frame, size_t pos, size_t mem_buf_len);
 
 		/**
 		 * Destructor for avb_interface_descriptor_imp used for destroying objects
@@ -0,0 +1,81 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * capture_filter.cpp
+ *
+ * Capture filter implementation
+ */
+
+#include "jdksavdecc_pdu.h"
+#include "capture_filter.h"
+
+namespace avdecc_lib
+{
+	capture_filter::capture_filter()
+	{
+		insn_count = 0;
+	}
+
+	capture_filter::~capture_filter() {}
+
+	void capture_filter::build(uint64_t mac, bool accept_adp, bool accept_aecp, bool accept_acmp)
+	{
+		enum filter_labels
+		{
+		        CHECK_MULTICAST = 7,
+		        CHECK_OUR_MAC = 9,
+		        ACCEPT = 13,
+		        REJECT = 14
+		};
+
+		/**
+		 * The jump offsets of an instruction at index i to an instruction at label are label - i - 1.
+		 */
+		struct bpf_insn program[] =
+		{
+			/* 0 */ BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 12), // Ethernet type
+			/* 1 */ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, JDKSAVDECC_AVTP_ETHERTYPE, 0, REJECT - 2),
+			/* 2 */ BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 14), // AVTP cd and subtype
+			/* 3 */ BPF_STMT(BPF_ALU | BPF_AND | BPF_K, 0x7F),
+			/* 4 */ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, JDKSAVDECC_SUBTYPE_ADP, (uint8_t)(accept_adp ? CHECK_MULTICAST - 5 : REJECT - 5), 0),
+			/* 5 */ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, JDKSAVDECC_SUBTYPE_AECP, (uint8_t)(accept_aecp ? CHECK_OUR_MAC - 6 : REJECT - 6), 0),
+			/* 6 */ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, JDKSAVDECC_SUBTYPE_ACMP, (uint8_t)(accept_acmp ? CHECK_MULTICAST - 7 : REJECT - 7), REJECT - 7),
+			/* 7 */ BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 0), // First byte of the destination MAC address
+			/* 8 */ BPF_JUMP(BPF_JMP | BPF_JSET | BPF_K, 0x01, ACCEPT - 9, REJECT - 9),
+			/* 9 */ BPF_STMT(BPF_LD | BPF_W | BPF_ABS, 2), // Last four bytes of the destination MAC address
+			/* 10 */ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, (uint32_t)(mac & 0xFFFFFFFF), 0, REJECT - 11),
+			/* 11 */ BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 0), // First two bytes of the destination MAC address
+			/* 12 */ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, (uint32_t)((mac >> 32) & 0xFFFF), ACCEPT - 13, REJECT - 13),
+			/* 13 */ BPF_STMT(BPF_RET | BPF_K, CAPTURE_FILTER_SNAP_LEN),
+			/* 14 */ BPF_STMT(BPF_RET | BPF_K, 0)
+		};
+
+		insn_count = sizeof(program) / sizeof(program[0]);
+
+		for(uint32_t index_i = 0; index_i < insn_count; index_i++)
+		{
+			insns[index_i] = program[index_i];
+		}
+	}
+}
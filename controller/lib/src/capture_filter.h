@@ -0,0 +1,86 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * capture_filter.h
+ *
+ * Capture filter class, which generates the BPF program used by the network interface to only capture the
+ * AVDECC frames the Controller processes.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_CAPTURE_FILTER_H_
+#define _AVDECC_CONTROLLER_LIB_CAPTURE_FILTER_H_
+
+#include <stdint.h>
+#include <pcap.h>
+
+namespace avdecc_lib
+{
+	class capture_filter
+	{
+	public:
+		enum capture_filter_sizes
+		{
+		        CAPTURE_FILTER_MAX_INSN_COUNT = 16,
+		        CAPTURE_FILTER_SNAP_LEN = 0xFFFF // The number of bytes of an accepted frame that are captured
+		};
+
+	private:
+		struct bpf_insn insns[CAPTURE_FILTER_MAX_INSN_COUNT];
+		uint32_t insn_count;
+
+	public:
+		/**
+		 * An empty constructor for capture_filter
+		 */
+		capture_filter();
+
+		/**
+		 * Destructor for capture_filter used for destroying objects
+		 */
+		~capture_filter();
+
+		/**
+		 * Generate a program that accepts ADP frames sent to a multicast address if accept_adp is set, AECP frames sent
+		 * to the MAC address of the Controller if accept_aecp is set, and ACMP frames sent to a multicast address if
+		 * accept_acmp is set.
+		 */
+		void build(uint64_t mac, bool accept_adp, bool accept_aecp, bool accept_acmp);
+
+		/**
+		 * Get the program in the layout shared by libpcap and the kernel.
+		 */
+		inline struct bpf_program get_program()
+		{
+			struct bpf_program program;
+
+			program.bf_len = insn_count;
+			program.bf_insns = insns;
+
+			return program;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,241 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * capture_replay.cpp
+ *
+ * Capture replay implementation
+ */
+
+#include "enumeration.h"
+#include "log.h"
+#include "timer.h"
+#include "capture_filter.h"
+#include "capture_replay.h"
+
+namespace avdecc_lib
+{
+	capture_replay::capture_replay(log *log_ref, const char *capture_file_path, bool is_recorded_pace, const char *tx_file_path)
+	{
+		this->log_ref = log_ref;
+		this->capture_file_path = capture_file_path;
+		this->tx_file_path = tx_file_path ? tx_file_path : "";
+		this->is_recorded_pace = is_recorded_pace;
+		first_frame_time_us = 0;
+		start_time_us = 0;
+		tx_dead_file = NULL;
+		tx_dumper = NULL;
+	}
+
+	capture_replay::~capture_replay()
+	{
+		for(uint32_t index_i = 0; index_i < channels.size(); index_i++)
+		{
+			if(channels.at(index_i).capture_file)
+			{
+				pcap_close(channels.at(index_i).capture_file);
+			}
+		}
+
+		if(tx_dumper)
+		{
+			pcap_dump_close(tx_dumper);
+		}
+
+		if(tx_dead_file)
+		{
+			pcap_close(tx_dead_file);
+		}
+	}
+
+	void capture_replay::set_log(log *new_log_ref)
+	{
+		log_ref = new_log_ref;
+	}
+
+	int capture_replay::open(uint32_t channel_count)
+	{
+		pcap_t *first_frame_file;
+		struct pcap_pkthdr *header;
+		const uint8_t *frame;
+
+		/******************************* Read the capture time of the first frame, which the replay pace is relative to ******************************/
+		first_frame_file = pcap_open_offline(capture_file_path.c_str(), err_buf);
+
+		if(first_frame_file == NULL)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Unable to open the capture file %s. %s", capture_file_path.c_str(), err_buf);
+			return -1;
+		}
+
+		if(pcap_next_ex(first_frame_file, &header, &frame) > 0)
+		{
+			first_frame_time_us = (int64_t)header->ts.tv_sec * 1000000 + header->ts.tv_usec;
+		}
+
+		pcap_close(first_frame_file);
+
+		/**************************************** Open the capture file once for each channel ***************************************/
+		channels.resize(channel_count);
+
+		for(uint32_t index_i = 0; index_i < channel_count; index_i++)
+		{
+			struct replay_channel &channel = channels.at(index_i);
+
+			channel.header = NULL;
+			channel.frame = NULL;
+			channel.is_done = false;
+			channel.capture_file = pcap_open_offline(capture_file_path.c_str(), err_buf);
+
+			if(channel.capture_file == NULL)
+			{
+				log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Unable to open the capture file %s. %s", capture_file_path.c_str(), err_buf);
+				return -1;
+			}
+		}
+
+		/************************************************ Open the file the frames sent are recorded to ***********************************************/
+		if(!tx_file_path.empty())
+		{
+			tx_dead_file = pcap_open_dead(DLT_EN10MB, capture_filter::CAPTURE_FILTER_SNAP_LEN);
+			tx_dumper = pcap_dump_open(tx_dead_file, tx_file_path.c_str());
+
+			if(tx_dumper == NULL)
+			{
+				log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Unable to open the transmit capture file %s. %s", tx_file_path.c_str(), pcap_geterr(tx_dead_file));
+				return -1;
+			}
+		}
+
+		return 0;
+	}
+
+	int capture_replay::set_channel_filter(uint32_t channel_index, struct bpf_program *program)
+	{
+		pcap_t *capture_file = channels.at(channel_index).capture_file;
+
+		if(pcap_setfilter(capture_file, program) < 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Error setting the filter. %s", pcap_geterr(capture_file));
+			return -1;
+		}
+
+		return 0;
+	}
+
+	int capture_replay::next_frame(uint32_t channel_index, const uint8_t **frame, uint16_t *mem_buf_len, uint32_t *delay_us)
+	{
+		struct replay_channel &channel = channels.at(channel_index);
+		int64_t current_time_us;
+		int64_t due_time_us;
+		int status;
+
+		*delay_us = 0;
+
+		if(channel.is_done)
+		{
+			return -1;
+		}
+
+		if(channel.header == NULL)
+		{
+			status = pcap_next_ex(channel.capture_file, &channel.header, &channel.frame);
+
+			if(status <= 0)
+			{
+				if(status == -1)
+				{
+					log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Error reading the capture file. %s", pcap_geterr(channel.capture_file));
+				}
+
+				channel.header = NULL;
+				channel.is_done = true;
+				return -1;
+			}
+		}
+
+		current_time_us = clk_monotonic_us();
+
+		if(start_time_us == 0)
+		{
+			start_time_us = current_time_us;
+		}
+
+		/**
+		 * At the recorded pace a frame is due once as much time has passed since the replay started as had passed
+		 * between the first frame of the capture file and the frame when it was captured.
+		 */
+		if(is_recorded_pace)
+		{
+			due_time_us = start_time_us + ((int64_t)channel.header->ts.tv_sec * 1000000 + channel.header->ts.tv_usec - first_frame_time_us);
+
+			if(due_time_us > current_time_us)
+			{
+				*delay_us = (due_time_us - current_time_us > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32_t)(due_time_us - current_time_us);
+				return 0;
+			}
+		}
+
+		*frame = channel.frame;
+		*mem_buf_len = (uint16_t)channel.header->caplen;
+		channel.header = NULL; // The frame stays valid until the next frame of the channel is read
+
+		return 1;
+	}
+
+	void capture_replay::record_tx_frame(const uint8_t *frame, uint16_t mem_buf_len)
+	{
+		struct pcap_pkthdr header;
+		int64_t frame_time_us;
+
+		if(tx_dumper == NULL)
+		{
+			return;
+		}
+
+		/**
+		 * Frames sent are stamped on the timeline of the capture file, so they line up with the frames replayed.
+		 */
+		frame_time_us = first_frame_time_us + ((start_time_us == 0) ? 0 : clk_monotonic_us() - start_time_us);
+		header.ts.tv_sec = (long)(frame_time_us / 1000000);
+		header.ts.tv_usec = (long)(frame_time_us % 1000000);
+		header.caplen = mem_buf_len;
+		header.len = mem_buf_len;
+		pcap_dump((u_char *)tx_dumper, &header, frame);
+	}
+
+	int64_t capture_replay::clk_monotonic_us()
+	{
+		timer clk;
+		int64_t count = (int64_t)clk.clk_monotonic();
+
+#ifdef WIN32
+		LARGE_INTEGER freq;
+		QueryPerformanceFrequency(&freq);
+
+		return (count / freq.QuadPart) * 1000000 + (count % freq.QuadPart) * 1000000 / freq.QuadPart;
+#elif defined __linux__
+		return count / 1000;
+#endif
+	}
+}
@@ -0,0 +1,124 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * capture_replay.h
+ *
+ * Capture replay class, which reads the frames of a pcap or pcapng capture file for a network interface
+ * in place of a live adapter, and optionally records the frames sent to a pcap file.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_CAPTURE_REPLAY_H_
+#define _AVDECC_CONTROLLER_LIB_CAPTURE_REPLAY_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <pcap.h>
+
+namespace avdecc_lib
+{
+	class log;
+
+	class capture_replay
+	{
+	private:
+		struct replay_channel
+		{
+			pcap_t *capture_file; // The capture file opened for the channel, which only admits the frames of the channel
+			struct pcap_pkthdr *header; // The header of the next frame of the channel, NULL if it has not been read yet
+			const uint8_t *frame; // The next frame of the channel, valid until the next frame is read
+			bool is_done; // Set once all the frames of the channel have been replayed
+		};
+
+		std::string capture_file_path;
+		std::string tx_file_path; // Empty if the frames sent are discarded
+		bool is_recorded_pace; // Set if frames are replayed at the pace they were captured, otherwise as fast as possible
+		std::vector<struct replay_channel> channels;
+		int64_t first_frame_time_us; // The capture time of the first frame in the capture file
+		int64_t start_time_us; // The time the first frame was replayed, 0 before the replay starts
+		pcap_t *tx_dead_file; // Handle describing the link layer of the file the frames sent are recorded to
+		pcap_dumper_t *tx_dumper;
+		char err_buf[PCAP_ERRBUF_SIZE];
+		log *log_ref; // The log of the network interface replaying the capture file
+
+	public:
+		/**
+		 * Constructor for capture_replay used for constructing an object with the log to log to, the capture file to
+		 * replay, the replay pace, and the file the frames sent are recorded to, or NULL to discard them.
+		 */
+		capture_replay(log *log_ref, const char *capture_file_path, bool is_recorded_pace, const char *tx_file_path);
+
+		/**
+		 * Destructor for capture_replay used for destroying objects
+		 */
+		~capture_replay();
+
+		/**
+		 * Set the log to log to.
+		 */
+		void set_log(log *new_log_ref);
+
+		/**
+		 * Open the capture file once for each channel, and the file the frames sent are recorded to.
+		 */
+		int open(uint32_t channel_count);
+
+		/**
+		 * Set the filter of a channel, so that only the frames it admits are replayed on the channel.
+		 */
+		int set_channel_filter(uint32_t channel_index, struct bpf_program *program);
+
+		/**
+		 * Get the next frame of a channel if it is due. The frame stays valid until the next call for the same channel.
+		 *
+		 * \param delay_us Set to the time until the next frame is due when no frame is returned.
+		 *
+		 * \return 1 if a frame is returned, 0 if the next frame is not due yet, or -1 if all the frames of the channel
+		 *	   have been replayed.
+		 */
+		int next_frame(uint32_t channel_index, const uint8_t **frame, uint16_t *mem_buf_len, uint32_t *delay_us);
+
+		/**
+		 * Record a frame sent to the file the frames sent are recorded to, if any.
+		 */
+		void record_tx_frame(const uint8_t *frame, uint16_t mem_buf_len);
+
+		/**
+		 * Get the path of the capture file replayed.
+		 */
+		inline const char * get_capture_file_path()
+		{
+			return capture_file_path.c_str();
+		}
+
+	private:
+		/**
+		 * Get the time of a monotonic clock in microseconds.
+		 */
+		int64_t clk_monotonic_us();
+	};
+}
+
+#endif
@@ -33,7 +33,7 @@
 #include "adp.h"
 #include "aecp.h"
 #include "end_station_imp.h"
-#include "system_tx_queue.h"
+#include "controller_context.h"
 #include "aem_controller_state_machine.h"
 #include "clock_domain_descriptor_imp.h"
 
@@ -41,13 +41,13 @@ namespace avdecc_lib
 {
 	clock_domain_descriptor_imp::clock_domain_descriptor_imp() {}
 
-	clock_domain_descriptor_imp::clock_domain_descriptor_imp(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len) : descriptor_base_imp(base_end_station_imp_ref)
+	clock_domain_descriptor_imp::clock_domain_descriptor_imp(end_station_imp *base_end_station_imp_ref, const uint8_t *frame, size_t pos, size_t mem_buf_len) : descriptor_base_imp(base_end_station_imp_ref)
 	{
 		desc_clock_domain_read_returned = jdksavdecc_descriptor_clock_domain_read(&clock_domain_desc, frame, pos, mem_buf_len);
 
 		if(desc_clock_domain_read_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "desc_clock_domain_read error");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "desc_clock_domain_read error");
 			assert(desc_clock_domain_read_returned >= 0);
 		}
 
@@ -94,7 +94,7 @@ namespace avdecc_lib
 		return clock_domain_desc.clock_sources_count;
 	}
 
-	void clock_domain_descriptor_imp::store_clock_sources(uint8_t *frame, size_t pos)
+	void clock_domain_descriptor_imp::store_clock_sources(const uint8_t *frame, size_t pos)
 	{
 		uint16_t offset = 0x0;
 
@@ -122,10 +122,9 @@ namespace avdecc_lib
 
 	int STDCALL clock_domain_descriptor_imp::send_set_clock_source_cmd(void *notification_id, uint16_t desc_index, uint16_t new_clk_src_index)
 	{
-		struct jdksavdecc_frame *ether_frame;
+		struct system_tx_slot tx_slot;
 		struct jdksavdecc_aem_command_set_clock_source aem_cmd_set_clk_src;
 		int aem_cmd_set_clk_src_returned;
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
 
 		/***************************************** AECP Common Data ********************************************/
 		aem_cmd_set_clk_src.controller_entity_id = base_end_station_imp_ref->get_adp()->get_controller_guid();
@@ -138,65 +137,60 @@ namespace avdecc_lib
 		aem_cmd_set_clk_src.clock_source_index = new_clk_src_index;
 
 		/******************************** Fill frame payload with AECP data and send the frame ***************************/
-		aecp::ether_frame_init(base_end_station_imp_ref, ether_frame);
+		if(system_queue_tx_reserve(context, tx_slot) < 0)
+		{
+			return -1;
+		}
+
+		aecp::ether_frame_init(base_end_station_imp_ref, tx_slot.frame);
 		aem_cmd_set_clk_src_returned = jdksavdecc_aem_command_set_clock_source_write(&aem_cmd_set_clk_src,
-		                                                                             ether_frame->payload,
+		                                                                             tx_slot.frame,
 		                                                                             aecp::CMD_POS,
-		                                                                             sizeof(ether_frame->payload));
+		                                                                             tx_slot.frame_size);
 
 		if(aem_cmd_set_clk_src_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_clk_src_write error\n");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_clk_src_write error\n");
 			assert(aem_cmd_set_clk_src_returned >= 0);
+			system_queue_tx_abort(context, tx_slot);
 			return -1;
 		}
 
-		aecp::common_hdr_init(ether_frame, base_end_station_imp_ref->get_end_station_guid());
-		system_queue_tx(notification_id, avdecc_lib::CMD_WITH_NOTIFICATION, ether_frame->payload, ether_frame->length);
+		aecp::common_hdr_init(base_end_station_imp_ref, tx_slot.frame, tx_slot.frame_size);
+		system_queue_tx_commit(context, tx_slot, notification_id, avdecc_lib::CMD_WITH_NOTIFICATION, AECP_FRAME_LEN);
 
-		free(ether_frame);
 		return 0;
 
 	}
 
-	int clock_domain_descriptor_imp::proc_set_clock_source_resp(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status)
+	int clock_domain_descriptor_imp::proc_set_clock_source_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
 	{
-		struct jdksavdecc_frame *ether_frame;
 		int aem_cmd_set_clk_src_resp_returned;
-		uint32_t msg_type;
-		bool u_field;
-
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
-		memcpy(ether_frame->payload, frame, mem_buf_len);
 
 		aem_cmd_set_clk_src_resp_returned = jdksavdecc_aem_command_get_clock_source_response_read(&aem_cmd_set_clk_src_resp,
-		                                                                                          frame,
+		                                                                                          rx_frame.frame(),
 		                                                                                          aecp::CMD_POS,
-		                                                                                          mem_buf_len);
+		                                                                                          rx_frame.length());
 
 		if(aem_cmd_set_clk_src_resp_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_clk_src_resp_read error\n");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_clk_src_resp_read error\n");
 			assert(aem_cmd_set_clk_src_resp_returned >= 0);
 			return -1;
 		}
 
-		msg_type = aem_cmd_set_clk_src_resp.aem_header.aecpdu_header.header.message_type;
-		status = aem_cmd_set_clk_src_resp.aem_header.aecpdu_header.header.status;
-		u_field = aem_cmd_set_clk_src_resp.command_type >> 15 & 0x01; // u_field = the msb of the uint16_t command_type
+		status = rx_frame.status();
 
-		aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, msg_type, u_field, ether_frame);
+		context->aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, rx_frame);
 
-		free(ether_frame);
 		return 0;
 	}
 
 	int STDCALL clock_domain_descriptor_imp::send_get_clock_source_cmd(void *notification_id, uint16_t desc_index)
 	{
-		struct jdksavdecc_frame *ether_frame;
+		struct system_tx_slot tx_slot;
 		struct jdksavdecc_aem_command_get_clock_source aem_cmd_get_clk_src;
 		int aem_cmd_get_clk_src_returned;
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
 
 		/***************************************** AECP Common Data ********************************************/
 		aem_cmd_get_clk_src.controller_entity_id = base_end_station_imp_ref->get_adp()->get_controller_guid();
@@ -208,55 +202,51 @@ namespace avdecc_lib
 		aem_cmd_get_clk_src.descriptor_index = desc_index;
 
 		/******************************** Fill frame payload with AECP data and send the frame ***************************/
-		aecp::ether_frame_init(base_end_station_imp_ref, ether_frame);
+		if(system_queue_tx_reserve(context, tx_slot) < 0)
+		{
+			return -1;
+		}
+
+		aecp::ether_frame_init(base_end_station_imp_ref, tx_slot.frame);
 		aem_cmd_get_clk_src_returned = jdksavdecc_aem_command_get_clock_source_write(&aem_cmd_get_clk_src,
-		                                                                             ether_frame->payload,
+		                                                                             tx_slot.frame,
 		                                                                             aecp::CMD_POS,
-		                                                                             sizeof(ether_frame->payload));
+		                                                                             tx_slot.frame_size);
 
 		if(aem_cmd_get_clk_src_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_clk_src_write error\n");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_clk_src_write error\n");
 			assert(aem_cmd_get_clk_src_returned >= 0);
+			system_queue_tx_abort(context, tx_slot);
 			return -1;
 		}
 
-		aecp::common_hdr_init(ether_frame, base_end_station_imp_ref->get_end_station_guid());
-		system_queue_tx(notification_id, avdecc_lib::CMD_WITH_NOTIFICATION, ether_frame->payload, ether_frame->length);
+		aecp::common_hdr_init(base_end_station_imp_ref, tx_slot.frame, tx_slot.frame_size);
+		system_queue_tx_commit(context, tx_slot, notification_id, avdecc_lib::CMD_WITH_NOTIFICATION, AECP_FRAME_LEN);
 
-		free(ether_frame);
 		return 0;
 	}
 
-	int clock_domain_descriptor_imp::proc_get_clock_source_resp(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status)
+	int clock_domain_descriptor_imp::proc_get_clock_source_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
 	{
-		struct jdksavdecc_frame *ether_frame;
 		int aem_cmd_get_clk_src_resp_returned;
-		uint32_t msg_type;
-		bool u_field;
-
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
-		memcpy(ether_frame->payload, frame, mem_buf_len);
 
 		aem_cmd_get_clk_src_resp_returned = jdksavdecc_aem_command_get_clock_source_response_read(&aem_cmd_get_clk_src_resp,
-		                                                                                          frame,
+		                                                                                          rx_frame.frame(),
 		                                                                                          aecp::CMD_POS,
-		                                                                                          mem_buf_len);
+		                                                                                          rx_frame.length());
 
 		if(aem_cmd_get_clk_src_resp_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_clk_src_resp_read error\n");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_clk_src_resp_read error\n");
 			assert(aem_cmd_get_clk_src_resp_returned >= 0);
 			return -1;
 		}
 
-		msg_type = aem_cmd_get_clk_src_resp.aem_header.aecpdu_header.header.message_type;
-		status = aem_cmd_get_clk_src_resp.aem_header.aecpdu_header.header.status;
-		u_field = aem_cmd_get_clk_src_resp.command_type >> 15 & 0x01; // u_field = the msb of the uint16_t command_type
+		status = rx_frame.status();
 
-		aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, msg_type, u_field, ether_frame);
+		context->aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, rx_frame);
 
-		free(ether_frame);
 		return 0;
 	}
 }
@@ -31,6 +31,7 @@
 #ifndef _AVDECC_CONTROLLER_LIB_CLOCK_DOMAIN_DESCRIPTOR_IMP_H_
 #define _AVDECC_CONTROLLER_LIB_CLOCK_DOMAIN_DESCRIPTOR_IMP_H_
 
+#include "frame_view.h"
 #include "descriptor_base_imp.h"
 #include "clock_domain_descriptor.h"
 
@@ -56,7 +57,7 @@ namespace avdecc_lib
 		 * Constructor for clock_domain_descriptor_imp used for constructing an object with a base End Station, frame, position offest,
 		 * and memory buffer length.
 		 */
-		clock_domain_descriptor_imp(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len);
+		clock_domain_descriptor_imp(end_station_imp *base_end_station_imp_ref, const uint8_t *frame, size_t pos, size_t mem_buf_len);
 
 		/**
 		 * Destructor for clock_domain_descriptor_imp used for destroying objects
@@ -106,7 +107,7 @@ namespace avdecc_lib
 		/**
 		* Store the Clock Sources of the Clock Domain descriptor object.
 		*/
-		void store_clock_sources(uint8_t *frame, size_t pos);
+		void store_clock_sources(const uint8_t *frame, size_t pos);
 
 		/**
 		 * Get the clock source index of the requested Clock Domain descriptor after sending a
@@ -128,7 +129,7 @@ namespace avdecc_lib
 		/**
 		 * Process a SET_CLOCK_SOURCE response for the SET_CLOCK_SOURCE command.
 		 */
-		int proc_set_clock_source_resp(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status);
+		int proc_set_clock_source_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
 
 		/**
 		 * Send a GET_CLOCK_SOURCE command to get the current clock source of a clock domain.
@@ -138,7 +139,7 @@ namespace avdecc_lib
 		/**
 		 * Process a GET_CLOCK_SOURCE response for the GET_CLOCK_SOURCE command.
 		 */
-		int proc_get_clock_source_resp(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status);
+		int proc_get_clock_source_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
 	};
 }
 
@@ -31,19 +31,20 @@
 #include "enumeration.h"
 #include "log.h"
 #include "end_station_imp.h"
+#include "controller_context.h"
 #include "configuration_descriptor_imp.h"
 
 namespace avdecc_lib
 {
 	configuration_descriptor_imp::configuration_descriptor_imp() {}
 
-	configuration_descriptor_imp::configuration_descriptor_imp(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len) : descriptor_base_imp(base_end_station_imp_ref)
+	configuration_descriptor_imp::configuration_descriptor_imp(end_station_imp *base_end_station_imp_ref, const uint8_t *frame, size_t pos, size_t mem_buf_len) : descriptor_base_imp(base_end_station_imp_ref)
 	{
 		desc_config_read_returned = jdksavdecc_descriptor_configuration_read(&config_desc, frame, pos, mem_buf_len);
 
 		if(desc_config_read_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "desc_config_read error");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "desc_config_read error");
 			assert(desc_config_read_returned >= 0);
 		}
 
@@ -138,7 +139,7 @@ namespace avdecc_lib
 		return config_desc.descriptor_counts_offset;
 	}
 
-	void configuration_descriptor_imp::desc_type_vector_init(uint8_t *frame, size_t pos)
+	void configuration_descriptor_imp::desc_type_vector_init(const uint8_t *frame, size_t pos)
 	{
 		uint16_t offset = 0x0;
 
@@ -149,7 +150,7 @@ namespace avdecc_lib
 		}
 	}
 
-	void configuration_descriptor_imp::desc_count_vector_init(uint8_t *frame, size_t pos)
+	void configuration_descriptor_imp::desc_count_vector_init(const uint8_t *frame, size_t pos)
 	{
 		uint16_t offset = 0x2;
 
@@ -190,54 +191,84 @@ namespace avdecc_lib
 		return desc_count_vector.at(desc_index);
 	}
 
-	void configuration_descriptor_imp::store_audio_unit_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len)
+	void configuration_descriptor_imp::add_desc_imp(uint16_t desc_type, descriptor_base_imp *desc_imp)
 	{
-		audio_unit_desc_vec.push_back(new audio_unit_descriptor_imp(base_end_station_imp_ref, frame, pos, mem_buf_len));
+		if(desc_imp_by_type.size() <= desc_type)
+		{
+			desc_imp_by_type.resize(desc_type + 1);
+		}
+
+		desc_imp_by_type[desc_type].push_back(desc_imp);
+	}
+
+	descriptor_base_imp * configuration_descriptor_imp::get_desc_imp(uint16_t desc_type, uint16_t desc_index)
+	{
+		if((desc_type < desc_imp_by_type.size()) && (desc_index < desc_imp_by_type[desc_type].size()))
+		{
+			return desc_imp_by_type[desc_type][desc_index];
+		}
+
+		return NULL;
+	}
+
+	void configuration_descriptor_imp::store_audio_unit_desc(descriptor_base_imp *desc)
+	{
+		audio_unit_desc_vec.push_back(dynamic_cast<audio_unit_descriptor_imp *>(desc));
+		add_desc_imp(JDKSAVDECC_DESCRIPTOR_AUDIO_UNIT, audio_unit_desc_vec.back());
 	}
 
-	void configuration_descriptor_imp::store_stream_input_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len)
+	void configuration_descriptor_imp::store_stream_input_desc(descriptor_base_imp *desc)
 	{
-		stream_input_desc_vec.push_back(new stream_input_descriptor_imp(base_end_station_imp_ref, frame, pos, mem_buf_len));
+		stream_input_desc_vec.push_back(dynamic_cast<stream_input_descriptor_imp *>(desc));
+		add_desc_imp(JDKSAVDECC_DESCRIPTOR_STREAM_INPUT, stream_input_desc_vec.back());
 	}
 
-	void configuration_descriptor_imp::store_stream_output_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len)
+	void configuration_descriptor_imp::store_stream_output_desc(descriptor_base_imp *desc)
 	{
-		stream_output_desc_vec.push_back(new stream_output_descriptor_imp(base_end_station_imp_ref, frame, pos, mem_buf_len));
+		stream_output_desc_vec.push_back(dynamic_cast<stream_output_descriptor_imp *>(desc));
+		add_desc_imp(JDKSAVDECC_DESCRIPTOR_STREAM_OUTPUT, stream_output_desc_vec.back());
 	}
 
-	void configuration_descriptor_imp::store_jack_input_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len)
+	void configuration_descriptor_imp::store_jack_input_desc(descriptor_base_imp *desc)
 	{
-		jack_input_desc_vec.push_back(new jack_input_descriptor_imp(base_end_station_imp_ref, frame, pos, mem_buf_len));
+		jack_input_desc_vec.push_back(dynamic_cast<jack_input_descriptor_imp *>(desc));
+		add_desc_imp(JDKSAVDECC_DESCRIPTOR_JACK_INPUT, jack_input_desc_vec.back());
 	}
 
-	void configuration_descriptor_imp::store_jack_output_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len)
+	void configuration_descriptor_imp::store_jack_output_desc(descriptor_base_imp *desc)
 	{
-		jack_output_desc_vec.push_back(new jack_output_descriptor_imp(base_end_station_imp_ref, frame, pos, mem_buf_len));
+		jack_output_desc_vec.push_back(dynamic_cast<jack_output_descriptor_imp *>(desc));
+		add_desc_imp(JDKSAVDECC_DESCRIPTOR_JACK_OUTPUT, jack_output_desc_vec.back());
 	}
 
-	void configuration_descriptor_imp::store_avb_interface_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len)
+	void configuration_descriptor_imp::store_avb_interface_desc(descriptor_base_imp *desc)
 	{
-		avb_interface_desc_vec.push_back(new avb_interface_descriptor_imp(base_end_station_imp_ref, frame, pos, mem_buf_len));
+		avb_interface_desc_vec.push_back(dynamic_cast<avb_interface_descriptor_imp *>(desc));
+		add_desc_imp(JDKSAVDECC_DESCRIPTOR_AVB_INTERFACE, avb_interface_desc_vec.back());
 	}
 
-	void configuration_descriptor_imp::store_clock_source_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len)
+	void configuration_descriptor_imp::store_clock_source_desc(descriptor_base_imp *desc)
 	{
-		clock_source_desc_vec.push_back(new clock_source_descriptor_imp(base_end_station_imp_ref, frame, pos, mem_buf_len));
+		clock_source_desc_vec.push_back(dynamic_cast<clock_source_descriptor_imp *>(desc));
+		add_desc_imp(JDKSAVDECC_DESCRIPTOR_CLOCK_SOURCE, clock_source_desc_vec.back());
 	}
 
-	void configuration_descriptor_imp::store_locale_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len)
+	void configuration_descriptor_imp::store_locale_desc(descriptor_base_imp *desc)
 	{
-		locale_desc_vec.push_back(new locale_descriptor_imp(base_end_station_imp_ref, frame, pos, mem_buf_len));
+		locale_desc_vec.push_back(dynamic_cast<locale_descriptor_imp *>(desc));
+		add_desc_imp(JDKSAVDECC_DESCRIPTOR_LOCALE, locale_desc_vec.back());
 	}
 
-	void configuration_descriptor_imp::store_strings_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len)
+	void configuration_descriptor_imp::store_strings_desc(descriptor_base_imp *desc)
 	{
-		strings_desc_vec.push_back(new strings_descriptor_imp(base_end_station_imp_ref, frame, pos, mem_buf_len));
+		strings_desc_vec.push_back(dynamic_cast<strings_descriptor_imp *>(desc));
+		add_desc_imp(JDKSAVDECC_DESCRIPTOR_STRINGS, strings_desc_vec.back());
 	}
 
-	void configuration_descriptor_imp::store_clock_domain_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len)
+	void configuration_descriptor_imp::store_clock_domain_desc(descriptor_base_imp *desc)
 	{
-		clock_domain_desc_vec.push_back(new clock_domain_descriptor_imp(base_end_station_imp_ref, frame, pos, mem_buf_len));
+		clock_domain_desc_vec.push_back(dynamic_cast<clock_domain_descriptor_imp *>(desc));
+		add_desc_imp(JDKSAVDECC_DESCRIPTOR_CLOCK_DOMAIN, clock_domain_desc_vec.back());
 	}
 
 	uint32_t STDCALL configuration_descriptor_imp::get_audio_unit_desc_count()
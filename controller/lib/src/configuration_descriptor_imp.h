@@ -65,6 +65,7 @@ namespace avdecc_lib
 		std::vector<locale_descriptor_imp *> locale_desc_vec; // Store a list of Locale descriptor class objects
 		std::vector<strings_descriptor_imp *> strings_desc_vec; // Store a list of Strings descriptor class objects
 		std::vector<clock_domain_descriptor_imp *> clock_domain_desc_vec; // Store a list of Clock Domain descriptor class objects
+		std::vector<std::vector<descriptor_base_imp *> > desc_imp_by_type; // The descriptor objects above, by descriptor type and index
 
 	public:
 		/**
@@ -76,7 +77,7 @@ namespace avdecc_lib
 		 * Constructor for configuration_descriptor_imp used for constructing an object with a base End Station, frame, position offest,
 		 * and memory buffer length.
 		 */
-		configuration_descriptor_imp(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len);
+		configuration_descriptor_imp(end_station_imp *base_end_station_imp_ref, const uint8_t *frame, size_t pos, size_t mem_buf_len);
 
 		/**
 		 * Destructor for configuration_descriptor_imp used for destroying objects
@@ -116,62 +117,69 @@ namespace avdecc_lib
 		/**
 		 * Initialize the descriptor type vector with descriptor types present in the current Configuration.
 		 */
-		void desc_type_vector_init(uint8_t *frame, size_t pos);
+		void desc_type_vector_init(const uint8_t *frame, size_t pos);
 
 		/**
 		 * Initialize the descriptor count vector with descriptor counts present in the current Configuration.
 		 */
-		void desc_count_vector_init(uint8_t *frame, size_t pos);
+		void desc_count_vector_init(const uint8_t *frame, size_t pos);
+
+		/**
+		 * Get the descriptor object of a type at an index.
+		 *
+		 * \return The descriptor object, or NULL if the Configuration has no such descriptor.
+		 */
+		descriptor_base_imp * get_desc_imp(uint16_t desc_type, uint16_t desc_index);
 
 		/**
 		 * Store Audio Unit descriptor object.
 		 */
-		void store_audio_unit_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len);
+		void store_audio_unit_desc(descriptor_base_imp *desc);
 
 		/**
 		 * Store Stream Input descriptor object.
 		 */
-		void store_stream_input_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len);
+		void store_stream_input_desc(descriptor_base_imp *desc);
 
 		/**
 		 * Store Stream Output descriptor object.
 		 */
-		void store_stream_output_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len);
+		void store_stream_output_desc(descriptor_base_imp *desc);
 
 		/**
 		 * Store Jack Input descriptor object.
 		 */
-		void store_jack_input_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len);
+		void store_jack_input_desc(descriptor_base_imp *desc);
 
 		/**
 		 * Store Jack Output descriptor object.
 		 */
-		void store_jack_output_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len);
+		void store_jack_output_desc(descriptor_base_imp *desc);
 
 		/**
 		 * Store AVB Interface descriptor object.
 		 */
-		void store_avb_interface_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len);
+		void store_avb_interface_desc(descriptor_base_imp *desc);
 
 		/**
 		 * Store Clock Source descriptor object.
 		 */
-		void store_clock_source_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len);
+		void store_clock_source_desc(descriptor_base_imp *desc);
 
 		/**
 		 * Store Locale descriptor object.
 		 */
-		void store_locale_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len);
+		void store_locale_desc(descriptor_base_imp *desc);
 
 		/**
 		 * Store Strings descriptor object.
 		 */
-		void store_strings_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len);
+		void store_strings_desc(descriptor_base_imp *desc);
 
 		/**
 		 * Store Clock Domain descriptor object.
 		 */
-		void store_clock_domain_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len);
+		void store_clock_domain_desc(descriptor_base_imp *desc);
 
 		/**
 		 * Get the number of Audio Unit descriptors present in the current Configuration.
@@ -287,6 +295,12 @@ namespace avdecc_lib
 		 * Get the corresponding CLOCK DOMAIN descriptor object by index.
 		 */
 		clock_domain_descriptor * STDCALL get_clock_domain_desc_by_index(uint32_t clock_domain_desc_index);
+
+	private:
+		/**
+		 * Add a descriptor object to the descriptor objects by type.
+		 */
+		void add_desc_imp(uint16_t desc_type, descriptor_base_imp *desc_imp);
 	};
 }
 
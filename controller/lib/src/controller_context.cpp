@@ -0,0 +1,137 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * controller_context.cpp
+ *
+ * Controller context implementation
+ */
+
+#include "net_interface_imp.h"
+#include "notification.h"
+#include "log.h"
+#include "timer_wheel.h"
+#include "aem_controller_state_machine.h"
+#include "adp_discovery_state_machine.h"
+#include "resp_dispatch_table.h"
+#include "end_station_list.h"
+#include "controller_context.h"
+
+namespace avdecc_lib
+{
+	controller_context::controller_context(controller_imp *controller_obj, net_interface_imp *netif,
+	                                       void (*notification_callback) (void *, int32_t, uint64_t, uint16_t, uint16_t, uint16_t, void *),
+	                                       void (*log_callback) (void *, int32_t, const char *, int32_t))
+	{
+		log_ref = new log();
+		log_ref->set_logging_callback(log_callback, NULL);
+		log_ref->logging_thread_init(); // Start logging thread
+
+		notification_ref = new notification();
+		notification_ref->set_notification_callback(notification_callback, NULL);
+
+		net_interface_ref = netif;
+		controller_imp_ref = controller_obj;
+		system_tx_queue_ref = NULL;
+		engine_shard_ref = NULL;
+		parent_context = NULL;
+		resp_dispatch_table_ref = new resp_dispatch_table();
+		end_station_list_ref = new end_station_list();
+		timer_wheel_ref = new timer_wheel();
+		aem_controller_state_machine_ref = new aem_controller_state_machine(this);
+		adp_discovery_state_machine_ref = new adp_discovery_state_machine(this);
+
+		if(net_interface_ref)
+		{
+			net_interface_ref->set_log(log_ref); // Log to the Controller once the network interface is in use by it
+		}
+	}
+
+	controller_context::controller_context(controller_context *parent)
+	{
+		log_ref = parent->log_ref;
+		notification_ref = parent->notification_ref;
+		net_interface_ref = parent->net_interface_ref;
+		controller_imp_ref = parent->controller_imp_ref;
+		system_tx_queue_ref = parent->system_tx_queue_ref;
+		engine_shard_ref = NULL;
+		parent_context = parent;
+		resp_dispatch_table_ref = parent->resp_dispatch_table_ref;
+		end_station_list_ref = parent->end_station_list_ref;
+		timer_wheel_ref = new timer_wheel();
+		aem_controller_state_machine_ref = new aem_controller_state_machine(this);
+		adp_discovery_state_machine_ref = new adp_discovery_state_machine(this);
+	}
+
+	controller_context::~controller_context()
+	{
+		if(net_interface_ref && !parent_context)
+		{
+			net_interface_ref->set_log(NULL);
+		}
+
+		delete adp_discovery_state_machine_ref;
+		delete aem_controller_state_machine_ref;
+		delete timer_wheel_ref;
+
+		if(!parent_context)
+		{
+			delete resp_dispatch_table_ref;
+			delete end_station_list_ref;
+			delete notification_ref;
+			delete log_ref;
+		}
+	}
+
+	int system_queue_tx_reserve(controller_context *context, struct system_tx_slot &slot)
+	{
+		if(context->system_tx_queue_ref)
+		{
+			return context->system_tx_queue_ref->queue_tx_reserve(slot);
+		}
+		else
+		{
+			return -1;
+		}
+	}
+
+	int system_queue_tx_commit(controller_context *context, struct system_tx_slot &slot, void *notification_id, uint32_t notification_flag, size_t mem_buf_len)
+	{
+		if(context->system_tx_queue_ref)
+		{
+			return context->system_tx_queue_ref->queue_tx_commit(slot, notification_id, notification_flag, mem_buf_len);
+		}
+		else
+		{
+			return -1;
+		}
+	}
+
+	void system_queue_tx_abort(controller_context *context, struct system_tx_slot &slot)
+	{
+		if(context->system_tx_queue_ref)
+		{
+			context->system_tx_queue_ref->queue_tx_abort(slot);
+		}
+	}
+}
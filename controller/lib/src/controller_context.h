@@ -0,0 +1,108 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * controller_context.h
+ *
+ * Controller context class, which holds the state of one Controller: the notification and logging threads, the
+ * timer wheel and the state machines, together with the network interface and the System the Controller runs on.
+ * Each Controller has its own context, so several Controllers can run independently in the same process.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_CONTROLLER_CONTEXT_H_
+#define _AVDECC_CONTROLLER_LIB_CONTROLLER_CONTEXT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "system_tx_queue.h"
+
+namespace avdecc_lib
+{
+	class net_interface_imp;
+	class notification;
+	class log;
+	class timer_wheel;
+	class aem_controller_state_machine;
+	class adp_discovery_state_machine;
+	class controller_imp;
+	class engine_shard;
+	class resp_dispatch_table;
+	class end_station_list;
+
+	class controller_context
+	{
+	public:
+		net_interface_imp *net_interface_ref; // The network interface of the Controller, owned by the application or the System
+		notification *notification_ref;
+		log *log_ref;
+		timer_wheel *timer_wheel_ref; // The timers of the Controller, expired by the thread running the Controller
+		aem_controller_state_machine *aem_controller_state_machine_ref;
+		adp_discovery_state_machine *adp_discovery_state_machine_ref;
+		controller_imp *controller_imp_ref; // The Controller owning the context
+		system_tx_queue *system_tx_queue_ref; // The transmit queue of the System running the Controller, NULL until the System is created
+		engine_shard *engine_shard_ref; // The shard running the End Stations of the context
+		resp_dispatch_table *resp_dispatch_table_ref; // The handlers of the AEM responses, shared with the shard contexts
+		end_station_list *end_station_list_ref; // The End Stations of all the shards in the order they were discovered, shared with the shard contexts
+		controller_context *parent_context; // The context of the Controller a shard context was made from, NULL for the context of a Controller
+
+		/**
+		 * Constructor for controller_context used for constructing the state of a Controller, which starts the
+		 * notification and logging threads with the notification and logging callback functions.
+		 */
+		controller_context(controller_imp *controller_obj, net_interface_imp *netif,
+		                   void (*notification_callback) (void *, int32_t, uint64_t, uint16_t, uint16_t, uint16_t, void *),
+		                   void (*log_callback) (void *, int32_t, const char *, int32_t));
+
+		/**
+		 * Constructor for controller_context used for constructing the context of an engine shard, with its own timer
+		 * wheel and state machines, sharing the log, notification, network interface and System of the Controller.
+		 */
+		controller_context(controller_context *parent);
+
+		/**
+		 * Destructor for controller_context used for destroying objects, which stops the notification and logging threads
+		 * of the context of a Controller.
+		 */
+		~controller_context();
+	};
+
+	/**
+	 * Reserve a frame in the transmit queue of the System running a Controller to build a command in.
+	 *
+	 * \return 0 on success, -1 if no frame is available or the Controller does not run on a System.
+	 */
+	int system_queue_tx_reserve(controller_context *context, struct system_tx_slot &slot);
+
+	/**
+	 * Queue a command built in a reserved frame to be transmitted by the System running a Controller.
+	 */
+	int system_queue_tx_commit(controller_context *context, struct system_tx_slot &slot, void *notification_id, uint32_t notification_flag, size_t mem_buf_len);
+
+	/**
+	 * Release a reserved frame without transmitting it.
+	 */
+	void system_queue_tx_abort(controller_context *context, struct system_tx_slot &slot);
+}
+
+#endif
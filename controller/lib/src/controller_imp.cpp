@@ -35,48 +35,52 @@
 #include "util.h"
 #include "adp.h"
 #include "aecp.h"
+#include "frame_view.h"
 #include "end_station_imp.h"
 #include "adp_discovery_state_machine.h"
 #include "aem_controller_state_machine.h"
+#include "controller_context.h"
+#include "engine_shard.h"
+#include "end_station_list.h"
 #include "controller_imp.h"
 
 namespace avdecc_lib
 {
-	net_interface_imp *net_interface_ref;
-	controller_imp *controller_imp_ref;
-
 	controller * STDCALL create_controller(net_interface *netif,
 	                                       void (*notification_callback) (void *, int32_t, uint64_t, uint16_t, uint16_t, uint16_t, void *),
 	                                       void (*log_callback) (void *, int32_t, const char *, int32_t))
 	{
-		net_interface_ref = dynamic_cast<net_interface_imp *>(netif);
+		net_interface_imp *netif_imp = dynamic_cast<net_interface_imp *>(netif);
 
-		if(!net_interface_ref)
+		if(!netif_imp)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Dynamic cast from derived net_interface_imp to base net_interface error");
+			return NULL; // There is no Controller to log the error with yet
 		}
 
-		controller_imp_ref = new controller_imp(notification_callback, log_callback);
-		return controller_imp_ref;
+		return new controller_imp(netif_imp, notification_callback, log_callback);
 	}
 
-	controller_imp::controller_imp() {}
+	controller_imp::controller_imp()
+	{
+		context = NULL;
+	}
 
-	controller_imp::controller_imp(void (*notification_callback) (void *, int32_t, uint64_t, uint16_t, uint16_t, uint16_t, void *),
+	controller_imp::controller_imp(net_interface_imp *netif,
+	                               void (*notification_callback) (void *, int32_t, uint64_t, uint16_t, uint16_t, uint16_t, void *),
 	                               void (*log_callback) (void *, int32_t, const char *, int32_t))
 	{
-		avdecc_lib::notification_ref->set_notification_callback(notification_callback, NULL);
-		avdecc_lib::log_ref->set_logging_callback(log_callback, NULL);
+		context = new controller_context(this, netif, notification_callback, log_callback);
+		shards.push_back(new engine_shard(context, 0));
 	}
 
 	controller_imp::~controller_imp()
 	{
-		for(uint32_t end_station_vec_index = 0; end_station_vec_index < end_station_vec.size(); end_station_vec_index++)
+		for(uint32_t shard_index = 0; shard_index < shards.size(); shard_index++)
 		{
-			delete end_station_vec.at(end_station_vec_index);
+			delete shards.at(shard_index);
 		}
 
-		delete controller_imp_ref;
+		delete context;
 	}
 
 	void STDCALL controller_imp::destroy()
@@ -94,217 +98,276 @@ namespace avdecc_lib
 		return controller_guid;
 	}
 
+	int controller_imp::set_engine_shard_count(uint32_t shard_count)
+	{
+		if((shard_count == 0) || (shard_count > ENGINE_SHARD_MAX_COUNT))
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "The shard count has to be between 1 and %d", ENGINE_SHARD_MAX_COUNT);
+			return -1;
+		}
+
+		if(get_end_station_count() > 0)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "The End Stations can only be sharded before any is discovered");
+			return -1;
+		}
+
+		for(uint32_t shard_index = 0; shard_index < shards.size(); shard_index++)
+		{
+			delete shards.at(shard_index);
+		}
+
+		shards.clear();
+
+		/**
+		 * A single shard runs on the context of the Controller, so that the default mode is unchanged.
+		 */
+		if(shard_count == 1)
+		{
+			shards.push_back(new engine_shard(context, 0));
+			return 0;
+		}
+
+		for(uint32_t shard_index = 0; shard_index < shard_count; shard_index++)
+		{
+			shards.push_back(new engine_shard(new controller_context(context), shard_index));
+		}
+
+		return 0;
+	}
+
+	uint32_t controller_imp::find_shard_index_by_guid(uint64_t entity_guid)
+	{
+		/**
+		 * Use the high bits of the hash, as the GUID index of each shard uses the low bits.
+		 */
+		uint32_t hash = (uint32_t)((entity_guid * UINT64_C(0x9E3779B97F4A7C15)) >> 32);
+
+		return (uint32_t)(((uint64_t)hash * shards.size()) >> 32);
+	}
+
 	uint32_t STDCALL controller_imp::get_end_station_count()
 	{
-		return end_station_vec.size();
+		return context->end_station_list_ref->size();
+	}
+
+	end_station_imp * controller_imp::find_end_station_by_index(uint32_t end_station_index, uint64_t &handle)
+	{
+		uint32_t shard_index;
+		uint64_t shard_handle;
+
+		/**
+		 * The list holds the End Stations of all the shards in the order they were discovered, so the index of an End
+		 * Station does not change when an End Station of another shard is discovered.
+		 */
+		if(!context->end_station_list_ref->at(end_station_index, shard_index, shard_handle))
+		{
+			return NULL;
+		}
+
+		handle = shard_handle | ((uint64_t)shard_index << ENGINE_SHARD_HANDLE_SHIFT);
+		return shards.at(shard_index)->get_end_station_by_handle(shard_handle);
+	}
+
+	end_station_imp * controller_imp::find_end_station_by_guid(uint64_t entity_guid, uint64_t &handle)
+	{
+		uint32_t shard_index = find_shard_index_by_guid(entity_guid);
+		end_station_imp *end_station = shards.at(shard_index)->find_end_station_by_guid(entity_guid, handle);
+
+		handle |= (uint64_t)shard_index << ENGINE_SHARD_HANDLE_SHIFT;
+		return end_station;
+	}
+
+	end_station_imp * controller_imp::find_end_station_by_handle(uint64_t end_station_handle)
+	{
+		uint32_t shard_index = (uint32_t)(end_station_handle >> ENGINE_SHARD_HANDLE_SHIFT) & (ENGINE_SHARD_MAX_COUNT - 1);
+
+		if(shard_index >= shards.size())
+		{
+			return NULL;
+		}
+
+		return shards.at(shard_index)->get_end_station_by_handle(end_station_handle & ~((uint64_t)(ENGINE_SHARD_MAX_COUNT - 1) << ENGINE_SHARD_HANDLE_SHIFT));
 	}
 
 	avdecc_lib::end_station * STDCALL controller_imp::get_end_station_by_index(uint32_t end_station_index)
 	{
-		return end_station_vec.at(end_station_index);
+		uint64_t handle;
+		end_station_imp *end_station = find_end_station_by_index(end_station_index, handle);
+
+		if(!end_station)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "get_end_station_by_index error");
+		}
+
+		return end_station;
 	}
 
-	bool controller_imp::find_end_station_by_guid(uint64_t entity_guid, uint32_t &end_station_index)
+	uint64_t STDCALL controller_imp::get_end_station_handle_by_index(uint32_t end_station_index)
 	{
-		uint64_t end_station_guid;
+		uint64_t handle;
 
-		for(uint32_t index_i = 0; index_i < end_station_vec.size(); index_i++)
+		if(!find_end_station_by_index(end_station_index, handle))
 		{
-			end_station_guid = end_station_vec.at(index_i)->get_end_station_guid();
+			return 0;
+		}
 
-			if(end_station_guid == entity_guid)
-			{
-				end_station_index = index_i;
-				return true;
-			}
+		return handle;
+	}
+
+	uint64_t STDCALL controller_imp::get_end_station_handle_by_guid(uint64_t entity_guid)
+	{
+		uint64_t handle;
+
+		if(!find_end_station_by_guid(entity_guid, handle))
+		{
+			return 0;
 		}
 
-		return false;
+		return handle;
 	}
 
-	configuration_descriptor * STDCALL controller_imp::get_config_by_index(uint32_t end_station_index, uint16_t entity_index, uint16_t config_index)
+	avdecc_lib::end_station * STDCALL controller_imp::get_end_station_by_handle(uint64_t end_station_handle)
+	{
+		return find_end_station_by_handle(end_station_handle);
+	}
+
+	configuration_descriptor * controller_imp::get_config(end_station_imp *end_station, uint16_t entity_index, uint16_t config_index)
 	{
 		bool is_valid;
-		is_valid = ((end_station_index < end_station_vec.size()) &&
-		            (entity_index < end_station_vec.at(end_station_index)->get_entity_desc_count()) &&
-		            (config_index < end_station_vec.at(end_station_index)->get_entity_desc_by_index(entity_index)->get_configurations_count()));
+		is_valid = (end_station &&
+		            (entity_index < end_station->get_entity_desc_count()) &&
+		            (config_index < end_station->get_entity_desc_by_index(entity_index)->get_configurations_count()));
 
 		if(is_valid)
 		{
-			return end_station_vec.at(end_station_index)->get_entity_desc_by_index(entity_index)->get_config_desc_by_index(config_index);
+			return end_station->get_entity_desc_by_index(entity_index)->get_config_desc_by_index(config_index);
 		}
 
-		else
+		return NULL;
+	}
+
+	configuration_descriptor * STDCALL controller_imp::get_config_by_index(uint32_t end_station_index, uint16_t entity_index, uint16_t config_index)
+	{
+		uint64_t handle;
+		configuration_descriptor *config = get_config(find_end_station_by_index(end_station_index, handle), entity_index, config_index);
+
+		if(!config)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "get_config_by_index error");
-			return NULL;
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "get_config_by_index error");
 		}
+
+		return config;
 	}
 
-	configuration_descriptor * controller_imp::get_config_by_guid(uint64_t entity_guid, uint16_t entity_index, uint16_t config_index)
+	configuration_descriptor * STDCALL controller_imp::get_config_by_guid(uint64_t entity_guid, uint16_t entity_index, uint16_t config_index)
 	{
+		uint64_t handle;
+		configuration_descriptor *config = get_config(find_end_station_by_guid(entity_guid, handle), entity_index, config_index);
 
-		return 0;
+		if(!config)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "get_config_by_guid error");
+		}
+
+		return config;
+	}
+
+	configuration_descriptor * STDCALL controller_imp::get_config_by_handle(uint64_t end_station_handle, uint16_t entity_index, uint16_t config_index)
+	{
+		configuration_descriptor *config = get_config(find_end_station_by_handle(end_station_handle), entity_index, config_index);
+
+		if(!config)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "get_config_by_handle error");
+		}
+
+		return config;
 	}
 
 	bool STDCALL controller_imp::is_inflight_cmd_with_notification_id(void *notification_id)
 	{
-		return aem_controller_state_machine_ref->find_inflight_cmd_by_notification_id(notification_id);
+		for(uint32_t shard_index = 0; shard_index < shards.size(); shard_index++)
+		{
+			if(shards.at(shard_index)->get_context()->aem_controller_state_machine_ref->find_inflight_cmd_by_notification_id(notification_id))
+			{
+				return true;
+			}
+		}
+
+		return false;
 	}
 
 	void STDCALL controller_imp::update_log_level(int32_t new_log_level)
 	{
-		log_ref->set_log_level(new_log_level);
+		context->log_ref->set_log_level(new_log_level);
 	}
 
 	uint32_t STDCALL controller_imp::missed_notification_count()
 	{
-		return notification_ref->get_missed_notification_event_count();
+		return context->notification_ref->get_missed_notification_event_count();
 	}
 
 	uint32_t STDCALL controller_imp::missed_log_count()
 	{
-		return log_ref->get_missed_log_event_count();
+		return context->log_ref->get_missed_log_event_count();
 	}
 
-	void STDCALL controller_imp::time_tick_event()
+	void STDCALL controller_imp::get_cmd_timing_stats(uint32_t &timed_cmd_count, uint32_t &avg_wire_rtt_us, uint32_t &max_wire_rtt_us, uint32_t &avg_library_delay_us)
 	{
-		uint64_t end_station_guid;
-		uint32_t disconnected_end_station_index;
-		aem_controller_state_machine_ref->aem_controller_tick();
+		uint64_t total_wire_rtt_us = 0;
+		uint64_t total_library_delay_us = 0;
+
+		timed_cmd_count = 0;
+		max_wire_rtt_us = 0;
 
-		if(adp_discovery_state_machine_ref->adp_discovery_tick(end_station_guid) &&
-		   find_end_station_by_guid(end_station_guid, disconnected_end_station_index))
+		for(uint32_t shard_index = 0; shard_index < shards.size(); shard_index++)
 		{
-			end_station_vec.at(disconnected_end_station_index)->set_disconnected();
+			uint32_t shard_timed_cmd_count;
+			uint32_t shard_avg_wire_rtt_us;
+			uint32_t shard_max_wire_rtt_us;
+			uint32_t shard_avg_library_delay_us;
+
+			shards.at(shard_index)->get_context()->aem_controller_state_machine_ref->get_cmd_timing_stats(shard_timed_cmd_count,
+			                                                                                          shard_avg_wire_rtt_us,
+			                                                                                          shard_max_wire_rtt_us,
+			                                                                                          shard_avg_library_delay_us);
+			timed_cmd_count += shard_timed_cmd_count;
+			total_wire_rtt_us += (uint64_t)shard_avg_wire_rtt_us * shard_timed_cmd_count;
+			total_library_delay_us += (uint64_t)shard_avg_library_delay_us * shard_timed_cmd_count;
+
+			if(shard_max_wire_rtt_us > max_wire_rtt_us)
+			{
+				max_wire_rtt_us = shard_max_wire_rtt_us;
+			}
 		}
+
+		avg_wire_rtt_us = timed_cmd_count ? (uint32_t)(total_wire_rtt_us / timed_cmd_count) : 0;
+		avg_library_delay_us = timed_cmd_count ? (uint32_t)(total_library_delay_us / timed_cmd_count) : 0;
 	}
 
-	void STDCALL controller_imp::rx_packet_event(void *&notification_id, bool &is_notification_id_valid, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status)
+	void STDCALL controller_imp::time_tick_event()
 	{
-		uint64_t dest_mac_addr;
-		uint32_t subtype;
-
-		convert_eui48_to_uint64(frame, dest_mac_addr);
-
-		if((dest_mac_addr == net_interface_ref->get_mac()) || (dest_mac_addr & UINT64_C(0x010000000000))) // Process if the packet dest is our MAC address or a multicast address
+		for(uint32_t shard_index = 0; shard_index < shards.size(); shard_index++)
 		{
-			subtype = jdksavdecc_subtype_data_get_subtype(jdksavdecc_uint32_get(frame, aecp::CMD_POS));
-
-			switch(subtype)
-			{
-				case JDKSAVDECC_SUBTYPE_ADP:
-					{
-						int found_end_station_index = -1;
-						bool found_adp_in_endpoint = false;
-						uint64_t entity_guid = jdksavdecc_uint64_get(frame, adp::ETHER_HDR_SIZE + adp::PROTOCOL_HDR_SIZE);
-
-						//avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG, "ADP packet discovered.");
-
-						/**
-						 * Check if an ADP object is already in the system. If not, create a new End Station object storing the ADPDU information
-						 * and add the End Station object to the system.
-						 */
-						for(uint32_t index_i = 0; index_i < end_station_vec.size(); index_i++)
-						{
-							if(end_station_vec.at(index_i)->get_adp()->get_entity_entity_id() == entity_guid)
-							{
-								found_adp_in_endpoint = true;
-								found_end_station_index = index_i;
-							}
-						}
-
-						if(entity_guid != 0x0)
-						{
-							if(!found_adp_in_endpoint)
-							{
-								adp_discovery_state_machine_ref->set_rcvd_avail(true);
-								adp_discovery_state_machine_ref->adp_discovery_state_waiting(frame);
-								end_station_vec.push_back(new end_station_imp(frame, mem_buf_len));
-								end_station_vec.at(end_station_vec.size() - 1)->set_connected();
-							}
-							else
-							{
-								if(end_station_vec.at(found_end_station_index)->get_connection_status() == 'D')
-								{
-									end_station_vec.at(found_end_station_index)->set_connected();
-									adp_discovery_state_machine_ref->set_rcvd_avail(true);
-									adp_discovery_state_machine_ref->adp_discovery_state_waiting(frame);
-								}
-								else
-								{
-									adp_discovery_state_machine_ref->set_rcvd_avail(true);
-									adp_discovery_state_machine_ref->adp_discovery_state_waiting(frame);
-								}
-							}
-						}
-						else
-						{
-							//avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Entity GUID is 0x0");
-						}
-
-						status = STATUS_INVALID_COMMAND;
-						is_notification_id_valid = false;
-					}
-					break;
-
-				case JDKSAVDECC_SUBTYPE_AECP:
-					{
-						int found_end_station_index = -1;
-						bool found_aecp_in_end_station = false;
-						uint8_t msg_type = jdksavdecc_uint8_get(frame, aecp::MSG_TYPE_POS);
-						uint64_t entity_guid = jdksavdecc_uint64_get(frame, aecp::TARGET_GUID_POS);
-						uint16_t seq_id = jdksavdecc_uint16_get(frame, aecp::SEQ_ID_POS);
-
-						/**
-						 * Check if an AECP object is already in the system. If yes, process response for the AECP packet.
-						 */
-						if((seq_id <= aem_controller_state_machine::aecp_seq_id) && (msg_type == JDKSAVDECC_AECP_MESSAGE_TYPE_AEM_RESPONSE) &&
-						   (dest_mac_addr == net_interface_ref->get_mac()))
-						{
-							for(uint32_t index_i = 0; index_i < end_station_vec.size(); index_i++)
-							{
-								if(end_station_vec.at(index_i)->get_adp()->get_entity_entity_id() == entity_guid)
-								{
-									found_aecp_in_end_station = true;
-									found_end_station_index = index_i;
-								}
-							}
-						}
-
-						if(found_aecp_in_end_station)
-						{
-							end_station_vec.at(found_end_station_index)->proc_rcvd_resp(notification_id, notification_flag, frame, mem_buf_len, status);
-							is_notification_id_valid = true;
-						}
-						else
-						{
-							//avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG, "Need to have ADP packet first.");
-							status = STATUS_INVALID_COMMAND;
-						}
-					}
-					break;
-
-				case JDKSAVDECC_SUBTYPE_ACMP:
-					//std::cout << "\nACMP subtype";
-					break;
-
-				default:
-					//avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Invalid subtype");
-					break;
-			}
+			shards.at(shard_index)->time_tick_event();
 		}
 	}
 
-	void STDCALL controller_imp::tx_packet_event(void *notification_id, uint32_t notification_flag, uint8_t *frame, uint16_t mem_buf_len)
+	void STDCALL controller_imp::rx_packet_event(void *&notification_id, bool &is_notification_id_valid, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status)
 	{
-		struct jdksavdecc_frame packet_frame;
+		frame_view rx_frame(frame, mem_buf_len, context->net_interface_ref->get_rx_timestamp()); // The received frame is handled in place, without copying it
 
-		packet_frame.length = mem_buf_len;
-		memcpy(packet_frame.payload, frame, mem_buf_len);
+		shards.at(find_shard_index_by_guid(rx_frame.guid()))->rx_packet_event(notification_id, is_notification_id_valid, notification_flag, rx_frame, status);
+	}
+
+	void STDCALL controller_imp::tx_packet_event(void *notification_id, uint32_t notification_flag, uint8_t *frame, uint16_t mem_buf_len)
+	{
+		shards.at(find_shard_index_by_guid(jdksavdecc_uint64_get(frame, aecp::TARGET_GUID_POS)))->tx_packet_event(notification_id, notification_flag, frame, mem_buf_len);
+	}
 
-		aem_controller_state_machine_ref->set_do_cmd(true);
-		aem_controller_state_machine_ref->aem_controller_state_waiting(notification_id, notification_flag, &packet_frame);
-		memcpy(frame, packet_frame.payload, mem_buf_len);
+	void STDCALL controller_imp::tx_timestamp_event(const uint8_t *frame, uint16_t mem_buf_len, uint64_t tx_timestamp_ns)
+	{
+		shards.at(find_shard_index_by_guid(jdksavdecc_uint64_get(frame, aecp::TARGET_GUID_POS)))->tx_timestamp_event(frame, mem_buf_len, tx_timestamp_ns);
 	}
 }
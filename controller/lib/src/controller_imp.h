@@ -31,17 +31,31 @@
 #ifndef _AVDECC_CONTROLLER_LIB_CONTROLLER_IMP_H_
 #define _AVDECC_CONTROLLER_LIB_CONTROLLER_IMP_H_
 
+#include <vector>
 #include "controller.h"
 
 #define AVDECC_CONTROLLER_VERSION "v0.0.7"
 
 namespace avdecc_lib
 {
+	class net_interface_imp;
+	class controller_context;
+	class engine_shard;
+	class end_station_imp;
+
 	class controller_imp : public virtual controller
 	{
+	public:
+		enum engine_shard_sizes
+		{
+		        ENGINE_SHARD_MAX_COUNT = 64,
+		        ENGINE_SHARD_HANDLE_SHIFT = 24 // The shard of an End Station is stored in the handle above the slot index
+		};
+
 	private:
+		controller_context *context; // The state of the Controller, shared with its End Stations and state machines
 		uint64_t controller_guid; // The unique identifier of the AVDECC Entity sending the command
-		std::vector<end_station_imp *> end_station_vec; // Store a list of End Station class objects
+		std::vector<engine_shard *> shards; // The End Stations by shard, a single shard running on the context of the Controller by default
 
 	public:
 		/**
@@ -52,7 +66,8 @@ namespace avdecc_lib
 		/**
 		 * A constructor for controller_imp used for constructing an object with network interface, notification, and logging callback functions.
 		 */
-		controller_imp(void (*notification_callback) (void *, int32_t, uint64_t, uint16_t, uint16_t, uint16_t, void *),
+		controller_imp(net_interface_imp *netif,
+		               void (*notification_callback) (void *, int32_t, uint64_t, uint16_t, uint16_t, uint16_t, void *),
 		               void (*log_callback) (void *, int32_t, const char *, int32_t));
 
 		/**
@@ -65,6 +80,14 @@ namespace avdecc_lib
 		 */
 		void STDCALL destroy();
 
+		/**
+		 * Get the context of the Controller.
+		 */
+		inline controller_context * get_context()
+		{
+			return context;
+		}
+
 		/**
 		 * Get the current build release version.
 		 */
@@ -86,9 +109,46 @@ namespace avdecc_lib
 		avdecc_lib::end_station * STDCALL get_end_station_by_index(uint32_t end_station_index);
 
 		/**
-		 * Get the corresponding End Station by GUID.
+		 * Get the handle of the End Station at an index.
+		 */
+		uint64_t STDCALL get_end_station_handle_by_index(uint32_t end_station_index);
+
+		/**
+		 * Get the handle of the End Station with a GUID.
+		 */
+		uint64_t STDCALL get_end_station_handle_by_guid(uint64_t entity_guid);
+
+		/**
+		 * Get the corresponding End Station by handle.
+		 */
+		avdecc_lib::end_station * STDCALL get_end_station_by_handle(uint64_t end_station_handle);
+
+		/**
+		 * Split the End Stations over a number of shards, each with its own timer wheel and state machines, or run
+		 * them all on the context of the Controller if shard_count is 1. Only possible before any End Station is found.
+		 */
+		int set_engine_shard_count(uint32_t shard_count);
+
+		/**
+		 * Get the number of shards the End Stations are split over.
+		 */
+		inline uint32_t get_engine_shard_count()
+		{
+			return (uint32_t)shards.size();
+		}
+
+		/**
+		 * Get a shard by index.
+		 */
+		inline engine_shard * get_engine_shard(uint32_t shard_index)
+		{
+			return shards.at(shard_index);
+		}
+
+		/**
+		 * Get the index of the shard running the End Station with a GUID.
 		 */
-		bool find_end_station_by_guid(uint64_t entity_guid, uint32_t &end_station_index);
+		uint32_t find_shard_index_by_guid(uint64_t entity_guid);
 
 		/**
 		 * Get the corresponding Configuration descriptor by index.
@@ -100,6 +160,11 @@ namespace avdecc_lib
 		 */
 		configuration_descriptor * STDCALL get_config_by_guid(uint64_t entity_guid, uint16_t entity_index, uint16_t config_index);
 
+		/**
+		 * Get the corresponding Configuration descriptor by End Station handle.
+		 */
+		configuration_descriptor * STDCALL get_config_by_handle(uint64_t end_station_handle, uint16_t entity_index, uint16_t config_index);
+
 		/**
 		 * Check if the command with the corresponding notification id is in the inflight list.
 		 */
@@ -120,13 +185,18 @@ namespace avdecc_lib
 		 */
 		uint32_t STDCALL missed_log_count();
 
+		/**
+		 * Get the timing statistics of the commands a response has been received for.
+		 */
+		void STDCALL get_cmd_timing_stats(uint32_t &timed_cmd_count, uint32_t &avg_wire_rtt_us, uint32_t &max_wire_rtt_us, uint32_t &avg_library_delay_us);
+
 		/**
 		 * Check for End Station connection, command packet, and response packet timeouts.
 		 */
 		void STDCALL time_tick_event();
 
 		/**
-		 * Lookup and process packet received.
+		 * Lookup and process packet received, in the shard of the End Station it is from.
 		 */
 		void STDCALL rx_packet_event(void *&notification_id, bool &notification_id_flag, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status);
 
@@ -134,9 +204,33 @@ namespace avdecc_lib
 		 * Send queued packet to the AEM Controller State Machine.
 		 */
 		void STDCALL tx_packet_event(void *notification_id, uint32_t notification_flag, uint8_t *frame, uint16_t mem_buf_len);
-	};
 
-	extern controller_imp *controller_imp_ref;
+		/**
+		 * Pass the time a sent packet left the network interface to the AEM Controller State Machine.
+		 */
+		void STDCALL tx_timestamp_event(const uint8_t *frame, uint16_t mem_buf_len, uint64_t tx_timestamp_ns);
+
+	private:
+		/**
+		 * Get the End Station at a position in the discovery order of all the shards and its handle, or NULL if there is none.
+		 */
+		end_station_imp * find_end_station_by_index(uint32_t end_station_index, uint64_t &handle);
+
+		/**
+		 * Get the End Station with a GUID and its handle, or NULL if there is none.
+		 */
+		end_station_imp * find_end_station_by_guid(uint64_t entity_guid, uint64_t &handle);
+
+		/**
+		 * Get the End Station of a handle, or NULL if the handle is invalid.
+		 */
+		end_station_imp * find_end_station_by_handle(uint64_t end_station_handle);
+
+		/**
+		 * Get the corresponding Configuration descriptor of an End Station, or NULL if there is none.
+		 */
+		configuration_descriptor * get_config(end_station_imp *end_station, uint16_t entity_index, uint16_t config_index);
+	};
 }
 
 #endif
@@ -0,0 +1,140 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * desc_decode_pool.cpp
+ *
+ * Descriptor decode pool implementation
+ */
+
+#include <string.h>
+#include "enumeration.h"
+#include "adp.h"
+#include "aecp.h"
+#include "end_station_imp.h"
+#include "controller_context.h"
+#include "resp_dispatch_table.h"
+#include "desc_decode_pool.h"
+
+namespace avdecc_lib
+{
+	desc_decode_pool::desc_decode_pool(uint32_t worker_count)
+	{
+		job_frames = new frame_slab(DECODE_FRAME_COUNT);
+
+		for(uint32_t worker_index = 0; worker_index < worker_count; worker_index++)
+		{
+			job_queues.push_back(new mpsc_ring(DECODE_FRAME_COUNT, sizeof(struct decode_job), true));
+		}
+	}
+
+	desc_decode_pool::~desc_decode_pool()
+	{
+		for(uint32_t worker_index = 0; worker_index < job_queues.size(); worker_index++)
+		{
+			delete job_queues.at(worker_index);
+		}
+
+		delete job_frames;
+	}
+
+	mpsc_ring * desc_decode_pool::create_done_queue()
+	{
+		return new mpsc_ring(DECODE_FRAME_COUNT, sizeof(struct decoded_desc), true);
+	}
+
+	int desc_decode_pool::submit(end_station_imp *end_station, mpsc_ring *done_queue, uint16_t desc_type, const uint8_t *frame, uint16_t mem_buf_len)
+	{
+		uint64_t end_station_guid = end_station->get_end_station_guid();
+		uint32_t worker_index = (uint32_t)(end_station_guid ^ (end_station_guid >> 32)) % job_queues.size();
+		struct decode_job job;
+
+		if((mem_buf_len > frame_slab::FRAME_SLAB_FRAME_SIZE) || (job_frames->alloc(job.frame_index) < 0))
+		{
+			return -1;
+		}
+
+		memcpy(job_frames->get_frame(job.frame_index), frame, mem_buf_len);
+		job.end_station = end_station;
+		job.done_queue = done_queue;
+		job.desc_type = desc_type;
+		job.mem_buf_len = mem_buf_len;
+
+		/**
+		 * A job queue has room for every frame of the pool, so the push cannot fail.
+		 */
+		job_queues.at(worker_index)->push(&job);
+
+		return 0;
+	}
+
+	bool desc_decode_pool::decode_jobs(uint32_t worker_index)
+	{
+		mpsc_ring *job_queue = job_queues.at(worker_index);
+		struct decode_job job_batch[DECODE_POP_BATCH];
+		uint32_t pop_count;
+		uint32_t decode_count = 0;
+
+		do
+		{
+			pop_count = job_queue->pop_batch(job_batch, DECODE_POP_BATCH);
+
+			for(uint32_t index_i = 0; index_i < pop_count; index_i++)
+			{
+				struct decode_job &job = job_batch[index_i];
+				resp_dispatch_table *dispatch_table = job.end_station->get_context()->resp_dispatch_table_ref;
+				resp_dispatch_table::decode_desc_handler decode_handler = dispatch_table->find_decode_desc_handler(job.desc_type);
+				struct decoded_desc decoded;
+
+				decoded.end_station = job.end_station;
+				decoded.desc = decode_handler ? decode_handler(job.end_station, job_frames->get_frame(job.frame_index), aecp::READ_DESC_POS, job.mem_buf_len) : NULL;
+				decoded.desc_type = job.desc_type;
+				decoded.frame_index = job.frame_index;
+
+				/**
+				 * Each decoded descriptor holds its frame until the engine takes it, so a done queue that has room for
+				 * every frame of the pool cannot be full.
+				 */
+				job.done_queue->push(&decoded);
+			}
+
+			decode_count += pop_count;
+		}
+		while((pop_count == DECODE_POP_BATCH) && (decode_count < DECODE_BUDGET));
+
+		/**
+		 * A job queue only wakes its thread when the thread was idle, so it has to be found empty before waiting again.
+		 */
+		return (pop_count == DECODE_POP_BATCH) || !job_queue->prepare_wait();
+	}
+
+	void desc_decode_pool::clear_wakeup(uint32_t worker_index)
+	{
+		job_queues.at(worker_index)->clear_wakeup();
+	}
+
+	ring_wakeup::wakeup_handle desc_decode_pool::wakeup_object(uint32_t worker_index)
+	{
+		return job_queues.at(worker_index)->wakeup_object();
+	}
+}
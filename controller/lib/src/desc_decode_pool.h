@@ -0,0 +1,138 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * desc_decode_pool.h
+ *
+ * Descriptor decode pool class, which decodes the descriptors read by the enumeration of the End Stations outside
+ * the engine thread. The engine copies a READ_DESCRIPTOR response to the pool once the response has been matched to
+ * its command, a decode thread builds the descriptor object, and the engine stores the object in its End Station
+ * when it takes it from its decoded descriptor queue. The System runs the decode threads.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_DESC_DECODE_POOL_H_
+#define _AVDECC_CONTROLLER_LIB_DESC_DECODE_POOL_H_
+
+#include <stdint.h>
+#include <vector>
+#include "mpsc_ring.h"
+#include "frame_slab.h"
+
+namespace avdecc_lib
+{
+	class end_station_imp;
+	class descriptor_base_imp;
+
+	class desc_decode_pool
+	{
+	public:
+		struct decode_job
+		{
+			end_station_imp *end_station; // The End Station the descriptor was read from
+			mpsc_ring *done_queue; // The decoded descriptor queue of the engine running the End Station
+			uint16_t desc_type;
+			uint16_t frame_index; // The copy of the response in the frame slab of the pool
+			uint16_t mem_buf_len;
+		};
+
+		struct decoded_desc
+		{
+			end_station_imp *end_station;
+			descriptor_base_imp *desc; // The descriptor object built, or NULL if the response could not be decoded
+			uint16_t desc_type;
+			uint16_t frame_index; // Held until the engine has taken the descriptor, so that a done queue never overflows
+		};
+
+		enum desc_decode_pool_sizes
+		{
+		        DECODE_WORKER_MAX_COUNT = 16,
+		        DECODE_FRAME_COUNT = 256, // The number of responses that can be decoded or waiting for the engine at once
+		        DECODE_POP_BATCH = 16,
+		        DECODE_BUDGET = 64 // The number of entries a thread handles before it serves its other events
+		};
+
+	private:
+		frame_slab *job_frames; // The copies of the responses being decoded
+		std::vector<mpsc_ring *> job_queues; // The jobs of each decode thread
+
+	public:
+		/**
+		 * Constructor for desc_decode_pool used for constructing a pool with a number of decode threads.
+		 */
+		desc_decode_pool(uint32_t worker_count);
+
+		/**
+		 * Destructor for desc_decode_pool used for destroying objects. The decode threads must have been stopped.
+		 */
+		~desc_decode_pool();
+
+		/**
+		 * Get the number of decode threads of the pool.
+		 */
+		inline uint32_t get_worker_count()
+		{
+			return (uint32_t)job_queues.size();
+		}
+
+		/**
+		 * Create the queue an engine takes its decoded descriptors from, sized so that it holds every frame of the pool.
+		 */
+		static mpsc_ring * create_done_queue();
+
+		/**
+		 * Copy a READ_DESCRIPTOR response to the pool, to be decoded by the thread of its End Station so that the
+		 * descriptors of an End Station are stored in the order they were read.
+		 *
+		 * \return 0 on success, -1 if the pool has no free frame and the response has to be decoded by the engine.
+		 */
+		int submit(end_station_imp *end_station, mpsc_ring *done_queue, uint16_t desc_type, const uint8_t *frame, uint16_t mem_buf_len);
+
+		/**
+		 * Decode up to DECODE_BUDGET jobs of a decode thread and pass the descriptors to their engines.
+		 *
+		 * \return True if jobs may be left to decode.
+		 */
+		bool decode_jobs(uint32_t worker_index);
+
+		/**
+		 * Return the frame of a decoded descriptor taken by an engine.
+		 */
+		inline void release_frame(uint16_t frame_index)
+		{
+			job_frames->release(frame_index);
+		}
+
+		/**
+		 * Reset the wakeup of a decode thread after it has been woken.
+		 */
+		void clear_wakeup(uint32_t worker_index);
+
+		/**
+		 * Get the handle a decode thread waits on.
+		 */
+		ring_wakeup::wakeup_handle wakeup_object(uint32_t worker_index);
+	};
+}
+
+#endif
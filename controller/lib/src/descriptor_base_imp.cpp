@@ -27,15 +27,24 @@
  * Descriptor base implementation
  */
 
+#include "enumeration.h"
+#include "log.h"
+#include "end_station_imp.h"
+#include "controller_context.h"
 #include "descriptor_base_imp.h"
 
 namespace avdecc_lib
 {
-	descriptor_base_imp::descriptor_base_imp() {}
+	descriptor_base_imp::descriptor_base_imp()
+	{
+		base_end_station_imp_ref = NULL;
+		context = NULL;
+	}
 
 	descriptor_base_imp::descriptor_base_imp(end_station_imp *base)
 	{
 		base_end_station_imp_ref = base;
+		context = base->get_context();
 	}
 
 	descriptor_base_imp::~descriptor_base_imp() {}
@@ -111,4 +120,74 @@ namespace avdecc_lib
 
 		return 0;
 	}
+
+	int descriptor_base_imp::proc_set_stream_format_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
+	{
+		context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "SET_STREAM_FORMAT response not supported by descriptor type %d", get_descriptor_type());
+
+		return -1;
+	}
+
+	int descriptor_base_imp::proc_get_stream_format_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
+	{
+		context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "GET_STREAM_FORMAT response not supported by descriptor type %d", get_descriptor_type());
+
+		return -1;
+	}
+
+	int descriptor_base_imp::proc_set_stream_info_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
+	{
+		context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "SET_STREAM_INFO response not supported by descriptor type %d", get_descriptor_type());
+
+		return -1;
+	}
+
+	int descriptor_base_imp::proc_get_stream_info_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
+	{
+		context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "GET_STREAM_INFO response not supported by descriptor type %d", get_descriptor_type());
+
+		return -1;
+	}
+
+	int descriptor_base_imp::proc_set_sampling_rate_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
+	{
+		context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "SET_SAMPLING_RATE response not supported by descriptor type %d", get_descriptor_type());
+
+		return -1;
+	}
+
+	int descriptor_base_imp::proc_get_sampling_rate_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
+	{
+		context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "GET_SAMPLING_RATE response not supported by descriptor type %d", get_descriptor_type());
+
+		return -1;
+	}
+
+	int descriptor_base_imp::proc_set_clock_source_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
+	{
+		context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "SET_CLOCK_SOURCE response not supported by descriptor type %d", get_descriptor_type());
+
+		return -1;
+	}
+
+	int descriptor_base_imp::proc_get_clock_source_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
+	{
+		context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "GET_CLOCK_SOURCE response not supported by descriptor type %d", get_descriptor_type());
+
+		return -1;
+	}
+
+	int descriptor_base_imp::proc_start_streaming_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
+	{
+		context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "START_STREAMING response not supported by descriptor type %d", get_descriptor_type());
+
+		return -1;
+	}
+
+	int descriptor_base_imp::proc_stop_streaming_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
+	{
+		context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "STOP_STREAMING response not supported by descriptor type %d", get_descriptor_type());
+
+		return -1;
+	}
 }
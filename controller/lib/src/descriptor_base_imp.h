@@ -37,16 +37,19 @@
 #include "jdksavdecc_util.h"
 #include "jdksavdecc_aem_command.h"
 #include "jdksavdecc_aem_descriptor.h"
+#include "frame_view.h"
 #include "descriptor_base.h"
 
 namespace avdecc_lib
 {
 	class end_station_imp;
+	class controller_context;
 
 	class descriptor_base_imp : public virtual descriptor_base
 	{
 	protected:
 		end_station_imp *base_end_station_imp_ref;
+		controller_context *context; // The Controller of the End Station
 
 	public:
 		/**
@@ -123,6 +126,56 @@ namespace avdecc_lib
 		 * Process a GET_NAME response for the GET_NAME command.
 		 */
 		virtual int proc_get_name_resp(uint8_t *base_pointer, uint16_t mem_buf_len);
+
+		/**
+		 * Process a SET_STREAM_FORMAT response for the SET_STREAM_FORMAT command.
+		 */
+		virtual int proc_set_stream_format_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
+
+		/**
+		 * Process a GET_STREAM_FORMAT response for the GET_STREAM_FORMAT command.
+		 */
+		virtual int proc_get_stream_format_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
+
+		/**
+		 * Process a SET_STREAM_INFO response for the SET_STREAM_INFO command.
+		 */
+		virtual int proc_set_stream_info_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
+
+		/**
+		 * Process a GET_STREAM_INFO response for the GET_STREAM_INFO command.
+		 */
+		virtual int proc_get_stream_info_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
+
+		/**
+		 * Process a SET_SAMPLING_RATE response for the SET_SAMPLING_RATE command.
+		 */
+		virtual int proc_set_sampling_rate_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
+
+		/**
+		 * Process a GET_SAMPLING_RATE response for the GET_SAMPLING_RATE command.
+		 */
+		virtual int proc_get_sampling_rate_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
+
+		/**
+		 * Process a SET_CLOCK_SOURCE response for the SET_CLOCK_SOURCE command.
+		 */
+		virtual int proc_set_clock_source_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
+
+		/**
+		 * Process a GET_CLOCK_SOURCE response for the GET_CLOCK_SOURCE command.
+		 */
+		virtual int proc_get_clock_source_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
+
+		/**
+		 * Process a START_STREAMING response for the START_STREAMING command.
+		 */
+		virtual int proc_start_streaming_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
+
+		/**
+		 * Process a STOP_STREAMING response for the STOP_STREAMING command.
+		 */
+		virtual int proc_stop_streaming_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
 	};
 }
 
@@ -28,22 +28,31 @@
  */
 
 #include <vector>
+#include "net_interface_imp.h"
 #include "enumeration.h"
 #include "notification.h"
 #include "log.h"
 #include "util.h"
 #include "adp.h"
 #include "aecp.h"
+#include "aem_string.h"
 #include "aem_controller_state_machine.h"
-#include "system_tx_queue.h"
+#include "controller_context.h"
+#include "resp_dispatch_table.h"
 #include "end_station_imp.h"
+#include "engine_shard.h"
 
 namespace avdecc_lib
 {
-	end_station_imp::end_station_imp() {}
+	end_station_imp::end_station_imp()
+	{
+		context = NULL;
+		timer_wheel::init_entry(&departed_timer, departed_timeout, this);
+	}
 
-	end_station_imp::end_station_imp(uint8_t *frame, size_t mem_buf_len)
+	end_station_imp::end_station_imp(controller_context *context, uint8_t *frame, size_t mem_buf_len)
 	{
+		this->context = context;
 		end_station_connection_status = ' ';
 		current_entity_desc = 0;
 		current_config_desc = 0;
@@ -52,7 +61,10 @@ namespace avdecc_lib
 		desc_count_from_config = 0;
 		desc_count_index_from_config = 0;
 		read_top_level_desc_in_config_state = READ_TOP_LEVEL_DESC_IN_CONFIG_IDLE;
-		adp_ref = new adp(frame, mem_buf_len);
+		timer_wheel::init_entry(&departed_timer, departed_timeout, this);
+		pending_desc_decode_count = 0;
+		retired_slot_index = 0;
+		adp_ref = new adp(context, frame, mem_buf_len);
 		end_station_guid = adp_ref->get_entity_entity_id();
 		convert_eui48_to_uint64(adp_ref->get_src_addr().value, end_station_mac);
 		end_station_init();
@@ -60,6 +72,7 @@ namespace avdecc_lib
 
 	end_station_imp::~end_station_imp()
 	{
+		context->timer_wheel_ref->cancel(&departed_timer);
 		delete adp_ref;
 
 		for(uint32_t entity_vec_index = 0; entity_vec_index < entity_desc_vec.size(); entity_vec_index++)
@@ -86,16 +99,49 @@ namespace avdecc_lib
 	void end_station_imp::set_connected()
 	{
 		end_station_connection_status = 'C';
+		context->timer_wheel_ref->cancel(&departed_timer);
 	}
 
 	void end_station_imp::set_reconnected()
 	{
 		end_station_connection_status = 'R';
+		context->timer_wheel_ref->cancel(&departed_timer);
 	}
 
 	void end_station_imp::set_disconnected()
 	{
 		end_station_connection_status = 'D';
+		context->timer_wheel_ref->arm(&departed_timer, END_STATION_DEPARTED_TIMEOUT);
+	}
+
+	void end_station_imp::set_retired(uint32_t slot_index)
+	{
+		retired_slot_index = slot_index;
+		timer_wheel::init_entry(&departed_timer, retired_timeout, this);
+		context->timer_wheel_ref->arm(&departed_timer, END_STATION_RETIRED_GRACE_PERIOD);
+	}
+
+	void end_station_imp::departed_timeout(void *end_station)
+	{
+		end_station_imp *departed_end_station = (end_station_imp *)end_station;
+
+		/**
+		 * A decode thread may still be building a descriptor of the End Station, so it is kept until its descriptors are stored.
+		 */
+		if(departed_end_station->pending_desc_decode_count > 0)
+		{
+			departed_end_station->context->timer_wheel_ref->arm(&departed_end_station->departed_timer, END_STATION_DEPARTED_TIMEOUT);
+			return;
+		}
+
+		departed_end_station->context->engine_shard_ref->retire_end_station(departed_end_station);
+	}
+
+	void end_station_imp::retired_timeout(void *end_station)
+	{
+		end_station_imp *retired_end_station = (end_station_imp *)end_station;
+
+		retired_end_station->context->engine_shard_ref->release_end_station(retired_end_station->retired_slot_index);
 	}
 
 	uint64_t STDCALL end_station_imp::get_end_station_guid()
@@ -108,6 +154,11 @@ namespace avdecc_lib
 		return end_station_mac;
 	}
 
+	void STDCALL end_station_imp::get_rto_stats(uint32_t &srtt_us, uint32_t &rttvar_us, uint32_t &rto_ms, uint32_t &timeout_count, uint32_t &in_progress_count)
+	{
+		context->aem_controller_state_machine_ref->get_rto_stats(end_station_guid, srtt_us, rttvar_us, rto_ms, timeout_count, in_progress_count);
+	}
+
 	adp * end_station_imp::get_adp()
 	{
 		return adp_ref;
@@ -135,10 +186,9 @@ namespace avdecc_lib
 
 	int end_station_imp::send_read_desc_cmd_with_flag(void *notification_id, uint32_t notification_flag, uint16_t desc_type, uint16_t desc_index)
 	{
-		struct jdksavdecc_frame *ether_frame;
+		struct system_tx_slot tx_slot;
 		struct jdksavdecc_aem_command_read_descriptor aem_command_read_desc;
 		int aem_command_read_desc_returned;
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
 
 		/***************************** AECP Common Data ****************************/
 		aem_command_read_desc.controller_entity_id = adp_ref->get_controller_guid();
@@ -152,49 +202,41 @@ namespace avdecc_lib
 		aem_command_read_desc.descriptor_index = desc_index;
 
 		/******************************* Fill frame payload with AECP data and send the frame ****************************/
-		aecp::ether_frame_init(this, ether_frame);
+		if(system_queue_tx_reserve(context, tx_slot) < 0)
+		{
+			return -1;
+		}
+
+		aecp::ether_frame_init(this, tx_slot.frame);
 		aem_command_read_desc_returned = jdksavdecc_aem_command_read_descriptor_write(&aem_command_read_desc,
-		                                                                              ether_frame->payload,
+		                                                                              tx_slot.frame,
 		                                                                              aecp::CMD_POS,
-		                                                                              sizeof(ether_frame->payload));
+		                                                                              tx_slot.frame_size);
 
 		if(aem_command_read_desc_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_read_desc_write error");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_read_desc_write error");
 			assert(aem_command_read_desc_returned >= 0);
+			system_queue_tx_abort(context, tx_slot);
 			return -1;
 		}
 
-		aecp::common_hdr_init(ether_frame, end_station_guid);
-		system_queue_tx(notification_id, notification_flag, ether_frame->payload, ether_frame->length);
+		aecp::common_hdr_init(this, tx_slot.frame, tx_slot.frame_size);
+		system_queue_tx_commit(context, tx_slot, notification_id, notification_flag, AECP_FRAME_LEN);
 
-		free(ether_frame);
 		return 0;
 	}
 
-	int end_station_imp::proc_read_desc_resp(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status)
+	int end_station_imp::proc_read_desc_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
 	{
-		struct jdksavdecc_frame *ether_frame;
+		const uint8_t *frame = rx_frame.frame();
+		uint16_t mem_buf_len = rx_frame.length();
 		struct jdksavdecc_aem_command_read_descriptor_response aem_cmd_read_desc_resp;
 		int aem_cmd_read_desc_resp_returned;
-		uint32_t msg_type;
-		bool u_field;
 		uint16_t desc_type;
 		uint16_t desc_index;
-		configuration_descriptor_imp *config_desc_imp_ref = NULL;
-
-		if(entity_desc_vec.size() >= 1 && entity_desc_vec.at(current_entity_desc)->get_config_desc_count() >= 1)
-		{
-			config_desc_imp_ref = dynamic_cast<configuration_descriptor_imp *>(entity_desc_vec.at(current_entity_desc)->get_config_desc_by_index(current_config_desc));
+		resp_dispatch_table::decode_desc_handler decode_handler;
 
-			if(!config_desc_imp_ref)
-			{
-				avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Dynamic cast from base configuration_descriptor to derived configuration_descriptor_imp error");
-			}
-		}
-
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
-		memcpy(ether_frame->payload, frame, mem_buf_len);
 		aem_cmd_read_desc_resp_returned = jdksavdecc_aem_command_read_descriptor_response_read(&aem_cmd_read_desc_resp,
 		                                                                                       frame,
 		                                                                                       adp::ETHER_HDR_SIZE,
@@ -202,126 +244,97 @@ namespace avdecc_lib
 
 		if(aem_cmd_read_desc_resp_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_read_desc_res_read error");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_read_desc_res_read error");
 			assert(aem_cmd_read_desc_resp_returned >= 0);
 			return -1;
 		}
 
-		msg_type = aem_cmd_read_desc_resp.aem_header.aecpdu_header.header.message_type;
-		status = aem_cmd_read_desc_resp.aem_header.aecpdu_header.header.status;
-		u_field = aem_cmd_read_desc_resp.command_type >> 15 & 0x01; // u_field = the msb of the uint16_t command_type
+		status = rx_frame.status();
 		desc_type = jdksavdecc_uint16_get(frame, adp::ETHER_HDR_SIZE + JDKSAVDECC_AEM_COMMAND_READ_DESCRIPTOR_RESPONSE_OFFSET_DESCRIPTOR);
 		desc_index = jdksavdecc_uint16_get(frame, adp::ETHER_HDR_SIZE + JDKSAVDECC_AEM_COMMAND_READ_DESCRIPTOR_RESPONSE_OFFSET_DESCRIPTOR + 2);
 
-		aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, msg_type, u_field, ether_frame);
+		context->aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, rx_frame);
+		decode_handler = context->resp_dispatch_table_ref->find_decode_desc_handler(desc_type);
+
+		/**
+		 * The descriptors read by the enumeration are decoded by the decode pool if there is one, so the engine thread
+		 * only matches their responses. Those read by the application are decoded at once, so that they are stored
+		 * before the application is notified.
+		 */
+		if((notification_flag == avdecc_lib::CMD_WITHOUT_NOTIFICATION) && decode_handler &&
+		   (context->engine_shard_ref->queue_desc_decode(this, desc_type, frame, mem_buf_len) == 0))
+		{
+			pending_desc_decode_count++;
+			return 0;
+		}
+
+		store_decoded_desc(desc_type, decode_handler ? decode_handler(this, frame, aecp::READ_DESC_POS, mem_buf_len) : NULL);
+
+		return 0;
+	}
+
+	void end_station_imp::proc_decoded_desc(uint16_t desc_type, descriptor_base_imp *desc)
+	{
+		pending_desc_decode_count--;
+		store_decoded_desc(desc_type, desc);
+	}
+
+	void end_station_imp::store_decoded_desc(uint16_t desc_type, descriptor_base_imp *desc)
+	{
+		configuration_descriptor_imp *config_desc_imp_ref = get_current_config_desc_imp();
 
 		/******************* Select the corresponding descriptor based on the descriptor type from the response packet received ******************/
 		switch(desc_type)
 		{
 			case JDKSAVDECC_DESCRIPTOR_ENTITY:
-				if(entity_desc_vec.size() == 0)
+				if(entity_desc_vec.size() == 0 && desc)
 				{
-					entity_desc_vec.push_back(new entity_descriptor_imp(this, frame, aecp::READ_DESC_POS, mem_buf_len));
+					entity_desc_vec.push_back(dynamic_cast<entity_descriptor_imp *>(desc));
 					current_config_desc = entity_desc_vec.at(entity_desc_vec.size() - 1)->get_current_configuration();
 					uint16_t desc_type = JDKSAVDECC_DESCRIPTOR_CONFIGURATION;
 					uint16_t desc_index = 0x0;
 					read_desc_init(desc_type, desc_index);
 				}
-
-				break;
-
-			case JDKSAVDECC_DESCRIPTOR_CONFIGURATION:
-				if(entity_desc_vec.size() == 1 && entity_desc_vec.at(current_entity_desc)->get_config_desc_count() == 0)
-				{
-					entity_desc_vec.at(current_entity_desc)->store_config_desc(this, frame, aecp::READ_DESC_POS, mem_buf_len);
-					read_top_level_desc_in_config_state = READ_TOP_LEVEL_DESC_IN_CONFIG_STARTING;
-				}
-
-				break;
-
-			case JDKSAVDECC_DESCRIPTOR_AUDIO_UNIT:
-				if(entity_desc_vec.size() == 1 && entity_desc_vec.at(current_entity_desc)->get_config_desc_count() >= 1)
-				{
-					config_desc_imp_ref->store_audio_unit_desc(this, frame, aecp::READ_DESC_POS, mem_buf_len);
-				}
-
-				break;
-
-			case JDKSAVDECC_DESCRIPTOR_STREAM_INPUT:
-				if(entity_desc_vec.size() == 1 && entity_desc_vec.at(current_entity_desc)->get_config_desc_count() >= 1)
-				{
-					config_desc_imp_ref->store_stream_input_desc(this, frame, aecp::READ_DESC_POS, mem_buf_len);
-				}
-
-				break;
-
-			case JDKSAVDECC_DESCRIPTOR_STREAM_OUTPUT:
-				if(entity_desc_vec.size() == 1 && entity_desc_vec.at(current_entity_desc)->get_config_desc_count() >= 1)
-				{
-					config_desc_imp_ref->store_stream_output_desc(this, frame, aecp::READ_DESC_POS, mem_buf_len);
-				}
-
-				break;
-
-			case JDKSAVDECC_DESCRIPTOR_JACK_INPUT:
-				if(entity_desc_vec.size() == 1 && entity_desc_vec.at(current_entity_desc)->get_config_desc_count() >= 1)
-				{
-					config_desc_imp_ref->store_jack_input_desc(this, frame, aecp::READ_DESC_POS, mem_buf_len);
-				}
-
-				break;
-
-			case JDKSAVDECC_DESCRIPTOR_JACK_OUTPUT:
-				if(entity_desc_vec.size() == 1 && entity_desc_vec.at(current_entity_desc)->get_config_desc_count() >= 1)
-				{
-					config_desc_imp_ref->store_jack_output_desc(this, frame, aecp::READ_DESC_POS, mem_buf_len);
-				}
-
-				break;
-
-			case JDKSAVDECC_DESCRIPTOR_AVB_INTERFACE:
-				if(entity_desc_vec.size() == 1 && entity_desc_vec.at(current_entity_desc)->get_config_desc_count() >= 1)
+				else
 				{
-					config_desc_imp_ref->store_avb_interface_desc(this, frame, aecp::READ_DESC_POS, mem_buf_len);
+					delete desc;
 				}
 
 				break;
 
-			case JDKSAVDECC_DESCRIPTOR_CLOCK_SOURCE:
-				if(entity_desc_vec.size() == 1 && entity_desc_vec.at(current_entity_desc)->get_config_desc_count() >= 1)
+			case JDKSAVDECC_DESCRIPTOR_CONFIGURATION:
+				if(entity_desc_vec.size() == 1 && entity_desc_vec.at(current_entity_desc)->get_config_desc_count() == 0 && desc)
 				{
-					config_desc_imp_ref->store_clock_source_desc(this, frame, aecp::READ_DESC_POS, mem_buf_len);
+					entity_desc_vec.at(current_entity_desc)->store_config_desc(dynamic_cast<configuration_descriptor_imp *>(desc));
+					read_top_level_desc_in_config_state = READ_TOP_LEVEL_DESC_IN_CONFIG_STARTING;
 				}
-
-				break;
-
-			case JDKSAVDECC_DESCRIPTOR_LOCALE:
-				if(entity_desc_vec.size() == 1 && entity_desc_vec.at(current_entity_desc)->get_config_desc_count() >= 1)
+				else
 				{
-					config_desc_imp_ref->store_locale_desc(this, frame, aecp::READ_DESC_POS, mem_buf_len);
+					delete desc;
 				}
 
 				break;
 
-			case JDKSAVDECC_DESCRIPTOR_STRINGS:
-				if(entity_desc_vec.size() == 1 && entity_desc_vec.at(current_entity_desc)->get_config_desc_count() >= 1)
+			default:
 				{
-					config_desc_imp_ref->store_strings_desc(this, frame, aecp::READ_DESC_POS, mem_buf_len);
-				}
+					resp_dispatch_table::store_desc_handler store_handler = context->resp_dispatch_table_ref->find_store_desc_handler(desc_type);
 
-				break;
-
-			case JDKSAVDECC_DESCRIPTOR_CLOCK_DOMAIN:
-				if(entity_desc_vec.size() == 1 && entity_desc_vec.at(current_entity_desc)->get_config_desc_count() >= 1)
-				{
-					config_desc_imp_ref->store_clock_domain_desc(this, frame, aecp::READ_DESC_POS, mem_buf_len);
+					if(!store_handler)
+					{
+						context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG, "Descriptor type is not implemented.");
+						delete desc;
+					}
+					else if(entity_desc_vec.size() == 1 && config_desc_imp_ref && desc)
+					{
+						(config_desc_imp_ref->*store_handler)(desc);
+					}
+					else
+					{
+						delete desc;
+					}
 				}
 
 				break;
-
-			default:
-				avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG, "Descriptor type is not implemented.");
-				break;
 		}
 
 		/*
@@ -383,323 +396,65 @@ namespace avdecc_lib
 			case READ_TOP_LEVEL_DESC_IN_CONFIG_DONE:
 				break;
 		}
-
-		free(ether_frame);
-		return 0;
 	}
 
-	int end_station_imp::proc_rcvd_resp(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status)
+	int end_station_imp::proc_rcvd_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
 	{
-		uint16_t cmd_type;
+		uint16_t cmd_type = rx_frame.cmd_type();
 		uint16_t desc_type;
 		uint16_t desc_index;
-		cmd_type = jdksavdecc_uint16_get(frame, aecp::CMD_TYPE_POS);
+		resp_dispatch_table::resp_handler resp_handler;
+		configuration_descriptor_imp *config_desc_imp_ref;
+		descriptor_base_imp *desc_imp_ref = NULL;
 
-		switch(cmd_type)
+		if(cmd_type == JDKSAVDECC_AEM_COMMAND_READ_DESCRIPTOR)
 		{
-			case JDKSAVDECC_AEM_COMMAND_ACQUIRE_ENTITY:
-
-				/**
-				 * TODO - P1
-				 *
-				 * Add implementation for ACQUIRE_ENTITY command.
-				 */
-
-				break;
-
-			case JDKSAVDECC_AEM_COMMAND_LOCK_ENTITY:
-
-				/**
-				 * TODO - P1
-				 *
-				 * Add implementation for LOCK_ENTITY command.
-				 */
-
-				break;
-
-			case JDKSAVDECC_AEM_COMMAND_ENTITY_AVAILABLE:
-
-				/**
-				 * TODO - Add implementation for ENTITY_AVAILABLE command.
-				 */
-
-				break;
-
-			case JDKSAVDECC_AEM_COMMAND_CONTROLLER_AVAILABLE:
-
-				/**
-				 * TODO - Add implementation for CONTROLLER_AVAILABLE command.
-				 */
-
-				break;
-
-			case JDKSAVDECC_AEM_COMMAND_READ_DESCRIPTOR:
-				proc_read_desc_resp(notification_id, notification_flag, frame, mem_buf_len, status);
-				break;
-
-			case JDKSAVDECC_AEM_COMMAND_SET_STREAM_FORMAT:
-
-				/**
-				 * TODO - Add implementation for SET_STREAM_FORMAT command.
-				 */
-
-				break;
-
-			case JDKSAVDECC_AEM_COMMAND_GET_STREAM_FORMAT:
-				desc_type = jdksavdecc_uint16_get(frame, adp::ETHER_HDR_SIZE + JDKSAVDECC_AEM_COMMAND_GET_STREAM_INFO_RESPONSE_OFFSET_DESCRIPTOR_TYPE);
-				desc_index = jdksavdecc_uint16_get(frame, adp::ETHER_HDR_SIZE + JDKSAVDECC_AEM_COMMAND_GET_STREAM_FORMAT_RESPONSE_OFFSET_DESCRIPTOR_INDEX);
-
-				if(desc_type == JDKSAVDECC_DESCRIPTOR_STREAM_INPUT)
-				{
-					stream_input_descriptor_imp *stream_input_desc_imp_ref;
-					stream_input_desc_imp_ref = dynamic_cast<stream_input_descriptor_imp *>(entity_desc_vec.at(current_entity_desc)->get_config_desc_by_index(current_config_desc)->get_stream_input_desc_by_index(desc_index));
-
-					if(stream_input_desc_imp_ref)
-					{
-						stream_input_desc_imp_ref->proc_get_stream_format_resp(notification_id, notification_flag, frame, mem_buf_len, status);
-					}
-					else
-					{
-						avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Dynamic cast from base stream_input_descriptor to derived stream_input_descriptor_imp error");
-					}
-				}
-				else if(desc_type == JDKSAVDECC_DESCRIPTOR_STREAM_OUTPUT)
-				{
-					stream_output_descriptor_imp *stream_output_desc_imp_ref;
-					stream_output_desc_imp_ref = dynamic_cast<stream_output_descriptor_imp *>(entity_desc_vec.at(current_entity_desc)->get_config_desc_by_index(current_config_desc)->get_stream_output_desc_by_index(desc_index));
-
-					if(stream_output_desc_imp_ref)
-					{
-						stream_output_desc_imp_ref->proc_get_stream_format_resp(notification_id, notification_flag, frame, mem_buf_len, status);
-					}
-					else
-					{
-						avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Dynamic cast from base stream_output_descriptor_imp to derived stream_output_descriptor_imp error");
-					}
-				}
-
-				break;
-
-			case JDKSAVDECC_AEM_COMMAND_SET_STREAM_INFO:
-
-				/**
-				 * TODO - Add implementation for SET_STREAM_INFO command.
-				 */
-
-				break;
-
-			case JDKSAVDECC_AEM_COMMAND_GET_STREAM_INFO:
-				desc_type = jdksavdecc_uint16_get(frame, adp::ETHER_HDR_SIZE + JDKSAVDECC_AEM_COMMAND_GET_STREAM_INFO_RESPONSE_OFFSET_DESCRIPTOR_TYPE);
-				desc_index = jdksavdecc_uint16_get(frame, adp::ETHER_HDR_SIZE + JDKSAVDECC_AEM_COMMAND_GET_STREAM_INFO_RESPONSE_OFFSET_DESCRIPTOR_INDEX);
-
-				if(desc_type == JDKSAVDECC_DESCRIPTOR_STREAM_INPUT)
-				{
-					stream_input_descriptor_imp *stream_input_desc_imp_ref;
-					stream_input_desc_imp_ref = dynamic_cast<stream_input_descriptor_imp *>(entity_desc_vec.at(current_entity_desc)->get_config_desc_by_index(current_config_desc)->get_stream_input_desc_by_index(desc_index));
-
-					if(stream_input_desc_imp_ref)
-					{
-						stream_input_desc_imp_ref->proc_get_stream_info_resp(notification_id, notification_flag, frame, mem_buf_len, status);
-					}
-					else
-					{
-						avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Dynamic cast from derived stream_input_descriptor_imp to base stream_input_descriptor error");
-					}
-				}
-				else if(desc_type == JDKSAVDECC_DESCRIPTOR_STREAM_OUTPUT)
-				{
-					stream_output_descriptor_imp *stream_output_desc_imp_ref;
-					stream_output_desc_imp_ref = dynamic_cast<stream_output_descriptor_imp *>(entity_desc_vec.at(current_entity_desc)->get_config_desc_by_index(current_config_desc)->get_stream_output_desc_by_index(desc_index));
-
-					if(stream_output_desc_imp_ref)
-					{
-						stream_output_desc_imp_ref->proc_get_stream_info_resp(notification_id, notification_flag, frame, mem_buf_len, status);
-					}
-					else
-					{
-						avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Dynamic cast from derived stream_output_descriptor_imp to base stream_output_descriptor error");
-					}
-				}
-
-				break;
-
-			case JDKSAVDECC_AEM_COMMAND_SET_NAME:
-
-				/**
-				 * TODO - Add implementation for SET_NAME command.
-				 */
-
-				break;
-
-			case JDKSAVDECC_AEM_COMMAND_GET_NAME:
-
-				/**
-				 * TODO - Add implementation for GET_NAME command.
-				 */
-
-				break;
-
-			case JDKSAVDECC_AEM_COMMAND_SET_SAMPLING_RATE:
-				{
-					desc_type = jdksavdecc_uint16_get(frame, adp::ETHER_HDR_SIZE + JDKSAVDECC_AEM_COMMAND_SET_SAMPLING_RATE_RESPONSE_OFFSET_DESCRIPTOR_TYPE);
-					desc_index = jdksavdecc_uint16_get(frame, adp::ETHER_HDR_SIZE + JDKSAVDECC_AEM_COMMAND_SET_SAMPLING_RATE_RESPONSE_OFFSET_DESCRIPTOR_INDEX);
-
-					if(desc_type == JDKSAVDECC_DESCRIPTOR_AUDIO_UNIT)
-					{
-						audio_unit_descriptor_imp *audio_unit_desc_imp_ref;
-						audio_unit_desc_imp_ref = dynamic_cast<audio_unit_descriptor_imp *>(entity_desc_vec.at(current_entity_desc)->get_config_desc_by_index(current_config_desc)->get_audio_unit_desc_by_index(desc_index));
-
-						if(audio_unit_desc_imp_ref)
-						{
-							audio_unit_desc_imp_ref->proc_set_sampling_rate_resp(notification_id, notification_flag, frame, mem_buf_len, status);
-						}
-						else
-						{
-							avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Dynamic cast from base audio_unit_descriptor to derived audio_unit_descriptor_imp error");
-						}
-
-					}
-				}
-				break;
-
-			case JDKSAVDECC_AEM_COMMAND_GET_SAMPLING_RATE:
-				{
-					desc_type = jdksavdecc_uint16_get(frame, adp::ETHER_HDR_SIZE + JDKSAVDECC_AEM_COMMAND_GET_SAMPLING_RATE_RESPONSE_OFFSET_DESCRIPTOR_TYPE);
-					desc_index = jdksavdecc_uint16_get(frame, adp::ETHER_HDR_SIZE + JDKSAVDECC_AEM_COMMAND_GET_SAMPLING_RATE_RESPONSE_OFFSET_DESCRIPTOR_INDEX);
-
-					if(desc_type == JDKSAVDECC_DESCRIPTOR_AUDIO_UNIT)
-					{
-						audio_unit_descriptor_imp *audio_unit_desc_imp_ref;
-						audio_unit_desc_imp_ref = dynamic_cast<audio_unit_descriptor_imp *>(entity_desc_vec.at(current_entity_desc)->get_config_desc_by_index(current_config_desc)->get_audio_unit_desc_by_index(desc_index));
-
-						if(audio_unit_desc_imp_ref)
-						{
-							audio_unit_desc_imp_ref->proc_get_sampling_rate_resp(notification_id, notification_flag, frame, mem_buf_len, status);
-						}
-						else
-						{
-							avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Dynamic cast from base audio_unit_descriptor to derived audio_unit_descriptor_imp error");
-						}
-
-					}
-				}
-				break;
-
-			case JDKSAVDECC_AEM_COMMAND_SET_CLOCK_SOURCE:
-				{
-					desc_type = jdksavdecc_uint16_get(frame, adp::ETHER_HDR_SIZE + JDKSAVDECC_AEM_COMMAND_SET_CLOCK_SOURCE_RESPONSE_OFFSET_DESCRIPTOR_TYPE);
-					desc_index = jdksavdecc_uint16_get(frame, adp::ETHER_HDR_SIZE + JDKSAVDECC_AEM_COMMAND_SET_CLOCK_SOURCE_RESPONSE_OFFSET_DESCRIPTOR_INDEX);
-
-					clock_domain_descriptor_imp *clock_domain_desc_imp_ref;
-					clock_domain_desc_imp_ref = dynamic_cast<clock_domain_descriptor_imp *>(entity_desc_vec.at(current_entity_desc)->get_config_desc_by_index(current_config_desc)->get_clock_domain_desc_by_index(desc_index));
-
-					if(clock_domain_desc_imp_ref)
-					{
-						clock_domain_desc_imp_ref->proc_set_clock_source_resp(notification_id, notification_flag, frame, mem_buf_len, status);
-					}
-					else
-					{
-						avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Dynamic cast from base clock_domain_descriptor to derived clock_domain_descriptor_imp error");
-					}
-				}
-				break;
-
-			case JDKSAVDECC_AEM_COMMAND_GET_CLOCK_SOURCE:
-				{
-					desc_type = jdksavdecc_uint16_get(frame, adp::ETHER_HDR_SIZE + JDKSAVDECC_AEM_COMMAND_GET_CLOCK_SOURCE_RESPONSE_OFFSET_DESCRIPTOR_TYPE);
-					desc_index = jdksavdecc_uint16_get(frame, adp::ETHER_HDR_SIZE + JDKSAVDECC_AEM_COMMAND_GET_CLOCK_SOURCE_RESPONSE_OFFSET_DESCRIPTOR_INDEX);
-
-					clock_domain_descriptor_imp *clock_domain_desc_imp_ref;
-					clock_domain_desc_imp_ref = dynamic_cast<clock_domain_descriptor_imp *>(entity_desc_vec.at(current_entity_desc)->get_config_desc_by_index(current_config_desc)->get_clock_domain_desc_by_index(desc_index));
-
-					if(clock_domain_desc_imp_ref)
-					{
-						clock_domain_desc_imp_ref->proc_get_clock_source_resp(notification_id, notification_flag, frame, mem_buf_len, status);
-					}
-					else
-					{
-						avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Dynamic cast from base clock_domain_descriptor to derived clock_domain_descriptor_imp error");
-					}
-				}
-				break;
-
-			case JDKSAVDECC_AEM_COMMAND_START_STREAMING:
-				{
-					desc_type = jdksavdecc_uint16_get(frame, adp::ETHER_HDR_SIZE + JDKSAVDECC_AEM_COMMAND_START_STREAMING_RESPONSE_OFFSET_DESCRIPTOR_TYPE);
-					desc_index = jdksavdecc_uint16_get(frame, adp::ETHER_HDR_SIZE + JDKSAVDECC_AEM_COMMAND_START_STREAMING_RESPONSE_OFFSET_DESCRIPTOR_INDEX);
-
-					if(desc_type == JDKSAVDECC_DESCRIPTOR_STREAM_INPUT)
-					{
-						stream_input_descriptor_imp *stream_input_desc_imp_ref;
-						stream_input_desc_imp_ref = dynamic_cast<stream_input_descriptor_imp *>(entity_desc_vec.at(current_entity_desc)->get_config_desc_by_index(current_config_desc)->get_stream_input_desc_by_index(desc_index));
+			return proc_read_desc_resp(notification_id, notification_flag, rx_frame, status);
+		}
 
-						if(stream_input_desc_imp_ref)
-						{
-							stream_input_desc_imp_ref->proc_start_streaming_resp(notification_id, notification_flag, frame, mem_buf_len, status);
-						}
-						else
-						{
-							avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Dynamic cast from derived stream_input_descriptor_imp to base stream_input_descriptor error");
-						}
-					}
-					else if(desc_type == JDKSAVDECC_DESCRIPTOR_STREAM_OUTPUT)
-					{
-						stream_output_descriptor_imp *stream_output_desc_imp_ref;
-						stream_output_desc_imp_ref = dynamic_cast<stream_output_descriptor_imp *>(entity_desc_vec.at(current_entity_desc)->get_config_desc_by_index(current_config_desc)->get_stream_output_desc_by_index(desc_index));
+		if(rx_frame.length() < aecp::DESC_INDEX_POS + 2)
+		{
+			context->notification_ref->notifying(avdecc_lib::NO_MATCH_FOUND, 0, cmd_type, 0, 0, 0);
+			return -1;
+		}
 
-						if(stream_output_desc_imp_ref)
-						{
-							stream_output_desc_imp_ref->proc_start_streaming_resp(notification_id, notification_flag, frame, mem_buf_len, status);
-						}
-						else
-						{
-							avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Dynamic cast from derived stream_output_descriptor_imp to base stream_output_descriptor error");
-						}
-					}
-				}
-				break;
+		/**
+		 * The handler of the response and the descriptor it is for are found by command type and descriptor type.
+		 */
+		desc_type = jdksavdecc_uint16_get(rx_frame.frame(), aecp::DESC_TYPE_POS);
+		desc_index = jdksavdecc_uint16_get(rx_frame.frame(), aecp::DESC_INDEX_POS);
+		resp_handler = context->resp_dispatch_table_ref->find_resp_handler(cmd_type, desc_type);
 
-			case JDKSAVDECC_AEM_COMMAND_STOP_STREAMING:
-				{
-					desc_type = jdksavdecc_uint16_get(frame, adp::ETHER_HDR_SIZE + JDKSAVDECC_AEM_COMMAND_STOP_STREAMING_RESPONSE_OFFSET_DESCRIPTOR_TYPE);
-					desc_index = jdksavdecc_uint16_get(frame, adp::ETHER_HDR_SIZE + JDKSAVDECC_AEM_COMMAND_STOP_STREAMING_RESPONSE_OFFSET_DESCRIPTOR_INDEX);
+		if(!resp_handler)
+		{
+			context->notification_ref->notifying(avdecc_lib::NO_MATCH_FOUND, 0, cmd_type, 0, 0, 0);
+			return -1;
+		}
 
-					if(desc_type == JDKSAVDECC_DESCRIPTOR_STREAM_INPUT)
-					{
-						stream_input_descriptor_imp *stream_input_desc_imp_ref;
-						stream_input_desc_imp_ref = dynamic_cast<stream_input_descriptor_imp *>(entity_desc_vec.at(current_entity_desc)->get_config_desc_by_index(current_config_desc)->get_stream_input_desc_by_index(desc_index));
+		config_desc_imp_ref = get_current_config_desc_imp();
+		if(config_desc_imp_ref)
+		{
+			desc_imp_ref = config_desc_imp_ref->get_desc_imp(desc_type, desc_index);
+		}
 
-						if(stream_input_desc_imp_ref)
-						{
-							stream_input_desc_imp_ref->proc_stop_streaming_resp(notification_id, notification_flag, frame, mem_buf_len, status);
-						}
-						else
-						{
-							avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Dynamic cast from derived stream_input_descriptor_imp to base stream_input_descriptor error");
-						}
-					}
-					else if(desc_type == JDKSAVDECC_DESCRIPTOR_STREAM_OUTPUT)
-					{
-						stream_output_descriptor_imp *stream_output_desc_imp_ref;
-						stream_output_desc_imp_ref = dynamic_cast<stream_output_descriptor_imp *>(entity_desc_vec.at(current_entity_desc)->get_config_desc_by_index(current_config_desc)->get_stream_output_desc_by_index(desc_index));
+		if(!desc_imp_ref)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "No %s descriptor %d for the %s response",
+			                          avdecc_lib::aem_string::desc_value_to_name(desc_type), desc_index,
+			                          avdecc_lib::aem_string::cmd_value_to_name(cmd_type));
+			return -1;
+		}
 
-						if(stream_output_desc_imp_ref)
-						{
-							stream_output_desc_imp_ref->proc_stop_streaming_resp(notification_id, notification_flag, frame, mem_buf_len, status);
-						}
-						else
-						{
-							avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Dynamic cast from derived stream_output_descriptor_imp to base stream_output_descriptor error");
-						}
-					}
-				}
-				break;
+		return (desc_imp_ref->*resp_handler)(notification_id, notification_flag, rx_frame, status);
+	}
 
-			default:
-				avdecc_lib::notification_ref->notifying(avdecc_lib::NO_MATCH_FOUND, 0, cmd_type, 0, 0, 0);
-				break;
+	configuration_descriptor_imp * end_station_imp::get_current_config_desc_imp()
+	{
+		if(current_entity_desc < entity_desc_vec.size())
+		{
+			return entity_desc_vec[current_entity_desc]->get_config_desc_imp_by_index(current_config_desc);
 		}
 
-		return 0;
+		return NULL;
 	}
 }
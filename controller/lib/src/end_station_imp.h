@@ -31,16 +31,23 @@
 #ifndef _AVDECC_CONTROLLER_LIB_END_STATION_IMP_H_
 #define _AVDECC_CONTROLLER_LIB_END_STATION_IMP_H_
 
+#include "timer_wheel.h"
+#include "frame_view.h"
 #include "entity_descriptor_imp.h"
 #include "end_station.h"
 
+#define END_STATION_DEPARTED_TIMEOUT 60000 // A disconnected End Station is retired once it has been disconnected this long
+#define END_STATION_RETIRED_GRACE_PERIOD 60000 // A retired End Station is deleted, and its slot reused, once it has been retired this long
+
 namespace avdecc_lib
 {
 	class adp;
+	class controller_context;
 
 	class end_station_imp : public virtual avdecc_lib::end_station
 	{
 	private:
+		controller_context *context; // The Controller the End Station was discovered by
 		uint64_t end_station_guid; // The unique identifier of the AVDECC Entity the command is targeted to
 		uint64_t end_station_mac; // The source MAC address of the End Station
 		char end_station_connection_status; // The connection status of an End Station
@@ -62,6 +69,9 @@ namespace avdecc_lib
 		uint16_t desc_count_from_config; // The top level descriptor count present in the Configuration Descriptor
 		uint16_t desc_count_index_from_config; // The top level descriptor count index present in the Configuration Descriptor
 
+		timer_wheel::entry departed_timer; // Armed while the End Station is disconnected, then for the grace period once it is retired
+		uint32_t pending_desc_decode_count; // The READ_DESCRIPTOR responses handed to the decode pool and not stored yet
+		uint32_t retired_slot_index; // The slot released once the grace period of the retired End Station ends
 		adp *adp_ref; // ADP associated with the End Station
 		std::vector<entity_descriptor_imp *> entity_desc_vec; // Store a list of Entity descriptor class objects
 
@@ -72,10 +82,10 @@ namespace avdecc_lib
 		end_station_imp();
 
 		/**
-		 * Constructor for end_station_imp used for constructing an object with network interface , Ethernet frame
-		 * and memory buffer length information.
+		 * Constructor for end_station_imp used for constructing an object with the Controller the End Station
+		 * was discovered by, Ethernet frame and memory buffer length information.
 		 */
-		end_station_imp(uint8_t *frame, size_t mem_buf_len);
+		end_station_imp(controller_context *context, uint8_t *frame, size_t mem_buf_len);
 
 		/**
 		 * Destructor for end_station_imp used for destroying objects
@@ -100,6 +110,28 @@ namespace avdecc_lib
 		 */
 		int send_read_desc_cmd_with_flag(void *notification_id, uint32_t notification_flag, uint16_t desc_type, uint16_t desc_index);
 
+		/**
+		 * Get the current Configuration descriptor of the current Entity descriptor, or NULL if it has not been read yet.
+		 */
+		configuration_descriptor_imp * get_current_config_desc_imp();
+
+		/**
+		 * Store a descriptor decoded from a READ_DESCRIPTOR response, deleting it if it is not needed, and read the
+		 * next descriptor of the enumeration.
+		 */
+		void store_decoded_desc(uint16_t desc_type, descriptor_base_imp *desc);
+
+		/**
+		 * Retire the End Station once it has been disconnected for END_STATION_DEPARTED_TIMEOUT, or later if the
+		 * decode pool still holds descriptors of the End Station.
+		 */
+		static void departed_timeout(void *end_station);
+
+		/**
+		 * Delete the End Station and release its slot once its grace period has ended.
+		 */
+		static void retired_timeout(void *end_station);
+
 	public:
 		/**
 		 * Get the status of the End Station connection.
@@ -121,6 +153,13 @@ namespace avdecc_lib
 		 */
 		void set_disconnected();
 
+		/**
+		 * Start the grace period of an End Station that has been retired from its slot, after which it is deleted
+		 * and the slot is released.
+		 */
+		void set_retired(uint32_t slot_index);
+
+
 		/**
 		 * Get the GUID of the End Station.
 		 */
@@ -131,6 +170,14 @@ namespace avdecc_lib
 		 */
 		uint64_t STDCALL get_end_station_mac();
 
+		/**
+		 * Get the context of the Controller the End Station was discovered by.
+		 */
+		inline controller_context * get_context()
+		{
+			return context;
+		}
+
 		/**
 		 * Get the ADP associated with the End Station.
 		 */
@@ -146,6 +193,11 @@ namespace avdecc_lib
 		 */
 		entity_descriptor * STDCALL get_entity_desc_by_index(uint32_t entity_desc_index);
 
+		/**
+		 * Get the statistics of the retransmission timeout of the commands sent to the End Station.
+		 */
+		void STDCALL get_rto_stats(uint32_t &srtt_us, uint32_t &rttvar_us, uint32_t &rto_ms, uint32_t &timeout_count, uint32_t &in_progress_count);
+
 		/**
 		 * Send a READ_DESCRIPTOR command with notification id to read a descriptor from an AVDECC Entity.
 		 */
@@ -154,12 +206,18 @@ namespace avdecc_lib
 		/**
 		 * Process a READ_DESCRIPTOR response for the READ_DESCRIPTOR command.
 		 */
-		int proc_read_desc_resp(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status);
+		int proc_read_desc_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
+
+		/**
+		 * Store a descriptor the decode pool has decoded from a READ_DESCRIPTOR response, or NULL if the response
+		 * could not be decoded.
+		 */
+		void proc_decoded_desc(uint16_t desc_type, descriptor_base_imp *desc);
 
 		/**
 		 * Process response received for the corresponding command.
 		 */
-		int proc_rcvd_resp(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status);
+		int proc_rcvd_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
 	};
 }
 
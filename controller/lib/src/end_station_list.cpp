@@ -0,0 +1,158 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * end_station_list.cpp
+ *
+ * End Station list implementation
+ */
+
+#include <stddef.h>
+#include "end_station_list.h"
+
+namespace avdecc_lib
+{
+	end_station_list::end_station_list()
+	{
+		for(uint32_t chunk_index = 0; chunk_index < END_STATION_LIST_CHUNK_COUNT; chunk_index++)
+		{
+			chunks[chunk_index] = NULL;
+		}
+
+		count = 0;
+		write_lock = 0;
+		change_seq = 0;
+	}
+
+	end_station_list::~end_station_list()
+	{
+		for(uint32_t chunk_index = 0; chunk_index < END_STATION_LIST_CHUNK_COUNT; chunk_index++)
+		{
+			delete[] chunks[chunk_index];
+		}
+	}
+
+	int end_station_list::append(uint32_t shard_index, uint64_t handle)
+	{
+		uint32_t list_index;
+
+		lock();
+		list_index = count;
+
+		if(list_index >= END_STATION_LIST_CHUNK_COUNT * END_STATION_LIST_CHUNK_SIZE)
+		{
+			unlock();
+			return -1;
+		}
+
+		if(list_index % END_STATION_LIST_CHUNK_SIZE == 0)
+		{
+			chunks[list_index / END_STATION_LIST_CHUNK_SIZE] = new struct list_entry[END_STATION_LIST_CHUNK_SIZE];
+		}
+
+		entry_at(list_index).handle = handle;
+		entry_at(list_index).shard_index = shard_index;
+
+		atomic_full_barrier(); // Publish the entry before the End Station count
+		count = list_index + 1;
+		unlock();
+
+		return 0;
+	}
+
+	void end_station_list::remove(uint32_t shard_index, uint64_t handle)
+	{
+		uint32_t list_index;
+		uint32_t list_count;
+
+		lock();
+		list_count = count;
+
+		for(list_index = 0; list_index < list_count; list_index++)
+		{
+			if((entry_at(list_index).shard_index == shard_index) && (entry_at(list_index).handle == handle))
+			{
+				break;
+			}
+		}
+
+		if(list_index < list_count)
+		{
+			change_seq++;
+			atomic_full_barrier();
+
+			for(; list_index + 1 < list_count; list_index++)
+			{
+				entry_at(list_index) = entry_at(list_index + 1);
+			}
+
+			count = list_count - 1;
+			atomic_full_barrier();
+			change_seq++;
+		}
+
+		unlock();
+	}
+
+	bool end_station_list::at(uint32_t list_index, uint32_t &shard_index, uint64_t &handle)
+	{
+		uint32_t seq;
+		bool is_found;
+
+		do
+		{
+			seq = change_seq & ~1u;
+			atomic_full_barrier();
+			is_found = list_index < size();
+
+			if(is_found)
+			{
+				handle = entry_at(list_index).handle;
+				shard_index = entry_at(list_index).shard_index;
+			}
+
+			atomic_full_barrier();
+		}
+		while(change_seq != seq);
+
+		return is_found;
+	}
+
+	void end_station_list::lock()
+	{
+		/**
+		 * The engine threads only change the list when End Stations are discovered or retired, so the lock is rarely
+		 * contended.
+		 */
+		while(atomic_cas_uint32(&write_lock, 0, 1) != 0)
+		{
+			continue;
+		}
+	}
+
+	void end_station_list::unlock()
+	{
+		atomic_full_barrier();
+		write_lock = 0;
+	}
+}
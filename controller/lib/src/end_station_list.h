@@ -0,0 +1,126 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * end_station_list.h
+ *
+ * End Station list class, which holds the End Stations of all the shards of a Controller in the order they were
+ * discovered, so that the index of an End Station does not depend on the shard it runs on. The engine threads append
+ * to the list in chunks that are never moved, while application threads read it. Discovering an End Station never
+ * changes the index of another one; only retiring an End Station moves the End Stations after it down by one.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_END_STATION_LIST_H_
+#define _AVDECC_CONTROLLER_LIB_END_STATION_LIST_H_
+
+#include <stdint.h>
+#include "atomic_ops.h"
+
+namespace avdecc_lib
+{
+	class end_station_list
+	{
+	public:
+		enum end_station_list_sizes
+		{
+		        END_STATION_LIST_CHUNK_SIZE = 1024,
+		        END_STATION_LIST_CHUNK_COUNT = 1024 // Enough for the End Stations of 64 full shards
+		};
+
+	private:
+		struct list_entry
+		{
+			uint64_t handle; // The handle of the End Station in its shard
+			uint32_t shard_index;
+		};
+
+		struct list_entry *chunks[END_STATION_LIST_CHUNK_COUNT];
+		volatile uint32_t count; // The number of End Stations, published once their entries are complete
+		volatile uint32_t write_lock; // Held by the engine thread changing the list
+		volatile uint32_t change_seq; // Odd while entries are being moved down, so that readers on other threads retry
+
+	public:
+		/**
+		 * An empty constructor for end_station_list
+		 */
+		end_station_list();
+
+		/**
+		 * Destructor for end_station_list used for destroying objects
+		 */
+		~end_station_list();
+
+		/**
+		 * Add an End Station of a shard at the end of the list. Called from the engine thread of the shard.
+		 *
+		 * \return 0 on success, -1 if the list is full.
+		 */
+		int append(uint32_t shard_index, uint64_t handle);
+
+		/**
+		 * Remove a retired End Station of a shard, moving the End Stations after it down by one. Called from the
+		 * engine thread of the shard.
+		 */
+		void remove(uint32_t shard_index, uint64_t handle);
+
+		/**
+		 * Get the number of End Stations. The End Stations below the count returned can be read from any thread.
+		 */
+		inline uint32_t size()
+		{
+			uint32_t published_count = count;
+
+			atomic_full_barrier(); // Read the entries only after the count they were published with
+			return published_count;
+		}
+
+		/**
+		 * Get the shard and the handle in the shard of the End Station at a position in the list.
+		 *
+		 * \return True if there is an End Station at the position.
+		 */
+		bool at(uint32_t list_index, uint32_t &shard_index, uint64_t &handle);
+
+	private:
+		/**
+		 * Get the entry at a position in the list.
+		 */
+		inline struct list_entry &entry_at(uint32_t list_index)
+		{
+			return chunks[list_index / END_STATION_LIST_CHUNK_SIZE][list_index % END_STATION_LIST_CHUNK_SIZE];
+		}
+
+		/**
+		 * Take the write lock, which is only held briefly by an engine thread changing the list.
+		 */
+		void lock();
+
+		/**
+		 * Release the write lock.
+		 */
+		void unlock();
+	};
+}
+
+#endif
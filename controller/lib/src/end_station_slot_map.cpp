@@ -0,0 +1,138 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * end_station_slot_map.cpp
+ *
+ * End Station slot map implementation
+ */
+
+#include <stddef.h>
+#include "atomic_ops.h"
+#include "end_station_slot_map.h"
+
+namespace avdecc_lib
+{
+	end_station_slot_map::end_station_slot_map()
+	{
+		for(uint32_t chunk_index = 0; chunk_index < SLOT_MAP_CHUNK_COUNT; chunk_index++)
+		{
+			slot_chunks[chunk_index] = NULL;
+		}
+
+		slot_count = 0;
+		free_slot_head = SLOT_MAP_NO_FREE_SLOT;
+	}
+
+	end_station_slot_map::~end_station_slot_map()
+	{
+		for(uint32_t chunk_index = 0; chunk_index < SLOT_MAP_CHUNK_COUNT; chunk_index++)
+		{
+			delete[] slot_chunks[chunk_index];
+		}
+	}
+
+	uint64_t end_station_slot_map::insert(end_station_imp *end_station, uint32_t &slot_index)
+	{
+		if(free_slot_head != SLOT_MAP_NO_FREE_SLOT)
+		{
+			/**
+			 * The generation of a released slot was bumped when its End Station was retired, so no handle of the
+			 * new End Station has been handed out before.
+			 */
+			slot_index = free_slot_head;
+			free_slot_head = get_slot(slot_index).next_free_slot;
+			get_slot(slot_index).end_station = end_station;
+			atomic_full_barrier(); // Store the End Station before its handle is published
+
+			return get_handle(slot_index);
+		}
+
+		slot_index = slot_count;
+
+		if(slot_index >= SLOT_MAP_CHUNK_COUNT * SLOT_MAP_CHUNK_SIZE)
+		{
+			return 0;
+		}
+
+		if(slot_index % SLOT_MAP_CHUNK_SIZE == 0)
+		{
+			slot_chunks[slot_index / SLOT_MAP_CHUNK_SIZE] = new struct slot[SLOT_MAP_CHUNK_SIZE];
+		}
+
+		get_slot(slot_index).end_station = end_station;
+		get_slot(slot_index).generation = 1;
+		get_slot(slot_index).next_free_slot = SLOT_MAP_NO_FREE_SLOT;
+
+		atomic_full_barrier(); // Publish the slot before the slot count
+		slot_count = slot_index + 1;
+
+		return get_handle(slot_index);
+	}
+
+	void end_station_slot_map::retire(uint32_t slot_index)
+	{
+		uint32_t generation = get_slot(slot_index).generation + 1;
+
+		get_slot(slot_index).generation = (generation == 0) ? 1 : generation;
+		atomic_full_barrier(); // Invalidate the handle before the End Station is removed from the lookups
+	}
+
+	void end_station_slot_map::release(uint32_t slot_index)
+	{
+		get_slot(slot_index).end_station = NULL;
+		get_slot(slot_index).next_free_slot = free_slot_head;
+		free_slot_head = slot_index;
+	}
+
+	end_station_imp * end_station_slot_map::get(uint64_t handle)
+	{
+		uint32_t slot_index = (uint32_t)handle;
+		end_station_imp *end_station;
+
+		if(slot_index >= size())
+		{
+			return NULL;
+		}
+
+		/**
+		 * The End Station is only returned if the slot held the generation of the handle both before and after
+		 * it was read, so a handle retired meanwhile is not resolved to the End Station reusing its slot.
+		 */
+		if(get_slot(slot_index).generation != (uint32_t)(handle >> 32))
+		{
+			return NULL;
+		}
+
+		atomic_full_barrier();
+		end_station = get_slot(slot_index).end_station;
+		atomic_full_barrier();
+
+		if(get_slot(slot_index).generation != (uint32_t)(handle >> 32))
+		{
+			return NULL;
+		}
+
+		return end_station;
+	}
+}
@@ -0,0 +1,143 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * end_station_slot_map.h
+ *
+ * End Station slot map class, which holds the End Stations of the Controller in slots addressed by handles tagged
+ * with the generation of the slot. Slots are allocated in chunks that are never moved, so lookups from application
+ * threads are not affected by End Stations being added on the engine thread. A retired End Station has the generation
+ * of its slot bumped, so that its handle is no longer valid, and its slot is only reused once it is released after a
+ * grace period during which pointers already handed out stay valid.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_END_STATION_SLOT_MAP_H_
+#define _AVDECC_CONTROLLER_LIB_END_STATION_SLOT_MAP_H_
+
+#include <stdint.h>
+#include "atomic_ops.h"
+
+namespace avdecc_lib
+{
+	class end_station_imp;
+
+	class end_station_slot_map
+	{
+	public:
+		enum slot_map_sizes
+		{
+		        SLOT_MAP_CHUNK_SIZE = 64,
+		        SLOT_MAP_CHUNK_COUNT = 256 // Up to 16384 End Stations
+		};
+
+	private:
+		enum slot_map_free_list
+		{
+		        SLOT_MAP_NO_FREE_SLOT = 0xFFFFFFFF
+		};
+
+		struct slot
+		{
+			end_station_imp *volatile end_station; // NULL while the slot is free
+			volatile uint32_t generation; // The generation of the End Station in the slot, never 0
+			uint32_t next_free_slot; // The next slot of the free list while the slot is free
+		};
+
+		struct slot *slot_chunks[SLOT_MAP_CHUNK_COUNT];
+		volatile uint32_t slot_count; // The number of slots allocated, published once their End Stations are stored
+		uint32_t free_slot_head; // The last slot released, or SLOT_MAP_NO_FREE_SLOT
+
+	public:
+		/**
+		 * An empty constructor for end_station_slot_map
+		 */
+		end_station_slot_map();
+
+		/**
+		 * Destructor for end_station_slot_map used for destroying objects. The End Stations are not deleted.
+		 */
+		~end_station_slot_map();
+
+		/**
+		 * Store an End Station in a released slot, or in a new slot if none is released.
+		 *
+		 * \param slot_index The slot the End Station is stored in.
+		 *
+		 * \return The handle of the End Station, or 0 if all slots are used.
+		 */
+		uint64_t insert(end_station_imp *end_station, uint32_t &slot_index);
+
+		/**
+		 * Invalidate the handle of the End Station in a slot. The End Station stays in the slot until it is released.
+		 */
+		void retire(uint32_t slot_index);
+
+		/**
+		 * Empty a retired slot so that it can be reused. Only called once no thread can still use the End Station.
+		 */
+		void release(uint32_t slot_index);
+
+		/**
+		 * Get the End Station of a handle. Can be called from any thread.
+		 *
+		 * \return The End Station, or NULL if the handle is invalid or its End Station has been retired.
+		 */
+		end_station_imp * get(uint64_t handle);
+
+		/**
+		 * Get the number of slots allocated. The slots below the count returned can be read from any thread.
+		 */
+		inline uint32_t size()
+		{
+			uint32_t published_count = slot_count;
+
+			atomic_full_barrier(); // Read the slots only after the count they were published with
+			return published_count;
+		}
+
+		/**
+		 * Get the End Station in a slot, or NULL if the slot is free. Only called from the engine thread.
+		 */
+		inline end_station_imp * get_by_slot(uint32_t slot_index)
+		{
+			return get_slot(slot_index).end_station;
+		}
+
+		/**
+		 * Get the handle of the End Station in a slot.
+		 */
+		inline uint64_t get_handle(uint32_t slot_index)
+		{
+			return ((uint64_t)get_slot(slot_index).generation << 32) | slot_index;
+		}
+
+	private:
+		inline struct slot &get_slot(uint32_t slot_index)
+		{
+			return slot_chunks[slot_index / SLOT_MAP_CHUNK_SIZE][slot_index % SLOT_MAP_CHUNK_SIZE];
+		}
+	};
+}
+
+#endif
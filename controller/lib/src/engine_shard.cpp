@@ -0,0 +1,334 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * engine_shard.cpp
+ *
+ * Engine shard implementation
+ */
+
+#include "net_interface_imp.h"
+#include "enumeration.h"
+#include "log.h"
+#include "util.h"
+#include "adp.h"
+#include "aecp.h"
+#include "end_station_imp.h"
+#include "timer_wheel.h"
+#include "adp_discovery_state_machine.h"
+#include "aem_controller_state_machine.h"
+#include "controller_context.h"
+#include "descriptor_base_imp.h"
+#include "mpsc_ring.h"
+#include "desc_decode_pool.h"
+#include "end_station_list.h"
+#include "engine_shard.h"
+
+namespace avdecc_lib
+{
+	engine_shard::engine_shard(controller_context *context, uint32_t shard_index) : end_station_guid_index(end_station_slot_map::SLOT_MAP_CHUNK_COUNT * end_station_slot_map::SLOT_MAP_CHUNK_SIZE)
+	{
+		this->context = context;
+		this->shard_index = shard_index;
+		decode_pool = NULL;
+		decoded_desc_queue = NULL;
+		context->engine_shard_ref = this;
+	}
+
+	engine_shard::~engine_shard()
+	{
+		if(decoded_desc_queue)
+		{
+			struct desc_decode_pool::decoded_desc decoded;
+
+			while(decoded_desc_queue->pop(&decoded) == 0)
+			{
+				delete decoded.desc; // The frames are freed with the pool
+			}
+
+			delete decoded_desc_queue;
+		}
+
+		for(uint32_t slot_index = 0; slot_index < end_station_slots.size(); slot_index++)
+		{
+			delete end_station_slots.get_by_slot(slot_index); // Including the End Stations retired and not released yet
+		}
+
+		if(context->parent_context)
+		{
+			delete context;
+		}
+		else
+		{
+			context->engine_shard_ref = NULL;
+		}
+	}
+
+	end_station_imp * engine_shard::find_end_station_by_guid(uint64_t entity_guid, uint64_t &handle)
+	{
+		uint32_t slot_index;
+
+		if(!end_station_guid_index.find_concurrent(entity_guid, slot_index))
+		{
+			return NULL;
+		}
+
+		/**
+		 * The End Station may be retired after its slot is found, in which case the generation check of the handle fails.
+		 */
+		handle = end_station_slots.get_handle(slot_index);
+		return end_station_slots.get(handle);
+	}
+
+	void engine_shard::retire_end_station(end_station_imp *end_station)
+	{
+		uint64_t end_station_guid = end_station->get_end_station_guid();
+		uint32_t slot_index;
+		uint64_t end_station_handle;
+
+		if(!end_station_guid_index.find(end_station_guid, slot_index))
+		{
+			return;
+		}
+
+		/**
+		 * The handle is invalidated first, so that no thread looks the End Station up once it is out of the lookups.
+		 * Threads that already hold the End Station may use it until the grace period ends.
+		 */
+		end_station_handle = end_station_slots.get_handle(slot_index);
+		end_station_slots.retire(slot_index);
+		end_station_guid_index.remove(end_station_guid);
+		context->end_station_list_ref->remove(shard_index, end_station_handle);
+		context->aem_controller_state_machine_ref->remove_target(end_station_guid);
+
+		context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_NOTICE, "Retired End Station 0x%llx", end_station_guid);
+		end_station->set_retired(slot_index);
+	}
+
+	void engine_shard::release_end_station(uint32_t slot_index)
+	{
+		end_station_imp *end_station = end_station_slots.get_by_slot(slot_index);
+
+		end_station_slots.release(slot_index);
+		delete end_station;
+	}
+
+	void engine_shard::set_desc_decode_pool(desc_decode_pool *pool)
+	{
+		decode_pool = pool;
+
+		if(decode_pool && !decoded_desc_queue)
+		{
+			decoded_desc_queue = desc_decode_pool::create_done_queue();
+		}
+	}
+
+	int engine_shard::queue_desc_decode(end_station_imp *end_station, uint16_t desc_type, const uint8_t *frame, uint16_t mem_buf_len)
+	{
+		if(!decode_pool)
+		{
+			return -1;
+		}
+
+		return decode_pool->submit(end_station, decoded_desc_queue, desc_type, frame, mem_buf_len);
+	}
+
+	bool engine_shard::poll_decoded_descs()
+	{
+		struct desc_decode_pool::decoded_desc decoded_batch[desc_decode_pool::DECODE_POP_BATCH];
+		uint32_t pop_count;
+		uint32_t store_count = 0;
+
+		do
+		{
+			pop_count = decoded_desc_queue->pop_batch(decoded_batch, desc_decode_pool::DECODE_POP_BATCH);
+
+			for(uint32_t index_i = 0; index_i < pop_count; index_i++)
+			{
+				struct desc_decode_pool::decoded_desc &decoded = decoded_batch[index_i];
+
+				decode_pool->release_frame(decoded.frame_index);
+				decoded.end_station->proc_decoded_desc(decoded.desc_type, decoded.desc);
+			}
+
+			store_count += pop_count;
+		}
+		while((pop_count == desc_decode_pool::DECODE_POP_BATCH) && (store_count < desc_decode_pool::DECODE_BUDGET));
+
+		return (pop_count == desc_decode_pool::DECODE_POP_BATCH) || !decoded_desc_queue->prepare_wait();
+	}
+
+	void engine_shard::time_tick_event()
+	{
+		uint64_t end_station_guid;
+		uint32_t disconnected_slot_index;
+
+		/**
+		 * Expire all the timers due in one pass. Commands are resent or completed from the expiry functions of their timers.
+		 */
+		context->timer_wheel_ref->expire(timer_wheel::clk_monotonic_ms());
+
+		while(context->adp_discovery_state_machine_ref->adp_discovery_tick(end_station_guid))
+		{
+			if(end_station_guid_index.find(end_station_guid, disconnected_slot_index))
+			{
+				end_station_slots.get_by_slot(disconnected_slot_index)->set_disconnected();
+			}
+		}
+	}
+
+	void engine_shard::rx_packet_event(void *&notification_id, bool &is_notification_id_valid, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
+	{
+		uint8_t *frame = (uint8_t *)rx_frame.frame(); // The ADP state machine and a new End Station copy what they keep of the frame
+		uint64_t dest_mac_addr;
+
+		convert_eui48_to_uint64(frame, dest_mac_addr);
+
+		if((dest_mac_addr == context->net_interface_ref->get_mac()) || (dest_mac_addr & UINT64_C(0x010000000000))) // Process if the packet dest is our MAC address or a multicast address
+		{
+			switch(rx_frame.subtype())
+			{
+				case JDKSAVDECC_SUBTYPE_ADP:
+					{
+						uint32_t found_slot_index = 0;
+						bool found_adp_in_endpoint;
+						uint64_t entity_guid = rx_frame.guid();
+
+						//context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG, "ADP packet discovered.");
+
+						/**
+						 * Check if an ADP object is already in the system. If not, create a new End Station object storing the ADPDU information
+						 * and add the End Station object to the system.
+						 */
+						found_adp_in_endpoint = end_station_guid_index.find(entity_guid, found_slot_index);
+
+						if(entity_guid != 0x0)
+						{
+							if(!found_adp_in_endpoint)
+							{
+								context->adp_discovery_state_machine_ref->set_rcvd_avail(true);
+								context->adp_discovery_state_machine_ref->adp_discovery_state_waiting(frame);
+								end_station_imp *end_station = new end_station_imp(context, frame, rx_frame.length());
+								uint64_t end_station_handle = end_station_slots.insert(end_station, found_slot_index);
+
+								if(end_station_handle == 0)
+								{
+									context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "No End Station slot available");
+									delete end_station;
+								}
+								else
+								{
+									end_station_guid_index.insert(entity_guid, found_slot_index);
+									end_station->set_connected();
+
+									if(context->end_station_list_ref->append(shard_index, end_station_handle) < 0)
+									{
+										context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "The End Station list is full");
+									}
+								}
+							}
+							else
+							{
+								if(end_station_slots.get_by_slot(found_slot_index)->get_connection_status() == 'D')
+								{
+									end_station_slots.get_by_slot(found_slot_index)->set_connected();
+									context->adp_discovery_state_machine_ref->set_rcvd_avail(true);
+									context->adp_discovery_state_machine_ref->adp_discovery_state_waiting(frame);
+								}
+								else
+								{
+									context->adp_discovery_state_machine_ref->set_rcvd_avail(true);
+									context->adp_discovery_state_machine_ref->adp_discovery_state_waiting(frame);
+								}
+							}
+						}
+						else
+						{
+							//context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Entity GUID is 0x0");
+						}
+
+						status = STATUS_INVALID_COMMAND;
+						is_notification_id_valid = false;
+					}
+					break;
+
+				case JDKSAVDECC_SUBTYPE_AECP:
+					{
+						uint32_t found_slot_index = 0;
+						bool found_aecp_in_end_station = false;
+						uint64_t entity_guid = rx_frame.guid();
+						uint16_t seq_id = rx_frame.seq_id();
+
+						/**
+						 * Check if an AECP object is already in the system. If yes, process response for the AECP packet.
+						 */
+						if((rx_frame.msg_type() == JDKSAVDECC_AECP_MESSAGE_TYPE_AEM_RESPONSE) && context->aem_controller_state_machine_ref->is_seq_id_in_window(entity_guid, seq_id) &&
+						            (dest_mac_addr == context->net_interface_ref->get_mac()))
+						{
+							found_aecp_in_end_station = end_station_guid_index.find(entity_guid, found_slot_index);
+						}
+
+						/**
+						 * An IN_PROGRESS response only postpones the timeout of the command, which stays inflight
+						 * until the final response.
+						 */
+						if(found_aecp_in_end_station && (rx_frame.status() == STATUS_IN_PROGRESS))
+						{
+							context->aem_controller_state_machine_ref->extend_inflight_cmd(entity_guid, seq_id);
+							status = STATUS_IN_PROGRESS;
+						}
+						else if(found_aecp_in_end_station)
+						{
+							end_station_slots.get_by_slot(found_slot_index)->proc_rcvd_resp(notification_id, notification_flag, rx_frame, status);
+							is_notification_id_valid = true;
+						}
+						else
+						{
+							//context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_DEBUG, "Need to have ADP packet first.");
+							status = STATUS_INVALID_COMMAND;
+						}
+					}
+					break;
+
+				case JDKSAVDECC_SUBTYPE_ACMP:
+					//std::cout << "\nACMP subtype";
+					break;
+
+				default:
+					//context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Invalid subtype");
+					break;
+			}
+		}
+	}
+
+	void engine_shard::tx_packet_event(void *notification_id, uint32_t notification_flag, uint8_t *frame, uint16_t mem_buf_len)
+	{
+		context->aem_controller_state_machine_ref->set_do_cmd(true);
+		context->aem_controller_state_machine_ref->aem_controller_state_waiting(notification_id, notification_flag, frame, mem_buf_len); // The sequence id is set in the queued frame
+	}
+
+	void engine_shard::tx_timestamp_event(const uint8_t *frame, uint16_t mem_buf_len, uint64_t tx_timestamp_ns)
+	{
+		context->aem_controller_state_machine_ref->tx_timestamp_event(frame, mem_buf_len, tx_timestamp_ns);
+	}
+}
@@ -0,0 +1,152 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * engine_shard.h
+ *
+ * Engine shard class, which holds a set of End Stations together with the timer wheel and state machines of their
+ * commands. A Controller runs a single shard on the poll thread of its System by default; in the sharded mode End
+ * Stations are assigned to shards by GUID, and each shard is run by its own engine thread.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_ENGINE_SHARD_H_
+#define _AVDECC_CONTROLLER_LIB_ENGINE_SHARD_H_
+
+#include <stdint.h>
+#include "guid_index.h"
+#include "end_station_slot_map.h"
+#include "frame_view.h"
+
+namespace avdecc_lib
+{
+	class controller_context;
+	class end_station_imp;
+	class desc_decode_pool;
+	class mpsc_ring;
+
+	class engine_shard
+	{
+	private:
+		controller_context *context; // The context of the shard, which is the context of the Controller if it has a single shard
+		uint32_t shard_index; // The position of the shard in the shards of the Controller
+		end_station_slot_map end_station_slots; // Store a list of End Station class objects
+		guid_index end_station_guid_index; // The slot of each End Station by GUID, sized for every slot so it is never reallocated under readers
+		desc_decode_pool *decode_pool; // Decodes the descriptors read during enumeration, or NULL if they are decoded by the engine
+		mpsc_ring *decoded_desc_queue; // The descriptors decoded by the pool for the End Stations of the shard
+
+	public:
+		/**
+		 * Constructor for engine_shard used for constructing a shard running the End Stations of a context.
+		 */
+		engine_shard(controller_context *context, uint32_t shard_index);
+
+		/**
+		 * Destructor for engine_shard used for destroying objects, which deletes the End Stations of the shard and
+		 * a context made for the shard.
+		 */
+		~engine_shard();
+
+		/**
+		 * Get the context of the shard.
+		 */
+		inline controller_context * get_context()
+		{
+			return context;
+		}
+
+		/**
+		 * Get the End Station of a handle of the shard, or NULL if the handle is invalid.
+		 */
+		inline end_station_imp * get_end_station_by_handle(uint64_t handle)
+		{
+			return end_station_slots.get(handle);
+		}
+
+		/**
+		 * Get the End Station with a GUID and its handle, or NULL if the shard has no End Station with the GUID.
+		 */
+		end_station_imp * find_end_station_by_guid(uint64_t entity_guid, uint64_t &handle);
+
+		/**
+		 * Remove an End Station that has been disconnected for END_STATION_DEPARTED_TIMEOUT from the lookups and
+		 * invalidate its handle. The End Station is kept for END_STATION_RETIRED_GRACE_PERIOD before it is deleted.
+		 */
+		void retire_end_station(end_station_imp *end_station);
+
+		/**
+		 * Delete a retired End Station once its grace period has ended and release its slot for reuse.
+		 */
+		void release_end_station(uint32_t slot_index);
+
+		/**
+		 * Check for End Station connection and command timeouts.
+		 */
+		void time_tick_event();
+
+		/**
+		 * Process a received frame addressed to an End Station of the shard.
+		 */
+		void rx_packet_event(void *&notification_id, bool &is_notification_id_valid, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
+
+		/**
+		 * Send a queued command to an End Station of the shard through the AEM Controller State Machine.
+		 */
+		void tx_packet_event(void *notification_id, uint32_t notification_flag, uint8_t *frame, uint16_t mem_buf_len);
+
+		/**
+		 * Pass the time a command to an End Station of the shard left the network interface to the AEM Controller State Machine.
+		 */
+		void tx_timestamp_event(const uint8_t *frame, uint16_t mem_buf_len, uint64_t tx_timestamp_ns);
+
+		/**
+		 * Set the pool the descriptors read during the enumeration of the End Stations are decoded by, or NULL to
+		 * decode them on the engine thread. Only called while the engine is stopped.
+		 */
+		void set_desc_decode_pool(desc_decode_pool *pool);
+
+		/**
+		 * Get the queue of the descriptors decoded for the shard, or NULL if the shard has never had a decode pool.
+		 */
+		inline mpsc_ring * get_decoded_desc_queue()
+		{
+			return decoded_desc_queue;
+		}
+
+		/**
+		 * Hand a READ_DESCRIPTOR response for an End Station of the shard to the decode pool.
+		 *
+		 * \return 0 on success, -1 if the shard has no decode pool or the pool is full.
+		 */
+		int queue_desc_decode(end_station_imp *end_station, uint16_t desc_type, const uint8_t *frame, uint16_t mem_buf_len);
+
+		/**
+		 * Store up to DECODE_BUDGET descriptors decoded by the pool in their End Stations.
+		 *
+		 * \return True if decoded descriptors may be left to store.
+		 */
+		bool poll_decoded_descs();
+	};
+}
+
+#endif
@@ -31,19 +31,20 @@
 #include "enumeration.h"
 #include "log.h"
 #include "end_station_imp.h"
+#include "controller_context.h"
 #include "entity_descriptor_imp.h"
 
 namespace avdecc_lib
 {
 	entity_descriptor_imp::entity_descriptor_imp() {}
 
-	entity_descriptor_imp::entity_descriptor_imp(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len) : descriptor_base_imp(base_end_station_imp_ref)
+	entity_descriptor_imp::entity_descriptor_imp(end_station_imp *base_end_station_imp_ref, const uint8_t *frame, size_t pos, size_t mem_buf_len) : descriptor_base_imp(base_end_station_imp_ref)
 	{
 		desc_entity_read_returned = jdksavdecc_descriptor_entity_read(&entity_desc, frame, pos, mem_buf_len);
 
 		if(desc_entity_read_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "entity_desc_read error");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "entity_desc_read error");
 			assert(desc_entity_read_returned >= 0);
 		}
 	}
@@ -164,9 +165,9 @@ namespace avdecc_lib
 		return entity_desc.current_configuration;
 	}
 
-	void entity_descriptor_imp::store_config_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len)
+	void entity_descriptor_imp::store_config_desc(configuration_descriptor_imp *config_desc)
 	{
-		config_desc_vec.push_back(new configuration_descriptor_imp(base_end_station_imp_ref, frame, pos, mem_buf_len));
+		config_desc_vec.push_back(config_desc);
 	}
 
 	uint32_t STDCALL entity_descriptor_imp::get_config_desc_count()
@@ -179,6 +180,16 @@ namespace avdecc_lib
 		return config_desc_vec.at(config_desc_index);
 	}
 
+	configuration_descriptor_imp * entity_descriptor_imp::get_config_desc_imp_by_index(uint16_t config_desc_index)
+	{
+		if(config_desc_index < config_desc_vec.size())
+		{
+			return config_desc_vec[config_desc_index];
+		}
+
+		return NULL;
+	}
+
 	int STDCALL entity_descriptor_imp::send_set_config_cmd()
 	{
 
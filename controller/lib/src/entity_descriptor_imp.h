@@ -54,7 +54,7 @@ namespace avdecc_lib
 		 * Constructor for entity_descriptor_imp used for constructing an object with a base End Station, frame, position offest,
 		 * and memory buffer length.
 		 */
-		entity_descriptor_imp(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len);
+		entity_descriptor_imp(end_station_imp *base_end_station_imp_ref, const uint8_t *frame, size_t pos, size_t mem_buf_len);
 
 		/**
 		 * Destructor for entity_descriptor_imp used for destroying objects
@@ -169,7 +169,7 @@ namespace avdecc_lib
 		/**
 		 * Store Configuration descriptor object.
 		 */
-		void store_config_desc(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len);
+		void store_config_desc(configuration_descriptor_imp *config_desc);
 
 		/**
 		 * Get the number of Configuration descriptors.
@@ -181,6 +181,13 @@ namespace avdecc_lib
 		 */
 		configuration_descriptor * STDCALL get_config_desc_by_index(uint16_t config_desc_index);
 
+		/**
+		 * Get the corresponding Configuration descriptor implementation object by index.
+		 *
+		 * \return The Configuration descriptor, or NULL if there is no such Configuration descriptor.
+		 */
+		configuration_descriptor_imp * get_config_desc_imp_by_index(uint16_t config_desc_index);
+
 		/**
 		 * Send a SET_CONFIFURATION command to change the current configuration of the AVDECC Entity.
 		 */
@@ -22,46 +22,58 @@
  */
 
 /**
- * system_message_queue.h
+ * frame_batch.cpp
  *
- * System message queue class, which is called by System modules to queue packets.
+ * Frame batch implementation
  */
 
-#include <stdint.h>
+#include <string.h>
+#include "frame_batch.h"
 
-class system_message_queue
+namespace avdecc_lib
 {
-private:
-	HANDLE space_avail;
-	HANDLE data_avail;
-	CRITICAL_SECTION critical_section_obj;
-	uint8_t *buf;
-	int in_pos;
-	int out_pos;
-	int entry_count;
-	int entry_size;
+	frame_batch::frame_batch()
+	{
+		for(uint32_t index_i = 0; index_i < FRAME_BATCH_COUNT; index_i++)
+		{
+			frames[index_i] = frames_buf[index_i];
+			mem_buf_lens[index_i] = 0;
+		}
 
-public:
-	/**
-	 * An empty constructor for system_message_queue
-	 */
-	system_message_queue();
+		frame_count = 0;
+		is_open = false;
+	}
 
-	/**
-	 * Constructor for system_message_queue used for constructing an object with count and size.
-	 */
-	system_message_queue(int count, int size);
+	frame_batch::~frame_batch() {}
 
-	/**
-	 * Destructor for system_message_queue used for destroying objects
-	 */
-	~system_message_queue();
+	void frame_batch::open()
+	{
+		frame_count = 0;
+		is_open = true;
+	}
 
-	void queue_push(void *thread_data);
+	void frame_batch::close()
+	{
+		frame_count = 0;
+		is_open = false;
+	}
 
-	void queue_pop_nowait(void *thread_data);
+	void frame_batch::clear()
+	{
+		frame_count = 0;
+	}
 
-	void queue_pop_wait(void *thread_data);
+	int frame_batch::add_frame(uint8_t *frame, uint16_t mem_buf_len)
+	{
+		if(is_full() || mem_buf_len > FRAME_BATCH_FRAME_SIZE)
+		{
+			return -1;
+		}
 
-	HANDLE queue_data_available_object();
-};
+		memcpy(frames_buf[frame_count], frame, mem_buf_len);
+		mem_buf_lens[frame_count] = mem_buf_len;
+		frame_count++;
+
+		return 0;
+	}
+}
@@ -0,0 +1,130 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * frame_batch.h
+ *
+ * Frame batch class, which holds the frames sent by the engine during one loop iteration so that
+ * the network interface can transmit them with a single submission.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_FRAME_BATCH_H_
+#define _AVDECC_CONTROLLER_LIB_FRAME_BATCH_H_
+
+#include <stdint.h>
+
+namespace avdecc_lib
+{
+	class frame_batch
+	{
+	public:
+		enum frame_batch_sizes
+		{
+		        FRAME_BATCH_COUNT = 64, // The maximum number of frames held before the batch has to be transmitted
+		        FRAME_BATCH_FRAME_SIZE = 1600
+		};
+
+	private:
+		uint8_t frames_buf[FRAME_BATCH_COUNT][FRAME_BATCH_FRAME_SIZE];
+		uint8_t *frames[FRAME_BATCH_COUNT];
+		uint16_t mem_buf_lens[FRAME_BATCH_COUNT];
+		uint32_t frame_count;
+		bool is_open;
+
+	public:
+		/**
+		 * An empty constructor for frame_batch
+		 */
+		frame_batch();
+
+		/**
+		 * Destructor for frame_batch used for destroying objects
+		 */
+		~frame_batch();
+
+		/**
+		 * Open the batch, so that frames sent are held until the batch is transmitted.
+		 */
+		void open();
+
+		/**
+		 * Close the batch and discard any frames held.
+		 */
+		void close();
+
+		/**
+		 * Discard the frames held, leaving the batch open.
+		 */
+		void clear();
+
+		/**
+		 * Copy a frame into the batch.
+		 *
+		 * \return 0 on success, -1 if the batch is full or the frame is too long.
+		 */
+		int add_frame(uint8_t *frame, uint16_t mem_buf_len);
+
+		/**
+		 * \return True if frames sent are being held in the batch.
+		 */
+		inline bool get_is_open()
+		{
+			return is_open;
+		}
+
+		/**
+		 * \return True if no more frames can be added to the batch.
+		 */
+		inline bool is_full()
+		{
+			return frame_count >= FRAME_BATCH_COUNT;
+		}
+
+		/**
+		 * \return The number of frames held in the batch.
+		 */
+		inline uint32_t get_frame_count()
+		{
+			return frame_count;
+		}
+
+		/**
+		 * \return The frames held in the batch.
+		 */
+		inline uint8_t ** get_frames()
+		{
+			return frames;
+		}
+
+		/**
+		 * \return The lengths of the frames held in the batch.
+		 */
+		inline uint16_t * get_mem_buf_lens()
+		{
+			return mem_buf_lens;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,116 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * frame_slab.cpp
+ *
+ * Frame slab implementation
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+#include "atomic_ops.h"
+#include "frame_slab.h"
+
+namespace avdecc_lib
+{
+	frame_slab::frame_slab(uint32_t count)
+	{
+		assert(count > 0 && count < FRAME_SLAB_MAX_COUNT);
+
+		frame_count = count;
+		frames_buf = (uint8_t *)malloc(frame_count * FRAME_SLAB_FRAME_SIZE);
+		next_free = (uint16_t *)malloc(frame_count * sizeof(uint16_t));
+
+		for(uint32_t index_i = 0; index_i < frame_count; index_i++)
+		{
+			next_free[index_i] = (index_i + 1 < frame_count) ? (uint16_t)(index_i + 1) : (uint16_t)FRAME_SLAB_NO_INDEX;
+		}
+
+		free_head = 0;
+		in_use_count = 0;
+		high_watermark = 0;
+		exhausted_count = 0;
+	}
+
+	frame_slab::~frame_slab()
+	{
+		free(frames_buf);
+		free(next_free);
+	}
+
+	int frame_slab::alloc(uint16_t &frame_index)
+	{
+		uint32_t head;
+		uint32_t new_head;
+		uint32_t in_use;
+		uint32_t watermark;
+
+		/**
+		 * Pop the first free frame. The tag is bumped on every change of the head, so a head that was popped
+		 * and pushed back by another thread in the meantime does not match.
+		 */
+		do
+		{
+			head = free_head;
+
+			if((head & 0xFFFF) == FRAME_SLAB_NO_INDEX)
+			{
+				atomic_inc_uint32(&exhausted_count);
+				return -1;
+			}
+
+			new_head = ((head & 0xFFFF0000) + 0x10000) | next_free[head & 0xFFFF];
+		}
+		while(atomic_cas_uint32(&free_head, head, new_head) != head);
+
+		frame_index = (uint16_t)(head & 0xFFFF);
+		in_use = atomic_inc_uint32(&in_use_count);
+
+		do
+		{
+			watermark = high_watermark;
+		}
+		while((in_use > watermark) && (atomic_cas_uint32(&high_watermark, watermark, in_use) != watermark));
+
+		return 0;
+	}
+
+	void frame_slab::release(uint16_t frame_index)
+	{
+		uint32_t head;
+		uint32_t new_head;
+
+		assert(frame_index < frame_count);
+
+		do
+		{
+			head = free_head;
+			next_free[frame_index] = (uint16_t)(head & 0xFFFF);
+			new_head = ((head & 0xFFFF0000) + 0x10000) | frame_index;
+		}
+		while(atomic_cas_uint32(&free_head, head, new_head) != head);
+
+		atomic_dec_uint32(&in_use_count);
+	}
+}
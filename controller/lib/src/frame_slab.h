@@ -0,0 +1,126 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * frame_slab.h
+ *
+ * Frame slab class, which holds a fixed number of preallocated frame buffers that are handed out by index
+ * to the System queues. Allocation and release are lock-free, so the capture, application, and poll threads
+ * can share the slab.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_FRAME_SLAB_H_
+#define _AVDECC_CONTROLLER_LIB_FRAME_SLAB_H_
+
+#include <stdint.h>
+
+namespace avdecc_lib
+{
+	class frame_slab
+	{
+	public:
+		enum frame_slab_sizes
+		{
+		        FRAME_SLAB_FRAME_SIZE = 1600,
+		        FRAME_SLAB_MAX_COUNT = 0xFFFF, // Frame indices are stored in the low 16 bits of the free list head
+		        FRAME_SLAB_NO_INDEX = 0xFFFF
+		};
+
+	private:
+		uint8_t *frames_buf; // Storage for all the frames in the slab
+		uint16_t *next_free; // The index of the next free frame for each free frame
+		uint32_t frame_count; // The number of frames in the slab
+		volatile uint32_t free_head; // A tag in the high 16 bits and the index of the first free frame in the low 16 bits
+		volatile uint32_t in_use_count; // The number of frames currently allocated
+		volatile uint32_t high_watermark; // The highest number of frames allocated at the same time
+		volatile uint32_t exhausted_count; // The number of allocations that failed because no frame was free
+
+	public:
+		/**
+		 * Constructor for frame_slab used for allocating storage for a number of frames.
+		 */
+		frame_slab(uint32_t count);
+
+		/**
+		 * Destructor for frame_slab used for destroying objects
+		 */
+		~frame_slab();
+
+		/**
+		 * Take a free frame from the slab.
+		 *
+		 * \param frame_index The index of the frame taken.
+		 *
+		 * \return 0 on success, -1 if no frame is free.
+		 */
+		int alloc(uint16_t &frame_index);
+
+		/**
+		 * Return a frame taken by alloc to the slab.
+		 */
+		void release(uint16_t frame_index);
+
+		/**
+		 * Get the buffer of a frame by index.
+		 */
+		inline uint8_t * get_frame(uint16_t frame_index)
+		{
+			return frames_buf + (uint32_t)frame_index * FRAME_SLAB_FRAME_SIZE;
+		}
+
+		/**
+		 * Get the number of frames in the slab.
+		 */
+		inline uint32_t get_frame_count()
+		{
+			return frame_count;
+		}
+
+		/**
+		 * Get the number of frames currently allocated.
+		 */
+		inline uint32_t get_in_use_count()
+		{
+			return in_use_count;
+		}
+
+		/**
+		 * Get the highest number of frames allocated at the same time.
+		 */
+		inline uint32_t get_high_watermark()
+		{
+			return high_watermark;
+		}
+
+		/**
+		 * Get the number of allocations that failed because no frame was free.
+		 */
+		inline uint32_t get_exhausted_count()
+		{
+			return exhausted_count;
+		}
+	};
+}
+
+#endif
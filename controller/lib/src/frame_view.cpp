@@ -0,0 +1,66 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * frame_view.cpp
+ *
+ * Frame view implementation
+ */
+
+#include "adp.h"
+#include "aecp.h"
+#include "frame_view.h"
+
+namespace avdecc_lib
+{
+	frame_view::frame_view(const uint8_t *frame, uint16_t mem_buf_len, uint64_t rx_timestamp_ns)
+	{
+		frame_buf = frame;
+		frame_len = mem_buf_len;
+		subtype_field = 0;
+		msg_type_field = 0;
+		status_field = 0;
+		cmd_type_field = 0;
+		u_field = false;
+		guid_field = 0;
+		seq_id_field = 0;
+		rx_timestamp_field = rx_timestamp_ns;
+
+		if(frame_len >= aecp::TARGET_GUID_POS + 8)
+		{
+			subtype_field = (uint8_t)jdksavdecc_subtype_data_get_subtype(jdksavdecc_uint32_get(frame, aecp::CMD_POS));
+			msg_type_field = jdksavdecc_uint8_get(frame, aecp::MSG_TYPE_POS);
+			status_field = jdksavdecc_common_control_header_get_status(frame, adp::ETHER_HDR_SIZE);
+			guid_field = jdksavdecc_uint64_get(frame, aecp::TARGET_GUID_POS);
+		}
+
+		if((subtype_field == JDKSAVDECC_SUBTYPE_AECP) && (frame_len >= aecp::CMD_TYPE_POS + 2))
+		{
+			uint16_t cmd_type = jdksavdecc_uint16_get(frame, aecp::CMD_TYPE_POS);
+
+			cmd_type_field = cmd_type & 0x7FFF;
+			u_field = (cmd_type >> 15 & 0x01) != 0; // u_field = the msb of the uint16_t command_type
+			seq_id_field = jdksavdecc_uint16_get(frame, aecp::SEQ_ID_POS);
+		}
+	}
+}
@@ -0,0 +1,143 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * frame_view.h
+ *
+ * Frame view class, which gives the handlers of a received frame read-only access to the frame where it was
+ * received, together with the common header fields parsed once on arrival.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_FRAME_VIEW_H_
+#define _AVDECC_CONTROLLER_LIB_FRAME_VIEW_H_
+
+#include <stdint.h>
+
+namespace avdecc_lib
+{
+	class frame_view
+	{
+	private:
+		const uint8_t *frame_buf; // The received frame, owned by the network interface until the frame has been processed
+		uint16_t frame_len; // The length of the received frame
+		uint8_t subtype_field; // The subtype of the AVTP control header, 0 if the frame is too short
+		uint8_t msg_type_field; // The message type of the AVTP control header
+		uint8_t status_field; // The status of the AVTP control header
+		uint16_t cmd_type_field; // The AEM command type without the unsolicited bit, for AECP frames
+		bool u_field; // The unsolicited bit of the AEM command type, for AECP frames
+		uint64_t guid_field; // The Entity GUID of an ADP frame or the target GUID of an AECP frame
+		uint16_t seq_id_field; // The sequence id of an AECP frame
+		uint64_t rx_timestamp_field; // The time the frame was received by the kernel, 0 if unknown
+
+	public:
+		/**
+		 * Constructor for frame_view used for parsing the common header fields of a received frame, with the time
+		 * in nanoseconds since the Unix epoch it was received by the kernel, or 0 if it is unknown.
+		 * The frame has to stay valid and unchanged for as long as the view is used.
+		 */
+		frame_view(const uint8_t *frame, uint16_t mem_buf_len, uint64_t rx_timestamp_ns);
+
+		/**
+		 * Get the received frame.
+		 */
+		inline const uint8_t * frame() const
+		{
+			return frame_buf;
+		}
+
+		/**
+		 * Get the length of the received frame.
+		 */
+		inline uint16_t length() const
+		{
+			return frame_len;
+		}
+
+		/**
+		 * Get the subtype of the received frame.
+		 */
+		inline uint8_t subtype() const
+		{
+			return subtype_field;
+		}
+
+		/**
+		 * Get the message type of the received frame.
+		 */
+		inline uint8_t msg_type() const
+		{
+			return msg_type_field;
+		}
+
+		/**
+		 * Get the status of the received frame.
+		 */
+		inline uint8_t status() const
+		{
+			return status_field;
+		}
+
+		/**
+		 * Get the AEM command type of the received frame, without the unsolicited bit.
+		 */
+		inline uint16_t cmd_type() const
+		{
+			return cmd_type_field;
+		}
+
+		/**
+		 * Check if the received frame is an unsolicited response.
+		 */
+		inline bool is_unsolicited() const
+		{
+			return u_field;
+		}
+
+		/**
+		 * Get the Entity GUID of an ADP frame or the target GUID of an AECP frame.
+		 */
+		inline uint64_t guid() const
+		{
+			return guid_field;
+		}
+
+		/**
+		 * Get the sequence id of the received frame.
+		 */
+		inline uint16_t seq_id() const
+		{
+			return seq_id_field;
+		}
+
+		/**
+		 * Get the time in nanoseconds since the Unix epoch the frame was received by the kernel, or 0 if it is unknown.
+		 */
+		inline uint64_t rx_timestamp() const
+		{
+			return rx_timestamp_field;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,222 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * guid_index.cpp
+ *
+ * GUID index implementation
+ */
+
+#include "atomic_ops.h"
+#include "guid_index.h"
+
+namespace avdecc_lib
+{
+	guid_index::guid_index()
+	{
+		struct guid_index_entry empty_entry = {0, 0, false};
+
+		entries.assign(GUID_INDEX_INITIAL_CAPACITY, empty_entry);
+		mask = GUID_INDEX_INITIAL_CAPACITY - 1;
+		count = 0;
+		change_seq = 0;
+		is_fixed_capacity = false;
+	}
+
+	guid_index::guid_index(uint32_t max_count)
+	{
+		struct guid_index_entry empty_entry = {0, 0, false};
+		uint32_t capacity = GUID_INDEX_INITIAL_CAPACITY;
+
+		while(capacity < max_count * 2)
+		{
+			capacity *= 2;
+		}
+
+		entries.assign(capacity, empty_entry);
+		mask = capacity - 1;
+		count = 0;
+		change_seq = 0;
+		is_fixed_capacity = true;
+	}
+
+	guid_index::~guid_index() {}
+
+	int guid_index::insert(uint64_t guid, uint32_t index)
+	{
+		uint32_t slot = find_slot(guid);
+
+		if(entries[slot].is_used)
+		{
+			begin_change();
+			entries[slot].index = index;
+			end_change();
+			return 0;
+		}
+
+		if((count + 1) * 2 > mask + 1)
+		{
+			if(is_fixed_capacity)
+			{
+				return -1;
+			}
+
+			grow();
+			slot = find_slot(guid);
+		}
+
+		begin_change();
+		entries[slot].guid = guid;
+		entries[slot].index = index;
+		entries[slot].is_used = true;
+		end_change();
+		count++;
+
+		return 0;
+	}
+
+	bool guid_index::find(uint64_t guid, uint32_t &index)
+	{
+		for(uint32_t slot = home_slot(guid); entries[slot].is_used; slot = (slot + 1) & mask)
+		{
+			if(entries[slot].guid == guid)
+			{
+				index = entries[slot].index;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool guid_index::find_concurrent(uint64_t guid, uint32_t &index)
+	{
+		uint32_t seq;
+		bool is_found;
+
+		/**
+		 * Entries shifted back by a remove may be probed half moved, so the probe is bounded by the capacity of the
+		 * table and its result is only kept if no entry changed meanwhile.
+		 */
+		do
+		{
+			seq = change_seq & ~1u;
+			atomic_full_barrier();
+			is_found = false;
+
+			uint32_t slot = home_slot(guid);
+
+			for(uint32_t probe_count = 0; (probe_count <= mask) && entries[slot].is_used; probe_count++)
+			{
+				if(entries[slot].guid == guid)
+				{
+					index = entries[slot].index;
+					is_found = true;
+					break;
+				}
+
+				slot = (slot + 1) & mask;
+			}
+
+			atomic_full_barrier();
+		}
+		while(change_seq != seq);
+
+		return is_found;
+	}
+
+	void guid_index::remove(uint64_t guid)
+	{
+		uint32_t slot;
+		uint32_t next_slot;
+		uint32_t next_home;
+
+		for(slot = home_slot(guid); entries[slot].is_used; slot = (slot + 1) & mask)
+		{
+			if(entries[slot].guid == guid)
+			{
+				break;
+			}
+		}
+
+		if(!entries[slot].is_used)
+		{
+			return;
+		}
+
+		begin_change();
+
+		/**
+		 * Shift the following entries of the probe sequence back, so that no lookup stops at the emptied slot before
+		 * reaching its GUID.
+		 */
+		for(next_slot = (slot + 1) & mask; entries[next_slot].is_used; next_slot = (next_slot + 1) & mask)
+		{
+			next_home = home_slot(entries[next_slot].guid);
+
+			if(((next_slot - next_home) & mask) >= ((next_slot - slot) & mask))
+			{
+				entries[slot] = entries[next_slot];
+				slot = next_slot;
+			}
+		}
+
+		entries[slot].is_used = false;
+		end_change();
+		count--;
+	}
+
+	uint32_t guid_index::find_slot(uint64_t guid)
+	{
+		uint32_t slot;
+
+		for(slot = home_slot(guid); entries[slot].is_used; slot = (slot + 1) & mask)
+		{
+			if(entries[slot].guid == guid)
+			{
+				break;
+			}
+		}
+
+		return slot;
+	}
+
+	void guid_index::grow()
+	{
+		std::vector<struct guid_index_entry> old_entries;
+		struct guid_index_entry empty_entry = {0, 0, false};
+
+		old_entries.swap(entries);
+		entries.assign(old_entries.size() * 2, empty_entry);
+		mask = (uint32_t)entries.size() - 1;
+		count = 0;
+
+		for(uint32_t slot = 0; slot < old_entries.size(); slot++)
+		{
+			if(old_entries[slot].is_used)
+			{
+				insert(old_entries[slot].guid, old_entries[slot].index);
+			}
+		}
+	}
+}
@@ -0,0 +1,156 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * guid_index.h
+ *
+ * GUID index class, an open addressing hash table mapping the GUID of an End Station to its slot in the End Station
+ * slot map of the Controller, so that the End Station a received frame is from is found without scanning the list.
+ * An index sized up front for a number of GUIDs is never reallocated, so that it can be looked up from application
+ * threads with find_concurrent while the engine adds and removes GUIDs.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_GUID_INDEX_H_
+#define _AVDECC_CONTROLLER_LIB_GUID_INDEX_H_
+
+#include <stdint.h>
+#include <vector>
+#include "atomic_ops.h"
+
+namespace avdecc_lib
+{
+	class guid_index
+	{
+	private:
+		struct guid_index_entry
+		{
+			uint64_t guid;
+			uint32_t index;
+			bool is_used;
+		};
+
+		enum guid_index_sizes
+		{
+		        GUID_INDEX_INITIAL_CAPACITY = 64 // A power of two, doubled whenever the table becomes half full unless it is sized up front
+		};
+
+		std::vector<struct guid_index_entry> entries;
+		uint32_t mask; // The capacity of the table minus one
+		uint32_t count; // The number of GUIDs in the table
+		volatile uint32_t change_seq; // Odd while entries are being changed, so that readers on other threads retry
+		bool is_fixed_capacity; // Set if the table is sized up front and never grows
+
+	public:
+		/**
+		 * An empty constructor for guid_index
+		 */
+		guid_index();
+
+		/**
+		 * A constructor for guid_index used for constructing a table sized up front to hold a number of GUIDs at most
+		 * half full, which is never reallocated.
+		 */
+		guid_index(uint32_t max_count);
+
+		/**
+		 * Destructor for guid_index used for destroying objects
+		 */
+		~guid_index();
+
+		/**
+		 * Add a GUID, or change the index of a GUID already in the table. A GUID added is published to readers on
+		 * other threads only once its entry is complete.
+		 *
+		 * \return 0 on success, -1 if the table is sized up front and already holds the number of GUIDs it was sized for.
+		 */
+		int insert(uint64_t guid, uint32_t index);
+
+		/**
+		 * Find the index of a GUID from the thread changing the table.
+		 *
+		 * \return True if the GUID is in the table.
+		 */
+		bool find(uint64_t guid, uint32_t &index);
+
+		/**
+		 * Find the index of a GUID from a thread other than the one changing the table, which is sized up front.
+		 * The lookup is retried if entries were changed while it was probing.
+		 *
+		 * \return True if the GUID is in the table.
+		 */
+		bool find_concurrent(uint64_t guid, uint32_t &index);
+
+		/**
+		 * Remove a GUID from the table, shifting back the entries probed past it.
+		 */
+		void remove(uint64_t guid);
+
+		/**
+		 * Get the number of GUIDs in the table.
+		 */
+		inline uint32_t size()
+		{
+			return count;
+		}
+
+	private:
+		/**
+		 * Mark the entries as being changed, so that find_concurrent retries until end_change.
+		 */
+		inline void begin_change()
+		{
+			change_seq++;
+			atomic_full_barrier();
+		}
+
+		/**
+		 * Publish the entries changed since begin_change.
+		 */
+		inline void end_change()
+		{
+			atomic_full_barrier();
+			change_seq++;
+		}
+
+		/**
+		 * Get the slot a GUID is looked up from. Entity GUIDs share their vendor bits, so all the bits are mixed.
+		 */
+		inline uint32_t home_slot(uint64_t guid)
+		{
+			return (uint32_t)((guid * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & mask;
+		}
+
+		/**
+		 * Find the slot of a GUID, or the empty slot it would be added to.
+		 */
+		uint32_t find_slot(uint64_t guid);
+
+		/**
+		 * Double the capacity of the table and insert the GUIDs again.
+		 */
+		void grow();
+	};
+}
+
+#endif
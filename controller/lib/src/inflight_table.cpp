@@ -0,0 +1,247 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * inflight_table.cpp
+ *
+ * Inflight command table implementation
+ */
+
+#include <string.h>
+#include "inflight_table.h"
+
+namespace avdecc_lib
+{
+	inflight_table::inflight_table()
+	{
+		entries = new struct inflight_cmd[INFLIGHT_TABLE_CAPACITY];
+		frames_buf = new uint8_t[(uint32_t)INFLIGHT_TABLE_CAPACITY * INFLIGHT_FRAME_SIZE];
+		free_entries = new uint16_t[INFLIGHT_TABLE_CAPACITY];
+		live_entries = new uint16_t[INFLIGHT_TABLE_CAPACITY];
+		cmd_buckets = new uint16_t[INFLIGHT_TABLE_BUCKET_COUNT];
+		notification_buckets = new struct notification_bucket[INFLIGHT_TABLE_BUCKET_COUNT];
+
+		for(uint32_t entry_index = 0; entry_index < INFLIGHT_TABLE_CAPACITY; entry_index++)
+		{
+			entries[entry_index].frame = frames_buf + entry_index * INFLIGHT_FRAME_SIZE;
+			free_entries[entry_index] = (uint16_t)(INFLIGHT_TABLE_CAPACITY - 1 - entry_index); // Hand out the lowest entries first
+		}
+
+		for(uint32_t bucket = 0; bucket < INFLIGHT_TABLE_BUCKET_COUNT; bucket++)
+		{
+			cmd_buckets[bucket] = INFLIGHT_NO_ENTRY;
+			notification_buckets[bucket].notification_id = NULL;
+			notification_buckets[bucket].cmd_count = 0;
+		}
+
+		free_count = INFLIGHT_TABLE_CAPACITY;
+		live_count = 0;
+		notification_seq = 0;
+	}
+
+	inflight_table::~inflight_table()
+	{
+		delete[] entries;
+		delete[] frames_buf;
+		delete[] free_entries;
+		delete[] live_entries;
+		delete[] cmd_buckets;
+		delete[] notification_buckets;
+	}
+
+	struct inflight_table::inflight_cmd * inflight_table::insert(uint64_t target_guid, uint16_t seq_id, void *notification_id, uint32_t notification_flag,
+	                                                             const uint8_t *frame, uint16_t frame_len)
+	{
+		uint32_t cmd_bucket = find_cmd_bucket(target_guid, seq_id);
+		uint32_t notification_bucket;
+		uint16_t entry_index;
+		struct inflight_cmd *cmd;
+
+		if((free_count == 0) || (frame_len > INFLIGHT_FRAME_SIZE) || (cmd_buckets[cmd_bucket] != INFLIGHT_NO_ENTRY))
+		{
+			return NULL;
+		}
+
+		entry_index = free_entries[--free_count];
+		cmd = &entries[entry_index];
+		cmd->target_guid = target_guid;
+		cmd->seq_id = seq_id;
+		cmd->notification_id = notification_id;
+		cmd->notification_flag = notification_flag;
+		cmd->frame_len = frame_len;
+		memcpy(cmd->frame, frame, frame_len);
+
+		cmd->live_index = (uint16_t)live_count;
+		live_entries[live_count++] = entry_index;
+		cmd_buckets[cmd_bucket] = entry_index;
+
+		begin_notification_change();
+		notification_bucket = find_notification_bucket(notification_id);
+		notification_buckets[notification_bucket].notification_id = notification_id;
+		notification_buckets[notification_bucket].cmd_count++;
+		end_notification_change();
+
+		return cmd;
+	}
+
+	struct inflight_table::inflight_cmd * inflight_table::find(uint64_t target_guid, uint16_t seq_id)
+	{
+		uint16_t entry_index = cmd_buckets[find_cmd_bucket(target_guid, seq_id)];
+
+		return (entry_index == INFLIGHT_NO_ENTRY) ? NULL : &entries[entry_index];
+	}
+
+	bool inflight_table::has_notification_id(void *notification_id)
+	{
+		volatile struct notification_bucket *buckets = notification_buckets;
+		uint32_t seq;
+		bool is_found;
+
+		/**
+		 * The lookup is retried if the notification buckets were being changed when it started, or were changed while
+		 * it ran. Starting from an odd sequence number always fails the check.
+		 */
+		do
+		{
+			seq = notification_seq & ~1u;
+			atomic_full_barrier();
+			is_found = false;
+
+			for(uint32_t bucket = notification_home_bucket(notification_id), probe_count = 0;
+			    (probe_count < INFLIGHT_TABLE_BUCKET_COUNT) && (buckets[bucket].cmd_count > 0);
+			    bucket = (bucket + 1) & (INFLIGHT_TABLE_BUCKET_COUNT - 1), probe_count++)
+			{
+				if(buckets[bucket].notification_id == notification_id)
+				{
+					is_found = true;
+					break;
+				}
+			}
+
+			atomic_full_barrier();
+		}
+		while(notification_seq != seq);
+
+		return is_found;
+	}
+
+	void inflight_table::remove(struct inflight_cmd *cmd)
+	{
+		uint16_t entry_index = (uint16_t)(cmd - entries);
+		uint32_t notification_bucket = find_notification_bucket(cmd->notification_id);
+		uint16_t moved_entry_index;
+
+		erase_cmd_bucket(find_cmd_bucket(cmd->target_guid, cmd->seq_id));
+
+		begin_notification_change();
+
+		if(--notification_buckets[notification_bucket].cmd_count == 0)
+		{
+			erase_notification_bucket(notification_bucket);
+		}
+
+		end_notification_change();
+
+		moved_entry_index = live_entries[--live_count];
+		live_entries[cmd->live_index] = moved_entry_index;
+		entries[moved_entry_index].live_index = cmd->live_index;
+
+		free_entries[free_count++] = entry_index;
+	}
+
+	uint32_t inflight_table::find_cmd_bucket(uint64_t target_guid, uint16_t seq_id)
+	{
+		uint32_t bucket;
+
+		for(bucket = cmd_home_bucket(target_guid, seq_id); cmd_buckets[bucket] != INFLIGHT_NO_ENTRY;
+		    bucket = (bucket + 1) & (INFLIGHT_TABLE_BUCKET_COUNT - 1))
+		{
+			struct inflight_cmd &cmd = entries[cmd_buckets[bucket]];
+
+			if((cmd.seq_id == seq_id) && (cmd.target_guid == target_guid))
+			{
+				break;
+			}
+		}
+
+		return bucket;
+	}
+
+	uint32_t inflight_table::find_notification_bucket(void *notification_id)
+	{
+		uint32_t bucket;
+
+		for(bucket = notification_home_bucket(notification_id); notification_buckets[bucket].cmd_count > 0;
+		    bucket = (bucket + 1) & (INFLIGHT_TABLE_BUCKET_COUNT - 1))
+		{
+			if(notification_buckets[bucket].notification_id == notification_id)
+			{
+				break;
+			}
+		}
+
+		return bucket;
+	}
+
+	void inflight_table::erase_cmd_bucket(uint32_t bucket)
+	{
+		uint32_t next_bucket;
+		uint32_t next_home;
+
+		for(next_bucket = (bucket + 1) & (INFLIGHT_TABLE_BUCKET_COUNT - 1); cmd_buckets[next_bucket] != INFLIGHT_NO_ENTRY;
+		    next_bucket = (next_bucket + 1) & (INFLIGHT_TABLE_BUCKET_COUNT - 1))
+		{
+			struct inflight_cmd &cmd = entries[cmd_buckets[next_bucket]];
+			next_home = cmd_home_bucket(cmd.target_guid, cmd.seq_id);
+
+			if(((next_bucket - next_home) & (INFLIGHT_TABLE_BUCKET_COUNT - 1)) >= ((next_bucket - bucket) & (INFLIGHT_TABLE_BUCKET_COUNT - 1)))
+			{
+				cmd_buckets[bucket] = cmd_buckets[next_bucket];
+				bucket = next_bucket;
+			}
+		}
+
+		cmd_buckets[bucket] = INFLIGHT_NO_ENTRY;
+	}
+
+	void inflight_table::erase_notification_bucket(uint32_t bucket)
+	{
+		uint32_t next_bucket;
+		uint32_t next_home;
+
+		for(next_bucket = (bucket + 1) & (INFLIGHT_TABLE_BUCKET_COUNT - 1); notification_buckets[next_bucket].cmd_count > 0;
+		    next_bucket = (next_bucket + 1) & (INFLIGHT_TABLE_BUCKET_COUNT - 1))
+		{
+			next_home = notification_home_bucket(notification_buckets[next_bucket].notification_id);
+
+			if(((next_bucket - next_home) & (INFLIGHT_TABLE_BUCKET_COUNT - 1)) >= ((next_bucket - bucket) & (INFLIGHT_TABLE_BUCKET_COUNT - 1)))
+			{
+				notification_buckets[bucket] = notification_buckets[next_bucket];
+				bucket = next_bucket;
+			}
+		}
+
+		notification_buckets[bucket].notification_id = NULL;
+		notification_buckets[bucket].cmd_count = 0;
+	}
+}
@@ -0,0 +1,195 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * inflight_table.h
+ *
+ * Inflight command table class, which holds the AEM commands waiting for a response in a preallocated slab. The
+ * commands are found by target GUID and sequence id through an open addressing hash table, and a second hash table
+ * counts the commands inflight for each notification id.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_INFLIGHT_TABLE_H_
+#define _AVDECC_CONTROLLER_LIB_INFLIGHT_TABLE_H_
+
+#include <stdint.h>
+#include "atomic_ops.h"
+#include "timer_wheel.h"
+#include "enumeration.h"
+
+namespace avdecc_lib
+{
+	class aem_controller_state_machine;
+
+	class inflight_table
+	{
+	public:
+		enum inflight_table_sizes
+		{
+		        INFLIGHT_TABLE_CAPACITY = 1024, // The most commands inflight at the same time
+		        INFLIGHT_TABLE_BUCKET_COUNT = 2 * INFLIGHT_TABLE_CAPACITY, // A power of two, so the hash tables are at most half full
+		        INFLIGHT_FRAME_SIZE = AECP_FRAME_LEN, // The longest command frame kept for a retry, as long as the commands the library builds
+		        INFLIGHT_NO_ENTRY = 0xFFFF
+		};
+
+		struct inflight_cmd
+		{
+			uint64_t target_guid;
+			uint16_t seq_id;
+			bool retried;
+			bool in_progress; // Set once the target has answered IN_PROGRESS
+			void *notification_id;
+			uint32_t notification_flag;
+			aem_controller_state_machine *owner; // The state machine the command was sent by, for the expiry of cmd_timer
+			timer_wheel::entry cmd_timer; // Armed while waiting for the response
+			uint64_t cmd_time_ns; // The wall clock time the command was handed to the network interface, to compare with the wire timestamps
+			uint64_t send_time_us; // The monotonic time the command was handed to the network interface, for the round trip time samples
+			uint64_t tx_timestamp_ns; // The time the command was sent on the wire, 0 if unknown
+			uint16_t live_index; // The position of the command in the list of inflight commands
+			uint16_t frame_len;
+			uint8_t *frame; // The bytes sent, for a retry, kept out of line in the frame buffer of the entry
+		};
+
+	private:
+		struct notification_bucket
+		{
+			void *notification_id;
+			uint32_t cmd_count; // The number of inflight commands with the notification id, 0 if the bucket is empty
+		};
+
+		struct inflight_cmd *entries; // The slab of commands
+		uint8_t *frames_buf; // The frame buffer of each entry, so that the entries stay small for the lookups
+		uint16_t *free_entries; // The entries not in use, as a stack
+		uint32_t free_count;
+		uint16_t *live_entries; // The entries in use, in no particular order
+		uint32_t live_count;
+		uint16_t *cmd_buckets; // The entry of each command by target GUID and sequence id
+		struct notification_bucket *notification_buckets;
+		volatile uint32_t notification_seq; // Odd while the notification buckets are being changed
+
+	public:
+		/**
+		 * An empty constructor for inflight_table, which allocates the slab and the hash tables.
+		 */
+		inflight_table();
+
+		/**
+		 * Destructor for inflight_table used for destroying objects
+		 */
+		~inflight_table();
+
+		/**
+		 * Add a command. The retried flag, timer and timestamps of the command returned are left to the caller.
+		 *
+		 * \return The command added, or NULL if the table is full or the frame is too long to be kept.
+		 */
+		struct inflight_cmd * insert(uint64_t target_guid, uint16_t seq_id, void *notification_id, uint32_t notification_flag,
+		                             const uint8_t *frame, uint16_t frame_len);
+
+		/**
+		 * Find a command by target GUID and sequence id.
+		 *
+		 * \return The command, or NULL if no such command is inflight.
+		 */
+		struct inflight_cmd * find(uint64_t target_guid, uint16_t seq_id);
+
+		/**
+		 * Check if a command with the notification id is inflight. Unlike the other methods, this can be called from
+		 * another thread than the one changing the table.
+		 */
+		bool has_notification_id(void *notification_id);
+
+		/**
+		 * Remove a command and return its entry to the slab.
+		 */
+		void remove(struct inflight_cmd *cmd);
+
+		/**
+		 * Get the number of inflight commands.
+		 */
+		inline uint32_t size()
+		{
+			return live_count;
+		}
+
+		/**
+		 * Get an inflight command by position. Removing a command moves the last command into its position.
+		 */
+		inline struct inflight_cmd * at(uint32_t live_index)
+		{
+			return &entries[live_entries[live_index]];
+		}
+
+	private:
+		inline uint32_t cmd_home_bucket(uint64_t target_guid, uint16_t seq_id)
+		{
+			return (uint32_t)(((target_guid ^ seq_id) * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & (INFLIGHT_TABLE_BUCKET_COUNT - 1);
+		}
+
+		inline uint32_t notification_home_bucket(void *notification_id)
+		{
+			return (uint32_t)(((uint64_t)(size_t)notification_id * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & (INFLIGHT_TABLE_BUCKET_COUNT - 1);
+		}
+
+		/**
+		 * Mark the notification buckets as being changed, so that lookups from other threads are retried.
+		 */
+		inline void begin_notification_change()
+		{
+			notification_seq++;
+			atomic_full_barrier();
+		}
+
+		/**
+		 * Publish the changes to the notification buckets.
+		 */
+		inline void end_notification_change()
+		{
+			atomic_full_barrier();
+			notification_seq++;
+		}
+
+		/**
+		 * Find the bucket of a command, or the empty bucket it would be added to.
+		 */
+		uint32_t find_cmd_bucket(uint64_t target_guid, uint16_t seq_id);
+
+		/**
+		 * Find the bucket of a notification id, or the empty bucket it would be added to.
+		 */
+		uint32_t find_notification_bucket(void *notification_id);
+
+		/**
+		 * Empty a command bucket, moving the following buckets of its probe sequence back.
+		 */
+		void erase_cmd_bucket(uint32_t bucket);
+
+		/**
+		 * Empty a notification bucket, moving the following buckets of its probe sequence back.
+		 */
+		void erase_notification_bucket(uint32_t bucket);
+	};
+}
+
+#endif
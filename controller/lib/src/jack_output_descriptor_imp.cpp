@@ -29,19 +29,20 @@
 
 #include "enumeration.h"
 #include "log.h"
+#include "controller_context.h"
 #include "jack_output_descriptor_imp.h"
 
 namespace avdecc_lib
 {
 	jack_output_descriptor_imp::jack_output_descriptor_imp() {}
 
-	jack_output_descriptor_imp::jack_output_descriptor_imp(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len) : descriptor_base_imp(base_end_station_imp_ref)
+	jack_output_descriptor_imp::jack_output_descriptor_imp(end_station_imp *base_end_station_imp_ref, const uint8_t *frame, size_t pos, size_t mem_buf_len) : descriptor_base_imp(base_end_station_imp_ref)
 	{
 		desc_jack_read_returned = jdksavdecc_descriptor_jack_read(&jack_output_desc, frame, pos, mem_buf_len);
 
 		if(desc_jack_read_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "desc_jack_output_read error");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "desc_jack_output_read error");
 			assert(desc_jack_read_returned >= 0);
 		}
 	}
@@ -0,0 +1,164 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * log.cpp
+ *
+ * Log implementation
+ */
+
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include "enumeration.h"
+#include "log.h"
+
+extern "C" void default_log(void *log_user_obj, int32_t log_level, const char *log_msg, int32_t time_stamp_ms)
+{
+	printf("avdecc_default_log (%d, %s)\n", log_level, log_msg);
+}
+
+namespace avdecc_lib
+{
+	log::log()
+	{
+		read_index = 0;
+		write_index = 0;
+		callback_func = default_log;
+		user_obj = NULL;
+		log_level = avdecc_lib::LOGGING_LEVEL_ERROR;
+		missed_log_event_cnt = 0;
+		is_thread_running = false;
+		kill_event = false;
+	}
+
+	log::~log()
+	{
+		if(is_thread_running)
+		{
+			kill_event = true;
+			sem_post(&log_event);
+			pthread_join(h_thread, NULL); // Wait for thread termination
+			sem_destroy(&log_event);
+		}
+	}
+
+	void log::set_log_level(int32_t new_log_level)
+	{
+		log_level = new_log_level;
+	}
+
+	int log::logging_thread_init()
+	{
+		sem_init(&log_event, 0, 0);
+
+		if(pthread_create(&h_thread, NULL, process_logging_thread, this) != 0)
+		{
+			exit(EXIT_FAILURE);
+		}
+
+		is_thread_running = true;
+
+		return 0;
+	}
+
+	void * log::process_logging_thread(void *lpParam)
+	{
+		log *logger = (log *)lpParam;
+		struct log_data *data = logger->log_buf;
+
+		while (true)
+		{
+			sem_wait(&logger->log_event);
+
+			if(logger->kill_event)
+			{
+				break;
+			}
+
+			if ((logger->write_index - logger->read_index) > 0)
+			{
+				logger->callback_func(logger->user_obj,
+				                      data[logger->read_index % LOG_BUF_COUNT].level,
+				                      data[logger->read_index % LOG_BUF_COUNT].msg,
+				                      data[logger->read_index % LOG_BUF_COUNT].time_stamp_ms
+				                     ); // Call callback function
+
+				logger->read_index++;
+			}
+		}
+
+		return 0;
+	}
+
+	void log::logging(int32_t level, const char *fmt,...)
+	{
+		if (level >= log_level)
+		{
+			va_list arglist;
+
+			if(!is_thread_running)
+			{
+				char msg[256];
+
+				va_start(arglist, fmt);
+				vsnprintf(msg, sizeof(msg), fmt, arglist);
+				va_end(arglist);
+				callback_func(user_obj, level, msg, 0);
+				return;
+			}
+
+			if ((write_index - read_index) > LOG_BUF_COUNT)
+			{
+				missed_log_event_cnt++;
+				return;
+			}
+
+			va_start(arglist, fmt);
+			vsnprintf(log_buf[write_index % LOG_BUF_COUNT].msg, 256, fmt, arglist);  // Write to log_buf using write_index
+			va_end(arglist);
+			log_buf[write_index % LOG_BUF_COUNT].level = level;
+			log_buf[write_index % LOG_BUF_COUNT].time_stamp_ms = 0;
+			write_index++;
+
+			sem_post(&log_event);
+		}
+	}
+
+	void log::set_logging_callback(void (*new_log_callback) (void *, int32_t, const char *, int32_t), void *p)
+	{
+		callback_func = new_log_callback;
+		user_obj = p;
+	}
+
+	uint32_t log::get_missed_log_event_count()
+	{
+		return missed_log_event_cnt;
+	}
+
+	pthread_t log::get_thread_handle()
+	{
+		return h_thread;
+	}
+}
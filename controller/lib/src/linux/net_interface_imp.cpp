@@ -0,0 +1,774 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * net_interface_imp.cpp
+ *
+ * Network interface implementation class
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <net/if.h>
+#include <net/ethernet.h>
+#include <arpa/inet.h>
+#include <linux/filter.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include "enumeration.h"
+#include "log.h"
+#include "jdksavdecc_util.h"
+#include "util.h"
+#include "capture_replay.h"
+#include "net_interface_imp.h"
+
+namespace avdecc_lib
+{
+	net_interface * STDCALL create_net_interface()
+	{
+		return (new net_interface_imp());
+	}
+
+	net_interface * STDCALL create_replay_net_interface(const char *capture_file_path, uint64_t mac, bool is_recorded_pace, const char *tx_file_path)
+	{
+		return (new net_interface_imp(capture_file_path, mac, is_recorded_pace, tx_file_path));
+	}
+
+	net_interface_imp::net_interface_imp()
+	{
+		init_members();
+
+		if(pcap_findalldevs(&all_devs, err_buf) == -1) // Retrieve the device list on the local machine.
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "pcap_findalldevs error %s", err_buf);
+			exit(EXIT_FAILURE);
+		}
+
+		for(dev = all_devs, total_devs = 0; dev; dev = dev->next)
+		{
+			total_devs++;
+		}
+
+		if(total_devs == 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "No interfaces found! Make sure libpcap has permission to capture.");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	net_interface_imp::net_interface_imp(const char *capture_file_path, uint64_t replay_mac, bool is_recorded_pace, const char *tx_file_path)
+	{
+		init_members();
+		mac = replay_mac;
+		total_devs = 1; // The capture file is the only device
+		replay = new capture_replay(log_ref, capture_file_path, is_recorded_pace, tx_file_path);
+	}
+
+	void net_interface_imp::init_members()
+	{
+		log_ref = &netif_log;
+		all_devs = NULL;
+		dev = NULL;
+		total_devs = 0;
+		interface_num = 0;
+		if_index = 0;
+		sock_fd = -1;
+		mac = 0;
+		capture_acmp = false;
+		busy_poll_us = 0;
+		replay = NULL;
+		rx_timestamp_ns = 0;
+		pthread_key_create(&tx_batch_key, free_tx_batch);
+		pthread_mutex_init(&replay_tx_lock, NULL);
+
+		for(uint32_t index_i = 0; index_i < CAPTURE_CHANNEL_COUNT; index_i++)
+		{
+			rx_channels[index_i].sock_fd = -1;
+			rx_channels[index_i].ring = NULL;
+			rx_channels[index_i].ring_len = 0;
+			rx_channels[index_i].block_index = 0;
+			rx_channels[index_i].block = NULL;
+			rx_channels[index_i].frame = NULL;
+			rx_channels[index_i].frames_left = 0;
+		}
+	}
+
+	net_interface_imp::~net_interface_imp()
+	{
+		if(all_devs)
+		{
+			pcap_freealldevs(all_devs); // Free the device list
+		}
+
+		for(uint32_t index_i = 0; index_i < CAPTURE_CHANNEL_COUNT; index_i++)
+		{
+			if(rx_channels[index_i].ring)
+			{
+				munmap(rx_channels[index_i].ring, rx_channels[index_i].ring_len);
+			}
+
+			if(rx_channels[index_i].sock_fd >= 0)
+			{
+				close(rx_channels[index_i].sock_fd);
+			}
+		}
+
+		if(sock_fd >= 0)
+		{
+			close(sock_fd);
+		}
+
+		delete replay;
+		pthread_key_delete(tx_batch_key);
+		pthread_mutex_destroy(&replay_tx_lock);
+	}
+
+	uint32_t STDCALL net_interface_imp::devs_count()
+	{
+		return total_devs;
+	}
+
+	uint64_t net_interface_imp::get_mac()
+	{
+		return mac;
+	}
+
+	void net_interface_imp::set_log(log *new_log_ref)
+	{
+		log_ref = new_log_ref ? new_log_ref : &netif_log;
+
+		if(replay)
+		{
+			replay->set_log(log_ref);
+		}
+	}
+
+	char * STDCALL net_interface_imp::get_dev_desc_by_index(uint32_t dev_index)
+	{
+		uint32_t index_i;
+
+		if(replay)
+		{
+			return (char *)replay->get_capture_file_path();
+		}
+
+		for(dev = all_devs, index_i = 0; (index_i < dev_index) && (dev_index < total_devs); dev = dev->next, index_i++); // Get the selected interface
+
+		if(!dev->description)
+		{
+			return dev->name; // Linux interfaces usually have no description, so use the name instead
+		}
+
+		return dev->description;
+	}
+
+	int STDCALL net_interface_imp::select_interface_by_num(uint32_t interface_num)
+	{
+		uint32_t index;
+		struct ifreq if_request;
+		struct sockaddr_ll sock_addr;
+		int timestamping_flags = SOF_TIMESTAMPING_TX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+
+		if(interface_num < 1 || interface_num > total_devs)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Interface number out of range.");
+			pcap_freealldevs(all_devs); // Free the device list
+			exit(EXIT_FAILURE);
+		}
+
+		this->interface_num = interface_num;
+
+		if(replay)
+		{
+			return select_replay();
+		}
+
+		for(dev = all_devs, index = 0; index < interface_num - 1; dev = dev->next, index++); // Jump to the selected adapter
+
+		/************************************************************** Open the device ****************************************************************/
+		sock_fd = socket(AF_PACKET, SOCK_RAW | SOCK_CLOEXEC, 0); // Protocol 0, so the socket used for sending captures nothing
+
+		if(sock_fd < 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Unable to open a packet socket for %s. %s", dev->name, strerror(errno));
+			exit(EXIT_FAILURE);
+		}
+
+		memset(&if_request, 0, sizeof(if_request));
+		strncpy(if_request.ifr_name, dev->name, sizeof(if_request.ifr_name) - 1);
+
+		if(ioctl(sock_fd, SIOCGIFINDEX, &if_request) < 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "SIOCGIFINDEX on %s failed.", dev->name);
+			exit(EXIT_FAILURE);
+		}
+
+		if_index = if_request.ifr_ifindex;
+
+		/****************************** Lookup MAC address ***************************/
+		if(ioctl(sock_fd, SIOCGIFHWADDR, &if_request) < 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "SIOCGIFHWADDR on %s failed.", dev->name);
+			exit(EXIT_FAILURE);
+		}
+
+		convert_eui48_to_uint64((uint8_t *)if_request.ifr_hwaddr.sa_data, mac);
+
+		memset(&sock_addr, 0, sizeof(sock_addr));
+		sock_addr.sll_family = AF_PACKET;
+		sock_addr.sll_protocol = 0;
+		sock_addr.sll_ifindex = if_index;
+
+		if(bind(sock_fd, (struct sockaddr *)&sock_addr, sizeof(sock_addr)) < 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Unable to bind to %s. %s", dev->name, strerror(errno));
+			exit(EXIT_FAILURE);
+		}
+
+		/*************************************** Return each sent frame with the time it was handed to the device ***************************************/
+		if(setsockopt(sock_fd, SOL_SOCKET, SO_TIMESTAMPING, &timestamping_flags, sizeof(timestamping_flags)) < 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_WARNING, "SO_TIMESTAMPING error %s", strerror(errno));
+		}
+
+		/*************************************** Open a capture channel for AECP frames and one for ADP frames ***************************************/
+		for(uint32_t index_i = 0; index_i < CAPTURE_CHANNEL_COUNT; index_i++)
+		{
+			if(open_rx_channel(index_i) < 0)
+			{
+				exit(EXIT_FAILURE);
+			}
+		}
+
+		return 0;
+	}
+
+	int net_interface_imp::select_replay()
+	{
+		if(replay->open(CAPTURE_CHANNEL_COUNT) < 0)
+		{
+			exit(EXIT_FAILURE);
+		}
+
+		for(uint32_t index_i = 0; index_i < CAPTURE_CHANNEL_COUNT; index_i++)
+		{
+			struct itimerspec due_time;
+
+			rx_channels[index_i].sock_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+			if((rx_channels[index_i].sock_fd < 0) || (attach_channel_filter(index_i) < 0))
+			{
+				log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Unable to replay %s.", replay->get_capture_file_path());
+				exit(EXIT_FAILURE);
+			}
+
+			memset(&due_time, 0, sizeof(due_time));
+			due_time.it_value.tv_nsec = 1; // The first frame of each channel is read as soon as the engine starts
+			timerfd_settime(rx_channels[index_i].sock_fd, 0, &due_time, NULL);
+		}
+
+		return 0;
+	}
+
+	int net_interface_imp::capture_replay_frame(uint32_t channel_index, const uint8_t **frame, uint16_t *mem_buf_len)
+	{
+		struct itimerspec due_time;
+		uint32_t delay_us;
+		int status;
+
+		status = replay->next_frame(channel_index, frame, mem_buf_len, &delay_us);
+
+		if(status > 0)
+		{
+			return 1;
+		}
+
+		/**
+		 * The timer of the channel stays expired, and so readable, while frames are due. Setting it clears the
+		 * expiration, so the engine is woken again when the next frame is due, or never once the channel is done.
+		 */
+		memset(&due_time, 0, sizeof(due_time));
+
+		if(status == 0)
+		{
+			due_time.it_value.tv_sec = delay_us / 1000000;
+			due_time.it_value.tv_nsec = (delay_us % 1000000) * 1000;
+		}
+
+		timerfd_settime(rx_channels[channel_index].sock_fd, 0, &due_time, NULL);
+
+		return -2; // No frame available
+	}
+
+	int net_interface_imp::open_rx_channel(uint32_t channel_index)
+	{
+		struct rx_channel &channel = rx_channels[channel_index];
+		struct sockaddr_ll sock_addr;
+		struct packet_mreq promisc_request;
+		struct tpacket_req3 rx_ring_request;
+		int tpacket_version = TPACKET_V3;
+
+		channel.sock_fd = socket(AF_PACKET, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, htons(ETH_P_ALL));
+
+		if(channel.sock_fd < 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Unable to open a packet socket for %s. %s", dev->name, strerror(errno));
+			return -1;
+		}
+
+		/************************************************** Map the TPACKET_V3 receive ring *************************************************/
+		if(setsockopt(channel.sock_fd, SOL_PACKET, PACKET_VERSION, &tpacket_version, sizeof(tpacket_version)) < 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "TPACKET_V3 is not supported. %s", strerror(errno));
+			return -1;
+		}
+
+		memset(&rx_ring_request, 0, sizeof(rx_ring_request));
+		rx_ring_request.tp_block_size = RX_RING_BLOCK_SIZE;
+		rx_ring_request.tp_block_nr = RX_RING_BLOCK_COUNT;
+		rx_ring_request.tp_frame_size = RX_RING_FRAME_SIZE;
+		rx_ring_request.tp_frame_nr = (RX_RING_BLOCK_SIZE / RX_RING_FRAME_SIZE) * RX_RING_BLOCK_COUNT;
+		rx_ring_request.tp_retire_blk_tov = RX_RING_BLOCK_TIMEOUT_MS;
+
+		if(setsockopt(channel.sock_fd, SOL_PACKET, PACKET_RX_RING, &rx_ring_request, sizeof(rx_ring_request)) < 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "PACKET_RX_RING error %s", strerror(errno));
+			return -1;
+		}
+
+		channel.ring_len = (size_t)RX_RING_BLOCK_SIZE * RX_RING_BLOCK_COUNT;
+		channel.ring = (uint8_t *)mmap(NULL, channel.ring_len, PROT_READ | PROT_WRITE, MAP_SHARED, channel.sock_fd, 0);
+
+		if(channel.ring == MAP_FAILED)
+		{
+			channel.ring = NULL;
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Unable to map the receive ring. %s", strerror(errno));
+			return -1;
+		}
+
+		/********************************** Only admit the frames of the channel now that the MAC address is known *********************************/
+		if(attach_channel_filter(channel_index) < 0)
+		{
+			return -1;
+		}
+
+		/******************************************* Bind to the interface and capture in promiscuous mode ******************************************/
+		memset(&sock_addr, 0, sizeof(sock_addr));
+		sock_addr.sll_family = AF_PACKET;
+		sock_addr.sll_protocol = htons(ETH_P_ALL);
+		sock_addr.sll_ifindex = if_index;
+
+		if(bind(channel.sock_fd, (struct sockaddr *)&sock_addr, sizeof(sock_addr)) < 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Unable to bind to %s. %s", dev->name, strerror(errno));
+			return -1;
+		}
+
+		memset(&promisc_request, 0, sizeof(promisc_request));
+		promisc_request.mr_ifindex = if_index;
+		promisc_request.mr_type = PACKET_MR_PROMISC;
+
+		if(setsockopt(channel.sock_fd, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &promisc_request, sizeof(promisc_request)) < 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Unable to set %s to promiscuous mode.", dev->name);
+		}
+
+		if(busy_poll_us > 0)
+		{
+			apply_channel_busy_poll(channel_index);
+		}
+
+		return 0;
+	}
+
+	int net_interface_imp::update_capture_filter()
+	{
+		for(uint32_t index_i = 0; index_i < CAPTURE_CHANNEL_COUNT; index_i++)
+		{
+			if((rx_channels[index_i].sock_fd >= 0) && (attach_channel_filter(index_i) < 0))
+			{
+				return -1;
+			}
+		}
+
+		return 0;
+	}
+
+	int net_interface_imp::attach_channel_filter(uint32_t channel_index)
+	{
+		struct rx_channel &channel = rx_channels[channel_index];
+		struct bpf_program program;
+		struct sock_fprog sock_program;
+		const uint8_t *flushed_frame;
+		uint16_t flushed_frame_len;
+
+		if(channel_index == CAPTURE_CHANNEL_AECP)
+		{
+			channel.filter.build(mac, false, true, false);
+		}
+		else
+		{
+			channel.filter.build(mac, true, false, capture_acmp);
+		}
+
+		program = channel.filter.get_program();
+
+		if(replay)
+		{
+			return replay->set_channel_filter(channel_index, &program);
+		}
+
+		sock_program.len = program.bf_len;
+		sock_program.filter = (struct sock_filter *)program.bf_insns; // The libpcap and kernel BPF instruction layouts are identical
+
+		if(setsockopt(channel.sock_fd, SOL_SOCKET, SO_ATTACH_FILTER, &sock_program, sizeof(sock_program)) < 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Error setting the filter. %s", strerror(errno));
+			return -1;
+		}
+
+		/*********** Flush any packets captured before the filter was set **********/
+		while(capture_channel_frame(channel_index, &flushed_frame, &flushed_frame_len) > 0);
+
+		return 0;
+	}
+
+	int net_interface_imp::set_capture_acmp(bool accept_acmp)
+	{
+		capture_acmp = accept_acmp;
+
+		return (rx_channels[CAPTURE_CHANNEL_ADP].sock_fd < 0) ? 0 : attach_channel_filter(CAPTURE_CHANNEL_ADP);
+	}
+
+	int net_interface_imp::get_capture_fd(uint32_t channel_index)
+	{
+		return rx_channels[channel_index].sock_fd;
+	}
+
+	int net_interface_imp::set_busy_poll(uint32_t new_busy_poll_us)
+	{
+		int status = 0;
+
+		busy_poll_us = new_busy_poll_us;
+
+		if(replay)
+		{
+			return 0; // Replayed frames are not captured by the kernel
+		}
+
+		for(uint32_t index_i = 0; index_i < CAPTURE_CHANNEL_COUNT; index_i++)
+		{
+			if((rx_channels[index_i].sock_fd >= 0) && (apply_channel_busy_poll(index_i) < 0))
+			{
+				status = -1;
+			}
+		}
+
+		return status;
+	}
+
+	uint64_t net_interface_imp::get_rx_timestamp()
+	{
+		return rx_timestamp_ns;
+	}
+
+	int net_interface_imp::get_tx_timestamp_fd()
+	{
+		return sock_fd;
+	}
+
+	int net_interface_imp::read_tx_timestamp(const uint8_t **frame, uint16_t *mem_buf_len, uint64_t *tx_timestamp_ns)
+	{
+		struct msghdr msg;
+		struct iovec iov;
+		struct cmsghdr *cmsg;
+		uint8_t control[CMSG_SPACE(sizeof(struct scm_timestamping)) + CMSG_SPACE(sizeof(struct sock_extended_err) + sizeof(struct sockaddr_ll))];
+		ssize_t frame_len;
+
+		*tx_timestamp_ns = 0;
+		iov.iov_base = tx_timestamp_frame;
+		iov.iov_len = sizeof(tx_timestamp_frame);
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_iov = &iov;
+		msg.msg_iovlen = 1;
+		msg.msg_control = control;
+		msg.msg_controllen = sizeof(control);
+
+		frame_len = recvmsg(sock_fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT);
+
+		if(frame_len < 0)
+		{
+			return ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ? 0 : -1;
+		}
+
+		for(cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg))
+		{
+			if((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_TIMESTAMPING))
+			{
+				struct scm_timestamping *timestamps = (struct scm_timestamping *)CMSG_DATA(cmsg);
+
+				*tx_timestamp_ns = (uint64_t)timestamps->ts[0].tv_sec * 1000000000 + timestamps->ts[0].tv_nsec; // ts[0] holds the software timestamp
+			}
+		}
+
+		*frame = tx_timestamp_frame;
+		*mem_buf_len = (uint16_t)frame_len;
+
+		return 1;
+	}
+
+	int net_interface_imp::apply_channel_busy_poll(uint32_t channel_index)
+	{
+#ifdef SO_BUSY_POLL
+		int busy_poll_value = (int)busy_poll_us;
+
+		/**
+		 * Raising the time above the net.core.busy_read sysctl requires CAP_NET_ADMIN. Without it the engine still
+		 * spins on the capture sockets, so this is only reported as a warning.
+		 */
+		if(setsockopt(rx_channels[channel_index].sock_fd, SOL_SOCKET, SO_BUSY_POLL, &busy_poll_value, sizeof(busy_poll_value)) < 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_WARNING, "SO_BUSY_POLL error %s", strerror(errno));
+			return -1;
+		}
+
+		return 0;
+#else
+		log_ref->logging(avdecc_lib::LOGGING_LEVEL_WARNING, "SO_BUSY_POLL is not supported");
+		return -1;
+#endif
+	}
+
+	void net_interface_imp::release_rx_block(struct rx_channel &channel)
+	{
+		channel.block->hdr.bh1.block_status = TP_STATUS_KERNEL;
+		__sync_synchronize();
+		channel.block = NULL;
+		channel.frame = NULL;
+		channel.frames_left = 0;
+		channel.block_index = (channel.block_index + 1) % RX_RING_BLOCK_COUNT;
+	}
+
+	int STDCALL net_interface_imp::capture_frame(const uint8_t **frame, uint16_t *mem_buf_len)
+	{
+		for(uint32_t index_i = 0; index_i < CAPTURE_CHANNEL_COUNT; index_i++)
+		{
+			if(capture_channel_frame(index_i, frame, mem_buf_len) > 0)
+			{
+				return 1;
+			}
+		}
+
+		return -2; // No frame available
+	}
+
+	int net_interface_imp::capture_channel_frame(uint32_t channel_index, const uint8_t **frame, uint16_t *mem_buf_len)
+	{
+		struct rx_channel &channel = rx_channels[channel_index];
+
+		*mem_buf_len = 0;
+
+		if(replay)
+		{
+			return capture_replay_frame(channel_index, frame, mem_buf_len);
+		}
+
+		/**
+		 * Frames are consumed in place, so a block is only handed back to the kernel once the frame captured
+		 * last from it has been processed, which is the next time capture_channel_frame is called.
+		 */
+		while(channel.frames_left == 0)
+		{
+			struct tpacket_block_desc *block;
+
+			if(channel.block)
+			{
+				release_rx_block(channel);
+			}
+
+			block = (struct tpacket_block_desc *)(channel.ring + (size_t)channel.block_index * RX_RING_BLOCK_SIZE);
+
+			if((block->hdr.bh1.block_status & TP_STATUS_USER) == 0)
+			{
+				return -2; // No frame available
+			}
+
+			__sync_synchronize();
+			channel.block = block;
+			channel.frames_left = block->hdr.bh1.num_pkts;
+			channel.frame = (struct tpacket3_hdr *)((uint8_t *)block + block->hdr.bh1.offset_to_first_pkt);
+		}
+
+		*frame = (uint8_t *)channel.frame + channel.frame->tp_mac;
+		*mem_buf_len = (uint16_t)channel.frame->tp_snaplen;
+		rx_timestamp_ns = (uint64_t)channel.frame->tp_sec * 1000000000 + channel.frame->tp_nsec; // Software timestamp taken by the kernel on receipt
+
+		channel.frames_left--;
+		channel.frame = (struct tpacket3_hdr *)((uint8_t *)channel.frame + channel.frame->tp_next_offset);
+
+		return 1;
+	}
+
+	int net_interface_imp::send_frame(uint8_t *frame, uint16_t mem_buf_len)
+	{
+		frame_batch *tx_batch = (frame_batch *)pthread_getspecific(tx_batch_key);
+
+		if(tx_batch && tx_batch->get_is_open())
+		{
+			if(tx_batch->is_full())
+			{
+				send_frames(tx_batch->get_frames(), tx_batch->get_mem_buf_lens(), tx_batch->get_frame_count());
+				tx_batch->clear();
+			}
+
+			if(tx_batch->add_frame(frame, mem_buf_len) == 0)
+			{
+				return 0;
+			}
+		}
+
+		if(replay)
+		{
+			record_tx_frame(frame, mem_buf_len);
+			return 0;
+		}
+
+		if(send(sock_fd, frame, mem_buf_len, 0) < 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "send_frame error %s", strerror(errno));
+			return -1;
+		}
+
+		return 0;
+	}
+
+	int net_interface_imp::send_frames(uint8_t **frames, uint16_t *mem_buf_lens, uint32_t count)
+	{
+		struct mmsghdr msgs[frame_batch::FRAME_BATCH_COUNT];
+		struct iovec iovs[frame_batch::FRAME_BATCH_COUNT];
+		uint32_t sent_count = 0;
+
+		if(replay)
+		{
+			for(uint32_t index_i = 0; index_i < count; index_i++)
+			{
+				record_tx_frame(frames[index_i], mem_buf_lens[index_i]);
+			}
+
+			return 0;
+		}
+
+		while(sent_count < count)
+		{
+			uint32_t submit_count = count - sent_count;
+			int sent;
+
+			if(submit_count > frame_batch::FRAME_BATCH_COUNT)
+			{
+				submit_count = frame_batch::FRAME_BATCH_COUNT;
+			}
+
+			memset(msgs, 0, sizeof(struct mmsghdr) * submit_count);
+
+			for(uint32_t index_i = 0; index_i < submit_count; index_i++)
+			{
+				iovs[index_i].iov_base = frames[sent_count + index_i];
+				iovs[index_i].iov_len = mem_buf_lens[sent_count + index_i];
+				msgs[index_i].msg_hdr.msg_iov = &iovs[index_i];
+				msgs[index_i].msg_hdr.msg_iovlen = 1;
+			}
+
+			sent = sendmmsg(sock_fd, msgs, submit_count, 0);
+
+			if(sent < 0)
+			{
+				if(errno == EINTR)
+				{
+					continue;
+				}
+
+				log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "sendmmsg error %s", strerror(errno));
+				return -1;
+			}
+
+			sent_count += sent;
+		}
+
+		return 0;
+	}
+
+	void net_interface_imp::record_tx_frame(const uint8_t *frame, uint16_t mem_buf_len)
+	{
+		pthread_mutex_lock(&replay_tx_lock);
+		replay->record_tx_frame(frame, mem_buf_len);
+		pthread_mutex_unlock(&replay_tx_lock);
+	}
+
+	void net_interface_imp::free_tx_batch(void *batch)
+	{
+		delete (frame_batch *)batch;
+	}
+
+	void net_interface_imp::tx_batch_begin()
+	{
+		frame_batch *tx_batch = (frame_batch *)pthread_getspecific(tx_batch_key);
+
+		/**
+		 * Each thread that sends frames gets its own batch the first time, freed when the thread exits.
+		 */
+		if(!tx_batch)
+		{
+			tx_batch = new frame_batch();
+			pthread_setspecific(tx_batch_key, tx_batch);
+		}
+
+		tx_batch->open();
+	}
+
+	int net_interface_imp::tx_batch_flush()
+	{
+		frame_batch *tx_batch = (frame_batch *)pthread_getspecific(tx_batch_key);
+		int status = 0;
+
+		if(!tx_batch)
+		{
+			return 0;
+		}
+
+		if(tx_batch->get_frame_count() > 0)
+		{
+			status = send_frames(tx_batch->get_frames(), tx_batch->get_mem_buf_lens(), tx_batch->get_frame_count());
+		}
+
+		tx_batch->close();
+
+		return status;
+	}
+}
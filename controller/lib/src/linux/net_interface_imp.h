@@ -0,0 +1,268 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * net_interface_imp.h
+ *
+ * Network interface implementation class
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_NET_INTERFACE_IMP_H_
+#define _AVDECC_CONTROLLER_LIB_NET_INTERFACE_IMP_H_
+
+#include <stdint.h>
+#include <pthread.h>
+#include <pcap.h>
+#include <linux/if_packet.h>
+#include "build.h"
+#include "net_interface.h"
+#include "frame_batch.h"
+#include "capture_filter.h"
+#include "log.h"
+
+namespace avdecc_lib
+{
+	class capture_replay;
+
+	class net_interface_imp : public virtual net_interface
+	{
+	public:
+		enum capture_channels
+		{
+		        CAPTURE_CHANNEL_AECP, // AECP frames sent to the Controller
+		        CAPTURE_CHANNEL_ADP, // ADP frames, and optionally ACMP frames, sent to a multicast address
+		        CAPTURE_CHANNEL_COUNT
+		};
+
+	private:
+		pcap_if_t *all_devs;
+		pcap_if_t *dev;
+		uint64_t mac;
+		uint32_t total_devs;
+		uint32_t interface_num; // The interface selected
+		char err_buf[PCAP_ERRBUF_SIZE];
+		int if_index; // The kernel index of the interface selected
+		int sock_fd; // AF_PACKET socket used for sending frames, which captures nothing
+
+		enum rx_ring_sizes
+		{
+		        RX_RING_BLOCK_SIZE = 1 << 16, // Size of a ring block, which is handed between the kernel and the library as a whole
+		        RX_RING_BLOCK_COUNT = 64,
+		        RX_RING_FRAME_SIZE = 2048,
+		        RX_RING_BLOCK_TIMEOUT_MS = 1 // A partially filled block is handed to the library after this timeout
+		};
+
+		struct rx_channel
+		{
+			int sock_fd; // AF_PACKET socket used for capturing the frames of the channel, or a timerfd signaling that a replayed frame is due
+			uint8_t *ring; // TPACKET_V3 receive ring mapped from the kernel
+			size_t ring_len;
+			uint32_t block_index; // The ring block that is currently being consumed or is next to be consumed
+			struct tpacket_block_desc *block; // The ring block currently owned by the library, NULL if none
+			struct tpacket3_hdr *frame; // The next frame to be captured in block
+			uint32_t frames_left; // The number of frames in block that have not been captured yet
+			capture_filter filter; // Program that admits only the frames of the channel
+		};
+
+		struct rx_channel rx_channels[CAPTURE_CHANNEL_COUNT];
+		pthread_key_t tx_batch_key; // The frame_batch of each thread sending frames, so that the engine threads batch separately
+		pthread_mutex_t replay_tx_lock; // Keeps the frames recorded by different threads from interleaving in the replay file
+		bool capture_acmp; // Set if ACMP frames are admitted by the ADP channel
+		uint32_t busy_poll_us; // The time the kernel busy polls the device for a capture socket, 0 if disabled
+		capture_replay *replay; // The source of the frames captured when a capture file is replayed, NULL for a live interface
+		log netif_log; // The log used until the network interface is attached to a Controller, which has no thread
+		log *log_ref; // The log of the Controller the network interface is attached to, or netif_log
+		uint64_t rx_timestamp_ns; // The time the frame captured last was received by the kernel, 0 if unknown
+		uint8_t tx_timestamp_frame[frame_batch::FRAME_BATCH_FRAME_SIZE]; // A sent frame returned with its transmit timestamp
+
+	public:
+		/**
+		 * An empty constructor for net_interface_imp
+		 */
+		net_interface_imp();
+
+		/**
+		 * A constructor for net_interface_imp used for replaying a capture file in place of a live interface, with the
+		 * MAC address of the Controller that recorded it, the replay pace, and the file the frames sent are recorded
+		 * to, or NULL to discard them.
+		 */
+		net_interface_imp(const char *capture_file_path, uint64_t replay_mac, bool is_recorded_pace, const char *tx_file_path);
+
+		/**
+		 * Destructor for net_interface_imp used for destroying objects
+		 */
+		virtual ~net_interface_imp();
+
+		/**
+		 * Count the number of devices.
+		 */
+		uint32_t STDCALL devs_count();
+
+		/**
+		 * Get the MAC address of the network interface.
+		 */
+		uint64_t get_mac();
+
+		/**
+		 * Set the log the network interface logs to, or NULL to log to its own log.
+		 */
+		void set_log(log *new_log_ref);
+
+		/**
+		 * Get the corresponding device description by index.
+		 */
+		char * STDCALL get_dev_desc_by_index(uint32_t dev_index);
+
+		/**
+		 * Select the corresponding interface by number.
+		 */
+		int STDCALL select_interface_by_num(uint32_t interface_num);
+
+		/**
+		 * Generate the capture filters for the MAC address of the interface selected and attach them, so that only AECP
+		 * frames sent to the Controller are captured on the AECP channel, and only ADP frames and optionally ACMP frames
+		 * sent to a multicast address are captured on the ADP channel.
+		 */
+		int update_capture_filter();
+
+		/**
+		 * Set whether ACMP frames are captured and update the capture filter if an interface is selected.
+		 */
+		int set_capture_acmp(bool accept_acmp);
+
+		/**
+		 * Get the file descriptor of the capture socket of a channel, which becomes readable when a frame can be captured.
+		 */
+		int get_capture_fd(uint32_t channel_index);
+
+		/**
+		 * Set the time in microseconds the kernel busy polls the device queue for frames when the capture sockets are
+		 * polled and no frame is ready (SO_BUSY_POLL), or 0 to disable busy polling.
+		 */
+		int set_busy_poll(uint32_t new_busy_poll_us);
+
+		/**
+		 * Get the time in nanoseconds since the Unix epoch the frame captured last was received by the kernel, or 0 if
+		 * it is unknown.
+		 */
+		uint64_t get_rx_timestamp();
+
+		/**
+		 * Get the file descriptor of the socket used for sending frames, which reports an error condition when the
+		 * transmit timestamp of a sent frame can be read, or -1 if there is none.
+		 */
+		int get_tx_timestamp_fd();
+
+		/**
+		 * Read a sent frame together with the time in nanoseconds since the Unix epoch it was handed to the device
+		 * (SO_TIMESTAMPING software timestamps). The frame stays valid until the next call.
+		 *
+		 * \return 1 if a frame is returned, 0 if no transmit timestamp is left to read, or -1 on error.
+		 */
+		int read_tx_timestamp(const uint8_t **frame, uint16_t *mem_buf_len, uint64_t *tx_timestamp_ns);
+
+		/**
+		 * Capture a network packet without blocking, from the AECP channel first. The frame points directly into the
+		 * receive ring and stays valid until the next call for the same channel.
+		 */
+		int STDCALL capture_frame(const uint8_t **frame, uint16_t *mem_buf_len);
+
+		/**
+		 * Capture a network packet of a channel without blocking. The frame points directly into the receive ring of the
+		 * channel and stays valid until the next call, when the ring block is handed back to the kernel once all of its
+		 * frames have been captured.
+		 */
+		int capture_channel_frame(uint32_t channel_index, const uint8_t **frame, uint16_t *mem_buf_len);
+
+		/**
+		 * Send a network packet. While the calling thread has a transmit batch open the packet is held and sent by
+		 * tx_batch_flush.
+		 */
+		int send_frame(uint8_t *frame, uint16_t mem_buf_len);
+
+		/**
+		 * Send several network packets with a single submission.
+		 */
+		int send_frames(uint8_t **frames, uint16_t *mem_buf_lens, uint32_t count);
+
+		/**
+		 * Open the transmit batch of the calling thread, so that packets the thread sends until it calls tx_batch_flush
+		 * are held and sent together.
+		 */
+		void tx_batch_begin();
+
+		/**
+		 * Send all packets held in the transmit batch of the calling thread with a single submission and close the batch.
+		 */
+		int tx_batch_flush();
+
+	private:
+		/**
+		 * Set the members that are common to a live interface and a replayed capture file to their initial values.
+		 */
+		void init_members();
+
+		/**
+		 * Record a sent frame to the replay file.
+		 */
+		void record_tx_frame(const uint8_t *frame, uint16_t mem_buf_len);
+
+		/**
+		 * Free the transmit batch of a thread when the thread exits.
+		 */
+		static void free_tx_batch(void *batch);
+
+		/**
+		 * Open the capture file for each channel and a timer signaling when the next frame of a channel is due.
+		 */
+		int select_replay();
+
+		/**
+		 * Capture the next replayed frame of a channel if it is due, or arm the timer of the channel for when it is.
+		 */
+		int capture_replay_frame(uint32_t channel_index, const uint8_t **frame, uint16_t *mem_buf_len);
+
+		/**
+		 * Open the capture socket of a channel, map its receive ring, and attach its capture filter.
+		 */
+		int open_rx_channel(uint32_t channel_index);
+
+		/**
+		 * Generate the capture filter of a channel and attach it.
+		 */
+		int attach_channel_filter(uint32_t channel_index);
+
+		/**
+		 * Apply the busy poll time to the capture socket of a channel.
+		 */
+		int apply_channel_busy_poll(uint32_t channel_index);
+
+		/**
+		 * Hand the ring block owned by the library back to the kernel.
+		 */
+		void release_rx_block(struct rx_channel &channel);
+	};
+}
+
+#endif
@@ -0,0 +1,152 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * notification.cpp
+ *
+ * Notification implementation
+ */
+
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include "enumeration.h"
+#include "notification.h"
+
+extern "C" void default_notification(void *notification_user_obj, int32_t notification_type, uint64_t guid, uint16_t cmd_type,
+                                     uint16_t desc_type, uint16_t desc_index, void *notification_id)
+{
+	printf("default_notification (%d, %llx, %d, %d, %d, %p)\n", notification_type, (unsigned long long)guid, cmd_type, desc_type, desc_index, notification_id);
+}
+
+namespace avdecc_lib
+{
+	notification::notification()
+	{
+		read_index = 0;
+		write_index = 0;
+		notifications = avdecc_lib::NO_MATCH_FOUND;
+		notification_callback = default_notification;
+		user_obj = NULL;
+		missed_notification_event_cnt = 0;
+		kill_event = false;
+
+		notification_thread_init(); // Start notification thread
+	}
+
+	notification::~notification()
+	{
+		kill_event = true;
+		sem_post(&notification_event);
+		pthread_join(h_thread, NULL); // Wait for thread termination
+		sem_destroy(&notification_event);
+	}
+
+	int notification::notification_thread_init()
+	{
+		sem_init(&notification_event, 0, 0);
+
+		if(pthread_create(&h_thread, NULL, process_notification_thread, this) != 0)
+		{
+			exit(EXIT_FAILURE);
+		}
+
+		return 0;
+	}
+
+	void * notification::process_notification_thread(void *lpParam)
+	{
+		notification *notifier = (notification *)lpParam;
+		struct notification_data *data = notifier->notification_buf;
+
+		while (true)
+		{
+			sem_wait(&notifier->notification_event);
+
+			if(notifier->kill_event)
+			{
+				break;
+			}
+
+			if((notifier->write_index - notifier->read_index) > 0)
+			{
+				uint32_t read_index = notifier->read_index;
+
+				notifier->notification_callback(notifier->user_obj,
+				                                data[read_index % NOTIFICATION_BUF_COUNT].notification_type,
+				                                data[read_index % NOTIFICATION_BUF_COUNT].guid,
+				                                data[read_index % NOTIFICATION_BUF_COUNT].cmd_type,
+				                                data[read_index % NOTIFICATION_BUF_COUNT].desc_type,
+				                                data[read_index % NOTIFICATION_BUF_COUNT].desc_index,
+				                                data[read_index % NOTIFICATION_BUF_COUNT].notification_id
+				                               ); // Call callback function
+				notifier->read_index++;
+			}
+		}
+
+		return 0;
+	}
+
+	void notification::notifying(int32_t notification_type, uint64_t guid, uint16_t cmd_type, uint16_t desc_type, uint16_t desc_index, void *notification_id)
+	{
+		if((write_index - read_index) > NOTIFICATION_BUF_COUNT)
+		{
+			missed_notification_event_cnt++;
+			return;
+		}
+
+		if(notification_type == avdecc_lib::NO_MATCH_FOUND || notification_type == avdecc_lib::END_STATION_DISCOVERED ||
+		   notification_type == avdecc_lib::END_STATION_CONNECTED || notification_type == avdecc_lib::END_STATION_RECONNECTED ||
+		   notification_type == avdecc_lib::END_STATION_DISCONNECTED || notification_type == avdecc_lib::COMMAND_SENT ||
+		   notification_type == avdecc_lib::COMMAND_TIMEOUT || notification_type == avdecc_lib::COMMAND_RESENT ||
+		   notification_type == avdecc_lib::RESPONSE_RECEIVED || notification_type == avdecc_lib::COMMAND_SUCCESS)
+		{
+			notification_buf[write_index % NOTIFICATION_BUF_COUNT].notification_type = notification_type;
+			notification_buf[write_index % NOTIFICATION_BUF_COUNT].guid = guid;
+			notification_buf[write_index % NOTIFICATION_BUF_COUNT].cmd_type = cmd_type;
+			notification_buf[write_index % NOTIFICATION_BUF_COUNT].desc_type = desc_type;
+			notification_buf[write_index % NOTIFICATION_BUF_COUNT].desc_index = desc_index;
+			notification_buf[write_index % NOTIFICATION_BUF_COUNT].notification_id = notification_id;
+
+			write_index++;
+			sem_post(&notification_event);
+		}
+	}
+
+	void notification::set_notification_callback(void (*new_notification_callback) (void *, int32_t, uint64_t, uint16_t,
+	                                                                                uint16_t, uint16_t, void *), void *p)
+	{
+		notification_callback = new_notification_callback;
+		user_obj = p;
+	}
+
+	uint32_t notification::get_missed_notification_event_count()
+	{
+		return missed_notification_event_cnt;
+	}
+
+	pthread_t notification::get_thread_handle()
+	{
+		return h_thread;
+	}
+}
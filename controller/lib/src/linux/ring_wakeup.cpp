@@ -0,0 +1,87 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * ring_wakeup.cpp
+ *
+ * Ring wakeup implementation
+ */
+
+#include <errno.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include "atomic_ops.h"
+#include "ring_wakeup.h"
+
+namespace avdecc_lib
+{
+	ring_wakeup::ring_wakeup()
+	{
+		event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		consumer_idle = 1;
+	}
+
+	ring_wakeup::~ring_wakeup()
+	{
+		close(event_fd);
+	}
+
+	void ring_wakeup::notify()
+	{
+		uint64_t one = 1;
+
+		atomic_full_barrier(); // Publish the entries before reading the idle flag
+
+		if(consumer_idle && (atomic_cas_uint32(&consumer_idle, 1, 0) == 1))
+		{
+			/**
+			 * The write only fails with EAGAIN if the counter is about to overflow, in which case the eventfd is
+			 * already readable.
+			 */
+			while((write(event_fd, &one, sizeof(one)) < 0) && (errno == EINTR));
+		}
+	}
+
+	void ring_wakeup::begin_idle()
+	{
+		consumer_idle = 1;
+		atomic_full_barrier(); // Publish the idle flag before the consumer checks the ring again
+	}
+
+	void ring_wakeup::cancel_idle()
+	{
+		consumer_idle = 0;
+	}
+
+	void ring_wakeup::clear()
+	{
+		uint64_t count;
+
+		while((read(event_fd, &count, sizeof(count)) < 0) && (errno == EINTR)); // Reset the eventfd counter, EAGAIN if it was not signalled
+	}
+
+	ring_wakeup::wakeup_handle ring_wakeup::get_handle()
+	{
+		return event_fd;
+	}
+}
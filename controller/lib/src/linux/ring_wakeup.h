@@ -0,0 +1,85 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * ring_wakeup.h
+ *
+ * Ring wakeup class, which wakes the consumer of a System ring through an eventfd when the consumer is idle.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_RING_WAKEUP_H_
+#define _AVDECC_CONTROLLER_LIB_RING_WAKEUP_H_
+
+#include <stdint.h>
+
+namespace avdecc_lib
+{
+	class ring_wakeup
+	{
+	public:
+		typedef int wakeup_handle;
+
+	private:
+		int event_fd; // Signaled by the producer to wake the consumer
+		volatile uint32_t consumer_idle; // Set by the consumer before it blocks, cleared by the producer that wakes it
+
+	public:
+		/**
+		 * An empty constructor for ring_wakeup
+		 */
+		ring_wakeup();
+
+		/**
+		 * Destructor for ring_wakeup used for destroying objects
+		 */
+		~ring_wakeup();
+
+		/**
+		 * Wake the consumer if it is idle. Called by a producer after it has added entries to the ring.
+		 */
+		void notify();
+
+		/**
+		 * Mark the consumer as idle. The consumer must check the ring again before it blocks.
+		 */
+		void begin_idle();
+
+		/**
+		 * Mark the consumer as busy again, after the ring was found not to be empty.
+		 */
+		void cancel_idle();
+
+		/**
+		 * Reset the wakeup after the consumer has been woken.
+		 */
+		void clear();
+
+		/**
+		 * Get the handle the consumer waits on.
+		 */
+		wakeup_handle get_handle();
+	};
+}
+
+#endif
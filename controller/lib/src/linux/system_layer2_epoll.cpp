@@ -0,0 +1,1345 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * system_layer2_epoll.cpp
+ *
+ * Linux System implementation
+ */
+
+#include <vector>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sched.h>
+#include <time.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include "net_interface_imp.h"
+#include "enumeration.h"
+#include "notification.h"
+#include "log.h"
+#include "end_station.h"
+#include "controller_imp.h"
+#include "mpsc_ring.h"
+#include "controller_context.h"
+#include "timer_wheel.h"
+#include "frame_view.h"
+#include "adp.h"
+#include "aecp.h"
+#include "engine_shard.h"
+#include "aem_controller_state_machine.h"
+#include "desc_decode_pool.h"
+#include "system_layer2_epoll.h"
+
+namespace avdecc_lib
+{
+	system * STDCALL create_system(system::system_type type, net_interface *netif, controller *controller_obj)
+	{
+		return new system_layer2_epoll(netif, controller_obj);
+	}
+
+	system_layer2_epoll::system_layer2_epoll() {}
+
+	system_layer2_epoll::system_layer2_epoll(net_interface *netif, controller *controller_obj)
+	{
+		context = dynamic_cast<controller_imp *>(controller_obj)->get_context();
+		netif_obj_in_system = dynamic_cast<net_interface_imp *>(netif);
+
+		if(!netif_obj_in_system)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Dynamic cast from base net_interface to derived net_interface_imp error");
+		}
+
+		controller_ref_in_system = controller_obj;
+		tx_queue = NULL;
+		epoll_fd = -1;
+		timeout_fd = -1;
+		timeout_fd_expiry_ms = 0;
+		tx_timestamp_fd = -1;
+		kill_fd = -1;
+		queue_frames = new frame_slab(QUEUE_FRAME_COUNT);
+		memset(&rx_stats, 0, sizeof(rx_stats));
+		memset(rx_backlog, 0, sizeof(rx_backlog));
+		tx_pending = false;
+		decode_pool = NULL;
+		decoded_desc_pending = false;
+		busy_poll_budget_us = 0;
+		spin_budget_us = 0;
+		memset(&busy_stats, 0, sizeof(busy_stats));
+		memset(thread_settings, 0, sizeof(thread_settings));
+		is_waiting = false;
+		queue_is_waiting = false;
+		waiting_notification_id = 0;
+		completion_queue = NULL;
+		resp_status_for_cmd = STATUS_INVALID_COMMAND;
+		poll_thread.is_running = false;
+		context->system_tx_queue_ref = this; // Commands built by the Controller are queued to this System
+	}
+
+	system_layer2_epoll::~system_layer2_epoll()
+	{
+		free_thread_resources();
+		delete decode_pool;
+		delete queue_frames;
+		sem_destroy(&waiting_sem);
+		context->system_tx_queue_ref = NULL;
+		controller_ref_in_system->destroy(); // Detaches the network interface from the log of the Controller
+		delete netif_obj_in_system;
+	}
+
+	void STDCALL system_layer2_epoll::destroy()
+	{
+		delete this;
+	}
+
+	int system_layer2_epoll::queue_tx_reserve(struct system_tx_slot &slot)
+	{
+		if(queue_frames->alloc(slot.frame_index) < 0)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "queue_tx_reserve error, no frame buffer available");
+			queue_is_waiting = false;
+			return -1;
+		}
+
+		slot.frame = queue_frames->get_frame(slot.frame_index);
+		slot.frame_size = frame_slab::FRAME_SLAB_FRAME_SIZE;
+
+		return 0;
+	}
+
+	void system_layer2_epoll::queue_tx_abort(struct system_tx_slot &slot)
+	{
+		queue_frames->release(slot.frame_index);
+		queue_is_waiting = false;
+	}
+
+	int system_layer2_epoll::queue_tx_commit(struct system_tx_slot &slot, void *notification_id, uint32_t notification_flag, size_t mem_buf_len)
+	{
+		struct poll_thread_data thread_data;
+
+		thread_data.frame_index = slot.frame_index;
+		thread_data.mem_buf_len = mem_buf_len;
+		thread_data.notification_id = notification_id;
+		thread_data.notification_flag = notification_flag;
+		thread_data.is_waited_on = queue_is_waiting; // The poll thread takes over the wait with the command
+
+		while(tx_queue->push(&thread_data) < 0)
+		{
+			sched_yield(); // Wait for the poll thread to make space in the transmit queue
+		}
+
+		/**
+		 * If queue_is_waiting is true, wait for the response before returning.
+		 */
+		if(queue_is_waiting)
+		{
+			while(sem_wait(&waiting_sem) != 0 && errno == EINTR);
+			queue_is_waiting = false;
+		}
+
+		return 0;
+	}
+
+	int STDCALL system_layer2_epoll::set_wait_for_next_cmd(void *notification_id)
+	{
+		queue_is_waiting = true;
+		resp_status_for_cmd = STATUS_INVALID_COMMAND; // Reset the status
+
+		return 0;
+	}
+
+	int STDCALL system_layer2_epoll::get_last_resp_status()
+	{
+		return resp_status_for_cmd;
+	}
+
+	uint32_t STDCALL system_layer2_epoll::queue_frame_high_watermark()
+	{
+		return queue_frames->get_high_watermark();
+	}
+
+	uint32_t STDCALL system_layer2_epoll::missed_queue_frame_count()
+	{
+		return queue_frames->get_exhausted_count();
+	}
+
+	void STDCALL system_layer2_epoll::get_rx_batch_stats(uint32_t &batch_count, uint32_t &frame_count, uint32_t &max_batch_size)
+	{
+		batch_count = rx_stats.batch_count;
+		frame_count = rx_stats.frame_count;
+		max_batch_size = rx_stats.max_batch_size;
+	}
+
+	void STDCALL system_layer2_epoll::get_adp_shed_stats(uint32_t &adp_frame_count, uint32_t &shed_count)
+	{
+		adp_frame_count = adp_shedder.get_adp_frame_count();
+		shed_count = adp_shedder.get_shed_count();
+	}
+
+	int STDCALL system_layer2_epoll::set_busy_poll(uint32_t new_spin_budget_us)
+	{
+		busy_poll_budget_us = new_spin_budget_us;
+		spin_budget_us = new_spin_budget_us;
+
+		return netif_obj_in_system->set_busy_poll(new_spin_budget_us);
+	}
+
+	void STDCALL system_layer2_epoll::get_busy_poll_stats(uint32_t &spin_hit_count, uint32_t &sleep_count)
+	{
+		spin_hit_count = busy_stats.spin_hit_count;
+		sleep_count = busy_stats.sleep_count;
+	}
+
+	int STDCALL system_layer2_epoll::set_thread_sched(thread_role role, int32_t cpu, thread_policy policy, int32_t priority)
+	{
+		switch(role)
+		{
+			case THREAD_POLL:
+				thread_settings[role].is_set = true;
+				thread_settings[role].cpu = cpu;
+				thread_settings[role].policy = policy;
+				thread_settings[role].priority = priority;
+
+				if(!poll_thread.is_running)
+				{
+					return 0; // Applied when the poll thread is created
+				}
+
+				for(uint32_t shard_index = 0; shard_index < shard_threads.size(); shard_index++)
+				{
+					if(thread_sched::apply(context->log_ref, shard_threads.at(shard_index).engine_thread.handle, -1, policy, priority) < 0)
+					{
+						return -1;
+					}
+				}
+
+				return thread_sched::apply(context->log_ref, poll_thread.handle, cpu, policy, priority);
+
+			case THREAD_NOTIFICATION:
+				return thread_sched::apply(context->log_ref, context->notification_ref->get_thread_handle(), cpu, policy, priority);
+
+			case THREAD_LOG:
+				return thread_sched::apply(context->log_ref, context->log_ref->get_thread_handle(), cpu, policy, priority);
+
+			default:
+				context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "No capture thread, frames are captured on the poll thread");
+				return -1;
+		}
+	}
+
+	int STDCALL system_layer2_epoll::get_thread_sched(thread_role role, int32_t &cpu, thread_policy &policy, int32_t &priority)
+	{
+		switch(role)
+		{
+			case THREAD_POLL:
+				if(!poll_thread.is_running)
+				{
+					return -1;
+				}
+
+				return thread_sched::get(context->log_ref, poll_thread.handle, cpu, policy, priority);
+
+			case THREAD_NOTIFICATION:
+				return thread_sched::get(context->log_ref, context->notification_ref->get_thread_handle(), cpu, policy, priority);
+
+			case THREAD_LOG:
+				return thread_sched::get(context->log_ref, context->log_ref->get_thread_handle(), cpu, policy, priority);
+
+			default:
+				return -1;
+		}
+	}
+
+	int STDCALL system_layer2_epoll::set_engine_shards(uint32_t shard_count)
+	{
+		if(poll_thread.is_running)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "The engine can only be sharded before process_start");
+			return -1;
+		}
+
+		if(context->controller_imp_ref->set_engine_shard_count(shard_count) < 0)
+		{
+			return -1;
+		}
+
+		/**
+		 * Frames routed to the engine threads are held in the queue frame slab until the shard has processed them.
+		 */
+		delete queue_frames;
+		queue_frames = new frame_slab((shard_count > 1) ? SHARDED_QUEUE_FRAME_COUNT : QUEUE_FRAME_COUNT);
+
+		return 0;
+	}
+
+	int STDCALL system_layer2_epoll::set_desc_decode_workers(uint32_t worker_count)
+	{
+		if(poll_thread.is_running)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "The decode threads can only be set before process_start");
+			return -1;
+		}
+
+		if(worker_count > desc_decode_pool::DECODE_WORKER_MAX_COUNT)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Invalid decode thread count %u, the maximum is %u",
+			                          worker_count, (uint32_t)desc_decode_pool::DECODE_WORKER_MAX_COUNT);
+			return -1;
+		}
+
+		delete decode_pool;
+		decode_pool = (worker_count > 0) ? new desc_decode_pool(worker_count) : NULL;
+
+		return 0;
+	}
+
+	void * system_layer2_epoll::proc_poll_thread(void *lpParam)
+	{
+		system_layer2_epoll *system_obj = (system_layer2_epoll *)lpParam;
+		int status;
+
+		while(true)
+		{
+			system_obj->netif_obj_in_system->tx_batch_begin(); // Frames sent while handling this event go out together
+			status = system_obj->poll_single();
+			system_obj->netif_obj_in_system->tx_batch_flush();
+
+			if(status != 0)
+			{
+				break;
+			}
+		}
+
+		return 0;
+	}
+
+	void * system_layer2_epoll::proc_shard_thread(void *lpParam)
+	{
+		struct shard_thread *worker = (struct shard_thread *)lpParam;
+		net_interface_imp *netif = worker->owner->netif_obj_in_system;
+		int status;
+
+		/**
+		 * The engine thread batches the frames it sends in its own transmit batch.
+		 */
+		do
+		{
+			netif->tx_batch_begin();
+			status = worker->owner->poll_shard(*worker);
+			netif->tx_batch_flush();
+		}
+		while(status == 0);
+
+		return 0;
+	}
+
+	void * system_layer2_epoll::proc_decode_thread(void *lpParam)
+	{
+		struct decode_thread *worker = (struct decode_thread *)lpParam;
+
+		while(worker->owner->poll_decode(*worker) == 0);
+
+		return 0;
+	}
+
+	int STDCALL system_layer2_epoll::process_start()
+	{
+		if(init_decode_threads() < 0 || init_shard_threads() < 0 || init_epoll() < 0 || init_poll_thread() < 0)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "init_polling error");
+
+			/**
+			 * Stop the threads started before the failure, so that none is left running on the queues freed.
+			 */
+			process_close();
+			free_thread_resources();
+			return -1;
+		}
+
+		return 0;
+	}
+
+	void system_layer2_epoll::free_thread_resources()
+	{
+		for(uint32_t shard_index = 0; shard_index < shard_threads.size(); shard_index++)
+		{
+			delete shard_threads.at(shard_index).work_queue;
+			close(shard_threads.at(shard_index).epoll_fd);
+			close(shard_threads.at(shard_index).timeout_fd);
+			close(shard_threads.at(shard_index).kill_fd);
+		}
+
+		shard_threads.clear();
+
+		for(uint32_t worker_index = 0; worker_index < decode_threads.size(); worker_index++)
+		{
+			close(decode_threads.at(worker_index).epoll_fd);
+			close(decode_threads.at(worker_index).kill_fd);
+		}
+
+		decode_threads.clear();
+
+		delete completion_queue;
+		completion_queue = NULL;
+		delete tx_queue;
+		tx_queue = NULL;
+		close(epoll_fd);
+		epoll_fd = -1;
+		close(timeout_fd);
+		timeout_fd = -1;
+		close(kill_fd);
+		kill_fd = -1;
+	}
+
+	int system_layer2_epoll::epoll_add(int fd, enum epoll_events event)
+	{
+		struct epoll_event ev;
+
+		memset(&ev, 0, sizeof(ev));
+		ev.events = EPOLLIN;
+		ev.data.u32 = event;
+
+		return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+	}
+
+	int system_layer2_epoll::init_epoll()
+	{
+		epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+
+		if(epoll_fd < 0)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "epoll_create1 error %s", strerror(errno));
+			return -1;
+		}
+
+		/**
+		 * The timer follows the deadlines of the timer wheel, so timers expire on time whatever the traffic on the
+		 * capture sockets.
+		 */
+		timeout_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+		service_timers(true);
+
+		tx_queue = new mpsc_ring(QUEUE_DEPTH, sizeof(struct poll_thread_data), true);
+		kill_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		capture_fds[net_interface_imp::CAPTURE_CHANNEL_AECP] = netif_obj_in_system->get_capture_fd(net_interface_imp::CAPTURE_CHANNEL_AECP);
+		capture_fds[net_interface_imp::CAPTURE_CHANNEL_ADP] = netif_obj_in_system->get_capture_fd(net_interface_imp::CAPTURE_CHANNEL_ADP);
+		tx_timestamp_fd = netif_obj_in_system->get_tx_timestamp_fd();
+		sem_init(&waiting_sem, 0, 0);
+
+		if(epoll_add(timeout_fd, EPOLL_TIMEOUT) < 0 ||
+		   ((tx_timestamp_fd >= 0) && (epoll_add(tx_timestamp_fd, EPOLL_TX_TIMESTAMP) < 0)) ||
+		   epoll_add(capture_fds[net_interface_imp::CAPTURE_CHANNEL_AECP], EPOLL_RX_AECP_PACKET) < 0 ||
+		   epoll_add(capture_fds[net_interface_imp::CAPTURE_CHANNEL_ADP], EPOLL_RX_ADP_PACKET) < 0 ||
+		   epoll_add(tx_queue->wakeup_object(), EPOLL_TX_PACKET) < 0 ||
+		   (decode_pool && shard_threads.empty() &&
+		    (epoll_add(context->engine_shard_ref->get_decoded_desc_queue()->wakeup_object(), EPOLL_DECODED_DESC) < 0)) ||
+		   (completion_queue && (epoll_add(completion_queue->wakeup_object(), EPOLL_CMD_COMPLETION) < 0)) ||
+		   epoll_add(kill_fd, KILL_ALL) < 0)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "epoll_ctl error %s", strerror(errno));
+			return -1;
+		}
+
+		return 0;
+	}
+
+	int system_layer2_epoll::init_poll_thread()
+	{
+		if(pthread_create(&poll_thread.handle, NULL, proc_poll_thread, this) != 0)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Error creating the poll thread");
+			return -1;
+		}
+
+		poll_thread.is_running = true;
+
+		if(thread_sched::apply(context->log_ref, poll_thread.handle, thread_settings[THREAD_POLL]) < 0)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_WARNING, "The poll thread runs with the default scheduling");
+		}
+
+		return 0;
+	}
+
+	int system_layer2_epoll::init_shard_threads()
+	{
+		uint32_t shard_count = context->controller_imp_ref->get_engine_shard_count();
+		struct thread_sched::setting engine_setting = thread_settings[THREAD_POLL];
+		struct shard_thread idle_worker;
+
+		if(shard_count == 1)
+		{
+			return 0; // The poll thread runs the engine
+		}
+
+		engine_setting.cpu = -1; // The engine threads are spread over the CPUs
+
+		memset(&idle_worker, 0, sizeof(idle_worker));
+		idle_worker.owner = this;
+		idle_worker.epoll_fd = -1;
+		idle_worker.timeout_fd = -1;
+		idle_worker.kill_fd = -1;
+		shard_threads.assign(shard_count, idle_worker);
+		completion_queue = new mpsc_ring(COMPLETION_QUEUE_DEPTH, sizeof(struct cmd_completion), true);
+
+		for(uint32_t shard_index = 0; shard_index < shard_count; shard_index++)
+		{
+			struct shard_thread &worker = shard_threads.at(shard_index);
+			struct epoll_event ev;
+
+			worker.shard = context->controller_imp_ref->get_engine_shard(shard_index);
+			worker.work_queue = new mpsc_ring(SHARDED_QUEUE_FRAME_COUNT, sizeof(struct shard_work), true);
+			worker.epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+			worker.timeout_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+			worker.kill_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+			memset(&ev, 0, sizeof(ev));
+			ev.events = EPOLLIN;
+
+			ev.data.u32 = SHARD_EPOLL_TIMEOUT;
+			if(epoll_ctl(worker.epoll_fd, EPOLL_CTL_ADD, worker.timeout_fd, &ev) < 0)
+			{
+				context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "epoll_ctl error %s", strerror(errno));
+				return -1;
+			}
+
+			ev.data.u32 = SHARD_EPOLL_WORK;
+			if(epoll_ctl(worker.epoll_fd, EPOLL_CTL_ADD, worker.work_queue->wakeup_object(), &ev) < 0)
+			{
+				context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "epoll_ctl error %s", strerror(errno));
+				return -1;
+			}
+
+			if(decode_pool)
+			{
+				ev.data.u32 = SHARD_EPOLL_DECODED_DESC;
+				if(epoll_ctl(worker.epoll_fd, EPOLL_CTL_ADD, worker.shard->get_decoded_desc_queue()->wakeup_object(), &ev) < 0)
+				{
+					context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "epoll_ctl error %s", strerror(errno));
+					return -1;
+				}
+			}
+
+			ev.data.u32 = SHARD_KILL;
+			if(epoll_ctl(worker.epoll_fd, EPOLL_CTL_ADD, worker.kill_fd, &ev) < 0)
+			{
+				context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "epoll_ctl error %s", strerror(errno));
+				return -1;
+			}
+
+			service_shard_timers(worker, true);
+
+			if(pthread_create(&worker.engine_thread.handle, NULL, proc_shard_thread, &worker) != 0)
+			{
+				context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Error creating an engine thread");
+				return -1;
+			}
+
+			worker.engine_thread.is_running = true;
+
+			if(thread_sched::apply(context->log_ref, worker.engine_thread.handle, engine_setting) < 0)
+			{
+				context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_WARNING, "The engine thread runs with the default scheduling");
+			}
+		}
+
+		return 0;
+	}
+
+	int system_layer2_epoll::init_decode_threads()
+	{
+		struct decode_thread idle_worker;
+
+		for(uint32_t shard_index = 0; shard_index < context->controller_imp_ref->get_engine_shard_count(); shard_index++)
+		{
+			context->controller_imp_ref->get_engine_shard(shard_index)->set_desc_decode_pool(decode_pool);
+		}
+
+		if(!decode_pool)
+		{
+			return 0; // The descriptors are decoded by the engine
+		}
+
+		memset(&idle_worker, 0, sizeof(idle_worker));
+		idle_worker.owner = this;
+		idle_worker.epoll_fd = -1;
+		idle_worker.kill_fd = -1;
+		decode_threads.assign(decode_pool->get_worker_count(), idle_worker);
+
+		for(uint32_t worker_index = 0; worker_index < decode_threads.size(); worker_index++)
+		{
+			struct decode_thread &worker = decode_threads.at(worker_index);
+			struct epoll_event ev;
+
+			worker.worker_index = worker_index;
+			worker.epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+			worker.kill_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+			memset(&ev, 0, sizeof(ev));
+			ev.events = EPOLLIN;
+
+			ev.data.u32 = DECODE_EPOLL_JOB;
+			if(epoll_ctl(worker.epoll_fd, EPOLL_CTL_ADD, decode_pool->wakeup_object(worker_index), &ev) < 0)
+			{
+				context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "epoll_ctl error %s", strerror(errno));
+				return -1;
+			}
+
+			ev.data.u32 = DECODE_KILL;
+			if(epoll_ctl(worker.epoll_fd, EPOLL_CTL_ADD, worker.kill_fd, &ev) < 0)
+			{
+				context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "epoll_ctl error %s", strerror(errno));
+				return -1;
+			}
+
+			/**
+			 * The decode threads keep the default scheduling, so they never hold up the engine.
+			 */
+			if(pthread_create(&worker.worker_thread.handle, NULL, proc_decode_thread, &worker) != 0)
+			{
+				context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Error creating a decode thread");
+				return -1;
+			}
+
+			worker.worker_thread.is_running = true;
+		}
+
+		return 0;
+	}
+
+	int system_layer2_epoll::wait_for_events(struct epoll_event *events, int timeout_ms)
+	{
+		uint32_t max_spin_us = busy_poll_budget_us;
+		struct timespec spin_start;
+		struct timespec spin_now;
+		uint64_t spin_elapsed_us;
+		int event_count;
+
+		if((timeout_ms == 0) || (max_spin_us == 0))
+		{
+			return epoll_wait(epoll_fd, events, NUM_OF_EVENTS, timeout_ms);
+		}
+
+		clock_gettime(CLOCK_MONOTONIC, &spin_start);
+
+		do
+		{
+			event_count = epoll_wait(epoll_fd, events, NUM_OF_EVENTS, 0);
+
+			if(event_count != 0)
+			{
+				if(event_count > 0)
+				{
+					busy_stats.spin_hit_count++;
+					spin_budget_us = max_spin_us; // Traffic is flowing, so spin for the whole budget again
+				}
+
+				return event_count;
+			}
+
+			clock_gettime(CLOCK_MONOTONIC, &spin_now);
+			spin_elapsed_us = (uint64_t)(spin_now.tv_sec - spin_start.tv_sec) * 1000000 +
+			                  (spin_now.tv_nsec - spin_start.tv_nsec) / 1000;
+		}
+		while(spin_elapsed_us < spin_budget_us);
+
+		/**
+		 * Nothing arrived while spinning, so halve the spin budget to waste less CPU time while the network is idle.
+		 */
+		busy_stats.sleep_count++;
+		spin_budget_us = spin_budget_us / 2;
+
+		if(spin_budget_us < max_spin_us / SPIN_BUDGET_MIN_DIVISOR + 1)
+		{
+			spin_budget_us = max_spin_us / SPIN_BUDGET_MIN_DIVISOR + 1;
+		}
+
+		return epoll_wait(epoll_fd, events, NUM_OF_EVENTS, timeout_ms);
+	}
+
+	int system_layer2_epoll::poll_single()
+	{
+		struct epoll_event events[NUM_OF_EVENTS];
+		bool is_ready[NUM_OF_EVENTS] = {false};
+		int event_count;
+
+		/**
+		 * Only block when the transmit queue has been emptied. The capture sockets are level triggered, so frames left
+		 * in a receive ring after a batch are reported again by the next epoll_wait, together with the other events.
+		 */
+		event_count = wait_for_events(events, (tx_pending || decoded_desc_pending) ? 0 : -1);
+
+		if(event_count < 0)
+		{
+			return (errno == EINTR) ? 0 : -1;
+		}
+
+		for(int index_i = 0; index_i < event_count; index_i++)
+		{
+			is_ready[events[index_i].data.u32] = true;
+		}
+
+		if(is_ready[KILL_ALL]) // Exit or kill event
+		{
+			return -1;
+		}
+
+		/**
+		 * Record when commands were sent before their responses are processed.
+		 */
+		if(is_ready[EPOLL_TX_TIMESTAMP])
+		{
+			poll_tx_timestamps();
+		}
+
+		/**
+		 * Serve the AECP channel first, so responses to commands are not held up by the ADP channel during discovery bursts.
+		 */
+		if(is_ready[EPOLL_RX_AECP_PACKET])
+		{
+			rx_backlog[net_interface_imp::CAPTURE_CHANNEL_AECP] = poll_rx_frames(net_interface_imp::CAPTURE_CHANNEL_AECP);
+		}
+
+		if(is_ready[EPOLL_TX_PACKET])
+		{
+			tx_queue->clear_wakeup();
+			tx_pending = true;
+		}
+
+		if(tx_pending)
+		{
+			tx_pending = poll_tx_frames();
+		}
+
+		if(is_ready[EPOLL_DECODED_DESC])
+		{
+			context->engine_shard_ref->get_decoded_desc_queue()->clear_wakeup();
+			decoded_desc_pending = true;
+		}
+
+		if(decoded_desc_pending)
+		{
+			decoded_desc_pending = context->engine_shard_ref->poll_decoded_descs();
+		}
+
+		if(is_ready[EPOLL_CMD_COMPLETION])
+		{
+			poll_cmd_completions();
+		}
+
+		if(is_ready[EPOLL_RX_ADP_PACKET])
+		{
+			rx_backlog[net_interface_imp::CAPTURE_CHANNEL_ADP] = poll_rx_frames(net_interface_imp::CAPTURE_CHANNEL_ADP);
+		}
+
+		if(is_ready[EPOLL_TIMEOUT])
+		{
+			clear_timer_fd(timeout_fd);
+		}
+
+		service_timers(is_ready[EPOLL_TIMEOUT]);
+
+		return 0;
+	}
+
+	void system_layer2_epoll::service_timers(bool is_timeout_fd_expired)
+	{
+		uint64_t now_ms = timer_wheel::clk_monotonic_ms();
+		bool is_due;
+
+		if(!shard_threads.empty())
+		{
+			return; // The timers of the shards are run by their engine threads
+		}
+
+		is_due = context->timer_wheel_ref->is_due(now_ms);
+
+		if(is_due)
+		{
+			controller_ref_in_system->time_tick_event();
+		}
+
+		if((is_due || is_timeout_fd_expired) && is_waiting &&
+		   (!controller_ref_in_system->is_inflight_cmd_with_notification_id(waiting_notification_id)))
+		{
+			complete_waiting_cmd(waiting_notification_id, STATUS_TICK_TIMEOUT);
+		}
+
+		set_timeout_fd(timeout_fd, timeout_fd_expiry_ms, context->timer_wheel_ref->next_expiry(), now_ms, is_timeout_fd_expired);
+	}
+
+	void system_layer2_epoll::set_timeout_fd(int fd, uint64_t &fd_expiry_ms, uint64_t next_expiry_ms, uint64_t now_ms, bool is_timeout_fd_expired)
+	{
+		/**
+		 * Only move the timer when the wheel is due earlier, so a stream of frames does not cost a system call each.
+		 */
+		if(is_timeout_fd_expired || (next_expiry_ms < fd_expiry_ms))
+		{
+			struct itimerspec expiry;
+
+			if(next_expiry_ms > now_ms + NETIF_READ_TIMEOUT_MS)
+			{
+				next_expiry_ms = now_ms + NETIF_READ_TIMEOUT_MS; // Still check on a thread waiting for a response
+			}
+
+			memset(&expiry, 0, sizeof(expiry));
+			expiry.it_value.tv_sec = next_expiry_ms / 1000;
+			expiry.it_value.tv_nsec = (next_expiry_ms % 1000) * 1000000;
+			timerfd_settime(fd, TFD_TIMER_ABSTIME, &expiry, NULL);
+			fd_expiry_ms = next_expiry_ms;
+		}
+	}
+
+	bool system_layer2_epoll::poll_rx_frames(uint32_t channel_index)
+	{
+		const uint8_t *frame;
+		uint16_t mem_buf_len;
+		uint32_t rx_count;
+		uint64_t now_ms = timer_wheel::clk_monotonic_ms();
+
+		bool is_backlogged = rx_backlog[net_interface_imp::CAPTURE_CHANNEL_AECP] || rx_backlog[net_interface_imp::CAPTURE_CHANNEL_ADP];
+
+		for(rx_count = 0; rx_count < POLL_BUDGET; rx_count++)
+		{
+			void *notification_id = NULL;
+			uint32_t notification_flag = 0;
+			bool is_notification_id_valid = false;
+			int rx_status = -1;
+
+			if(netif_obj_in_system->capture_channel_frame(channel_index, &frame, &mem_buf_len) <= 0)
+			{
+				break;
+			}
+
+			/**
+			 * Advertisements that repeat what the engine already knows are discarded before they reach it while the
+			 * engine is behind: a capture channel had frames left after a whole batch, or the engine threads hold
+			 * ADP_SHED_FRAME_LIMIT frames. Advertisements with new information are always passed on.
+			 */
+			if(channel_index == net_interface_imp::CAPTURE_CHANNEL_ADP)
+			{
+				bool is_under_pressure = is_backlogged || (!shard_threads.empty() && (queue_frames->get_in_use_count() >= ADP_SHED_FRAME_LIMIT));
+
+				if(adp_shedder.is_redundant(frame_view(frame, mem_buf_len, 0), is_under_pressure, now_ms))
+				{
+					continue;
+				}
+			}
+
+			if(!shard_threads.empty())
+			{
+				route_rx_frame(frame, mem_buf_len);
+				continue;
+			}
+
+			controller_ref_in_system->rx_packet_event(notification_id,
+			                                          is_notification_id_valid,
+			                                          notification_flag,
+			                                          (uint8_t *)frame,
+			                                          mem_buf_len,
+			                                          rx_status);
+
+			/**
+			 * Only look up the inflight commands for a response to the command being waited on.
+			 */
+			if(is_waiting && is_notification_id_valid && (waiting_notification_id == notification_id) &&
+			   (!controller_ref_in_system->is_inflight_cmd_with_notification_id(waiting_notification_id)))
+			{
+				complete_waiting_cmd(notification_id, rx_status);
+			}
+		}
+
+		update_rx_batch_stats(rx_count);
+
+		return rx_count == POLL_BUDGET;
+	}
+
+	void system_layer2_epoll::poll_tx_timestamps()
+	{
+		const uint8_t *frame;
+		uint16_t mem_buf_len;
+		uint64_t tx_timestamp_ns;
+		struct shard_work work;
+
+		memset(&work, 0, sizeof(work));
+
+		for(uint32_t tx_count = 0; tx_count < POLL_BUDGET; tx_count++)
+		{
+			if(netif_obj_in_system->read_tx_timestamp(&frame, &mem_buf_len, &tx_timestamp_ns) <= 0)
+			{
+				break;
+			}
+
+			if(tx_timestamp_ns == 0)
+			{
+				continue;
+			}
+
+			if(shard_threads.empty())
+			{
+				controller_ref_in_system->tx_timestamp_event(frame, mem_buf_len, tx_timestamp_ns);
+			}
+			else if((mem_buf_len <= frame_slab::FRAME_SLAB_FRAME_SIZE) && (queue_frames->alloc(work.frame_index) == 0))
+			{
+				memcpy(queue_frames->get_frame(work.frame_index), frame, mem_buf_len);
+				work.kind = SHARD_WORK_TX_TIMESTAMP;
+				work.mem_buf_len = mem_buf_len;
+				work.timestamp_ns = tx_timestamp_ns;
+				route_to_shard(context->controller_imp_ref->find_shard_index_by_guid(jdksavdecc_uint64_get(frame, aecp::TARGET_GUID_POS)), work);
+			}
+		}
+	}
+
+	bool system_layer2_epoll::poll_tx_frames()
+	{
+		struct poll_thread_data thread_data_batch[QUEUE_POP_BATCH];
+		uint32_t pop_count;
+		uint32_t tx_count = 0;
+
+		do
+		{
+			pop_count = tx_queue->pop_batch(thread_data_batch, QUEUE_POP_BATCH);
+
+			for(uint32_t index_i = 0; index_i < pop_count; index_i++)
+			{
+				struct poll_thread_data &thread_data = thread_data_batch[index_i];
+
+				if(thread_data.is_waited_on)
+				{
+					is_waiting = true;
+					waiting_notification_id = thread_data.notification_id;
+				}
+
+				if(!shard_threads.empty())
+				{
+					struct shard_work work;
+					uint8_t *frame = queue_frames->get_frame(thread_data.frame_index);
+					uint32_t shard_index = context->controller_imp_ref->find_shard_index_by_guid(jdksavdecc_uint64_get(frame, aecp::TARGET_GUID_POS));
+
+					work.kind = SHARD_WORK_TX_CMD;
+					work.frame_index = thread_data.frame_index;
+					work.mem_buf_len = thread_data.mem_buf_len;
+					work.notification_id = thread_data.notification_id;
+					work.notification_flag = thread_data.notification_flag;
+					work.is_waited_on = thread_data.is_waited_on;
+					work.timestamp_ns = 0;
+
+					route_to_shard(shard_index, work); // The engine thread releases the frame once the command is sent
+					continue;
+				}
+
+				controller_ref_in_system->tx_packet_event(thread_data.notification_id, thread_data.notification_flag,
+				                                          queue_frames->get_frame(thread_data.frame_index), thread_data.mem_buf_len);
+				queue_frames->release(thread_data.frame_index);
+			}
+
+			tx_count += pop_count;
+		}
+		while((pop_count == QUEUE_POP_BATCH) && (tx_count < POLL_BUDGET));
+
+		/**
+		 * The transmit queue only wakes the poll thread when it was idle, so it has to be found empty before waiting again.
+		 */
+		return (pop_count == QUEUE_POP_BATCH) || !tx_queue->prepare_wait();
+	}
+
+	void system_layer2_epoll::complete_waiting_cmd(void *notification_id, int status)
+	{
+		if(is_waiting && (waiting_notification_id == notification_id))
+		{
+			resp_status_for_cmd = status;
+			is_waiting = false;
+			sem_post(&waiting_sem);
+		}
+	}
+
+	void system_layer2_epoll::poll_cmd_completions()
+	{
+		struct cmd_completion completion;
+
+		completion_queue->clear_wakeup();
+
+		/**
+		 * At most one completion is queued per command waited on, so the queue is emptied each time, and only left
+		 * once the engine threads will wake the poll thread for the next one.
+		 */
+		do
+		{
+			while(completion_queue->pop(&completion) == 0)
+			{
+				complete_waiting_cmd(completion.notification_id, completion.status);
+			}
+		}
+		while(!completion_queue->prepare_wait());
+	}
+
+	void system_layer2_epoll::route_rx_frame(const uint8_t *frame, uint16_t mem_buf_len)
+	{
+		frame_view rx_frame(frame, mem_buf_len, 0);
+		struct shard_work work;
+
+		if(((rx_frame.subtype() != JDKSAVDECC_SUBTYPE_ADP) && (rx_frame.subtype() != JDKSAVDECC_SUBTYPE_AECP)) ||
+		   (mem_buf_len > frame_slab::FRAME_SLAB_FRAME_SIZE))
+		{
+			return;
+		}
+
+		if(queue_frames->alloc(work.frame_index) < 0)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "route_rx_frame error, no frame buffer available");
+			return;
+		}
+
+		/**
+		 * The frame is copied out of the receive ring, which the poll thread hands back to the kernel before the
+		 * engine thread gets to it.
+		 */
+		memcpy(queue_frames->get_frame(work.frame_index), frame, mem_buf_len);
+		work.kind = SHARD_WORK_RX_FRAME;
+		work.mem_buf_len = mem_buf_len;
+		work.notification_id = NULL;
+		work.notification_flag = 0;
+		work.is_waited_on = false;
+		work.timestamp_ns = netif_obj_in_system->get_rx_timestamp();
+
+		route_to_shard(context->controller_imp_ref->find_shard_index_by_guid(rx_frame.guid()), work);
+	}
+
+	void system_layer2_epoll::route_to_shard(uint32_t shard_index, struct shard_work &work)
+	{
+		if(shard_threads.at(shard_index).work_queue->push(&work) < 0)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "route_to_shard error, the queue of shard %u is full", shard_index);
+			queue_frames->release(work.frame_index);
+		}
+	}
+
+	int system_layer2_epoll::poll_shard(struct shard_thread &worker)
+	{
+		struct epoll_event events[SHARD_NUM_OF_EVENTS];
+		bool is_ready[SHARD_NUM_OF_EVENTS] = {false};
+		int event_count;
+
+		event_count = epoll_wait(worker.epoll_fd, events, SHARD_NUM_OF_EVENTS, (worker.work_pending || worker.decoded_desc_pending) ? 0 : -1);
+
+		if(event_count < 0)
+		{
+			return (errno == EINTR) ? 0 : -1;
+		}
+
+		for(int index_i = 0; index_i < event_count; index_i++)
+		{
+			is_ready[events[index_i].data.u32] = true;
+		}
+
+		if(is_ready[SHARD_KILL])
+		{
+			return -1;
+		}
+
+		if(is_ready[SHARD_EPOLL_WORK])
+		{
+			worker.work_queue->clear_wakeup();
+			worker.work_pending = true;
+		}
+
+		if(worker.work_pending)
+		{
+			worker.work_pending = poll_shard_work(worker);
+		}
+
+		if(is_ready[SHARD_EPOLL_DECODED_DESC])
+		{
+			worker.shard->get_decoded_desc_queue()->clear_wakeup();
+			worker.decoded_desc_pending = true;
+		}
+
+		if(worker.decoded_desc_pending)
+		{
+			worker.decoded_desc_pending = worker.shard->poll_decoded_descs();
+		}
+
+		if(is_ready[SHARD_EPOLL_TIMEOUT])
+		{
+			clear_timer_fd(worker.timeout_fd);
+		}
+
+		service_shard_timers(worker, is_ready[SHARD_EPOLL_TIMEOUT]);
+
+		return 0;
+	}
+
+	int system_layer2_epoll::poll_decode(struct decode_thread &worker)
+	{
+		struct epoll_event events[DECODE_NUM_OF_EVENTS];
+		bool is_ready[DECODE_NUM_OF_EVENTS] = {false};
+		int event_count;
+
+		event_count = epoll_wait(worker.epoll_fd, events, DECODE_NUM_OF_EVENTS, worker.jobs_pending ? 0 : -1);
+
+		if(event_count < 0)
+		{
+			return (errno == EINTR) ? 0 : -1;
+		}
+
+		for(int index_i = 0; index_i < event_count; index_i++)
+		{
+			is_ready[events[index_i].data.u32] = true;
+		}
+
+		if(is_ready[DECODE_KILL])
+		{
+			return -1;
+		}
+
+		if(is_ready[DECODE_EPOLL_JOB])
+		{
+			decode_pool->clear_wakeup(worker.worker_index);
+			worker.jobs_pending = true;
+		}
+
+		if(worker.jobs_pending)
+		{
+			worker.jobs_pending = decode_pool->decode_jobs(worker.worker_index);
+		}
+
+		return 0;
+	}
+
+	bool system_layer2_epoll::poll_shard_work(struct shard_thread &worker)
+	{
+		struct shard_work work_batch[QUEUE_POP_BATCH];
+		aem_controller_state_machine *shard_aem = worker.shard->get_context()->aem_controller_state_machine_ref;
+		uint32_t pop_count;
+		uint32_t work_count = 0;
+
+		do
+		{
+			pop_count = worker.work_queue->pop_batch(work_batch, QUEUE_POP_BATCH);
+
+			for(uint32_t index_i = 0; index_i < pop_count; index_i++)
+			{
+				struct shard_work &work = work_batch[index_i];
+				uint8_t *frame = queue_frames->get_frame(work.frame_index);
+
+				switch(work.kind)
+				{
+					case SHARD_WORK_RX_FRAME:
+						{
+							frame_view rx_frame(frame, work.mem_buf_len, work.timestamp_ns);
+							void *notification_id = NULL;
+							uint32_t notification_flag = 0;
+							bool is_notification_id_valid = false;
+							int rx_status = -1;
+
+							worker.shard->rx_packet_event(notification_id, is_notification_id_valid, notification_flag, rx_frame, rx_status);
+
+							if(worker.is_waiting && is_notification_id_valid && (worker.waiting_notification_id == notification_id) &&
+							   (!shard_aem->find_inflight_cmd_by_notification_id(notification_id)))
+							{
+								post_cmd_completion(worker, rx_status);
+							}
+						}
+						break;
+
+					case SHARD_WORK_TX_CMD:
+						if(work.is_waited_on)
+						{
+							worker.is_waiting = true;
+							worker.waiting_notification_id = work.notification_id;
+						}
+
+						worker.shard->tx_packet_event(work.notification_id, work.notification_flag, frame, work.mem_buf_len);
+						break;
+
+					case SHARD_WORK_TX_TIMESTAMP:
+						worker.shard->tx_timestamp_event(frame, work.mem_buf_len, work.timestamp_ns);
+						break;
+				}
+
+				queue_frames->release(work.frame_index);
+			}
+
+			work_count += pop_count;
+		}
+		while((pop_count == QUEUE_POP_BATCH) && (work_count < POLL_BUDGET));
+
+		return (pop_count == QUEUE_POP_BATCH) || !worker.work_queue->prepare_wait();
+	}
+
+	void system_layer2_epoll::service_shard_timers(struct shard_thread &worker, bool is_timeout_fd_expired)
+	{
+		controller_context *shard_context = worker.shard->get_context();
+		uint64_t now_ms = timer_wheel::clk_monotonic_ms();
+		bool is_due = shard_context->timer_wheel_ref->is_due(now_ms);
+
+		if(is_due)
+		{
+			worker.shard->time_tick_event();
+		}
+
+		/**
+		 * Only the engine thread of the shard the command being waited on was routed to completes it.
+		 */
+		if((is_due || is_timeout_fd_expired) && worker.is_waiting &&
+		   (!shard_context->aem_controller_state_machine_ref->find_inflight_cmd_by_notification_id(worker.waiting_notification_id)))
+		{
+			post_cmd_completion(worker, STATUS_TICK_TIMEOUT);
+		}
+
+		set_timeout_fd(worker.timeout_fd, worker.timeout_fd_expiry_ms, shard_context->timer_wheel_ref->next_expiry(), now_ms, is_timeout_fd_expired);
+	}
+
+	void system_layer2_epoll::post_cmd_completion(struct shard_thread &worker, int status)
+	{
+		struct cmd_completion completion;
+
+		completion.notification_id = worker.waiting_notification_id;
+		completion.status = status;
+		worker.is_waiting = false;
+
+		while(completion_queue->push(&completion) < 0)
+		{
+			sched_yield(); // Wait for the poll thread to take the completions of earlier commands
+		}
+	}
+
+	void system_layer2_epoll::update_rx_batch_stats(uint32_t rx_count)
+	{
+		if(rx_count > 0)
+		{
+			rx_stats.batch_count++;
+			rx_stats.frame_count += rx_count;
+
+			if(rx_count > rx_stats.max_batch_size)
+			{
+				rx_stats.max_batch_size = rx_count;
+			}
+		}
+	}
+
+	int system_layer2_epoll::signal_event_fd(int event_fd)
+	{
+		uint64_t one = 1;
+		ssize_t write_returned;
+
+		do
+		{
+			write_returned = write(event_fd, &one, sizeof(one));
+		}
+		while((write_returned < 0) && (errno == EINTR));
+
+		if(write_returned != (ssize_t)sizeof(one))
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Error signalling an eventfd. %s", strerror(errno));
+			return -1;
+		}
+
+		return 0;
+	}
+
+	void system_layer2_epoll::clear_timer_fd(int timer_fd)
+	{
+		uint64_t expirations;
+		ssize_t read_returned;
+
+		do
+		{
+			read_returned = read(timer_fd, &expirations, sizeof(expirations));
+		}
+		while((read_returned < 0) && (errno == EINTR));
+
+		if((read_returned < 0) && (errno != EAGAIN)) // EAGAIN if the timer was rearmed since epoll reported it
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Error reading a timerfd. %s", strerror(errno));
+		}
+	}
+
+	int STDCALL system_layer2_epoll::process_close()
+	{
+		int status = 0;
+
+		/**
+		 * A thread is only waited for once its kill event is sent, so a failed write cannot block the close.
+		 */
+		if(poll_thread.is_running)
+		{
+			if(signal_event_fd(kill_fd) == 0) // Send kill event to the poll thread
+			{
+				pthread_join(poll_thread.handle, NULL); // Wait for thread termination
+				poll_thread.is_running = false;
+			}
+			else
+			{
+				status = -1;
+			}
+		}
+
+		/**
+		 * Stop the engine threads once the poll thread no longer routes work to them.
+		 */
+		for(uint32_t shard_index = 0; shard_index < shard_threads.size(); shard_index++)
+		{
+			struct shard_thread &worker = shard_threads.at(shard_index);
+
+			if(worker.engine_thread.is_running)
+			{
+				if(signal_event_fd(worker.kill_fd) == 0)
+				{
+					pthread_join(worker.engine_thread.handle, NULL);
+					worker.engine_thread.is_running = false;
+				}
+				else
+				{
+					status = -1;
+				}
+			}
+		}
+
+		/**
+		 * Stop the decode threads once no engine hands them descriptors.
+		 */
+		for(uint32_t worker_index = 0; worker_index < decode_threads.size(); worker_index++)
+		{
+			struct decode_thread &worker = decode_threads.at(worker_index);
+
+			if(worker.worker_thread.is_running)
+			{
+				if(signal_event_fd(worker.kill_fd) == 0)
+				{
+					pthread_join(worker.worker_thread.handle, NULL);
+					worker.worker_thread.is_running = false;
+				}
+				else
+				{
+					status = -1;
+				}
+			}
+		}
+
+		return status;
+	}
+}
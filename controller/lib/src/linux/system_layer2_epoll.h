@@ -0,0 +1,486 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * system_layer2_epoll.h
+ *
+ * Linux System implementation class, which multiplexes the capture socket, transmit queue,
+ * timer wheel and kill events in a single epoll loop.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_SYSTEM_LAYER2_EPOLL_H_
+#define _AVDECC_CONTROLLER_LIB_SYSTEM_LAYER2_EPOLL_H_
+
+#include <vector>
+#include <pthread.h>
+#include <semaphore.h>
+#include "system.h"
+#include "frame_slab.h"
+#include "adp_load_shedder.h"
+#include "system_tx_queue.h"
+#include "thread_sched.h"
+#include "net_interface_imp.h"
+
+namespace avdecc_lib
+{
+	class mpsc_ring;
+	class controller_context;
+	class engine_shard;
+	class desc_decode_pool;
+
+	class system_layer2_epoll : public virtual system, public system_tx_queue
+	{
+	private:
+		struct poll_thread_data
+		{
+			uint16_t frame_index; // The index of the frame in the queue frame slab
+			uint16_t mem_buf_len;
+			void *notification_id;
+			uint32_t notification_flag;
+			bool is_waited_on; // Set if the application thread that queued the command waits for its response
+		};
+
+		struct cmd_completion
+		{
+			void *notification_id; // The command waited on
+			int status; // The status of the response, or STATUS_TICK_TIMEOUT
+		};
+
+		struct rx_batch_stats
+		{
+			uint32_t batch_count;
+			uint32_t frame_count;
+			uint32_t max_batch_size;
+		};
+
+		struct busy_poll_stats
+		{
+			uint32_t spin_hit_count;
+			uint32_t sleep_count;
+		};
+
+		struct thread_creation
+		{
+			pthread_t handle;
+			bool is_running;
+		};
+
+		struct shard_work
+		{
+			uint8_t kind; // The kind of the work, from shard_work_kinds
+			uint16_t frame_index; // The index of the frame in the queue frame slab, released by the engine thread
+			uint16_t mem_buf_len;
+			void *notification_id;
+			uint32_t notification_flag;
+			bool is_waited_on; // Set for the command an application thread waits on
+			uint64_t timestamp_ns; // The receive or transmit timestamp of the frame, 0 if unknown
+		};
+
+		struct shard_thread
+		{
+			system_layer2_epoll *owner;
+			engine_shard *shard;
+			struct thread_creation engine_thread;
+			mpsc_ring *work_queue; // Frames and commands routed to the shard by the poll thread
+			bool work_pending; // Set while routed work may be left to process
+			bool decoded_desc_pending; // Set while descriptors decoded for the shard may be left to store
+			int epoll_fd;
+			int timeout_fd; // Set to expire when the timer wheel of the shard is next due
+			uint64_t timeout_fd_expiry_ms;
+			int kill_fd;
+			bool is_waiting; // Set while the command an application thread waits on is inflight on the shard
+			void *waiting_notification_id;
+		};
+
+		struct decode_thread
+		{
+			system_layer2_epoll *owner;
+			uint32_t worker_index; // The index of the thread in the decode pool
+			struct thread_creation worker_thread;
+			bool jobs_pending; // Set while descriptors may be left to decode
+			int epoll_fd;
+			int kill_fd;
+		};
+
+		enum shard_work_kinds
+		{
+		        SHARD_WORK_RX_FRAME,
+		        SHARD_WORK_TX_CMD,
+		        SHARD_WORK_TX_TIMESTAMP
+		};
+
+		enum shard_epoll_events
+		{
+		        SHARD_EPOLL_TIMEOUT,
+		        SHARD_EPOLL_WORK,
+		        SHARD_EPOLL_DECODED_DESC,
+		        SHARD_KILL,
+		        SHARD_NUM_OF_EVENTS
+		};
+
+		enum decode_epoll_events
+		{
+		        DECODE_EPOLL_JOB,
+		        DECODE_KILL,
+		        DECODE_NUM_OF_EVENTS
+		};
+
+		enum epoll_events
+		{
+		        EPOLL_TIMEOUT,
+		        EPOLL_TX_TIMESTAMP,
+		        EPOLL_RX_AECP_PACKET,
+		        EPOLL_RX_ADP_PACKET,
+		        EPOLL_TX_PACKET,
+		        EPOLL_DECODED_DESC,
+		        EPOLL_CMD_COMPLETION,
+		        KILL_ALL,
+		        NUM_OF_EVENTS
+		};
+
+		enum queue_sizes
+		{
+		        QUEUE_DEPTH = 256,
+		        QUEUE_POP_BATCH = 16, // The number of entries taken from a queue at a time
+		        POLL_BUDGET = 64, // The most entries processed from one source before the other events are served
+		        QUEUE_FRAME_COUNT = QUEUE_DEPTH + 64, // A full queue, with frames left for the threads blocked pushing to it
+		        SHARDED_QUEUE_FRAME_COUNT = QUEUE_FRAME_COUNT + 4 * QUEUE_DEPTH, // Frames held for the engine threads as well
+		        ADP_SHED_FRAME_LIMIT = SHARDED_QUEUE_FRAME_COUNT / 4, // Redundant advertisements are discarded while the engine threads hold this many frames
+		        COMPLETION_QUEUE_DEPTH = 16 // Only one command is waited on at a time
+		};
+
+		enum busy_poll_sizes
+		{
+		        SPIN_BUDGET_MIN_DIVISOR = 16 // The spin budget never shrinks below the budget set divided by this
+		};
+
+		enum thread_roles
+		{
+		        THREAD_ROLE_COUNT = THREAD_LOG + 1
+		};
+
+		net_interface_imp *netif_obj_in_system;
+		controller *controller_ref_in_system;
+		controller_context *context; // The context of the Controller the System runs
+		struct thread_creation poll_thread;
+		mpsc_ring *tx_queue; // Commands queued by application threads
+		int epoll_fd;
+		int capture_fds[net_interface_imp::CAPTURE_CHANNEL_COUNT];
+		int timeout_fd; // Set to expire when the timer wheel is next due, and at least every NETIF_READ_TIMEOUT_MS
+		uint64_t timeout_fd_expiry_ms; // The time timeout_fd is set to expire at
+		int tx_timestamp_fd; // The socket used for sending frames, which has transmit timestamps to read while in error
+		int kill_fd;
+		std::vector<struct shard_thread> shard_threads; // The engine threads of the shards, empty if the poll thread runs the engine
+		mpsc_ring *completion_queue; // Commands waited on that the engine threads have completed, NULL if the poll thread runs the engine
+		desc_decode_pool *decode_pool; // Decodes the descriptors read during enumeration, or NULL if the engine decodes them
+		std::vector<struct decode_thread> decode_threads; // The threads of the decode pool
+		sem_t waiting_sem;
+		frame_slab *queue_frames; // Frame buffers for the frames held in the transmit queue
+
+		struct rx_batch_stats rx_stats;
+		bool rx_backlog[net_interface_imp::CAPTURE_CHANNEL_COUNT]; // Set while the last batch of a channel left received frames to process
+		adp_load_shedder adp_shedder; // Classifies the frames captured on the ADP channel
+		bool tx_pending; // Set while queued commands may be left to process
+		bool decoded_desc_pending; // Set while descriptors decoded for the poll thread may be left to store
+
+		uint32_t busy_poll_budget_us; // The spin budget set for the busy poll mode, 0 if disabled
+		uint32_t spin_budget_us; // The spin budget currently used, adapted to the traffic
+		struct busy_poll_stats busy_stats;
+
+		struct thread_sched::setting thread_settings[THREAD_ROLE_COUNT]; // The thread settings chosen by the application
+
+		/**
+		 * The waiter state is owned by the poll thread. The application thread only sets queue_is_waiting, which is
+		 * passed on with the command it queues, and reads resp_status_for_cmd once waiting_sem is posted.
+		 */
+		bool is_waiting;
+		bool queue_is_waiting;
+		void *waiting_notification_id;
+		int resp_status_for_cmd;
+
+	public:
+		/**
+		 * An empty constructor for system_layer2_epoll
+		 */
+		system_layer2_epoll();
+
+		/**
+		 * A constructor for system_layer2_epoll used for constructing an object with network interface and controller objects.
+		 */
+		system_layer2_epoll(net_interface *netif, controller *controller_obj);
+
+		/**
+		 * Destructor for system_layer2_epoll used for destroying objects
+		 */
+		virtual ~system_layer2_epoll();
+
+		/**
+		 * Deallocate memory
+		 */
+		void STDCALL destroy();
+
+		/**
+		 * Reserve a frame in the transmit queue to build a command in.
+		 */
+		int queue_tx_reserve(struct system_tx_slot &slot);
+
+		/**
+		 * Store a command built in a reserved frame in the transmit queue.
+		 */
+		int queue_tx_commit(struct system_tx_slot &slot, void *notification_id, uint32_t notification_flag, size_t mem_buf_len);
+
+		/**
+		 * Release a reserved frame without transmitting it.
+		 */
+		void queue_tx_abort(struct system_tx_slot &slot);
+
+		/**
+		 * Set a waiting flag for the command sent.
+		 */
+		int STDCALL set_wait_for_next_cmd(void *notification_id);
+
+		/**
+		 * Wait for the response packet with the corrsponding notification id to be received.
+		 */
+		int STDCALL get_last_resp_status();
+
+		/**
+		 * Get the highest number of frame buffers held by the transmit queue at the same time.
+		 */
+		uint32_t STDCALL queue_frame_high_watermark();
+
+		/**
+		 * Get the number of frames dropped because no frame buffer was free for the transmit queue.
+		 */
+		uint32_t STDCALL missed_queue_frame_count();
+
+		/**
+		 * Get the receive batch statistics of the poll thread.
+		 */
+		void STDCALL get_rx_batch_stats(uint32_t &batch_count, uint32_t &frame_count, uint32_t &max_batch_size);
+
+		/**
+		 * Get the ADP load shedding statistics of the poll thread.
+		 */
+		void STDCALL get_adp_shed_stats(uint32_t &adp_frame_count, uint32_t &shed_count);
+
+		/**
+		 * Set the low-latency busy poll mode of the poll thread.
+		 */
+		int STDCALL set_busy_poll(uint32_t spin_budget_us);
+
+		/**
+		 * Get the busy poll statistics of the poll thread.
+		 */
+		void STDCALL get_busy_poll_stats(uint32_t &spin_hit_count, uint32_t &sleep_count);
+
+		/**
+		 * Pin the poll, notification or logging thread to a CPU and set its scheduling policy and priority.
+		 */
+		int STDCALL set_thread_sched(thread_role role, int32_t cpu, thread_policy policy, int32_t priority);
+
+		/**
+		 * Get the effective CPU affinity, scheduling policy and priority of the poll, notification or logging thread.
+		 */
+		int STDCALL get_thread_sched(thread_role role, int32_t &cpu, thread_policy &policy, int32_t &priority);
+
+		/**
+		 * Split the engine into shards run by their own engine threads.
+		 */
+		int STDCALL set_engine_shards(uint32_t shard_count);
+
+		/**
+		 * Decode the descriptors read during enumeration on a pool of decode threads.
+		 */
+		int STDCALL set_desc_decode_workers(uint32_t worker_count);
+
+	private:
+		/**
+		 * Start of the polling thread used for polling events, with the System as the thread parameter.
+		 */
+		static void * proc_poll_thread(void *lpParam);
+
+		/**
+		 * Create the epoll instance and register the capture socket, transmit queue, timer and kill events with it.
+		 */
+		int init_epoll();
+
+		/**
+		 * Create and initialize the poll thread.
+		 */
+		int init_poll_thread();
+
+		/**
+		 * Add a file descriptor to the epoll set, tagged with the corresponding event.
+		 */
+		int epoll_add(int fd, enum epoll_events event);
+
+		/**
+		 * Wait for events. When the busy poll mode is enabled and the wait would block, first spin checking for events
+		 * for up to the spin budget.
+		 */
+		int wait_for_events(struct epoll_event *events, int timeout_ms);
+
+		/**
+		 * Execute poll events.
+		 */
+		int poll_single();
+
+		/**
+		 * Process up to POLL_BUDGET frames received on a capture channel.
+		 *
+		 * \return True if received frames may be left to process.
+		 */
+		bool poll_rx_frames(uint32_t channel_index);
+
+		/**
+		 * Pass up to POLL_BUDGET transmit timestamps of sent frames to the Controller.
+		 */
+		void poll_tx_timestamps();
+
+		/**
+		 * Process up to POLL_BUDGET queued commands.
+		 *
+		 * \return True if queued commands may be left to process.
+		 */
+		bool poll_tx_frames();
+
+		/**
+		 * Complete the command being waited on with the status of its response, releasing the application thread.
+		 */
+		void complete_waiting_cmd(void *notification_id, int status);
+
+		/**
+		 * Take the completions of commands waited on from the engine threads.
+		 */
+		void poll_cmd_completions();
+
+		/**
+		 * Expire the timers of the timer wheel that are due, and set timeout_fd to expire when the wheel is next due
+		 * if that is earlier than the time it is set to, or if it has expired.
+		 */
+		void service_timers(bool is_timeout_fd_expired);
+
+		/**
+		 * Update the receive batch statistics with the number of frames processed in a batch.
+		 */
+		void update_rx_batch_stats(uint32_t rx_count);
+
+		/**
+		 * Signal an eventfd, retrying if the write is interrupted.
+		 *
+		 * \return 0 on success, -1 if the eventfd could not be written.
+		 */
+		int signal_event_fd(int event_fd);
+
+		/**
+		 * Read the expirations of a timerfd, so that it stops being reported ready, retrying if the read is interrupted.
+		 */
+		void clear_timer_fd(int timer_fd);
+
+		/**
+		 * Start of an engine thread used for running a shard, with its shard_thread as the thread parameter.
+		 */
+		static void * proc_shard_thread(void *lpParam);
+
+		/**
+		 * Create the queue, epoll instance and engine thread of each shard.
+		 */
+		int init_shard_threads();
+
+		/**
+		 * Start of a decode thread of the decode pool, with its decode_thread as the thread parameter.
+		 */
+		static void * proc_decode_thread(void *lpParam);
+
+		/**
+		 * Hand the decode pool to the shards and create its decode threads.
+		 */
+		int init_decode_threads();
+
+		/**
+		 * Free the queues and close the descriptors of the poll, engine and decode threads, once they are stopped.
+		 */
+		void free_thread_resources();
+
+		/**
+		 * Execute the events of a decode thread.
+		 */
+		int poll_decode(struct decode_thread &worker);
+
+		/**
+		 * Copy a captured frame to the queue frame slab and route it to the shard of the End Station it is from.
+		 * Frames that are neither ADP nor AECP, or that find no free frame buffer, are dropped.
+		 */
+		void route_rx_frame(const uint8_t *frame, uint16_t mem_buf_len);
+
+		/**
+		 * Route work to the engine thread of a shard. The queue of a shard has room for every frame of the slab, so
+		 * the work can only be refused if the frame is not from the slab.
+		 */
+		void route_to_shard(uint32_t shard_index, struct shard_work &work);
+
+		/**
+		 * Execute the events of an engine thread.
+		 */
+		int poll_shard(struct shard_thread &worker);
+
+		/**
+		 * Process up to POLL_BUDGET entries routed to a shard.
+		 *
+		 * \return True if routed work may be left to process.
+		 */
+		bool poll_shard_work(struct shard_thread &worker);
+
+		/**
+		 * Expire the timers of a shard that are due, complete a command being waited on that has timed out, and set
+		 * the timer of the engine thread to expire when the timer wheel of the shard is next due.
+		 */
+		void service_shard_timers(struct shard_thread &worker, bool is_timeout_fd_expired);
+
+		/**
+		 * Hand the completion of the command being waited on from an engine thread to the poll thread.
+		 */
+		void post_cmd_completion(struct shard_thread &worker, int status);
+
+		/**
+		 * Set a timerfd to expire at the next expiry of a timer wheel, or within NETIF_READ_TIMEOUT_MS, if that is
+		 * earlier than the time it is set to or if it has expired.
+		 */
+		void set_timeout_fd(int fd, uint64_t &fd_expiry_ms, uint64_t next_expiry_ms, uint64_t now_ms, bool is_timeout_fd_expired);
+
+	public:
+		/**
+		 * Start point of the system process, which calls the thread initialization function.
+		 */
+		int STDCALL process_start();
+
+		/**
+		 * End point of the system process, which terminates the threads.
+		 */
+		int STDCALL process_close();
+	};
+}
+
+#endif
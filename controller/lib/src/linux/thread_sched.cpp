@@ -0,0 +1,148 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * thread_sched.cpp
+ *
+ * Thread scheduling implementation
+ */
+
+#include <sched.h>
+#include <string.h>
+#include "enumeration.h"
+#include "log.h"
+#include "thread_sched.h"
+
+namespace avdecc_lib
+{
+	int thread_sched::apply(log *log_ref, thread_handle thread, int32_t cpu, system::thread_policy policy, int32_t priority)
+	{
+		cpu_set_t cpu_set;
+		struct sched_param param;
+		int sched_policy = (policy == system::THREAD_POLICY_FIFO) ? SCHED_FIFO : SCHED_OTHER;
+		int rc;
+
+		if(cpu >= CPU_SETSIZE)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "CPU %d is out of range", cpu);
+			return -1;
+		}
+
+		CPU_ZERO(&cpu_set);
+
+		if(cpu < 0)
+		{
+			for(int cpu_index = 0; cpu_index < CPU_SETSIZE; cpu_index++)
+			{
+				CPU_SET(cpu_index, &cpu_set); // The kernel ignores the CPUs that are not present
+			}
+		}
+		else
+		{
+			CPU_SET(cpu, &cpu_set);
+		}
+
+		rc = pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set);
+		if(rc != 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "pthread_setaffinity_np error %s", strerror(rc));
+			return -1;
+		}
+
+		memset(&param, 0, sizeof(param));
+
+		if(sched_policy == SCHED_FIFO)
+		{
+			if((priority < sched_get_priority_min(SCHED_FIFO)) || (priority > sched_get_priority_max(SCHED_FIFO)))
+			{
+				log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "SCHED_FIFO priority %d is out of range", priority);
+				return -1;
+			}
+
+			param.sched_priority = priority;
+		}
+
+		rc = pthread_setschedparam(thread, sched_policy, &param);
+		if(rc != 0)
+		{
+			/**
+			 * SCHED_FIFO needs CAP_SYS_NICE or an RLIMIT_RTPRIO of at least the priority.
+			 */
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "pthread_setschedparam error %s", strerror(rc));
+			return -1;
+		}
+
+		return 0;
+	}
+
+	int thread_sched::apply(log *log_ref, thread_handle thread, const struct setting &thread_setting)
+	{
+		if(!thread_setting.is_set)
+		{
+			return 0;
+		}
+
+		return apply(log_ref, thread, thread_setting.cpu, thread_setting.policy, thread_setting.priority);
+	}
+
+	int thread_sched::get(log *log_ref, thread_handle thread, int32_t &cpu, system::thread_policy &policy, int32_t &priority)
+	{
+		cpu_set_t cpu_set;
+		struct sched_param param;
+		int sched_policy;
+		int rc;
+
+		rc = pthread_getaffinity_np(thread, sizeof(cpu_set), &cpu_set);
+		if(rc != 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "pthread_getaffinity_np error %s", strerror(rc));
+			return -1;
+		}
+
+		cpu = -1;
+
+		if(CPU_COUNT(&cpu_set) == 1)
+		{
+			for(int cpu_index = 0; cpu_index < CPU_SETSIZE; cpu_index++)
+			{
+				if(CPU_ISSET(cpu_index, &cpu_set))
+				{
+					cpu = cpu_index;
+					break;
+				}
+			}
+		}
+
+		rc = pthread_getschedparam(thread, &sched_policy, &param);
+		if(rc != 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "pthread_getschedparam error %s", strerror(rc));
+			return -1;
+		}
+
+		policy = ((sched_policy == SCHED_FIFO) || (sched_policy == SCHED_RR)) ? system::THREAD_POLICY_FIFO : system::THREAD_POLICY_OTHER;
+		priority = param.sched_priority;
+
+		return 0;
+	}
+}
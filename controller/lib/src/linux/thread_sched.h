@@ -0,0 +1,71 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * thread_sched.h
+ *
+ * Thread scheduling class, which sets and reads the CPU affinity and scheduling policy of a library thread.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_THREAD_SCHED_H_
+#define _AVDECC_CONTROLLER_LIB_THREAD_SCHED_H_
+
+#include <pthread.h>
+#include "system.h"
+
+namespace avdecc_lib
+{
+	class log;
+
+	class thread_sched
+	{
+	public:
+		typedef pthread_t thread_handle;
+
+		struct setting
+		{
+			bool is_set; // Set once the application has chosen the settings of the threads
+			int32_t cpu;
+			system::thread_policy policy;
+			int32_t priority;
+		};
+
+		/**
+		 * Pin a thread to a CPU, or let it run on any CPU if cpu is -1, and set its scheduling policy and priority. Errors are logged to log_ref.
+		 */
+		static int apply(log *log_ref, thread_handle thread, int32_t cpu, system::thread_policy policy, int32_t priority);
+
+		/**
+		 * Apply the settings chosen by the application to a thread that has just been created.
+		 */
+		static int apply(log *log_ref, thread_handle thread, const struct setting &thread_setting);
+
+		/**
+		 * Get the CPU a thread is pinned to, or -1 if it may run on more than one CPU, and its scheduling policy and priority.
+		 */
+		static int get(log *log_ref, thread_handle thread, int32_t &cpu, system::thread_policy &policy, int32_t &priority);
+	};
+}
+
+#endif
@@ -0,0 +1,176 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * mpsc_ring.cpp
+ *
+ * Multiple producer, single consumer ring implementation
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "mpsc_ring.h"
+
+namespace avdecc_lib
+{
+	mpsc_ring::mpsc_ring(uint32_t count, uint32_t size, bool use_wakeup)
+	{
+		for(entry_count = 1; entry_count < count; entry_count <<= 1);
+
+		entry_size = size;
+		cell_size = (sizeof(uint32_t) + entry_size + 7) & ~7;
+		cells = (uint8_t *)calloc(entry_count, cell_size);
+		wakeup = use_wakeup ? new ring_wakeup() : NULL;
+		head = 0;
+		tail = 0;
+
+		for(uint32_t pos = 0; pos < entry_count; pos++)
+		{
+			*cell_seq(pos) = pos;
+		}
+	}
+
+	mpsc_ring::~mpsc_ring()
+	{
+		free(cells);
+		delete wakeup;
+	}
+
+	int mpsc_ring::push_no_wakeup(const void *entry)
+	{
+		uint32_t pos;
+		int32_t diff;
+
+		while(true)
+		{
+			pos = tail;
+			diff = (int32_t)(*cell_seq(pos) - pos);
+
+			if(diff == 0)
+			{
+				if(atomic_cas_uint32(&tail, pos, pos + 1) == pos)
+				{
+					break; // The cell at pos is claimed by this producer
+				}
+			}
+			else if(diff < 0)
+			{
+				return -1; // The cell still holds an entry the consumer has not popped, so the ring is full
+			}
+		}
+
+		memcpy(cell_entry(pos), entry, entry_size);
+		atomic_full_barrier(); // Publish the entry before its sequence number
+		*cell_seq(pos) = pos + 1;
+
+		return 0;
+	}
+
+	int mpsc_ring::push(const void *entry)
+	{
+		return (push_batch(entry, 1) == 1) ? 0 : -1;
+	}
+
+	uint32_t mpsc_ring::push_batch(const void *entries, uint32_t count)
+	{
+		uint32_t pushed_count;
+
+		for(pushed_count = 0; pushed_count < count; pushed_count++)
+		{
+			if(push_no_wakeup((const uint8_t *)entries + pushed_count * entry_size) < 0)
+			{
+				break;
+			}
+		}
+
+		if((pushed_count > 0) && wakeup)
+		{
+			wakeup->notify();
+		}
+
+		return pushed_count;
+	}
+
+	int mpsc_ring::pop(void *entry)
+	{
+		return (pop_batch(entry, 1) == 1) ? 0 : -1;
+	}
+
+	uint32_t mpsc_ring::pop_batch(void *entries, uint32_t max_count)
+	{
+		uint32_t pos = head;
+		uint32_t count;
+
+		for(count = 0; count < max_count; count++, pos++)
+		{
+			if(*cell_seq(pos) != pos + 1)
+			{
+				break; // The next cell has not been published yet
+			}
+
+			atomic_full_barrier(); // Read the entry only after the sequence number that published it
+			memcpy((uint8_t *)entries + count * entry_size, cell_entry(pos), entry_size);
+			atomic_full_barrier(); // Finish reading the entry before the cell is handed back to the producers
+			*cell_seq(pos) = pos + entry_count;
+		}
+
+		head = pos;
+
+		return count;
+	}
+
+	bool mpsc_ring::is_empty()
+	{
+		return *cell_seq(head) != head + 1;
+	}
+
+	bool mpsc_ring::prepare_wait()
+	{
+		assert(wakeup);
+
+		wakeup->begin_idle();
+
+		if(!is_empty())
+		{
+			wakeup->cancel_idle();
+			return false;
+		}
+
+		return true;
+	}
+
+	void mpsc_ring::clear_wakeup()
+	{
+		assert(wakeup);
+
+		wakeup->clear();
+	}
+
+	ring_wakeup::wakeup_handle mpsc_ring::wakeup_object()
+	{
+		assert(wakeup);
+
+		return wakeup->get_handle();
+	}
+}
@@ -0,0 +1,145 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * mpsc_ring.h
+ *
+ * Multiple producer, single consumer ring class, which passes fixed-size entries from any number of threads
+ * to one thread without locks. Used for the commands queued by application threads for the poll thread.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_MPSC_RING_H_
+#define _AVDECC_CONTROLLER_LIB_MPSC_RING_H_
+
+#include <stdint.h>
+#include "atomic_ops.h"
+#include "ring_wakeup.h"
+
+namespace avdecc_lib
+{
+	class mpsc_ring
+	{
+	private:
+		/**
+		 * Each cell starts with a sequence number followed by the entry. A cell holding an entry pushed at position
+		 * pos has the sequence number pos + 1, and a free cell for position pos has the sequence number pos.
+		 */
+		uint8_t *cells;
+		uint32_t cell_size; // The size of a cell in bytes, the sequence number and the entry rounded up to 8 bytes
+		uint32_t entry_count; // The number of entries in the ring, a power of 2
+		uint32_t entry_size; // The size of an entry in bytes
+		ring_wakeup *wakeup; // Wakes the consumer when it is idle, or NULL if the consumer only polls
+
+		uint8_t head_pad[CACHE_LINE_SIZE];
+		volatile uint32_t head; // The position of the next entry to pop, written by the consumer only
+		uint8_t tail_pad[CACHE_LINE_SIZE];
+		volatile uint32_t tail; // The position of the next cell to claim, shared by the producers
+		uint8_t end_pad[CACHE_LINE_SIZE];
+
+		/**
+		 * Get the sequence number of the cell at a position.
+		 */
+		inline volatile uint32_t * cell_seq(uint32_t pos)
+		{
+			return (volatile uint32_t *)&cells[(pos & (entry_count - 1)) * cell_size];
+		}
+
+		/**
+		 * Get the entry of the cell at a position.
+		 */
+		inline uint8_t * cell_entry(uint32_t pos)
+		{
+			return &cells[(pos & (entry_count - 1)) * cell_size + sizeof(uint32_t)];
+		}
+
+		/**
+		 * Claim a cell, copy the entry into it and publish it, without waking the consumer.
+		 */
+		int push_no_wakeup(const void *entry);
+
+	public:
+		/**
+		 * Constructor for mpsc_ring used for constructing a ring with count entries of size bytes. The count is
+		 * rounded up to a power of 2. The consumer can only block on the ring if use_wakeup is set.
+		 */
+		mpsc_ring(uint32_t count, uint32_t size, bool use_wakeup);
+
+		/**
+		 * Destructor for mpsc_ring used for destroying objects
+		 */
+		~mpsc_ring();
+
+		/**
+		 * Push an entry to the ring.
+		 *
+		 * \return 0 on success, -1 if the ring is full.
+		 */
+		int push(const void *entry);
+
+		/**
+		 * Push up to count entries stored one after another to the ring, waking the consumer once.
+		 *
+		 * \return The number of entries pushed.
+		 */
+		uint32_t push_batch(const void *entries, uint32_t count);
+
+		/**
+		 * Pop an entry from the ring.
+		 *
+		 * \return 0 on success, -1 if the ring is empty.
+		 */
+		int pop(void *entry);
+
+		/**
+		 * Pop up to max_count entries from the ring, stored one after another.
+		 *
+		 * \return The number of entries popped.
+		 */
+		uint32_t pop_batch(void *entries, uint32_t max_count);
+
+		/**
+		 * Check if the next entry for the consumer has not been published yet.
+		 */
+		bool is_empty();
+
+		/**
+		 * Mark the consumer as idle before it blocks on the wakeup handle.
+		 *
+		 * \return True if the ring is still empty and the consumer can block, false if it has to pop again.
+		 */
+		bool prepare_wait();
+
+		/**
+		 * Reset the wakeup after the consumer has been woken.
+		 */
+		void clear_wakeup();
+
+		/**
+		 * Get the handle the consumer waits on.
+		 */
+		ring_wakeup::wakeup_handle wakeup_object();
+	};
+}
+
+#endif
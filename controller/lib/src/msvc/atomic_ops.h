@@ -0,0 +1,79 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * atomic_ops.h
+ *
+ * Atomic operations on 32 bit values shared between threads, implemented with the Interlocked functions.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_ATOMIC_OPS_H_
+#define _AVDECC_CONTROLLER_LIB_ATOMIC_OPS_H_
+
+#include <stdint.h>
+#include <windows.h>
+
+namespace avdecc_lib
+{
+	enum atomic_ops_sizes
+	{
+	        CACHE_LINE_SIZE = 64 // Used to pad data written by different threads onto separate cache lines
+	};
+
+	/**
+	 * Store the desired value if the target holds the expected value.
+	 *
+	 * \return The value held by the target before the operation.
+	 */
+	inline uint32_t atomic_cas_uint32(volatile uint32_t *target, uint32_t expected, uint32_t desired)
+	{
+		return (uint32_t)InterlockedCompareExchange((volatile LONG *)target, (LONG)desired, (LONG)expected);
+	}
+
+	/**
+	 * \return The value held by the target after it is incremented.
+	 */
+	inline uint32_t atomic_inc_uint32(volatile uint32_t *target)
+	{
+		return (uint32_t)InterlockedIncrement((volatile LONG *)target);
+	}
+
+	/**
+	 * \return The value held by the target after it is decremented.
+	 */
+	inline uint32_t atomic_dec_uint32(volatile uint32_t *target)
+	{
+		return (uint32_t)InterlockedDecrement((volatile LONG *)target);
+	}
+
+	/**
+	 * Order all memory accesses before the barrier ahead of all memory accesses after it.
+	 */
+	inline void atomic_full_barrier()
+	{
+		MemoryBarrier();
+	}
+}
+
+#endif
@@ -38,26 +38,28 @@ extern "C" void default_log(void *log_user_obj, int32_t log_level, const char *l
 
 namespace avdecc_lib
 {
-	uint32_t log::read_index = 0;
-	uint32_t log::write_index = 0;
-	void (*log::callback_func) (void *, int32_t, const char *, int32_t);
-	void *log::user_obj;
-	uint32_t log::missed_log_event_cnt = 0;
-	HANDLE log::poll_events[2];
-
-	log *log_ref = new log();
-
 	log::log()
 	{
+		read_index = 0;
+		write_index = 0;
 		callback_func = default_log;
 		user_obj = NULL;
 		log_level = avdecc_lib::LOGGING_LEVEL_ERROR;
 		missed_log_event_cnt = 0;
-
-		logging_thread_init(); // Start logging thread
+		is_thread_running = false;
 	}
 
-	log::~log() {}
+	log::~log()
+	{
+		if(is_thread_running)
+		{
+			SetEvent(poll_events[KILL_EVENT]);
+			WaitForSingleObject(h_thread, INFINITE); // Wait for thread termination
+			CloseHandle(h_thread);
+			CloseHandle(poll_events[LOG_EVENT]);
+			CloseHandle(poll_events[KILL_EVENT]);
+		}
+	}
 
 	void log::set_log_level(int32_t new_log_level)
 	{
@@ -72,7 +74,7 @@ namespace avdecc_lib
 		h_thread = CreateThread(NULL, // Default security descriptor
 		                        0, // Default stack size
 		                        process_logging_thread, // Point to the start address of the thread
-		                        &log_buf, // Data to be passed to the thread
+		                        this, // Data to be passed to the thread
 		                        0, // Flag controlling the creation of the thread
 		                        &thread_id // Thread identifier
 		                       );
@@ -82,35 +84,38 @@ namespace avdecc_lib
 			exit(EXIT_FAILURE);
 		}
 
+		is_thread_running = true;
+
 		return 0;
 	}
 
 	DWORD WINAPI log::process_logging_thread(LPVOID lpParam)
 	{
 		DWORD dwEvent;
-		struct log_data *data = (struct log_data *)lpParam;
+		log *logger = (log *)lpParam;
+		struct log_data *data = logger->log_buf;
 
 		while (true)
 		{
-			dwEvent = WaitForMultipleObjects(2, poll_events, FALSE, INFINITE);
+			dwEvent = WaitForMultipleObjects(2, logger->poll_events, FALSE, INFINITE);
 
 			if (dwEvent == (WAIT_OBJECT_0 + LOG_EVENT))
 			{
-				if ((write_index - read_index) > 0)
+				if ((logger->write_index - logger->read_index) > 0)
 				{
-					callback_func(user_obj,
-					              data[read_index % LOG_BUF_COUNT].level,
-					              data[read_index % LOG_BUF_COUNT].msg,
-					              data[read_index % LOG_BUF_COUNT].time_stamp_ms
-					             ); // Call callback function
+					logger->callback_func(logger->user_obj,
+					                      data[logger->read_index % LOG_BUF_COUNT].level,
+					                      data[logger->read_index % LOG_BUF_COUNT].msg,
+					                      data[logger->read_index % LOG_BUF_COUNT].time_stamp_ms
+					                     ); // Call callback function
 
-					read_index++;
+					logger->read_index++;
 				}
 			}
 
 			else
 			{
-				SetEvent(poll_events[KILL_EVENT]);
+				SetEvent(logger->poll_events[KILL_EVENT]);
 				break;
 			}
 		}
@@ -124,6 +129,17 @@ namespace avdecc_lib
 		{
 			va_list arglist;
 
+			if(!is_thread_running)
+			{
+				char msg[256];
+
+				va_start(arglist, fmt);
+				vsprintf_s(msg, sizeof(msg), fmt, arglist);
+				va_end(arglist);
+				callback_func(user_obj, level, msg, 0);
+				return;
+			}
+
 			if ((write_index - read_index) > LOG_BUF_COUNT)
 			{
 				missed_log_event_cnt++;
@@ -151,4 +167,9 @@ namespace avdecc_lib
 	{
 		return missed_log_event_cnt;
 	}
+
+	HANDLE log::get_thread_handle()
+	{
+		return h_thread;
+	}
 }
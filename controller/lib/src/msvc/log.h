@@ -40,11 +40,11 @@ namespace avdecc_lib
 	{
 	private:
 		int32_t log_level;
-		static uint32_t read_index;
-		static uint32_t write_index;
-		static void (*callback_func)(void *, int32_t, const char *, int32_t);
-		static void *user_obj;
-		static uint32_t missed_log_event_cnt;
+		uint32_t read_index;
+		uint32_t write_index;
+		void (*callback_func)(void *, int32_t, const char *, int32_t);
+		void *user_obj;
+		uint32_t missed_log_event_cnt;
 
 		enum
 		{
@@ -60,8 +60,9 @@ namespace avdecc_lib
 		LPTHREAD_START_ROUTINE thread;
 		HANDLE h_thread;
 		DWORD thread_id;
+		bool is_thread_running; // Messages are passed to the callback function by the caller until the thread is started
 
-		static HANDLE poll_events[2];
+		HANDLE poll_events[2];
 
 		struct log_data
 		{
@@ -74,12 +75,12 @@ namespace avdecc_lib
 
 	public:
 		/**
-		 * An empty constructor for log
+		 * An empty constructor for log. No logging thread is started until logging_thread_init is called.
 		 */
 		log();
 
 		/**
-		 * Destructor for log used for destroying objects
+		 * Destructor for log used for destroying objects, which stops the logging thread.
 		 */
 		virtual ~log();
 
@@ -94,7 +95,7 @@ namespace avdecc_lib
 		int logging_thread_init();
 
 		/**
-		 * Start of the logging thread used for logging purposes.
+		 * Start of the logging thread used for logging purposes, with the log as parameter.
 		 */
 		static DWORD WINAPI process_logging_thread(LPVOID lpParam);
 
@@ -112,9 +113,12 @@ namespace avdecc_lib
 		 * Get the number of missed log that exceeds the log buffer count.
 		 */
 		uint32_t get_missed_log_event_count();
-	};
 
-	extern log *log_ref;
+		/**
+		 * Get the handle of the logging thread.
+		 */
+		HANDLE get_thread_handle();
+	};
 }
 
 #endif
@@ -33,6 +33,7 @@
 #include "log.h"
 #include "jdksavdecc_util.h"
 #include "util.h"
+#include "capture_replay.h"
 #include "net_interface_imp.h"
 
 namespace avdecc_lib
@@ -42,13 +43,18 @@ namespace avdecc_lib
 		return (new net_interface_imp());
 	}
 
+	net_interface * STDCALL create_replay_net_interface(const char *capture_file_path, uint64_t mac, bool is_recorded_pace, const char *tx_file_path)
+	{
+		return (new net_interface_imp(capture_file_path, mac, is_recorded_pace, tx_file_path));
+	}
+
 	net_interface_imp::net_interface_imp()
 	{
-		interface_num = 0;
+		init_members();
 
 		if(pcap_findalldevs(&all_devs, err_buf) == -1) // Retrieve the device list on the local machine.
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "pcap_findalldevs error %s", err_buf);
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "pcap_findalldevs error %s", err_buf);
 			exit(EXIT_FAILURE);
 		}
 
@@ -65,15 +71,60 @@ namespace avdecc_lib
 
 		if(total_devs == 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "No interfaces found! Make sure WinPcap is installed.");
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "No interfaces found! Make sure WinPcap is installed.");
 			exit(EXIT_FAILURE);
 		}
 	}
 
+	net_interface_imp::net_interface_imp(const char *capture_file_path, uint64_t replay_mac, bool is_recorded_pace, const char *tx_file_path)
+	{
+		init_members();
+		mac = replay_mac;
+		total_devs = 1; // The capture file is the only device
+		interface_num = 1;
+		replay = new capture_replay(log_ref, capture_file_path, is_recorded_pace, tx_file_path);
+	}
+
+	void net_interface_imp::init_members()
+	{
+		log_ref = &netif_log;
+		all_devs = NULL;
+		dev = NULL;
+		mac = 0;
+		total_devs = 0;
+		interface_num = 0;
+		tx_send_queue = NULL;
+		capture_acmp = false;
+		is_busy_poll = false;
+		replay = NULL;
+
+		for(uint32_t channel_index = 0; channel_index < CAPTURE_CHANNEL_COUNT; channel_index++)
+		{
+			pcap_channels[channel_index] = NULL;
+		}
+	}
+
 	net_interface_imp::~net_interface_imp()
 	{
-		pcap_freealldevs(all_devs); // Free the device list
-		pcap_close(pcap_interface);
+		if(tx_send_queue)
+		{
+			pcap_sendqueue_destroy(tx_send_queue);
+		}
+
+		if(all_devs)
+		{
+			pcap_freealldevs(all_devs); // Free the device list
+		}
+
+		for(uint32_t channel_index = 0; channel_index < CAPTURE_CHANNEL_COUNT; channel_index++)
+		{
+			if(pcap_channels[channel_index])
+			{
+				pcap_close(pcap_channels[channel_index]);
+			}
+		}
+
+		delete replay;
 	}
 
 	uint32_t STDCALL net_interface_imp::devs_count()
@@ -86,15 +137,35 @@ namespace avdecc_lib
 		return mac;
 	}
 
+	void net_interface_imp::set_log(log *new_log_ref)
+	{
+		log_ref = new_log_ref ? new_log_ref : &netif_log;
+
+		if(replay)
+		{
+			replay->set_log(log_ref);
+		}
+	}
+
+	uint64_t net_interface_imp::get_rx_timestamp()
+	{
+		return 0;
+	}
+
 	char * STDCALL net_interface_imp::get_dev_desc_by_index(uint32_t dev_index)
 	{
 		uint32_t index_i;
 
+		if(replay)
+		{
+			return (char *)replay->get_capture_file_path();
+		}
+
 		for(dev = all_devs, index_i = 0; (index_i < dev_index) && (dev_index < total_devs); dev = dev->next, index_i++); // Get the selected interface
 
 		if(!dev->description)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Interface description is blank.");
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Interface description is blank.");
 		}
 
 		return dev->description;
@@ -110,11 +181,22 @@ namespace avdecc_lib
 		DWORD status;
 		int timeout_ms = 100;
 
+		/***************************************** Open the capture file for each channel in place of the device *****************************************/
+		if(replay)
+		{
+			if((replay->open(CAPTURE_CHANNEL_COUNT) < 0) || (update_capture_filter() < 0))
+			{
+				exit(EXIT_FAILURE);
+			}
+
+			return 0;
+		}
+
 		if(interface_num == 0)
 		{
 			if(interface_num < 1 || interface_num > total_devs)
 			{
-				avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Interface number out of range.");
+				log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Interface number out of range.");
 				pcap_freealldevs(all_devs); // Free the device list
 				exit(EXIT_FAILURE);
 			}
@@ -127,16 +209,23 @@ namespace avdecc_lib
 
 		for(dev = all_devs, index = 0; index < interface_num - 1; dev = dev->next, index++); // Jump to the selected adapter
 
-		/************************************************************** Open the device ****************************************************************/
-		if((pcap_interface = pcap_open_live(dev->name,		       // Name of the device
-		                                    65536,		       // Portion of the packet to capture
-		                                    // 65536 guarantees that the whole packet will be captured on all the link layers
-		                                    PCAP_OPENFLAG_PROMISCUOUS, // In promiscuous mode, all packets including packets of other hosts are captured
-		                                    timeout_ms,		       // Read timeout in ms
-		                                    err_buf		       // Error buffer
-		                                   )) == NULL)
+		/******************************************* Open the device once for each capture channel *******************************************/
+		for(uint32_t channel_index = 0; channel_index < CAPTURE_CHANNEL_COUNT; channel_index++)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Unable to open the adapter. %s is not supported by WinPcap.", dev->name);
+			if((pcap_channels[channel_index] = open_interface(timeout_ms)) == NULL)
+			{
+				log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Unable to open the adapter. %s is not supported by WinPcap.", dev->name);
+				pcap_freealldevs(all_devs); // Free the device list
+				exit(EXIT_FAILURE);
+			}
+		}
+
+		/******************************************** Allocate the send queue used for transmit batches *******************************************/
+		tx_send_queue = pcap_sendqueue_alloc(frame_batch::FRAME_BATCH_COUNT * (frame_batch::FRAME_BATCH_FRAME_SIZE + sizeof(struct pcap_pkthdr)));
+
+		if(tx_send_queue == NULL)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "pcap_sendqueue_alloc error");
 			pcap_freealldevs(all_devs); // Free the device list
 			exit(EXIT_FAILURE);
 		}
@@ -152,7 +241,7 @@ namespace avdecc_lib
 
 			if(AdapterInfo == NULL)
 			{
-				avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Allocating memory needed to call GetAdaptersinfo.", dev->name);
+				log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Allocating memory needed to call GetAdaptersinfo.", dev->name);
 				exit(EXIT_FAILURE);
 			}
 
@@ -160,7 +249,7 @@ namespace avdecc_lib
 
 			if(status != ERROR_SUCCESS)
 			{
-				avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "GetAdaptersInfo call in netif_win32_pcap.c failed.", dev->name);
+				log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "GetAdaptersInfo call in netif_win32_pcap.c failed.", dev->name);
 				free(AdapterInfo);
 				exit(EXIT_FAILURE);
 			}
@@ -182,62 +271,136 @@ namespace avdecc_lib
 		}
 
 		free(AdapterInfo);
+
+		/*********************** Only admit the AVDECC frames for this Controller now that its MAC address is known ***********************/
+		if(update_capture_filter() < 0)
+		{
+			pcap_freealldevs(all_devs); // Free the device list
+			exit(EXIT_FAILURE);
+		}
+
+		if(is_busy_poll)
+		{
+			for(uint32_t channel_index = 0; channel_index < CAPTURE_CHANNEL_COUNT; channel_index++)
+			{
+				apply_channel_busy_poll(channel_index);
+			}
+		}
+
 		return 0;
 	}
 
-	int net_interface_imp::set_capture_ether_type(uint16_t *ether_type, uint32_t count)
+	pcap_t * net_interface_imp::open_interface(int timeout_ms)
 	{
-		struct bpf_program fcode;
-		char ether_type_string[512];
-		char ether_type_single[64];
-		const unsigned char *ether_packet = NULL;
-		struct pcap_pkthdr pcap_header;
-
-		ether_type_string[0] = 0;
+		return pcap_open_live(dev->name,		       // Name of the device
+		                      65536,		       // Portion of the packet to capture
+		                      // 65536 guarantees that the whole packet will be captured on all the link layers
+		                      PCAP_OPENFLAG_PROMISCUOUS, // In promiscuous mode, all packets including packets of other hosts are captured
+		                      timeout_ms,		       // Read timeout in ms
+		                      err_buf		       // Error buffer
+		                     );
+	}
 
-		for(uint32_t index_i = 0; index_i < count; index_i++)
+	int net_interface_imp::update_capture_filter()
+	{
+		for(uint32_t channel_index = 0; channel_index < CAPTURE_CHANNEL_COUNT; channel_index++)
 		{
-			sprintf(ether_type_single, "ether proto 0x%04x", ether_type[index_i]);
-			strcat(ether_type_string, ether_type_single);
-
-			if((index_i + 1) < count)
+			if(attach_channel_filter(channel_index) < 0)
 			{
-				strcat(ether_type_string, " or ");
+				return -1;
 			}
 		}
 
-		/******************************************************* Compile a filter ************************************************/
-		if(pcap_compile(pcap_interface, &fcode, ether_type_string, 1, 0) < 0)
+		return 0;
+	}
+
+	int net_interface_imp::attach_channel_filter(uint32_t channel_index)
+	{
+		struct bpf_program program;
+
+		if(channel_index == CAPTURE_CHANNEL_AECP)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Unable to compile the packet filter.");
-			pcap_freealldevs(all_devs); // Free the device list
-			return -1;
+			channel_filters[channel_index].build(mac, false, true, false);
+		}
+		else
+		{
+			channel_filters[channel_index].build(mac, true, false, capture_acmp);
+		}
+
+		program = channel_filters[channel_index].get_program();
+
+		if(replay)
+		{
+			return replay->set_channel_filter(channel_index, &program);
 		}
 
 		/*************************************************** Set the filter *******************************************/
-		if(pcap_setfilter(pcap_interface, &fcode) < 0)
+		if(pcap_setfilter(pcap_channels[channel_index], &program) < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Error setting the filter.");
-			pcap_freealldevs(all_devs);  // Free the device list
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Error setting the filter. %s", pcap_geterr(pcap_channels[channel_index]));
 			return -1;
 		}
 
-		/*********** Flush any packets that might be present **********/
-		for(uint32_t index_j = 0; index_j < 1; index_j++)
+		return 0;
+	}
+
+	int net_interface_imp::set_capture_acmp(bool accept_acmp)
+	{
+		capture_acmp = accept_acmp;
+
+		return ((pcap_channels[CAPTURE_CHANNEL_ADP] == NULL) && (replay == NULL)) ? 0 : attach_channel_filter(CAPTURE_CHANNEL_ADP);
+	}
+
+	int net_interface_imp::set_busy_poll(uint32_t busy_poll_us)
+	{
+		int status = 0;
+
+		is_busy_poll = (busy_poll_us > 0);
+
+		for(uint32_t channel_index = 0; channel_index < CAPTURE_CHANNEL_COUNT; channel_index++)
 		{
-			ether_packet = pcap_next(pcap_interface, &pcap_header);
+			if(pcap_channels[channel_index] && (apply_channel_busy_poll(channel_index) < 0))
+			{
+				status = -1;
+			}
+		}
+
+		return status;
+	}
+
+	int net_interface_imp::apply_channel_busy_poll(uint32_t channel_index)
+	{
+		/**
+		 * WinPcap holds captured frames in the driver until MIN_TO_COPY_DEFAULT bytes are buffered or the read
+		 * timeout expires. A minimum of 0 hands each frame to the capture thread as soon as it arrives.
+		 */
+		if(pcap_setmintocopy(pcap_channels[channel_index], is_busy_poll ? 0 : MIN_TO_COPY_DEFAULT) < 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_WARNING, "pcap_setmintocopy error %s", pcap_geterr(pcap_channels[channel_index]));
+			return -1;
 		}
 
 		return 0;
 	}
 
 	int STDCALL net_interface_imp::capture_frame(const uint8_t **frame, uint16_t *mem_buf_len)
+	{
+		return capture_channel_frame(CAPTURE_CHANNEL_AECP, frame, mem_buf_len);
+	}
+
+	int net_interface_imp::capture_channel_frame(uint32_t channel_index, const uint8_t **frame, uint16_t *mem_buf_len)
 	{
 		struct pcap_pkthdr *header;
 		int error = 0;
 
 		*mem_buf_len = 0;
-		error = pcap_next_ex(pcap_interface, &header, frame);
+
+		if(replay)
+		{
+			return capture_replay_frame(channel_index, frame, mem_buf_len);
+		}
+
+		error = pcap_next_ex(pcap_channels[channel_index], &header, frame);
 
 		if(error > 0 )
 		{
@@ -252,16 +415,119 @@ namespace avdecc_lib
 		return -2; // Timeout
 	}
 
+	int net_interface_imp::capture_replay_frame(uint32_t channel_index, const uint8_t **frame, uint16_t *mem_buf_len)
+	{
+		uint32_t delay_us;
+		int status;
+
+		status = replay->next_frame(channel_index, frame, mem_buf_len, &delay_us);
+
+		while((status == 0) && (delay_us < NETIF_READ_TIMEOUT_MS * 1000))
+		{
+			Sleep(delay_us / 1000);
+			status = replay->next_frame(channel_index, frame, mem_buf_len, &delay_us);
+		}
+
+		if(status > 0)
+		{
+			return 1;
+		}
+
+		Sleep(NETIF_READ_TIMEOUT_MS); // Behave like the read timeout of a live interface
+		return -2; // Timeout
+	}
+
 	int net_interface_imp::send_frame(uint8_t *frame, uint16_t mem_buf_len)
 	{
 		//	printf("TX frame: %d bytes\n", length);
 
-		if(pcap_sendpacket(pcap_interface, frame, mem_buf_len) != 0)
+		if(tx_batch.get_is_open())
+		{
+			if(tx_batch.is_full())
+			{
+				send_frames(tx_batch.get_frames(), tx_batch.get_mem_buf_lens(), tx_batch.get_frame_count());
+				tx_batch.clear();
+			}
+
+			if(tx_batch.add_frame(frame, mem_buf_len) == 0)
+			{
+				return 0;
+			}
+		}
+
+		if(replay)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "pcap_sendpacket error %s", pcap_geterr(pcap_interface));
+			replay->record_tx_frame(frame, mem_buf_len);
+			return 0;
+		}
+
+		if(pcap_sendpacket(pcap_channels[CAPTURE_CHANNEL_AECP], frame, mem_buf_len) != 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "pcap_sendpacket error %s", pcap_geterr(pcap_channels[CAPTURE_CHANNEL_AECP]));
 			return -1;
 		}
 
 		return 0;
 	}
+
+	int net_interface_imp::send_frames(uint8_t **frames, uint16_t *mem_buf_lens, uint32_t count)
+	{
+		struct pcap_pkthdr pcap_header;
+		uint32_t queued_count = 0;
+
+		if(replay)
+		{
+			for(uint32_t index_i = 0; index_i < count; index_i++)
+			{
+				replay->record_tx_frame(frames[index_i], mem_buf_lens[index_i]);
+			}
+
+			return 0;
+		}
+
+		memset(&pcap_header, 0, sizeof(pcap_header));
+
+		while(queued_count < count)
+		{
+			tx_send_queue->len = 0; // Reuse the send queue allocated when the interface was selected
+
+			for(; queued_count < count; queued_count++)
+			{
+				pcap_header.caplen = mem_buf_lens[queued_count];
+				pcap_header.len = mem_buf_lens[queued_count];
+
+				if(pcap_sendqueue_queue(tx_send_queue, &pcap_header, frames[queued_count]) != 0)
+				{
+					break; // The send queue is full, transmit it and queue the remaining frames
+				}
+			}
+
+			if(pcap_sendqueue_transmit(pcap_channels[CAPTURE_CHANNEL_AECP], tx_send_queue, 0) < tx_send_queue->len)
+			{
+				log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "pcap_sendqueue_transmit error %s", pcap_geterr(pcap_channels[CAPTURE_CHANNEL_AECP]));
+				return -1;
+			}
+		}
+
+		return 0;
+	}
+
+	void net_interface_imp::tx_batch_begin()
+	{
+		tx_batch.open();
+	}
+
+	int net_interface_imp::tx_batch_flush()
+	{
+		int status = 0;
+
+		if(tx_batch.get_frame_count() > 0)
+		{
+			status = send_frames(tx_batch.get_frames(), tx_batch.get_mem_buf_lens(), tx_batch.get_frame_count());
+		}
+
+		tx_batch.close();
+
+		return status;
+	}
 }
@@ -37,21 +37,47 @@
 #include <pcap.h>
 #include "build.h"
 #include "net_interface.h"
+#include "frame_batch.h"
+#include "capture_filter.h"
+#include "log.h"
 
 namespace avdecc_lib
 {
+	class capture_replay;
+
 	class net_interface_imp : public virtual net_interface
 	{
+	public:
+		enum capture_channels
+		{
+		        CAPTURE_CHANNEL_AECP, // AECP frames sent to the Controller
+		        CAPTURE_CHANNEL_ADP, // ADP frames, and optionally ACMP frames, sent to a multicast address
+		        CAPTURE_CHANNEL_COUNT
+		};
+
 	private:
+		enum capture_sizes
+		{
+		        MIN_TO_COPY_DEFAULT = 16000 // The WinPcap default for the data buffered in the driver before a read returns
+		};
+
 		pcap_if_t *all_devs;
 		pcap_if_t *dev;
 		uint64_t mac;
 		uint32_t total_devs;
 		uint32_t interface_num; // The interface selected
-		pcap_t *pcap_interface;
+		pcap_t *pcap_channels[CAPTURE_CHANNEL_COUNT]; // Adapter handles used for capturing the frames of each channel, the AECP one also sends frames
+		capture_filter channel_filters[CAPTURE_CHANNEL_COUNT]; // Programs that admit only the frames of each channel
 		char err_buf[PCAP_ERRBUF_SIZE];
 		const u_char *ether_frame;
 		uint8_t tx_frame[1500];	// Ethernet frame used to send packets
+		frame_batch tx_batch; // Frames held for transmission while a transmit batch is open
+		bool capture_acmp; // Set if ACMP frames are admitted by the ADP channel
+		bool is_busy_poll; // Set if captured frames are handed to the capture threads without waiting for more to arrive
+		capture_replay *replay; // The source of the frames captured when a capture file is replayed, NULL for a live interface
+		log netif_log; // The log used until the network interface is attached to a Controller, which has no thread
+		log *log_ref; // The log of the Controller the network interface is attached to, or netif_log
+		pcap_send_queue *tx_send_queue; // WinPcap send queue used to transmit a batch of frames with a single call
 
 	public:
 		/**
@@ -59,6 +85,13 @@ namespace avdecc_lib
 		 */
 		net_interface_imp();
 
+		/**
+		 * A constructor for net_interface_imp used for replaying a capture file in place of a live interface, with the
+		 * MAC address of the Controller that recorded it, the replay pace, and the file the frames sent are recorded
+		 * to, or NULL to discard them.
+		 */
+		net_interface_imp(const char *capture_file_path, uint64_t replay_mac, bool is_recorded_pace, const char *tx_file_path);
+
 		/**
 		 * Destructor for net_interface_imp used for destroying objects
 		 */
@@ -74,6 +107,17 @@ namespace avdecc_lib
 		 */
 		uint64_t get_mac();
 
+		/**
+		 * Set the log the network interface logs to, or NULL to log to its own log.
+		 */
+		void set_log(log *new_log_ref);
+
+		/**
+		 * Get the time the frame captured last was received by the network interface. Frames are captured on separate
+		 * threads and queued, so no receive timestamp is available and 0 is returned.
+		 */
+		uint64_t get_rx_timestamp();
+
 		/**
 		 * Get the corresponding device description by index.
 		 */
@@ -85,23 +129,79 @@ namespace avdecc_lib
 		int STDCALL select_interface_by_num(uint32_t interface_num);
 
 		/**
-		 * Update the Ethernet type for the network interface.
+		 * Generate the capture filters for the MAC address of the interface selected and attach them, so that only AECP
+		 * frames sent to the Controller are captured on the AECP channel, and only ADP frames and optionally ACMP frames
+		 * sent to a multicast address are captured on the ADP channel.
+		 */
+		int update_capture_filter();
+
+		/**
+		 * Set whether ACMP frames are captured and update the capture filter if an interface is selected.
+		 */
+		int set_capture_acmp(bool accept_acmp);
+
+		/**
+		 * Set whether each captured frame is handed to the capture threads as soon as it arrives, rather than once the
+		 * driver has buffered enough data or the read timeout expires, for the low-latency busy poll mode.
 		 */
-		int set_capture_ether_type(uint16_t *ether_type, uint32_t count);
+		int set_busy_poll(uint32_t busy_poll_us);
 
 		/**
-		 * Capture a network packet.
+		 * Capture a network packet from the AECP channel.
 		 */
 		int STDCALL capture_frame(const uint8_t **frame, uint16_t *mem_buf_len);
 
 		/**
-		 * Send a network packet.
+		 * Capture a network packet of a channel, waiting up to the read timeout of the channel.
+		 */
+		int capture_channel_frame(uint32_t channel_index, const uint8_t **frame, uint16_t *mem_buf_len);
+
+		/**
+		 * Send a network packet. While a transmit batch is open the packet is held and sent by tx_batch_flush.
 		 */
 		int send_frame(uint8_t *frame, uint16_t mem_buf_len);
 
-	};
+		/**
+		 * Send several network packets with a single submission.
+		 */
+		int send_frames(uint8_t **frames, uint16_t *mem_buf_lens, uint32_t count);
+
+		/**
+		 * Open a transmit batch, so that packets sent until tx_batch_flush is called are held and sent together.
+		 */
+		void tx_batch_begin();
+
+		/**
+		 * Send all packets held in the transmit batch with a single submission and close the batch.
+		 */
+		int tx_batch_flush();
+
+	private:
+		/**
+		 * Set the members that are common to a live interface and a replayed capture file to their initial values.
+		 */
+		void init_members();
 
-	extern net_interface_imp *net_interface_ref;
+		/**
+		 * Capture the next replayed frame of a channel, waiting up to the read timeout for it to be due.
+		 */
+		int capture_replay_frame(uint32_t channel_index, const uint8_t **frame, uint16_t *mem_buf_len);
+
+		/**
+		 * Open an adapter handle on the interface selected.
+		 */
+		pcap_t * open_interface(int timeout_ms);
+
+		/**
+		 * Generate the capture filter of a channel and attach it.
+		 */
+		int attach_channel_filter(uint32_t channel_index);
+
+		/**
+		 * Apply the busy poll mode to the adapter handle of a channel.
+		 */
+		int apply_channel_busy_poll(uint32_t channel_index);
+	};
 }
 
 #endif
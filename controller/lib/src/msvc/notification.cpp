@@ -39,17 +39,10 @@ extern "C" void default_notification(void *notification_user_obj, int32_t notifi
 
 namespace avdecc_lib
 {
-	uint32_t notification::read_index = 0;
-	uint32_t notification::write_index = 0;
-	void (*notification::notification_callback) (void *, int32_t, uint64_t, uint16_t, uint16_t, uint16_t, void *);
-	void *notification::user_obj;
-	uint32_t notification::missed_notification_event_cnt = 0;
-	HANDLE notification::poll_events[2];
-
-	notification *notification_ref = new notification();
-
 	notification::notification()
 	{
+		read_index = 0;
+		write_index = 0;
 		notifications = avdecc_lib::NO_MATCH_FOUND;
 		notification_callback = default_notification;
 		user_obj = NULL;
@@ -58,7 +51,14 @@ namespace avdecc_lib
 		notification_thread_init(); // Start notification thread
 	}
 
-	notification::~notification() {}
+	notification::~notification()
+	{
+		SetEvent(poll_events[KILL_EVENT]);
+		WaitForSingleObject(h_thread, INFINITE); // Wait for thread termination
+		CloseHandle(h_thread);
+		CloseHandle(poll_events[NOTIFICATION_EVENT]);
+		CloseHandle(poll_events[KILL_EVENT]);
+	}
 
 	int notification::notification_thread_init()
 	{
@@ -68,7 +68,7 @@ namespace avdecc_lib
 		h_thread = CreateThread(NULL, // Default security descriptor
 		                        0, // Default stack size
 		                        process_notification_thread, // Point to the start address of the thread
-		                        &notification_buf, // Data to be passed to the thread
+		                        this, // Data to be passed to the thread
 		                        0, // Flag controlling the creation of the thread
 		                        &thread_id // Thread identifier
 		                       );
@@ -84,31 +84,34 @@ namespace avdecc_lib
 	DWORD WINAPI notification::process_notification_thread(LPVOID lpParam)
 	{
 		DWORD dwEvent;
-		struct notification_data *data = (struct notification_data *)lpParam;
+		notification *notifier = (notification *)lpParam;
+		struct notification_data *data = notifier->notification_buf;
 
 		while (true)
 		{
-			dwEvent = WaitForMultipleObjects(2, poll_events, FALSE, INFINITE);
+			dwEvent = WaitForMultipleObjects(2, notifier->poll_events, FALSE, INFINITE);
 
 			if(dwEvent == (WAIT_OBJECT_0 + NOTIFICATION_EVENT))
 			{
-				if((write_index - read_index) > 0)
+				if((notifier->write_index - notifier->read_index) > 0)
 				{
-					notification_callback(user_obj,
-					                      data[read_index % NOTIFICATION_BUF_COUNT].notification_type,
-					                      data[read_index % NOTIFICATION_BUF_COUNT].guid,
-					                      data[read_index % NOTIFICATION_BUF_COUNT].cmd_type,
-					                      data[read_index % NOTIFICATION_BUF_COUNT].desc_type,
-					                      data[read_index % NOTIFICATION_BUF_COUNT].desc_index,
-					                      data[read_index % NOTIFICATION_BUF_COUNT].notification_id
-					                     ); // Call callback function
-					read_index++;
+					uint32_t read_index = notifier->read_index;
+
+					notifier->notification_callback(notifier->user_obj,
+					                                data[read_index % NOTIFICATION_BUF_COUNT].notification_type,
+					                                data[read_index % NOTIFICATION_BUF_COUNT].guid,
+					                                data[read_index % NOTIFICATION_BUF_COUNT].cmd_type,
+					                                data[read_index % NOTIFICATION_BUF_COUNT].desc_type,
+					                                data[read_index % NOTIFICATION_BUF_COUNT].desc_index,
+					                                data[read_index % NOTIFICATION_BUF_COUNT].notification_id
+					                               ); // Call callback function
+					notifier->read_index++;
 				}
 			}
 
 			else
 			{
-				SetEvent(poll_events[KILL_EVENT]);
+				SetEvent(notifier->poll_events[KILL_EVENT]);
 				break;
 			}
 		}
@@ -153,4 +156,9 @@ namespace avdecc_lib
 	{
 		return missed_notification_event_cnt;
 	}
+
+	HANDLE notification::get_thread_handle()
+	{
+		return h_thread;
+	}
 }
@@ -40,11 +40,11 @@ namespace avdecc_lib
 	{
 	private:
 		int32_t notifications;
-		static uint32_t read_index;
-		static uint32_t write_index;
-		static void (*notification_callback) (void *, int32_t, uint64_t, uint16_t, uint16_t, uint16_t, void *);
-		static void *user_obj;
-		static uint32_t missed_notification_event_cnt;
+		uint32_t read_index;
+		uint32_t write_index;
+		void (*notification_callback) (void *, int32_t, uint64_t, uint16_t, uint16_t, uint16_t, void *);
+		void *user_obj;
+		uint32_t missed_notification_event_cnt;
 
 		enum
 		{
@@ -61,7 +61,7 @@ namespace avdecc_lib
 		HANDLE h_thread;
 		DWORD thread_id;
 
-		static HANDLE poll_events[2];
+		HANDLE poll_events[2];
 
 		struct notification_data
 		{
@@ -77,12 +77,12 @@ namespace avdecc_lib
 
 	public:
 		/**
-		 * An empty constructor for notification
+		 * An empty constructor for notification, which starts the notification thread.
 		 */
 		notification();
 
 		/**
-		 * Destructor for notification used for destroying objects
+		 * Destructor for notification used for destroying objects, which stops the notification thread.
 		 */
 		virtual ~notification();
 
@@ -92,7 +92,7 @@ namespace avdecc_lib
 		int notification_thread_init();
 
 		/**
-		 * Start of the notifying thread used for generating notification messages.
+		 * Start of the notifying thread used for generating notification messages, with the notification as parameter.
 		 */
 		static DWORD WINAPI process_notification_thread(LPVOID lpParam);
 
@@ -110,9 +110,12 @@ namespace avdecc_lib
 		 * Get the number of missed notification that exceeds the notification buffer count.
 		 */
 		uint32_t get_missed_notification_event_count();
-	};
 
-	extern notification *notification_ref;
+		/**
+		 * Get the handle of the notification thread.
+		 */
+		HANDLE get_thread_handle();
+	};
 }
 
 #endif
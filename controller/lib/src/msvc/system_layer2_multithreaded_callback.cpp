@@ -28,66 +28,67 @@
  */
 
 #include <vector>
-#include "net_interface.h"
+#include "net_interface_imp.h"
 #include "enumeration.h"
 #include "notification.h"
 #include "log.h"
 #include "end_station.h"
-#include "controller.h"
-#include "system_message_queue.h"
-#include "system_tx_queue.h"
+#include "controller_imp.h"
+#include "atomic_ops.h"
+#include "spsc_ring.h"
+#include "mpsc_ring.h"
+#include "controller_context.h"
+#include "timer_wheel.h"
 #include "system_layer2_multithreaded_callback.h"
 
 namespace avdecc_lib
 {
-	net_interface *netif_obj_in_system;
-	controller *controller_ref_in_system;
-	system_layer2_multithreaded_callback *local_system = NULL;
-	struct system_layer2_multithreaded_callback::msg_poll system_layer2_multithreaded_callback::poll_rx;
-	struct system_layer2_multithreaded_callback::msg_poll system_layer2_multithreaded_callback::poll_tx;
-	struct system_layer2_multithreaded_callback::thread_creation system_layer2_multithreaded_callback::poll_thread;
-	HANDLE system_layer2_multithreaded_callback::poll_events_array[NUM_OF_EVENTS];
-	HANDLE system_layer2_multithreaded_callback::waiting_sem;
-	bool system_layer2_multithreaded_callback::is_waiting = false;
-	bool system_layer2_multithreaded_callback::queue_is_waiting = false;
-	void *system_layer2_multithreaded_callback::waiting_notification_id = 0;
-	int system_layer2_multithreaded_callback::resp_status_for_cmd = STATUS_INVALID_COMMAND;
-
-	size_t system_queue_tx(void *notification_id, uint32_t notification_flag, uint8_t *frame, size_t mem_buf_len)
-	{
-		if(local_system)
-		{
-			return local_system->queue_tx_frame(notification_id, notification_flag, frame, mem_buf_len);
-		}
-		else
-		{
-			return 0;
-		}
-	}
-
 	system * STDCALL create_system(system::system_type type, net_interface *netif, controller *controller_obj)
 	{
-		local_system = new system_layer2_multithreaded_callback(netif, controller_obj);
-
-		return local_system;
+		return new system_layer2_multithreaded_callback(netif, controller_obj);
 	}
 
 	system_layer2_multithreaded_callback::system_layer2_multithreaded_callback() {}
 
 	system_layer2_multithreaded_callback::system_layer2_multithreaded_callback(net_interface *netif, controller *controller_obj)
 	{
-		netif_obj_in_system = netif;
+		context = dynamic_cast<controller_imp *>(controller_obj)->get_context();
+		netif_obj_in_system = dynamic_cast<net_interface_imp *>(netif);
+
+		if(!netif_obj_in_system)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Dynamic cast from base net_interface to derived net_interface_imp error");
+		}
+
 		controller_ref_in_system = controller_obj;
+		memset(poll_rx, 0, sizeof(poll_rx));
+		memset(&poll_tx, 0, sizeof(poll_tx));
+		memset(&poll_thread, 0, sizeof(poll_thread));
+		memset(poll_events_array, 0, sizeof(poll_events_array));
+		waiting_sem = NULL;
+		queue_frames = new frame_slab(QUEUE_FRAME_COUNT);
+		rx_queue_full_count = 0;
+		memset(&rx_stats, 0, sizeof(rx_stats));
+		memset(rx_pending, 0, sizeof(rx_pending));
+		tx_pending = false;
+		busy_poll_budget_us = 0;
+		spin_budget_us = 0;
+		memset(&busy_stats, 0, sizeof(busy_stats));
+		memset(thread_settings, 0, sizeof(thread_settings));
+		is_waiting = false;
 		queue_is_waiting = false;
+		waiting_notification_id = 0;
+		resp_status_for_cmd = STATUS_INVALID_COMMAND;
+		context->system_tx_queue_ref = this; // Commands built by the Controller are queued to this System
 	}
 
 	system_layer2_multithreaded_callback::~system_layer2_multithreaded_callback()
 	{
-		delete poll_rx.rx_queue;
-		delete poll_tx.tx_queue;
+		free_thread_resources();
+		delete queue_frames;
+		context->system_tx_queue_ref = NULL;
+		controller_ref_in_system->destroy(); // Detaches the network interface from the log of the Controller
 		delete netif_obj_in_system;
-		delete controller_ref_in_system;
-		delete local_system;
 	}
 
 	void STDCALL system_layer2_multithreaded_callback::destroy()
@@ -95,16 +96,40 @@ namespace avdecc_lib
 		delete this;
 	}
 
-	int system_layer2_multithreaded_callback::queue_tx_frame(void *notification_id, uint32_t notification_flag, uint8_t *frame, size_t mem_buf_len)
+	int system_layer2_multithreaded_callback::queue_tx_reserve(struct system_tx_slot &slot)
+	{
+		if(queue_frames->alloc(slot.frame_index) < 0)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "queue_tx_reserve error, no frame buffer available");
+			queue_is_waiting = false;
+			return -1;
+		}
+
+		slot.frame = queue_frames->get_frame(slot.frame_index);
+		slot.frame_size = frame_slab::FRAME_SLAB_FRAME_SIZE;
+
+		return 0;
+	}
+
+	void system_layer2_multithreaded_callback::queue_tx_abort(struct system_tx_slot &slot)
+	{
+		queue_frames->release(slot.frame_index);
+		queue_is_waiting = false;
+	}
+
+	int system_layer2_multithreaded_callback::queue_tx_commit(struct system_tx_slot &slot, void *notification_id, uint32_t notification_flag, size_t mem_buf_len)
 	{
 		struct poll_thread_data thread_data;
 
-		thread_data.frame = (uint8_t *)malloc(1600);
+		thread_data.frame_index = slot.frame_index;
 		thread_data.mem_buf_len = mem_buf_len;
-		memcpy(thread_data.frame, frame, mem_buf_len);
 		thread_data.notification_id = notification_id;
 		thread_data.notification_flag = notification_flag;
-		poll_tx.tx_queue->queue_push(&thread_data);
+
+		while(poll_tx.tx_queue->push(&thread_data) < 0)
+		{
+			Sleep(1); // Wait for the poll thread to make space in the transmit queue
+		}
 
 		/**
 		 * If queue_is_waiting is true, wait for the response before returning.
@@ -132,9 +157,152 @@ namespace avdecc_lib
 		return resp_status_for_cmd;
 	}
 
+	uint32_t STDCALL system_layer2_multithreaded_callback::queue_frame_high_watermark()
+	{
+		return queue_frames->get_high_watermark();
+	}
+
+	uint32_t STDCALL system_layer2_multithreaded_callback::missed_queue_frame_count()
+	{
+		return queue_frames->get_exhausted_count() + rx_queue_full_count;
+	}
+
+	void STDCALL system_layer2_multithreaded_callback::get_rx_batch_stats(uint32_t &batch_count, uint32_t &frame_count, uint32_t &max_batch_size)
+	{
+		batch_count = rx_stats.batch_count;
+		frame_count = rx_stats.frame_count;
+		max_batch_size = rx_stats.max_batch_size;
+	}
+
+	void STDCALL system_layer2_multithreaded_callback::get_adp_shed_stats(uint32_t &adp_frame_count, uint32_t &shed_count)
+	{
+		adp_frame_count = adp_shedder.get_adp_frame_count();
+		shed_count = adp_shedder.get_shed_count();
+	}
+
+	int STDCALL system_layer2_multithreaded_callback::set_busy_poll(uint32_t new_spin_budget_us)
+	{
+		busy_poll_budget_us = new_spin_budget_us;
+		spin_budget_us = new_spin_budget_us;
+
+		return netif_obj_in_system->set_busy_poll(new_spin_budget_us);
+	}
+
+	void STDCALL system_layer2_multithreaded_callback::get_busy_poll_stats(uint32_t &spin_hit_count, uint32_t &sleep_count)
+	{
+		spin_hit_count = busy_stats.spin_hit_count;
+		sleep_count = busy_stats.sleep_count;
+	}
+
+	int STDCALL system_layer2_multithreaded_callback::set_thread_sched(thread_role role, int32_t cpu, thread_policy policy, int32_t priority)
+	{
+		int status = 0;
+
+		if((uint32_t)role >= THREAD_ROLE_COUNT)
+		{
+			return -1;
+		}
+
+		thread_settings[role].is_set = true;
+		thread_settings[role].cpu = cpu;
+		thread_settings[role].policy = policy;
+		thread_settings[role].priority = priority;
+
+		switch(role)
+		{
+			case THREAD_CAPTURE:
+				for(uint32_t channel_index = 0; channel_index < net_interface_imp::CAPTURE_CHANNEL_COUNT; channel_index++)
+				{
+					if(poll_rx[channel_index].queue_thread.handle &&
+					   (thread_sched::apply(context->log_ref, poll_rx[channel_index].queue_thread.handle, cpu, policy, priority) < 0))
+					{
+						status = -1;
+					}
+				}
+
+				return status; // Applied when the wpcap threads are created if they are not running
+
+			case THREAD_POLL:
+				if(!poll_thread.handle)
+				{
+					return 0; // Applied when the poll thread is created
+				}
+
+				return thread_sched::apply(context->log_ref, poll_thread.handle, cpu, policy, priority);
+
+			case THREAD_NOTIFICATION:
+				return thread_sched::apply(context->log_ref, context->notification_ref->get_thread_handle(), cpu, policy, priority);
+
+			case THREAD_LOG:
+				return thread_sched::apply(context->log_ref, context->log_ref->get_thread_handle(), cpu, policy, priority);
+
+			default:
+				return -1;
+		}
+	}
+
+	int STDCALL system_layer2_multithreaded_callback::get_thread_sched(thread_role role, int32_t &cpu, thread_policy &policy, int32_t &priority)
+	{
+		HANDLE thread_handle;
+
+		switch(role)
+		{
+			case THREAD_CAPTURE:
+				thread_handle = poll_rx[net_interface_imp::CAPTURE_CHANNEL_AECP].queue_thread.handle; // Both wpcap threads have the same settings
+				break;
+
+			case THREAD_POLL:
+				thread_handle = poll_thread.handle;
+				break;
+
+			case THREAD_NOTIFICATION:
+				thread_handle = context->notification_ref->get_thread_handle();
+				break;
+
+			case THREAD_LOG:
+				thread_handle = context->log_ref->get_thread_handle();
+				break;
+
+			default:
+				return -1;
+		}
+
+		if(!thread_handle)
+		{
+			return -1;
+		}
+
+		cpu = thread_settings[role].is_set ? thread_settings[role].cpu : -1;
+
+		return thread_sched::get(context->log_ref, thread_handle, cpu, policy, priority);
+	}
+
+	int STDCALL system_layer2_multithreaded_callback::set_engine_shards(uint32_t shard_count)
+	{
+		if(shard_count != 1)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Engine shards are only supported by the epoll System");
+			return -1;
+		}
+
+		return context->controller_imp_ref->set_engine_shard_count(shard_count);
+	}
+
+	int STDCALL system_layer2_multithreaded_callback::set_desc_decode_workers(uint32_t worker_count)
+	{
+		if(worker_count != 0)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Decode threads are only supported by the epoll System");
+			return -1;
+		}
+
+		return 0;
+	}
+
 	DWORD WINAPI system_layer2_multithreaded_callback::proc_wpcap_thread(LPVOID lpParam)
 	{
 		struct msg_poll *data = (struct msg_poll *)lpParam;
+		system_layer2_multithreaded_callback *system_obj = data->owner;
 		int status;
 		struct poll_thread_data thread_data;
 		const uint8_t *frame;
@@ -142,21 +310,35 @@ namespace avdecc_lib
 
 		while(WaitForSingleObject(data->queue_thread.kill_sem, 0))
 		{
-			status = netif_obj_in_system->capture_frame(&frame, &length);
+			status = system_obj->netif_obj_in_system->capture_channel_frame(data->channel_index, &frame, &length);
 
-			if(status > 0)
+			/**
+			 * Advertisements that repeat what the engine already knows are discarded while the poll thread is behind
+			 * on either receive queue.
+			 */
+			if((status > 0) && (data->channel_index == net_interface_imp::CAPTURE_CHANNEL_ADP))
 			{
-				thread_data.mem_buf_len = length;
-				thread_data.frame = (uint8_t *)malloc(1600);
-				memcpy(thread_data.frame, frame, thread_data.mem_buf_len);
-				poll_rx.rx_queue->queue_push(&thread_data);
+				bool is_under_pressure = !system_obj->poll_rx[net_interface_imp::CAPTURE_CHANNEL_AECP].rx_queue->is_empty() ||
+				                         !data->rx_queue->is_empty();
+
+				if(system_obj->adp_shedder.is_redundant(frame_view(frame, length, 0), is_under_pressure, timer_wheel::clk_monotonic_ms()))
+				{
+					continue;
+				}
 			}
-			else
+
+			if(status > 0)
 			{
-				if(!SetEvent(data->timeout_event))
+				if((length <= frame_slab::FRAME_SLAB_FRAME_SIZE) && (system_obj->queue_frames->alloc(thread_data.frame_index) == 0)) // Drop the frame if no frame buffer is free
 				{
-					avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "SetEvent pkt_event_wpcap_timeout failed");
-					exit(EXIT_FAILURE);
+					thread_data.mem_buf_len = length;
+					memcpy(system_obj->queue_frames->get_frame(thread_data.frame_index), frame, thread_data.mem_buf_len);
+
+					if(data->rx_queue->push(&thread_data) < 0)
+					{
+						system_obj->queue_frames->release(thread_data.frame_index);
+						atomic_inc_uint32(&system_obj->rx_queue_full_count); // Both wpcap threads count dropped frames
+					}
 				}
 			}
 		}
@@ -166,11 +348,14 @@ namespace avdecc_lib
 
 	DWORD WINAPI system_layer2_multithreaded_callback::proc_poll_thread(LPVOID lpParam)
 	{
+		system_layer2_multithreaded_callback *system_obj = (system_layer2_multithreaded_callback *)lpParam;
 		int status;
 
-		while(WaitForSingleObject(poll_thread.kill_sem, 0))
+		while(WaitForSingleObject(system_obj->poll_thread.kill_sem, 0))
 		{
-			status = poll_single();
+			system_obj->netif_obj_in_system->tx_batch_begin(); // Frames sent while handling this event go out together
+			status = system_obj->poll_single();
+			system_obj->netif_obj_in_system->tx_batch_flush();
 
 			if(status != 0)
 			{
@@ -185,37 +370,70 @@ namespace avdecc_lib
 	{
 		if(init_wpcap_thread() < 0 || init_poll_thread() < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "init_polling error");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "init_polling error");
+
+			/**
+			 * Stop the threads started before the failure, so that none is left running on the queues freed.
+			 */
+			process_close();
+			free_thread_resources();
+			return -1;
 		}
 
 		return 0;
 	}
 
+	void system_layer2_multithreaded_callback::free_thread_resources()
+	{
+		for(uint32_t channel_index = 0; channel_index < net_interface_imp::CAPTURE_CHANNEL_COUNT; channel_index++)
+		{
+			delete poll_rx[channel_index].rx_queue;
+			poll_rx[channel_index].rx_queue = NULL;
+			poll_rx[channel_index].queue_thread.handle = NULL;
+		}
+
+		delete poll_tx.tx_queue;
+		poll_tx.tx_queue = NULL;
+		poll_thread.handle = NULL;
+	}
+
 	int system_layer2_multithreaded_callback::init_wpcap_thread()
 	{
-		poll_rx.rx_queue = new system_message_queue(256, sizeof(struct poll_thread_data));
-		poll_rx.queue_thread.kill_sem = CreateSemaphore(NULL, 0, 32767, NULL);
-		poll_rx.timeout_event = CreateEvent(NULL, FALSE, FALSE, NULL);
-		poll_events_array[WPCAP_TIMEOUT] = poll_rx.timeout_event;
-		poll_events_array[WPCAP_RX_PACKET] = poll_rx.rx_queue->queue_data_available_object();
-		poll_rx.queue_thread.handle = CreateThread(NULL, // Default security descriptor
-		                                           0, // Default stack size
-		                                           proc_wpcap_thread, // Point to the start address of the thread
-		                                           &poll_rx, // Data to be passed to the thread
-		                                           0, // Flag controlling the creation of the thread
-		                                           &poll_rx.queue_thread.id // Thread identifier
-		                                          );
-
-		if(poll_rx.queue_thread.handle == NULL)
+		for(uint32_t channel_index = 0; channel_index < net_interface_imp::CAPTURE_CHANNEL_COUNT; channel_index++)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Error creating the wpcap thread");
-			exit(EXIT_FAILURE);
+			struct msg_poll &channel_poll = poll_rx[channel_index];
+
+			channel_poll.owner = this;
+			channel_poll.channel_index = channel_index;
+			channel_poll.rx_queue = new spsc_ring(QUEUE_DEPTH, sizeof(struct poll_thread_data), true);
+			channel_poll.queue_thread.kill_sem = CreateSemaphore(NULL, 0, 32767, NULL);
+			rx_pending[channel_index] = false;
+			channel_poll.queue_thread.handle = CreateThread(NULL, // Default security descriptor
+			                                                0, // Default stack size
+			                                                proc_wpcap_thread, // Point to the start address of the thread
+			                                                &channel_poll, // Data to be passed to the thread
+			                                                0, // Flag controlling the creation of the thread
+			                                                &channel_poll.queue_thread.id // Thread identifier
+			                                               );
+
+			if(channel_poll.queue_thread.handle == NULL)
+			{
+				context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Error creating the wpcap thread");
+				return -1;
+			}
+
+			if(thread_sched::apply(context->log_ref, channel_poll.queue_thread.handle, thread_settings[THREAD_CAPTURE]) < 0)
+			{
+				context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_WARNING, "The wpcap thread runs with the default scheduling");
+			}
 		}
 
-		poll_tx.tx_queue = new system_message_queue(256, sizeof(struct poll_thread_data));
+		poll_events_array[WPCAP_RX_AECP_PACKET] = poll_rx[net_interface_imp::CAPTURE_CHANNEL_AECP].rx_queue->wakeup_object();
+		poll_events_array[WPCAP_RX_ADP_PACKET] = poll_rx[net_interface_imp::CAPTURE_CHANNEL_ADP].rx_queue->wakeup_object();
+
+		poll_tx.tx_queue = new mpsc_ring(QUEUE_DEPTH, sizeof(struct poll_thread_data), true);
 		poll_tx.queue_thread.kill_sem = CreateSemaphore(NULL, 0, 32767, NULL);
-		poll_tx.timeout_event = CreateEvent(NULL, FALSE, FALSE, NULL);
-		poll_events_array[WPCAP_TX_PACKET] = poll_tx.tx_queue->queue_data_available_object();
+		poll_events_array[WPCAP_TX_PACKET] = poll_tx.tx_queue->wakeup_object();
 
 		poll_events_array[KILL_ALL] = CreateEvent(NULL, FALSE, FALSE, NULL);
 
@@ -230,105 +448,278 @@ namespace avdecc_lib
 		poll_thread.handle = CreateThread(NULL, // Default security descriptor //poll_thread_handle = CreateThread(NULL, // Default security descriptor
 		                                  0, // Default stack size
 		                                  proc_poll_thread, // Point to the start address of the thread
-		                                  NULL, // Data to be passed to the thread
+		                                  this, // Data to be passed to the thread
 		                                  0, // Flag controlling the creation of the thread
 		                                  &poll_thread.id // Thread identifier
 		                                 );
 
 		if(poll_thread.handle == NULL)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Error creating the poll thread");
-			exit(EXIT_FAILURE);
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Error creating the poll thread");
+			return -1;
+		}
+
+		if(thread_sched::apply(context->log_ref, poll_thread.handle, thread_settings[THREAD_POLL]) < 0)
+		{
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_WARNING, "The poll thread runs with the default scheduling");
 		}
 
 		return 0;
 	}
 
+	DWORD system_layer2_multithreaded_callback::wait_for_events(DWORD wait_ms)
+	{
+		DWORD poll_count = sizeof(poll_events_array) / sizeof(HANDLE);
+		uint32_t max_spin_us = busy_poll_budget_us;
+		LARGE_INTEGER counter_freq;
+		LARGE_INTEGER spin_start;
+		LARGE_INTEGER spin_now;
+		uint64_t spin_elapsed_us;
+		DWORD dwEvent;
+
+		if((wait_ms == 0) || (max_spin_us == 0))
+		{
+			return WaitForMultipleObjects(poll_count, poll_events_array, FALSE, wait_ms);
+		}
+
+		QueryPerformanceFrequency(&counter_freq);
+		QueryPerformanceCounter(&spin_start);
+
+		do
+		{
+			dwEvent = WaitForMultipleObjects(poll_count, poll_events_array, FALSE, 0);
+
+			if(dwEvent != WAIT_TIMEOUT)
+			{
+				busy_stats.spin_hit_count++;
+				spin_budget_us = max_spin_us; // Traffic is flowing, so spin for the whole budget again
+				return dwEvent;
+			}
+
+			QueryPerformanceCounter(&spin_now);
+			spin_elapsed_us = (uint64_t)(spin_now.QuadPart - spin_start.QuadPart) * 1000000 / counter_freq.QuadPart;
+		}
+		while(spin_elapsed_us < spin_budget_us);
+
+		/**
+		 * Nothing arrived while spinning, so halve the spin budget to waste less CPU time while the network is idle.
+		 */
+		busy_stats.sleep_count++;
+		spin_budget_us = spin_budget_us / 2;
+
+		if(spin_budget_us < max_spin_us / SPIN_BUDGET_MIN_DIVISOR + 1)
+		{
+			spin_budget_us = max_spin_us / SPIN_BUDGET_MIN_DIVISOR + 1;
+		}
+
+		return WaitForMultipleObjects(poll_count, poll_events_array, FALSE, wait_ms);
+	}
+
 	int system_layer2_multithreaded_callback::poll_single()
 	{
-		struct poll_thread_data thread_data;
 		DWORD dwEvent;
-		DWORD poll_count = sizeof(poll_events_array) / sizeof(HANDLE);
+		DWORD wait_ms;
 		int status = 0;
 
-		//adp_discovery_state_machine_ref->set_do_discover(true); // Send ENTITY_DISCOVER message
-		//adp_discovery_state_machine_ref->adp_discovery_state_waiting(NULL);
+		//context->adp_discovery_state_machine_ref->set_do_discover(true); // Send ENTITY_DISCOVER message
+		//context->adp_discovery_state_machine_ref->adp_discovery_state_waiting(NULL);
 
-		dwEvent = WaitForMultipleObjects(poll_count, poll_events_array, FALSE, INFINITE);
+		/**
+		 * Only block when all queues have been emptied, and only until the timer wheel is due. Otherwise just check
+		 * the other events, so the kill event is served between batches of frames.
+		 */
+		wait_ms = (rx_pending[net_interface_imp::CAPTURE_CHANNEL_AECP] || rx_pending[net_interface_imp::CAPTURE_CHANNEL_ADP] || tx_pending) ? 0 : timer_wait_ms();
+		dwEvent = wait_for_events(wait_ms);
 
 		switch (dwEvent)
 		{
-			case WAIT_OBJECT_0 + WPCAP_TIMEOUT:
-				{
-					controller_ref_in_system->time_tick_event();
+			case WAIT_OBJECT_0 + WPCAP_RX_AECP_PACKET:
+				rx_pending[net_interface_imp::CAPTURE_CHANNEL_AECP] = true;
+				break;
 
-					if(is_waiting && (!controller_ref_in_system->is_inflight_cmd_with_notification_id(waiting_notification_id)))
-					{
-						is_waiting = false;
-						resp_status_for_cmd = STATUS_TICK_TIMEOUT;
-						ReleaseSemaphore(waiting_sem, 1, NULL);
+			case WAIT_OBJECT_0 + WPCAP_TX_PACKET:
+				tx_pending = true;
+				break;
 
-					}
-				}
+			case WAIT_OBJECT_0 + WPCAP_RX_ADP_PACKET:
+				rx_pending[net_interface_imp::CAPTURE_CHANNEL_ADP] = true;
+				break;
 
+			case WAIT_OBJECT_0 + KILL_ALL: // Exit or kill event
+				status = -1;
 				break;
+		}
 
-			case WAIT_OBJECT_0 + WPCAP_RX_PACKET:
-				{
-					poll_rx.rx_queue->queue_pop_nowait(&thread_data);
+		/**
+		 * Responses on the AECP channel are served ahead of queued commands, and both ahead of ADP advertisements,
+		 * so that a burst of advertisements cannot delay the completion of inflight commands.
+		 */
+		if(rx_pending[net_interface_imp::CAPTURE_CHANNEL_AECP])
+		{
+			rx_pending[net_interface_imp::CAPTURE_CHANNEL_AECP] = poll_rx_frames(net_interface_imp::CAPTURE_CHANNEL_AECP);
+		}
 
-					bool is_notification_id_valid = false;
-					int status = -1;
+		if(tx_pending)
+		{
+			tx_pending = poll_tx_frames();
+		}
 
-					controller_ref_in_system->rx_packet_event(thread_data.notification_id,
-					                                          is_notification_id_valid,
-					                                          thread_data.notification_flag,
-					                                          thread_data.frame,
-					                                          thread_data.mem_buf_len,
-					                                          status);
+		if(rx_pending[net_interface_imp::CAPTURE_CHANNEL_ADP])
+		{
+			rx_pending[net_interface_imp::CAPTURE_CHANNEL_ADP] = poll_rx_frames(net_interface_imp::CAPTURE_CHANNEL_ADP);
+		}
 
-					if(is_waiting && (!controller_ref_in_system->is_inflight_cmd_with_notification_id(waiting_notification_id)) &&
-					   is_notification_id_valid && (waiting_notification_id == thread_data.notification_id))
-					{
-						resp_status_for_cmd = status;
-						is_waiting = false;
-						ReleaseSemaphore(waiting_sem, 1, NULL);
+		service_timers((dwEvent == WAIT_TIMEOUT) && (wait_ms != 0));
 
-					}
+		return status;
+	}
+
+	DWORD system_layer2_multithreaded_callback::timer_wait_ms()
+	{
+		uint64_t now_ms = timer_wheel::clk_monotonic_ms();
+		uint64_t next_expiry_ms = context->timer_wheel_ref->next_expiry();
+
+		if(next_expiry_ms <= now_ms)
+		{
+			return 0;
+		}
+
+		/**
+		 * Wake up at least every NETIF_READ_TIMEOUT_MS to check on a thread waiting for a response.
+		 */
+		return (next_expiry_ms - now_ms < NETIF_READ_TIMEOUT_MS) ? (DWORD)(next_expiry_ms - now_ms) : NETIF_READ_TIMEOUT_MS;
+	}
+
+	void system_layer2_multithreaded_callback::service_timers(bool is_wait_timed_out)
+	{
+		bool is_due = context->timer_wheel_ref->is_due(timer_wheel::clk_monotonic_ms());
+
+		if(is_due)
+		{
+			controller_ref_in_system->time_tick_event();
+		}
+
+		if((is_due || is_wait_timed_out) && is_waiting &&
+		   (!controller_ref_in_system->is_inflight_cmd_with_notification_id(waiting_notification_id)))
+		{
+			is_waiting = false;
+			resp_status_for_cmd = STATUS_TICK_TIMEOUT;
+			ReleaseSemaphore(waiting_sem, 1, NULL);
+		}
+	}
+
+	bool system_layer2_multithreaded_callback::poll_rx_frames(uint32_t channel_index)
+	{
+		spsc_ring *rx_queue = poll_rx[channel_index].rx_queue;
+		struct poll_thread_data thread_data_batch[QUEUE_POP_BATCH];
+		uint32_t pop_count;
+		uint32_t rx_count = 0;
+
+		do
+		{
+			pop_count = rx_queue->pop_batch(thread_data_batch, QUEUE_POP_BATCH);
+
+			for(uint32_t index_i = 0; index_i < pop_count; index_i++)
+			{
+				struct poll_thread_data &thread_data = thread_data_batch[index_i];
+				bool is_notification_id_valid = false;
+				int status = -1;
+
+				controller_ref_in_system->rx_packet_event(thread_data.notification_id,
+				                                          is_notification_id_valid,
+				                                          thread_data.notification_flag,
+				                                          queue_frames->get_frame(thread_data.frame_index),
+				                                          thread_data.mem_buf_len,
+				                                          status);
+
+				/**
+				 * Only look up the inflight commands for a response to the command being waited on.
+				 */
+				if(is_waiting && is_notification_id_valid && (waiting_notification_id == thread_data.notification_id) &&
+				   (!controller_ref_in_system->is_inflight_cmd_with_notification_id(waiting_notification_id)))
+				{
+					resp_status_for_cmd = status;
+					is_waiting = false;
+					ReleaseSemaphore(waiting_sem, 1, NULL);
 
-					free(thread_data.frame);
 				}
-				break;
 
-			case WAIT_OBJECT_0 + WPCAP_TX_PACKET:
-				poll_tx.tx_queue->queue_pop_nowait(&thread_data);
+				queue_frames->release(thread_data.frame_index);
+			}
 
-				controller_ref_in_system->tx_packet_event(thread_data.notification_id, thread_data.notification_flag, thread_data.frame, thread_data.mem_buf_len);
+			rx_count += pop_count;
+		}
+		while((pop_count == QUEUE_POP_BATCH) && (rx_count < POLL_BUDGET));
+
+		update_rx_batch_stats(rx_count);
+
+		/**
+		 * The receive queue only wakes the poll thread when it was idle, so it has to be found empty before waiting again.
+		 */
+		return (pop_count == QUEUE_POP_BATCH) || !rx_queue->prepare_wait();
+	}
+
+	bool system_layer2_multithreaded_callback::poll_tx_frames()
+	{
+		struct poll_thread_data thread_data_batch[QUEUE_POP_BATCH];
+		uint32_t pop_count;
+		uint32_t tx_count = 0;
+
+		do
+		{
+			pop_count = poll_tx.tx_queue->pop_batch(thread_data_batch, QUEUE_POP_BATCH);
+
+			for(uint32_t index_i = 0; index_i < pop_count; index_i++)
+			{
+				struct poll_thread_data &thread_data = thread_data_batch[index_i];
+
+				controller_ref_in_system->tx_packet_event(thread_data.notification_id, thread_data.notification_flag,
+				                                          queue_frames->get_frame(thread_data.frame_index), thread_data.mem_buf_len);
+				queue_frames->release(thread_data.frame_index);
 
 				if(thread_data.notification_flag == avdecc_lib::CMD_WITH_NOTIFICATION)
 				{
 					waiting_notification_id = thread_data.notification_id;
 				}
+			}
 
-				break;
-
-			case WAIT_OBJECT_0 + KILL_ALL: // Exit or kill event
-				status = -1;
-				break;
+			tx_count += pop_count;
 		}
+		while((pop_count == QUEUE_POP_BATCH) && (tx_count < POLL_BUDGET));
 
-		return status;
+		return (pop_count == QUEUE_POP_BATCH) || !poll_tx.tx_queue->prepare_wait();
+	}
+
+	void system_layer2_multithreaded_callback::update_rx_batch_stats(uint32_t rx_count)
+	{
+		if(rx_count > 0)
+		{
+			rx_stats.batch_count++;
+			rx_stats.frame_count += rx_count;
+
+			if(rx_count > rx_stats.max_batch_size)
+			{
+				rx_stats.max_batch_size = rx_count;
+			}
+		}
 	}
 
 	int STDCALL system_layer2_multithreaded_callback::process_close()
 	{
 		LONG previous;
+		HANDLE aecp_thread = poll_rx[net_interface_imp::CAPTURE_CHANNEL_AECP].queue_thread.handle;
+		HANDLE adp_thread = poll_rx[net_interface_imp::CAPTURE_CHANNEL_ADP].queue_thread.handle;
 
-		ReleaseSemaphore(poll_rx.queue_thread.kill_sem, 1, &previous); // Send kill events to threads
+		/**
+		 * Only the threads created are waited for, as process_close also stops the threads of a failed process_start.
+		 */
+		ReleaseSemaphore(poll_rx[net_interface_imp::CAPTURE_CHANNEL_AECP].queue_thread.kill_sem, 1, &previous); // Send kill events to threads
+		ReleaseSemaphore(poll_rx[net_interface_imp::CAPTURE_CHANNEL_ADP].queue_thread.kill_sem, 1, &previous);
 		ReleaseSemaphore(poll_thread.kill_sem, 1, &previous); // Send kill events to threads
 
-		while ((WaitForSingleObject(poll_rx.queue_thread.handle, 0) != WAIT_OBJECT_0) ||
-		       (WaitForSingleObject(poll_thread.handle, 0) != WAIT_OBJECT_0)) // Wait for thread termination
+		while ((aecp_thread && (WaitForSingleObject(aecp_thread, 0) != WAIT_OBJECT_0)) ||
+		       (adp_thread && (WaitForSingleObject(adp_thread, 0) != WAIT_OBJECT_0)) ||
+		       (poll_thread.handle && (WaitForSingleObject(poll_thread.handle, 0) != WAIT_OBJECT_0))) // Wait for thread termination
 		{
 			Sleep(100);
 		}
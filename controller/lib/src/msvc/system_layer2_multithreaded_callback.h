@@ -32,20 +32,42 @@
 #define _AVDECC_CONTROLLER_LIB_SYSTEM_LAYER2_MULTITHREADED_CALLBACK_H_
 
 #include "system.h"
+#include "frame_slab.h"
+#include "adp_load_shedder.h"
+#include "system_tx_queue.h"
+#include "thread_sched.h"
+#include "net_interface_imp.h"
 
 namespace avdecc_lib
 {
-	class system_layer2_multithreaded_callback : public virtual system
+	class spsc_ring;
+	class mpsc_ring;
+	class controller_context;
+
+	class system_layer2_multithreaded_callback : public virtual system, public system_tx_queue
 	{
 	private:
 		struct poll_thread_data
 		{
-			uint8_t *frame;
+			uint16_t frame_index; // The index of the frame in the queue frame slab
 			uint16_t mem_buf_len;
 			void *notification_id;
 			uint32_t notification_flag;
 		};
 
+		struct rx_batch_stats
+		{
+			uint32_t batch_count;
+			uint32_t frame_count;
+			uint32_t max_batch_size;
+		};
+
+		struct busy_poll_stats
+		{
+			uint32_t spin_hit_count;
+			uint32_t sleep_count;
+		};
+
 		struct thread_creation
 		{
 			LPTHREAD_START_ROUTINE thread;
@@ -56,31 +78,66 @@ namespace avdecc_lib
 
 		struct msg_poll
 		{
+			system_layer2_multithreaded_callback *owner; // The System the wpcap thread captures for
 			struct thread_creation queue_thread;
-			system_message_queue *rx_queue;
-			system_message_queue *tx_queue;
-			HANDLE timeout_event;
+			uint32_t channel_index; // The capture channel served by the wpcap thread
+			spsc_ring *rx_queue; // Frames captured by the wpcap thread
+			mpsc_ring *tx_queue; // Commands queued by application threads
 		};
 
 		enum wpcap_events
 		{
-		        WPCAP_TIMEOUT,
-		        WPCAP_RX_PACKET,
+		        WPCAP_RX_AECP_PACKET, // Lower indexes are reported first when several events are signaled
 		        WPCAP_TX_PACKET,
+		        WPCAP_RX_ADP_PACKET,
 		        KILL_ALL,
 		        NUM_OF_EVENTS
 		};
 
-		static struct msg_poll poll_rx;
-		static struct msg_poll poll_tx;
-		static struct thread_creation poll_thread;
-		static HANDLE poll_events_array[NUM_OF_EVENTS];
-		static HANDLE waiting_sem;
+		enum queue_sizes
+		{
+		        QUEUE_DEPTH = 256,
+		        QUEUE_POP_BATCH = 16, // The number of entries taken from a queue at a time
+		        POLL_BUDGET = 64, // The most entries processed from one source before the other events are served
+		        QUEUE_FRAME_COUNT = 3 * QUEUE_DEPTH + 64 // All queues full, with frames left for the threads blocked pushing to them
+		};
+
+		enum busy_poll_sizes
+		{
+		        SPIN_BUDGET_MIN_DIVISOR = 16 // The spin budget never shrinks below the budget set divided by this
+		};
+
+		enum thread_roles
+		{
+		        THREAD_ROLE_COUNT = THREAD_LOG + 1
+		};
+
+		net_interface_imp *netif_obj_in_system;
+		controller *controller_ref_in_system;
+		controller_context *context; // The context of the Controller the System runs
+		struct msg_poll poll_rx[net_interface_imp::CAPTURE_CHANNEL_COUNT]; // One wpcap thread and receive queue for each capture channel
+		struct msg_poll poll_tx;
+		struct thread_creation poll_thread;
+		HANDLE poll_events_array[NUM_OF_EVENTS];
+		HANDLE waiting_sem;
+		frame_slab *queue_frames; // Frame buffers for the frames held in the receive and transmit queues
+		volatile uint32_t rx_queue_full_count; // The number of captured frames dropped because a receive queue was full
+
+		struct rx_batch_stats rx_stats;
+		adp_load_shedder adp_shedder; // Classifies the frames captured on the ADP channel, used by its wpcap thread only
+		bool rx_pending[net_interface_imp::CAPTURE_CHANNEL_COUNT]; // Set while received frames of a channel may be left to process
+		bool tx_pending; // Set while queued commands may be left to process
+
+		uint32_t busy_poll_budget_us; // The spin budget set for the busy poll mode, 0 if disabled
+		uint32_t spin_budget_us; // The spin budget currently used, adapted to the traffic
+		struct busy_poll_stats busy_stats;
+
+		struct thread_sched::setting thread_settings[THREAD_ROLE_COUNT]; // The thread settings chosen by the application
 
-		static bool is_waiting;
-		static bool queue_is_waiting;
-		static void *waiting_notification_id;
-		static int resp_status_for_cmd;
+		bool is_waiting;
+		bool queue_is_waiting;
+		void *waiting_notification_id;
+		int resp_status_for_cmd;
 
 	public:
 		/**
@@ -104,9 +161,19 @@ namespace avdecc_lib
 		void STDCALL destroy();
 
 		/**
-		 * Store the frame to be sent in a queue.
+		 * Reserve a frame in the transmit queue to build a command in.
 		 */
-		int queue_tx_frame(void *notification_id, uint32_t notification_flag, uint8_t *frame, size_t mem_buf_len);
+		int queue_tx_reserve(struct system_tx_slot &slot);
+
+		/**
+		 * Store a command built in a reserved frame in the transmit queue.
+		 */
+		int queue_tx_commit(struct system_tx_slot &slot, void *notification_id, uint32_t notification_flag, size_t mem_buf_len);
+
+		/**
+		 * Release a reserved frame without transmitting it.
+		 */
+		void queue_tx_abort(struct system_tx_slot &slot);
 
 		/**
 		 * Set a waiting flag for the command sent.
@@ -118,19 +185,70 @@ namespace avdecc_lib
 		 */
 		int STDCALL get_last_resp_status();
 
+		/**
+		 * Get the highest number of frame buffers held by the receive and transmit queues at the same time.
+		 */
+		uint32_t STDCALL queue_frame_high_watermark();
+
+		/**
+		 * Get the number of frames dropped because a receive queue or the frame buffers for the queues were full.
+		 */
+		uint32_t STDCALL missed_queue_frame_count();
+
+		/**
+		 * Get the receive batch statistics of the poll thread.
+		 */
+		void STDCALL get_rx_batch_stats(uint32_t &batch_count, uint32_t &frame_count, uint32_t &max_batch_size);
+
+		/**
+		 * Get the ADP load shedding statistics of the ADP wpcap thread.
+		 */
+		void STDCALL get_adp_shed_stats(uint32_t &adp_frame_count, uint32_t &shed_count);
+
+		/**
+		 * Set the low-latency busy poll mode of the poll thread.
+		 */
+		int STDCALL set_busy_poll(uint32_t spin_budget_us);
+
+		/**
+		 * Get the busy poll statistics of the poll thread.
+		 */
+		void STDCALL get_busy_poll_stats(uint32_t &spin_hit_count, uint32_t &sleep_count);
+
+		/**
+		 * Pin the wpcap, poll, notification or logging threads to a CPU and set their scheduling policy and priority.
+		 */
+		int STDCALL set_thread_sched(thread_role role, int32_t cpu, thread_policy policy, int32_t priority);
+
+		/**
+		 * Get the effective scheduling policy and priority of the wpcap, poll, notification or logging threads, and the CPU
+		 * they were pinned to.
+		 */
+		int STDCALL get_thread_sched(thread_role role, int32_t &cpu, thread_policy &policy, int32_t &priority);
+
+		/**
+		 * Only a single shard is supported, run by the poll thread.
+		 */
+		int STDCALL set_engine_shards(uint32_t shard_count);
+
+		/**
+		 * The descriptors are always decoded by the poll thread.
+		 */
+		int STDCALL set_desc_decode_workers(uint32_t worker_count);
+
 	private:
 		/**
-		 * Start of the packet capture thread used for capturing packets.
+		 * Start of a packet capture thread used for capturing the packets of a channel.
 		 */
 		static DWORD WINAPI proc_wpcap_thread(LPVOID lpParam);
 
 		/**
-		 * Start of the polling thread used for polling events.
+		 * Start of the polling thread used for polling events, with the System as the thread parameter.
 		 */
 		static DWORD WINAPI proc_poll_thread(LPVOID lpParam);
 
 		/**
-		 * Create and initialize threads, events, and semaphores for wpcap thread.
+		 * Create and initialize threads, events, and semaphores for the wpcap threads.
 		 */
 		int init_wpcap_thread();
 
@@ -139,10 +257,50 @@ namespace avdecc_lib
 		 */
 		int init_poll_thread();
 
+		/**
+		 * Free the queues of the wpcap and poll threads, once they are stopped.
+		 */
+		void free_thread_resources();
+
+		/**
+		 * Wait for events. When the busy poll mode is enabled and the wait would block, first spin checking for events
+		 * for up to the spin budget.
+		 */
+		DWORD wait_for_events(DWORD wait_ms);
+
 		/**
 		 * Execute poll events.
 		 */
-		static int poll_single();
+		int poll_single();
+
+		/**
+		 * Process up to POLL_BUDGET frames received on a capture channel.
+		 *
+		 * \return True if received frames may be left to process.
+		 */
+		bool poll_rx_frames(uint32_t channel_index);
+
+		/**
+		 * Process up to POLL_BUDGET queued commands.
+		 *
+		 * \return True if queued commands may be left to process.
+		 */
+		bool poll_tx_frames();
+
+		/**
+		 * Get how long the poll thread may block before the timer wheel is due, at most NETIF_READ_TIMEOUT_MS.
+		 */
+		DWORD timer_wait_ms();
+
+		/**
+		 * Expire the timers of the timer wheel that are due.
+		 */
+		void service_timers(bool is_wait_timed_out);
+
+		/**
+		 * Update the receive batch statistics with the number of frames processed in a batch.
+		 */
+		void update_rx_batch_stats(uint32_t rx_count);
 
 	public:
 		/**
@@ -0,0 +1,118 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * thread_sched.cpp
+ *
+ * Thread scheduling implementation
+ */
+
+#include "enumeration.h"
+#include "log.h"
+#include "thread_sched.h"
+
+namespace avdecc_lib
+{
+	int thread_sched::apply(log *log_ref, thread_handle thread, int32_t cpu, system::thread_policy policy, int32_t priority)
+	{
+		DWORD_PTR process_mask;
+		DWORD_PTR system_mask;
+		DWORD_PTR thread_mask;
+		int thread_priority;
+
+		if(cpu >= (int32_t)(sizeof(DWORD_PTR) * 8))
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "CPU %d is out of range", cpu);
+			return -1;
+		}
+
+		if(cpu < 0)
+		{
+			if(!GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask))
+			{
+				log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "GetProcessAffinityMask error %d", GetLastError());
+				return -1;
+			}
+
+			thread_mask = process_mask;
+		}
+		else
+		{
+			thread_mask = (DWORD_PTR)1 << cpu;
+		}
+
+		if(SetThreadAffinityMask(thread, thread_mask) == 0)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "SetThreadAffinityMask error %d", GetLastError());
+			return -1;
+		}
+
+		if(policy == system::THREAD_POLICY_FIFO)
+		{
+			thread_priority = THREAD_PRIORITY_TIME_CRITICAL;
+		}
+		else if((priority >= THREAD_PRIORITY_LOWEST) && (priority <= THREAD_PRIORITY_HIGHEST))
+		{
+			thread_priority = priority;
+		}
+		else
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Thread priority %d is out of range", priority);
+			return -1;
+		}
+
+		if(!SetThreadPriority(thread, thread_priority))
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "SetThreadPriority error %d", GetLastError());
+			return -1;
+		}
+
+		return 0;
+	}
+
+	int thread_sched::apply(log *log_ref, thread_handle thread, const struct setting &thread_setting)
+	{
+		if(!thread_setting.is_set)
+		{
+			return 0;
+		}
+
+		return apply(log_ref, thread, thread_setting.cpu, thread_setting.policy, thread_setting.priority);
+	}
+
+	int thread_sched::get(log *log_ref, thread_handle thread, int32_t &cpu, system::thread_policy &policy, int32_t &priority)
+	{
+		int thread_priority = GetThreadPriority(thread);
+
+		if(thread_priority == THREAD_PRIORITY_ERROR_RETURN)
+		{
+			log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "GetThreadPriority error %d", GetLastError());
+			return -1;
+		}
+
+		policy = (thread_priority == THREAD_PRIORITY_TIME_CRITICAL) ? system::THREAD_POLICY_FIFO : system::THREAD_POLICY_OTHER;
+		priority = thread_priority;
+
+		return 0;
+	}
+}
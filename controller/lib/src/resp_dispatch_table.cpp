@@ -0,0 +1,146 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * resp_dispatch_table.cpp
+ *
+ * Response dispatch table implementation
+ */
+
+#include "resp_dispatch_table.h"
+
+namespace avdecc_lib
+{
+	resp_dispatch_table::resp_dispatch_table()
+	{
+		register_resp_handler(JDKSAVDECC_AEM_COMMAND_SET_STREAM_FORMAT, JDKSAVDECC_DESCRIPTOR_STREAM_INPUT, &descriptor_base_imp::proc_set_stream_format_resp);
+		register_resp_handler(JDKSAVDECC_AEM_COMMAND_SET_STREAM_FORMAT, JDKSAVDECC_DESCRIPTOR_STREAM_OUTPUT, &descriptor_base_imp::proc_set_stream_format_resp);
+		register_resp_handler(JDKSAVDECC_AEM_COMMAND_GET_STREAM_FORMAT, JDKSAVDECC_DESCRIPTOR_STREAM_INPUT, &descriptor_base_imp::proc_get_stream_format_resp);
+		register_resp_handler(JDKSAVDECC_AEM_COMMAND_GET_STREAM_FORMAT, JDKSAVDECC_DESCRIPTOR_STREAM_OUTPUT, &descriptor_base_imp::proc_get_stream_format_resp);
+		register_resp_handler(JDKSAVDECC_AEM_COMMAND_SET_STREAM_INFO, JDKSAVDECC_DESCRIPTOR_STREAM_INPUT, &descriptor_base_imp::proc_set_stream_info_resp);
+		register_resp_handler(JDKSAVDECC_AEM_COMMAND_SET_STREAM_INFO, JDKSAVDECC_DESCRIPTOR_STREAM_OUTPUT, &descriptor_base_imp::proc_set_stream_info_resp);
+		register_resp_handler(JDKSAVDECC_AEM_COMMAND_GET_STREAM_INFO, JDKSAVDECC_DESCRIPTOR_STREAM_INPUT, &descriptor_base_imp::proc_get_stream_info_resp);
+		register_resp_handler(JDKSAVDECC_AEM_COMMAND_GET_STREAM_INFO, JDKSAVDECC_DESCRIPTOR_STREAM_OUTPUT, &descriptor_base_imp::proc_get_stream_info_resp);
+		register_resp_handler(JDKSAVDECC_AEM_COMMAND_SET_SAMPLING_RATE, JDKSAVDECC_DESCRIPTOR_AUDIO_UNIT, &descriptor_base_imp::proc_set_sampling_rate_resp);
+		register_resp_handler(JDKSAVDECC_AEM_COMMAND_GET_SAMPLING_RATE, JDKSAVDECC_DESCRIPTOR_AUDIO_UNIT, &descriptor_base_imp::proc_get_sampling_rate_resp);
+		register_resp_handler(JDKSAVDECC_AEM_COMMAND_SET_CLOCK_SOURCE, JDKSAVDECC_DESCRIPTOR_CLOCK_DOMAIN, &descriptor_base_imp::proc_set_clock_source_resp);
+		register_resp_handler(JDKSAVDECC_AEM_COMMAND_GET_CLOCK_SOURCE, JDKSAVDECC_DESCRIPTOR_CLOCK_DOMAIN, &descriptor_base_imp::proc_get_clock_source_resp);
+		register_resp_handler(JDKSAVDECC_AEM_COMMAND_START_STREAMING, JDKSAVDECC_DESCRIPTOR_STREAM_INPUT, &descriptor_base_imp::proc_start_streaming_resp);
+		register_resp_handler(JDKSAVDECC_AEM_COMMAND_START_STREAMING, JDKSAVDECC_DESCRIPTOR_STREAM_OUTPUT, &descriptor_base_imp::proc_start_streaming_resp);
+		register_resp_handler(JDKSAVDECC_AEM_COMMAND_STOP_STREAMING, JDKSAVDECC_DESCRIPTOR_STREAM_INPUT, &descriptor_base_imp::proc_stop_streaming_resp);
+		register_resp_handler(JDKSAVDECC_AEM_COMMAND_STOP_STREAMING, JDKSAVDECC_DESCRIPTOR_STREAM_OUTPUT, &descriptor_base_imp::proc_stop_streaming_resp);
+
+		register_decode_desc_handler(JDKSAVDECC_DESCRIPTOR_ENTITY, &decode_desc<entity_descriptor_imp>);
+		register_decode_desc_handler(JDKSAVDECC_DESCRIPTOR_CONFIGURATION, &decode_desc<configuration_descriptor_imp>);
+		register_decode_desc_handler(JDKSAVDECC_DESCRIPTOR_AUDIO_UNIT, &decode_desc<audio_unit_descriptor_imp>);
+		register_decode_desc_handler(JDKSAVDECC_DESCRIPTOR_STREAM_INPUT, &decode_desc<stream_input_descriptor_imp>);
+		register_decode_desc_handler(JDKSAVDECC_DESCRIPTOR_STREAM_OUTPUT, &decode_desc<stream_output_descriptor_imp>);
+		register_decode_desc_handler(JDKSAVDECC_DESCRIPTOR_JACK_INPUT, &decode_desc<jack_input_descriptor_imp>);
+		register_decode_desc_handler(JDKSAVDECC_DESCRIPTOR_JACK_OUTPUT, &decode_desc<jack_output_descriptor_imp>);
+		register_decode_desc_handler(JDKSAVDECC_DESCRIPTOR_AVB_INTERFACE, &decode_desc<avb_interface_descriptor_imp>);
+		register_decode_desc_handler(JDKSAVDECC_DESCRIPTOR_CLOCK_SOURCE, &decode_desc<clock_source_descriptor_imp>);
+		register_decode_desc_handler(JDKSAVDECC_DESCRIPTOR_LOCALE, &decode_desc<locale_descriptor_imp>);
+		register_decode_desc_handler(JDKSAVDECC_DESCRIPTOR_STRINGS, &decode_desc<strings_descriptor_imp>);
+		register_decode_desc_handler(JDKSAVDECC_DESCRIPTOR_CLOCK_DOMAIN, &decode_desc<clock_domain_descriptor_imp>);
+
+		register_store_desc_handler(JDKSAVDECC_DESCRIPTOR_AUDIO_UNIT, &configuration_descriptor_imp::store_audio_unit_desc);
+		register_store_desc_handler(JDKSAVDECC_DESCRIPTOR_STREAM_INPUT, &configuration_descriptor_imp::store_stream_input_desc);
+		register_store_desc_handler(JDKSAVDECC_DESCRIPTOR_STREAM_OUTPUT, &configuration_descriptor_imp::store_stream_output_desc);
+		register_store_desc_handler(JDKSAVDECC_DESCRIPTOR_JACK_INPUT, &configuration_descriptor_imp::store_jack_input_desc);
+		register_store_desc_handler(JDKSAVDECC_DESCRIPTOR_JACK_OUTPUT, &configuration_descriptor_imp::store_jack_output_desc);
+		register_store_desc_handler(JDKSAVDECC_DESCRIPTOR_AVB_INTERFACE, &configuration_descriptor_imp::store_avb_interface_desc);
+		register_store_desc_handler(JDKSAVDECC_DESCRIPTOR_CLOCK_SOURCE, &configuration_descriptor_imp::store_clock_source_desc);
+		register_store_desc_handler(JDKSAVDECC_DESCRIPTOR_LOCALE, &configuration_descriptor_imp::store_locale_desc);
+		register_store_desc_handler(JDKSAVDECC_DESCRIPTOR_STRINGS, &configuration_descriptor_imp::store_strings_desc);
+		register_store_desc_handler(JDKSAVDECC_DESCRIPTOR_CLOCK_DOMAIN, &configuration_descriptor_imp::store_clock_domain_desc);
+	}
+
+	resp_dispatch_table::~resp_dispatch_table() {}
+
+	void resp_dispatch_table::register_resp_handler(uint16_t cmd_type, uint16_t desc_type, resp_handler handler)
+	{
+		uint32_t handler_pos;
+
+		if(resp_handler_index.find(resp_handler_key(cmd_type, desc_type), handler_pos))
+		{
+			resp_handlers[handler_pos] = handler;
+		}
+		else
+		{
+			resp_handler_index.insert(resp_handler_key(cmd_type, desc_type), resp_handlers.size());
+			resp_handlers.push_back(handler);
+		}
+	}
+
+	resp_dispatch_table::resp_handler resp_dispatch_table::find_resp_handler(uint16_t cmd_type, uint16_t desc_type)
+	{
+		uint32_t handler_pos;
+
+		if(resp_handler_index.find(resp_handler_key(cmd_type, desc_type), handler_pos))
+		{
+			return resp_handlers[handler_pos];
+		}
+
+		return NULL;
+	}
+
+	void resp_dispatch_table::register_decode_desc_handler(uint16_t desc_type, decode_desc_handler handler)
+	{
+		if(decode_desc_handlers.size() <= desc_type)
+		{
+			decode_desc_handlers.resize(desc_type + 1, NULL);
+		}
+
+		decode_desc_handlers[desc_type] = handler;
+	}
+
+	resp_dispatch_table::decode_desc_handler resp_dispatch_table::find_decode_desc_handler(uint16_t desc_type)
+	{
+		if(desc_type < decode_desc_handlers.size())
+		{
+			return decode_desc_handlers[desc_type];
+		}
+
+		return NULL;
+	}
+
+	void resp_dispatch_table::register_store_desc_handler(uint16_t desc_type, store_desc_handler handler)
+	{
+		if(store_desc_handlers.size() <= desc_type)
+		{
+			store_desc_handlers.resize(desc_type + 1, NULL);
+		}
+
+		store_desc_handlers[desc_type] = handler;
+	}
+
+	resp_dispatch_table::store_desc_handler resp_dispatch_table::find_store_desc_handler(uint16_t desc_type)
+	{
+		if(desc_type < store_desc_handlers.size())
+		{
+			return store_desc_handlers[desc_type];
+		}
+
+		return NULL;
+	}
+}
@@ -0,0 +1,136 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * resp_dispatch_table.h
+ *
+ * Response dispatch table class, which holds the handlers of the AEM responses by command type and descriptor
+ * type, and the handlers storing the descriptors read by READ_DESCRIPTOR by descriptor type.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_RESP_DISPATCH_TABLE_H_
+#define _AVDECC_CONTROLLER_LIB_RESP_DISPATCH_TABLE_H_
+
+#include <vector>
+#include "guid_index.h"
+#include "frame_view.h"
+#include "descriptor_base_imp.h"
+#include "configuration_descriptor_imp.h"
+#include "entity_descriptor_imp.h"
+
+namespace avdecc_lib
+{
+	class resp_dispatch_table
+	{
+	public:
+		/**
+		 * The handler of a response, called on the descriptor the response is for.
+		 */
+		typedef int (descriptor_base_imp::*resp_handler)(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
+
+		/**
+		 * The handler decoding a descriptor read by READ_DESCRIPTOR into a new descriptor object. It only reads the
+		 * frame, so it may run outside the engine thread.
+		 */
+		typedef descriptor_base_imp * (*decode_desc_handler)(end_station_imp *base_end_station_imp_ref, const uint8_t *frame, size_t pos, size_t mem_buf_len);
+
+		/**
+		 * The handler storing a decoded descriptor in its Configuration.
+		 */
+		typedef void (configuration_descriptor_imp::*store_desc_handler)(descriptor_base_imp *desc);
+
+	private:
+		std::vector<resp_handler> resp_handlers; // The response handlers registered
+		guid_index resp_handler_index; // The position of each response handler in resp_handlers, by command type and descriptor type
+		std::vector<decode_desc_handler> decode_desc_handlers; // The decode handlers registered, by descriptor type
+		std::vector<store_desc_handler> store_desc_handlers; // The store handlers registered, by descriptor type
+
+	public:
+		/**
+		 * Constructor for resp_dispatch_table used for registering the handlers of the descriptors implemented.
+		 */
+		resp_dispatch_table();
+
+		/**
+		 * Destructor for resp_dispatch_table used for destroying objects
+		 */
+		~resp_dispatch_table();
+
+		/**
+		 * Register the handler of the responses to a command for a descriptor type, replacing any handler registered before.
+		 */
+		void register_resp_handler(uint16_t cmd_type, uint16_t desc_type, resp_handler handler);
+
+		/**
+		 * Get the handler of the responses to a command for a descriptor type.
+		 *
+		 * \return The handler, or NULL if no handler is registered.
+		 */
+		resp_handler find_resp_handler(uint16_t cmd_type, uint16_t desc_type);
+
+		/**
+		 * Register the handler decoding the descriptors of a type read by READ_DESCRIPTOR, replacing any handler registered before.
+		 */
+		void register_decode_desc_handler(uint16_t desc_type, decode_desc_handler handler);
+
+		/**
+		 * Get the handler decoding the descriptors of a type read by READ_DESCRIPTOR.
+		 *
+		 * \return The handler, or NULL if no handler is registered.
+		 */
+		decode_desc_handler find_decode_desc_handler(uint16_t desc_type);
+
+		/**
+		 * Register the handler storing the decoded descriptors of a type in their Configuration, replacing any handler registered before.
+		 */
+		void register_store_desc_handler(uint16_t desc_type, store_desc_handler handler);
+
+		/**
+		 * Get the handler storing the decoded descriptors of a type in their Configuration.
+		 *
+		 * \return The handler, or NULL if no handler is registered.
+		 */
+		store_desc_handler find_store_desc_handler(uint16_t desc_type);
+
+	private:
+		/**
+		 * Decode a descriptor read by READ_DESCRIPTOR into a new object of its descriptor class.
+		 */
+		template <class desc_imp>
+		static descriptor_base_imp * decode_desc(end_station_imp *base_end_station_imp_ref, const uint8_t *frame, size_t pos, size_t mem_buf_len)
+		{
+			return new desc_imp(base_end_station_imp_ref, frame, pos, mem_buf_len);
+		}
+
+		/**
+		 * Get the key of a command type and descriptor type in resp_handler_index.
+		 */
+		inline uint64_t resp_handler_key(uint16_t cmd_type, uint16_t desc_type)
+		{
+			return ((uint64_t)cmd_type << 16) | desc_type;
+		}
+	};
+}
+
+#endif
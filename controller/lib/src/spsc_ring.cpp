@@ -0,0 +1,154 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * spsc_ring.cpp
+ *
+ * Single producer, single consumer ring implementation
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "spsc_ring.h"
+
+namespace avdecc_lib
+{
+	spsc_ring::spsc_ring(uint32_t count, uint32_t size, bool use_wakeup)
+	{
+		for(entry_count = 1; entry_count < count; entry_count <<= 1);
+
+		entry_size = size;
+		buf = (uint8_t *)calloc(entry_count, entry_size);
+		wakeup = use_wakeup ? new ring_wakeup() : NULL;
+		head = 0;
+		tail = 0;
+	}
+
+	spsc_ring::~spsc_ring()
+	{
+		free(buf);
+		delete wakeup;
+	}
+
+	int spsc_ring::push(const void *entry)
+	{
+		return (push_batch(entry, 1) == 1) ? 0 : -1;
+	}
+
+	uint32_t spsc_ring::push_batch(const void *entries, uint32_t count)
+	{
+		uint32_t pos = tail;
+		uint32_t free_count = entry_count - (pos - head);
+
+		if(count > free_count)
+		{
+			count = free_count;
+		}
+
+		for(uint32_t index_i = 0; index_i < count; index_i++)
+		{
+			memcpy(&buf[((pos + index_i) & (entry_count - 1)) * entry_size], (const uint8_t *)entries + index_i * entry_size, entry_size);
+		}
+
+		if(count > 0)
+		{
+			atomic_full_barrier(); // Publish the entries before the new tail
+			tail = pos + count;
+
+			if(wakeup)
+			{
+				wakeup->notify();
+			}
+		}
+
+		return count;
+	}
+
+	int spsc_ring::pop(void *entry)
+	{
+		return (pop_batch(entry, 1) == 1) ? 0 : -1;
+	}
+
+	uint32_t spsc_ring::pop_batch(void *entries, uint32_t max_count)
+	{
+		uint32_t pos = head;
+		uint32_t count = tail - pos;
+
+		if(count > max_count)
+		{
+			count = max_count;
+		}
+
+		if(count == 0)
+		{
+			return 0;
+		}
+
+		atomic_full_barrier(); // Read the entries only after the tail that published them
+
+		for(uint32_t index_i = 0; index_i < count; index_i++)
+		{
+			memcpy((uint8_t *)entries + index_i * entry_size, &buf[((pos + index_i) & (entry_count - 1)) * entry_size], entry_size);
+		}
+
+		atomic_full_barrier(); // Finish reading the entries before the producer can reuse them
+		head = pos + count;
+
+		return count;
+	}
+
+	bool spsc_ring::is_empty()
+	{
+		return head == tail;
+	}
+
+	bool spsc_ring::prepare_wait()
+	{
+		assert(wakeup);
+
+		wakeup->begin_idle();
+
+		if(!is_empty())
+		{
+			wakeup->cancel_idle();
+			return false;
+		}
+
+		return true;
+	}
+
+	void spsc_ring::clear_wakeup()
+	{
+		assert(wakeup);
+
+		wakeup->clear();
+	}
+
+	ring_wakeup::wakeup_handle spsc_ring::wakeup_object()
+	{
+		assert(wakeup);
+
+		return wakeup->get_handle();
+	}
+}
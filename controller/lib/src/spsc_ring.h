@@ -0,0 +1,119 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * spsc_ring.h
+ *
+ * Single producer, single consumer ring class, which passes fixed-size entries from one thread to another
+ * without locks. Used for the frames passed from the capture thread to the poll thread.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_SPSC_RING_H_
+#define _AVDECC_CONTROLLER_LIB_SPSC_RING_H_
+
+#include <stdint.h>
+#include "atomic_ops.h"
+#include "ring_wakeup.h"
+
+namespace avdecc_lib
+{
+	class spsc_ring
+	{
+	private:
+		uint8_t *buf; // Storage for the entries
+		uint32_t entry_count; // The number of entries in the ring, a power of 2
+		uint32_t entry_size; // The size of an entry in bytes
+		ring_wakeup *wakeup; // Wakes the consumer when it is idle, or NULL if the consumer only polls
+
+		uint8_t head_pad[CACHE_LINE_SIZE];
+		volatile uint32_t head; // The position of the next entry to pop, written by the consumer only
+		uint8_t tail_pad[CACHE_LINE_SIZE];
+		volatile uint32_t tail; // The position of the next entry to push, written by the producer only
+		uint8_t end_pad[CACHE_LINE_SIZE];
+
+	public:
+		/**
+		 * Constructor for spsc_ring used for constructing a ring with count entries of size bytes. The count is
+		 * rounded up to a power of 2. The consumer can only block on the ring if use_wakeup is set.
+		 */
+		spsc_ring(uint32_t count, uint32_t size, bool use_wakeup);
+
+		/**
+		 * Destructor for spsc_ring used for destroying objects
+		 */
+		~spsc_ring();
+
+		/**
+		 * Push an entry to the ring.
+		 *
+		 * \return 0 on success, -1 if the ring is full.
+		 */
+		int push(const void *entry);
+
+		/**
+		 * Push up to count entries stored one after another to the ring, waking the consumer once.
+		 *
+		 * \return The number of entries pushed.
+		 */
+		uint32_t push_batch(const void *entries, uint32_t count);
+
+		/**
+		 * Pop an entry from the ring.
+		 *
+		 * \return 0 on success, -1 if the ring is empty.
+		 */
+		int pop(void *entry);
+
+		/**
+		 * Pop up to max_count entries from the ring, stored one after another.
+		 *
+		 * \return The number of entries popped.
+		 */
+		uint32_t pop_batch(void *entries, uint32_t max_count);
+
+		/**
+		 * Check if the ring is empty.
+		 */
+		bool is_empty();
+
+		/**
+		 * Mark the consumer as idle before it blocks on the wakeup handle.
+		 *
+		 * \return True if the ring is still empty and the consumer can block, false if it has to pop again.
+		 */
+		bool prepare_wait();
+
+		/**
+		 * Reset the wakeup after the consumer has been woken.
+		 */
+		void clear_wakeup();
+
+		/**
+		 * Get the handle the consumer waits on.
+		 */
+		ring_wakeup::wakeup_handle wakeup_object();
+	};
+}
+
+#endif
@@ -33,7 +33,7 @@
 #include "adp.h"
 #include "aecp.h"
 #include "end_station_imp.h"
-#include "system_tx_queue.h"
+#include "controller_context.h"
 #include "aem_controller_state_machine.h"
 #include "stream_input_descriptor_imp.h"
 
@@ -41,13 +41,13 @@ namespace avdecc_lib
 {
 	stream_input_descriptor_imp::stream_input_descriptor_imp() {}
 
-	stream_input_descriptor_imp::stream_input_descriptor_imp(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len) : descriptor_base_imp(base_end_station_imp_ref)
+	stream_input_descriptor_imp::stream_input_descriptor_imp(end_station_imp *base_end_station_imp_ref, const uint8_t *frame, size_t pos, size_t mem_buf_len) : descriptor_base_imp(base_end_station_imp_ref)
 	{
 		stream_input_desc_read_returned = jdksavdecc_descriptor_stream_read(&stream_input_desc, frame, pos, mem_buf_len);
 
 		if(stream_input_desc_read_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "desc_stream_input_read error");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "desc_stream_input_read error");
 			assert(stream_input_desc_read_returned >= 0);
 		}
 
@@ -282,10 +282,9 @@ namespace avdecc_lib
 
 	int STDCALL stream_input_descriptor_imp::send_set_stream_format_cmd(void *notification_id, uint16_t desc_index, uint64_t new_stream_format)
 	{
-		struct jdksavdecc_frame *ether_frame;
+		struct system_tx_slot tx_slot;
 		struct jdksavdecc_aem_command_set_stream_format aem_cmd_set_stream_format;
 		int aem_cmd_set_stream_format_returned;
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
 
 		/***************************************** AECP Common Data ********************************************/
 		aem_cmd_set_stream_format.controller_entity_id = base_end_station_imp_ref->get_adp()->get_controller_guid();
@@ -298,64 +297,59 @@ namespace avdecc_lib
 		jdksavdecc_uint64_write(new_stream_format, &aem_cmd_set_stream_format.stream_format, 0, sizeof(uint64_t));
 
 		/******************************** Fill frame payload with AECP data and send the frame ***************************/
-		aecp::ether_frame_init(base_end_station_imp_ref, ether_frame);
+		if(system_queue_tx_reserve(context, tx_slot) < 0)
+		{
+			return -1;
+		}
+
+		aecp::ether_frame_init(base_end_station_imp_ref, tx_slot.frame);
 		aem_cmd_set_stream_format_returned = jdksavdecc_aem_command_set_stream_format_write(&aem_cmd_set_stream_format,
-		                                                                                    ether_frame->payload,
+		                                                                                    tx_slot.frame,
 		                                                                                    aecp::CMD_POS,
-		                                                                                    sizeof(ether_frame->payload));
+		                                                                                    tx_slot.frame_size);
 
 		if(aem_cmd_set_stream_format_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_set_stream_format_write error\n");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_set_stream_format_write error\n");
 			assert(aem_cmd_set_stream_format_returned >= 0);
+			system_queue_tx_abort(context, tx_slot);
 			return -1;
 		}
 
-		aecp::common_hdr_init(ether_frame, base_end_station_imp_ref->get_end_station_guid());
-		system_queue_tx(notification_id, avdecc_lib::CMD_WITH_NOTIFICATION, ether_frame->payload, ether_frame->length);
+		aecp::common_hdr_init(base_end_station_imp_ref, tx_slot.frame, tx_slot.frame_size);
+		system_queue_tx_commit(context, tx_slot, notification_id, avdecc_lib::CMD_WITH_NOTIFICATION, AECP_FRAME_LEN);
 
-		free(ether_frame);
 		return 0;
 	}
 
-	int stream_input_descriptor_imp::proc_set_stream_format_resp(void *notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status)
+	int stream_input_descriptor_imp::proc_set_stream_format_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
 	{
-		struct jdksavdecc_frame *ether_frame;
 		int aem_cmd_set_stream_format_resp_returned;
-		uint32_t msg_type;
-		bool u_field;
-
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
-		memcpy(ether_frame->payload, frame, mem_buf_len);
 
 		aem_cmd_set_stream_format_resp_returned = jdksavdecc_aem_command_set_stream_format_response_read(&aem_cmd_set_stream_format_resp,
-		                                                                                                 frame,
+		                                                                                                 rx_frame.frame(),
 		                                                                                                 aecp::CMD_POS,
-		                                                                                                 mem_buf_len);
+		                                                                                                 rx_frame.length());
 
 		if(aem_cmd_set_stream_format_resp_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_set_stream_format_resp_read error\n");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_set_stream_format_resp_read error\n");
 			assert(aem_cmd_set_stream_format_resp_returned >= 0);
 			return -1;
 		}
 
-		msg_type = aem_cmd_get_stream_format_resp.aem_header.aecpdu_header.header.message_type;
-		status = aem_cmd_get_stream_format_resp.aem_header.aecpdu_header.header.status;
-		u_field = aem_cmd_get_stream_format_resp.command_type >> 15 & 0x01; // u_field = the msb of the uint16_t command_type
+		status = rx_frame.status();
 
-		aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, msg_type, u_field, ether_frame);
+		context->aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, rx_frame);
 
-		free(ether_frame);
 		return 0;
 	}
 
 	int STDCALL stream_input_descriptor_imp::send_get_stream_format_cmd(void *notification_id, uint16_t desc_index)
 	{
-		struct jdksavdecc_frame *ether_frame;
+		struct system_tx_slot tx_slot;
 		struct jdksavdecc_aem_command_get_stream_format aem_cmd_get_stream_format;
 		int aem_cmd_get_stream_format_returned;
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
 
 		/***************************************** AECP Common Data ********************************************/
 		aem_cmd_get_stream_format.controller_entity_id = base_end_station_imp_ref->get_adp()->get_controller_guid();
@@ -367,65 +361,60 @@ namespace avdecc_lib
 		aem_cmd_get_stream_format.descriptor_index = desc_index;
 
 		/******************************** Fill frame payload with AECP data and send the frame ***************************/
-		aecp::ether_frame_init(base_end_station_imp_ref, ether_frame);
+		if(system_queue_tx_reserve(context, tx_slot) < 0)
+		{
+			return -1;
+		}
+
+		aecp::ether_frame_init(base_end_station_imp_ref, tx_slot.frame);
 		aem_cmd_get_stream_format_returned = jdksavdecc_aem_command_get_stream_format_write(&aem_cmd_get_stream_format,
-		                                                                                    ether_frame->payload,
+		                                                                                    tx_slot.frame,
 		                                                                                    aecp::CMD_POS,
-		                                                                                    sizeof(ether_frame->payload));
+		                                                                                    tx_slot.frame_size);
 
 		if(aem_cmd_get_stream_format_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_stream_format_write error\n");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_stream_format_write error\n");
 			assert(aem_cmd_get_stream_format_returned >= 0);
+			system_queue_tx_abort(context, tx_slot);
 			return -1;
 		}
 
-		aecp::common_hdr_init(ether_frame, base_end_station_imp_ref->get_end_station_guid());
-		system_queue_tx(notification_id, avdecc_lib::CMD_WITH_NOTIFICATION, ether_frame->payload, ether_frame->length);
+		aecp::common_hdr_init(base_end_station_imp_ref, tx_slot.frame, tx_slot.frame_size);
+		system_queue_tx_commit(context, tx_slot, notification_id, avdecc_lib::CMD_WITH_NOTIFICATION, AECP_FRAME_LEN);
 
-		free(ether_frame);
 		return 0;
 	}
 
-	int stream_input_descriptor_imp::proc_get_stream_format_resp(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status)
+	int stream_input_descriptor_imp::proc_get_stream_format_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
 	{
-		struct jdksavdecc_frame *ether_frame;
 		int aem_cmd_get_stream_format_resp_returned;
-		uint32_t msg_type;
-		bool u_field;
-
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
-		memcpy(ether_frame->payload, frame, mem_buf_len);
 
 		aem_cmd_get_stream_format_resp_returned = jdksavdecc_aem_command_get_stream_format_response_read(&aem_cmd_get_stream_format_resp,
-		                                                                                                 frame,
+		                                                                                                 rx_frame.frame(),
 		                                                                                                 aecp::CMD_POS,
-		                                                                                                 mem_buf_len);
+		                                                                                                 rx_frame.length());
 
 		if(aem_cmd_get_stream_format_resp_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_stream_format_resp_read error\n");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_stream_format_resp_read error\n");
 			assert(aem_cmd_get_stream_format_resp_returned >= 0);
 			return -1;
 		}
 
-		msg_type = aem_cmd_get_stream_format_resp.aem_header.aecpdu_header.header.message_type;
-		status = aem_cmd_get_stream_format_resp.aem_header.aecpdu_header.header.status;
-		u_field = aem_cmd_get_stream_format_resp.command_type >> 15 & 0x01; // u_field = the msb of the uint16_t command_type
+		status = rx_frame.status();
 
-		aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, msg_type, u_field, ether_frame);
+		context->aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, rx_frame);
 
-		free(ether_frame);
 		return 0;
 	}
 
 	int STDCALL stream_input_descriptor_imp::send_set_stream_info_cmd(void *notification_id, uint16_t desc_index, void *new_stream_info_field)
 	{
-		struct jdksavdecc_frame *ether_frame;
+		struct system_tx_slot tx_slot;
 		struct jdksavdecc_aem_command_set_stream_info aem_cmd_set_stream_info;
 		int aem_cmd_set_stream_info_returned;
 		//		uint32_t stream_info_index;
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
 
 		/****************************************** AECP Common Data *****************************************/
 		aem_cmd_set_stream_info.controller_entity_id = base_end_station_imp_ref->get_adp()->get_controller_guid();
@@ -451,70 +440,65 @@ namespace avdecc_lib
 		}
 		else
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Matching stream info is not found.\n");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "Matching stream info is not found.\n");
 			return -1;
 		}*/
 
 		/************************** Fill frame payload with AECP data and send the frame *****************************/
-		aecp::ether_frame_init(base_end_station_imp_ref, ether_frame);
+		if(system_queue_tx_reserve(context, tx_slot) < 0)
+		{
+			return -1;
+		}
+
+		aecp::ether_frame_init(base_end_station_imp_ref, tx_slot.frame);
 		aem_cmd_set_stream_info_returned = jdksavdecc_aem_command_set_stream_info_write(&aem_cmd_set_stream_info,
-		                                                                                ether_frame->payload,
+		                                                                                tx_slot.frame,
 		                                                                                aecp::CMD_POS,
-		                                                                                sizeof(ether_frame->payload));
+		                                                                                tx_slot.frame_size);
 
 		if(aem_cmd_set_stream_info_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_set_stream_info_write error\n");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_set_stream_info_write error\n");
 			assert(aem_cmd_set_stream_info_returned >= 0);
+			system_queue_tx_abort(context, tx_slot);
 			return -1;
 		}
 
-		aecp::common_hdr_init(ether_frame, base_end_station_imp_ref->get_end_station_guid());
-		system_queue_tx(notification_id, avdecc_lib::CMD_WITH_NOTIFICATION, ether_frame->payload, ether_frame->length);
+		aecp::common_hdr_init(base_end_station_imp_ref, tx_slot.frame, tx_slot.frame_size);
+		system_queue_tx_commit(context, tx_slot, notification_id, avdecc_lib::CMD_WITH_NOTIFICATION, AECP_FRAME_LEN);
 
-		free(ether_frame);
 		return 0;
 	}
 
-	int stream_input_descriptor_imp::proc_set_stream_info_resp(void *notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status)
+	int stream_input_descriptor_imp::proc_set_stream_info_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
 	{
-		struct jdksavdecc_frame *ether_frame;
 		struct jdksavdecc_aem_command_set_stream_info_response aem_cmd_set_stream_info_resp;
 		int aem_cmd_set_stream_info_resp_returned;
-		uint32_t msg_type;
-		bool u_field;
-
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
-		memcpy(ether_frame->payload, frame, mem_buf_len);
 
 		aem_cmd_set_stream_info_resp_returned = jdksavdecc_aem_command_set_stream_info_response_read(&aem_cmd_set_stream_info_resp,
-		                                                                                             frame,
+		                                                                                             rx_frame.frame(),
 		                                                                                             aecp::CMD_POS,
-		                                                                                             mem_buf_len);
+		                                                                                             rx_frame.length());
 
 		if(aem_cmd_set_stream_info_resp_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_set_stream_info_resp_read error\n");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_set_stream_info_resp_read error\n");
 			assert(aem_cmd_set_stream_info_resp_returned >= 0);
 			return -1;
 		}
 
-		msg_type = aem_cmd_get_stream_info_resp.aem_header.aecpdu_header.header.message_type;
-		status = aem_cmd_get_stream_info_resp.aem_header.aecpdu_header.header.status;
-		u_field = aem_cmd_get_stream_info_resp.command_type >> 15 & 0x01; // u_field = the msb of the uint16_t command_type
+		status = rx_frame.status();
 
-		aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, msg_type, u_field, ether_frame);
+		context->aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, rx_frame);
 
-		free(ether_frame);
 		return 0;
 	}
 
 	int STDCALL stream_input_descriptor_imp::send_get_stream_info_cmd(void *notification_id, uint16_t desc_index)
 	{
-		struct jdksavdecc_frame *ether_frame;
+		struct system_tx_slot tx_slot;
 		struct jdksavdecc_aem_command_get_stream_info aem_cmd_get_stream_info;
 		int aem_cmd_get_stream_info_returned;
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
 
 		/****************************************** AECP Common Data *****************************************/
 		aem_cmd_get_stream_info.controller_entity_id = base_end_station_imp_ref->get_adp()->get_controller_guid();
@@ -526,64 +510,60 @@ namespace avdecc_lib
 		aem_cmd_get_stream_info.descriptor_index = desc_index;
 
 		/************************** Fill frame payload with AECP data and send the frame *****************************/
-		aecp::ether_frame_init(base_end_station_imp_ref, ether_frame);
+		if(system_queue_tx_reserve(context, tx_slot) < 0)
+		{
+			return -1;
+		}
+
+		aecp::ether_frame_init(base_end_station_imp_ref, tx_slot.frame);
 		aem_cmd_get_stream_info_returned = jdksavdecc_aem_command_get_stream_info_write(&aem_cmd_get_stream_info,
-		                                                                                ether_frame->payload,
+		                                                                                tx_slot.frame,
 		                                                                                aecp::CMD_POS,
-		                                                                                sizeof(ether_frame->payload));
+		                                                                                tx_slot.frame_size);
 
 		if(aem_cmd_get_stream_info_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_stream_info_write error\n");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_stream_info_write error\n");
 			assert(aem_cmd_get_stream_info_returned >= 0);
+			system_queue_tx_abort(context, tx_slot);
 			return -1;
 		}
 
-		aecp::common_hdr_init(ether_frame, base_end_station_imp_ref->get_end_station_guid());
-		system_queue_tx(notification_id, avdecc_lib::CMD_WITH_NOTIFICATION, ether_frame->payload, ether_frame->length);
+		aecp::common_hdr_init(base_end_station_imp_ref, tx_slot.frame, tx_slot.frame_size);
+		system_queue_tx_commit(context, tx_slot, notification_id, avdecc_lib::CMD_WITH_NOTIFICATION, AECP_FRAME_LEN);
 
-		free(ether_frame);
 		return 0;
 	}
 
-	int stream_input_descriptor_imp::proc_get_stream_info_resp(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status)
+	int stream_input_descriptor_imp::proc_get_stream_info_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
 	{
-		struct jdksavdecc_frame *ether_frame;
 		struct jdksavdecc_aem_command_get_stream_info_response aem_cmd_get_stream_info_resp;
 		int aem_cmd_get_stream_info_resp_returned;
-		uint32_t msg_type;
-		bool u_field;
 
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
-		memcpy(ether_frame->payload, frame, mem_buf_len);
 		aem_cmd_get_stream_info_resp_returned = jdksavdecc_aem_command_get_stream_info_response_read(&aem_cmd_get_stream_info_resp,
-		                                                                                             frame,
+		                                                                                             rx_frame.frame(),
 		                                                                                             aecp::CMD_POS,
-		                                                                                             mem_buf_len);
+		                                                                                             rx_frame.length());
 
 		if(aem_cmd_get_stream_info_resp_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_stream_info_resp_read error");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_get_stream_info_resp_read error");
 			assert(aem_cmd_get_stream_info_resp_returned >= 0);
 			return -1;
 		}
 
-		msg_type = aem_cmd_get_stream_info_resp.aem_header.aecpdu_header.header.message_type;
-		status = aem_cmd_get_stream_info_resp.aem_header.aecpdu_header.header.status;
-		u_field = aem_cmd_get_stream_info_resp.command_type >> 15 & 0x01; // u_field = the msb of the uint16_t command_type
+		status = rx_frame.status();
 
-		aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, msg_type, u_field, ether_frame);
+		context->aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, rx_frame);
 
-		free(ether_frame);
 		return 0;
 	}
 
 	int STDCALL stream_input_descriptor_imp::send_start_streaming_cmd(void *notification_id, uint16_t desc_index)
 	{
-		struct jdksavdecc_frame *ether_frame;
+		struct system_tx_slot tx_slot;
 		struct jdksavdecc_aem_command_start_streaming aem_cmd_start_streaming;
 		int aem_cmd_start_streaming_returned;
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
 
 		/****************************************** AECP Common Data *****************************************/
 		aem_cmd_start_streaming.controller_entity_id = base_end_station_imp_ref->get_adp()->get_controller_guid();
@@ -595,64 +575,60 @@ namespace avdecc_lib
 		aem_cmd_start_streaming.descriptor_index = desc_index;
 
 		/************************** Fill frame payload with AECP data and send the frame *****************************/
-		aecp::ether_frame_init(base_end_station_imp_ref, ether_frame);
+		if(system_queue_tx_reserve(context, tx_slot) < 0)
+		{
+			return -1;
+		}
+
+		aecp::ether_frame_init(base_end_station_imp_ref, tx_slot.frame);
 		aem_cmd_start_streaming_returned = jdksavdecc_aem_command_start_streaming_write(&aem_cmd_start_streaming,
-		                                                                                ether_frame->payload,
+		                                                                                tx_slot.frame,
 		                                                                                aecp::CMD_POS,
-		                                                                                sizeof(ether_frame->payload));
+		                                                                                tx_slot.frame_size);
 
 		if(aem_cmd_start_streaming_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_start_streaming_write error\n");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_start_streaming_write error\n");
 			assert(aem_cmd_start_streaming_returned >= 0);
+			system_queue_tx_abort(context, tx_slot);
 			return -1;
 		}
 
-		aecp::common_hdr_init(ether_frame, base_end_station_imp_ref->get_end_station_guid());
-		system_queue_tx(notification_id, avdecc_lib::CMD_WITH_NOTIFICATION, ether_frame->payload, ether_frame->length);
+		aecp::common_hdr_init(base_end_station_imp_ref, tx_slot.frame, tx_slot.frame_size);
+		system_queue_tx_commit(context, tx_slot, notification_id, avdecc_lib::CMD_WITH_NOTIFICATION, AECP_FRAME_LEN);
 
-		free(ether_frame);
 		return 0;
 	}
 
-	int stream_input_descriptor_imp::proc_start_streaming_resp(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status)
+	int stream_input_descriptor_imp::proc_start_streaming_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
 	{
-		struct jdksavdecc_frame *ether_frame;
 		struct jdksavdecc_aem_command_start_streaming_response aem_cmd_start_streaming_resp;
 		int aem_cmd_start_streaming_resp_returned;
-		uint32_t msg_type;
-		bool u_field;
 
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
-		memcpy(ether_frame->payload, frame, mem_buf_len);
 		aem_cmd_start_streaming_resp_returned = jdksavdecc_aem_command_start_streaming_response_read(&aem_cmd_start_streaming_resp,
-		                                                                                             frame,
+		                                                                                             rx_frame.frame(),
 		                                                                                             aecp::CMD_POS,
-		                                                                                             mem_buf_len);
+		                                                                                             rx_frame.length());
 
 		if(aem_cmd_start_streaming_resp_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_start_streaming_resp_read error");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_start_streaming_resp_read error");
 			assert(aem_cmd_start_streaming_resp_returned >= 0);
 			return -1;
 		}
 
-		msg_type = aem_cmd_get_stream_info_resp.aem_header.aecpdu_header.header.message_type;
-		status = aem_cmd_get_stream_info_resp.aem_header.aecpdu_header.header.status;
-		u_field = aem_cmd_get_stream_info_resp.command_type >> 15 & 0x01; // u_field = the msb of the uint16_t command_type
+		status = rx_frame.status();
 
-		aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, msg_type, u_field, ether_frame);
+		context->aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, rx_frame);
 
-		free(ether_frame);
 		return 0;
 	}
 
 	int STDCALL stream_input_descriptor_imp::send_stop_streaming_cmd(void *notification_id, uint16_t desc_index)
 	{
-		struct jdksavdecc_frame *ether_frame;
+		struct system_tx_slot tx_slot;
 		struct jdksavdecc_aem_command_stop_streaming aem_cmd_stop_streaming;
 		int aem_cmd_stop_streaming_returned;
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
 
 		/****************************************** AECP Common Data *****************************************/
 		aem_cmd_stop_streaming.controller_entity_id = base_end_station_imp_ref->get_adp()->get_controller_guid();
@@ -664,55 +640,52 @@ namespace avdecc_lib
 		aem_cmd_stop_streaming.descriptor_index = desc_index;
 
 		/************************** Fill frame payload with AECP data and send the frame *****************************/
-		aecp::ether_frame_init(base_end_station_imp_ref, ether_frame);
+		if(system_queue_tx_reserve(context, tx_slot) < 0)
+		{
+			return -1;
+		}
+
+		aecp::ether_frame_init(base_end_station_imp_ref, tx_slot.frame);
 		aem_cmd_stop_streaming_returned = jdksavdecc_aem_command_stop_streaming_write(&aem_cmd_stop_streaming,
-		                                                                              ether_frame->payload,
+		                                                                              tx_slot.frame,
 		                                                                              aecp::CMD_POS,
-		                                                                              sizeof(ether_frame->payload));
+		                                                                              tx_slot.frame_size);
 
 		if(aem_cmd_stop_streaming_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_stop_streaming_write error\n");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_stop_streaming_write error\n");
 			assert(aem_cmd_stop_streaming_returned >= 0);
+			system_queue_tx_abort(context, tx_slot);
 			return -1;
 		}
 
-		aecp::common_hdr_init(ether_frame, base_end_station_imp_ref->get_end_station_guid());
-		system_queue_tx(notification_id, avdecc_lib::CMD_WITH_NOTIFICATION, ether_frame->payload, ether_frame->length);
+		aecp::common_hdr_init(base_end_station_imp_ref, tx_slot.frame, tx_slot.frame_size);
+		system_queue_tx_commit(context, tx_slot, notification_id, avdecc_lib::CMD_WITH_NOTIFICATION, AECP_FRAME_LEN);
 
-		free(ether_frame);
 		return 0;
 	}
 
-	int stream_input_descriptor_imp::proc_stop_streaming_resp(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status)
+	int stream_input_descriptor_imp::proc_stop_streaming_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status)
 	{
-		struct jdksavdecc_frame *ether_frame;
 		struct jdksavdecc_aem_command_stop_streaming_response aem_cmd_stop_streaming_resp;
 		int aem_cmd_stop_streaming_resp_returned;
-		uint32_t msg_type;
-		bool u_field;
 
-		ether_frame = (struct jdksavdecc_frame *)malloc(sizeof(struct jdksavdecc_frame));
-		memcpy(ether_frame->payload, frame, mem_buf_len);
 		aem_cmd_stop_streaming_resp_returned = jdksavdecc_aem_command_stop_streaming_response_read(&aem_cmd_stop_streaming_resp,
-		                                                                                           frame,
+		                                                                                           rx_frame.frame(),
 		                                                                                           aecp::CMD_POS,
-		                                                                                           mem_buf_len);
+		                                                                                           rx_frame.length());
 
 		if(aem_cmd_stop_streaming_resp_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_stop_streaming_resp_read error");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "aem_cmd_stop_streaming_resp_read error");
 			assert(aem_cmd_stop_streaming_resp_returned >= 0);
 			return -1;
 		}
 
-		msg_type = aem_cmd_get_stream_info_resp.aem_header.aecpdu_header.header.message_type;
-		status = aem_cmd_get_stream_info_resp.aem_header.aecpdu_header.header.status;
-		u_field = aem_cmd_get_stream_info_resp.command_type >> 15 & 0x01; // u_field = the msb of the uint16_t command_type
+		status = rx_frame.status();
 
-		aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, msg_type, u_field, ether_frame);
+		context->aem_controller_state_machine_ref->update_inflight_for_rcvd_resp(notification_id, notification_flag, rx_frame);
 
-		free(ether_frame);
 		return 0;
 	}
 }
@@ -31,6 +31,7 @@
 #ifndef _AVDECC_CONTROLLER_LIB_STREAM_OUTPUT_DESCRIPTOR_IMP_H_
 #define _AVDECC_CONTROLLER_LIB_STREAM_OUTPUT_DESCRIPTOR_IMP_H_
 
+#include "frame_view.h"
 #include "descriptor_base_imp.h"
 #include "stream_output_descriptor.h"
 
@@ -75,7 +76,7 @@ namespace avdecc_lib
 		 * Constructor for stream_output_descriptor_imp used for constructing an object with a base End Station, frame, position offest,
 		 * and memory buffer length.
 		 */
-		stream_output_descriptor_imp(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len);
+		stream_output_descriptor_imp(end_station_imp *base_end_station_imp_ref, const uint8_t *frame, size_t pos, size_t mem_buf_len);
 
 		/**
 		 * Destructor for stream_output_descriptor_imp used for destroying objects
@@ -300,7 +301,7 @@ namespace avdecc_lib
 		/**
 		 * Process a SET_STREAM_FORMAT response for the SET_STREAM_FORMAT command.
 		 */
-		int proc_set_stream_format_resp(void *notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status);
+		int proc_set_stream_format_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
 
 		/**
 		 * Send a GET_STREAM_FORMAT command with a notification id to fetch the current format of a stream.
@@ -310,7 +311,7 @@ namespace avdecc_lib
 		/**
 		 * Process a GET_STREAM_FORMAT response for the GET_STREAM_FORMAT command.
 		 */
-		int proc_get_stream_format_resp(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status);
+		int proc_get_stream_format_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
 
 		/**
 		 * Send a SET_STREAM_INFO command with a notification id to change the current values of the dynamic information of the stream.
@@ -320,7 +321,7 @@ namespace avdecc_lib
 		/**
 		 * Process a SET_STREAM_INFO response for the SET_STREAM_INFO command.
 		 */
-		int proc_set_stream_info_resp(void *notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status);
+		int proc_set_stream_info_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
 
 		/**
 		 * Send a GET_STREAM_INFO command with a notification id to fetch the current information for a stream.
@@ -330,7 +331,7 @@ namespace avdecc_lib
 		/**
 		 * Process a GET_STREAM_INFO response for the GET_STREAM_INFO command.
 		 */
-		int proc_get_stream_info_resp(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status);
+		int proc_get_stream_info_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
 
 		/**
 		 * Send a START_STREAMING command with a notification id to start streaming on a previously connected stream that was connected
@@ -341,7 +342,7 @@ namespace avdecc_lib
 		/**
 		 * Process a START_STREAMING response for the START_STREAMING command.
 		 */
-		int proc_start_streaming_resp(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status);
+		int proc_start_streaming_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
 
 		/**
 		 * Send a STOP_STREAMING command with a notification id to stop a connected stream for streaming media.
@@ -351,7 +352,7 @@ namespace avdecc_lib
 		/**
 		 * Process a START_STREAMING response for the START_STREAMING command.
 		 */
-		int proc_stop_streaming_resp(void *&notification_id, uint32_t &notification_flag, uint8_t *frame, uint16_t mem_buf_len, int &status);
+		int proc_stop_streaming_resp(void *&notification_id, uint32_t &notification_flag, const frame_view &rx_frame, int &status);
 	};
 }
 
@@ -29,19 +29,20 @@
 
 #include "enumeration.h"
 #include "log.h"
+#include "controller_context.h"
 #include "strings_descriptor_imp.h"
 
 namespace avdecc_lib
 {
 	strings_descriptor_imp::strings_descriptor_imp() {}
 
-	strings_descriptor_imp::strings_descriptor_imp(end_station_imp *base_end_station_imp_ref, uint8_t *frame, size_t pos, size_t mem_buf_len) : descriptor_base_imp(base_end_station_imp_ref)
+	strings_descriptor_imp::strings_descriptor_imp(end_station_imp *base_end_station_imp_ref, const uint8_t *frame, size_t pos, size_t mem_buf_len) : descriptor_base_imp(base_end_station_imp_ref)
 	{
 		desc_strings_read_returned = jdksavdecc_descriptor_strings_read(&strings_desc, frame, pos, mem_buf_len);
 
 		if(desc_strings_read_returned < 0)
 		{
-			avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "desc_strings_read error");
+			context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "desc_strings_read error");
 			assert(desc_strings_read_returned >= 0);
 		}
 	}
@@ -92,7 +93,7 @@ namespace avdecc_lib
 				break;
 
 			default:
-				avdecc_lib::log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "get_string_by_index error");
+				context->log_ref->logging(avdecc_lib::LOGGING_LEVEL_ERROR, "get_string_by_index error");
 				break;
 		}
 
@@ -24,18 +24,52 @@
 /**
  * system_tx_queue.h
  *
- * System transmit queue class, which is implemented in system_layer2_multithreaded_callback class
- * to store commands in a queue to be transmitted.
+ * System transmit queue class, which is implemented by the System classes to store commands in a queue to be
+ * transmitted. A command is built directly in a frame reserved in the queue and committed once built, so that
+ * queuing a command neither allocates nor copies the frame.
  */
 
 #pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_SYSTEM_TX_QUEUE_H_
+#define _AVDECC_CONTROLLER_LIB_SYSTEM_TX_QUEUE_H_
 
 #include <stdint.h>
+#include <stddef.h>
 
 namespace avdecc_lib
 {
-	/**
-	 * Store command in a queue to be transmitted.
-	 */
-	size_t system_queue_tx(void *notification_id, uint32_t notification_flag, uint8_t *frame, size_t mem_buf_len);
+	struct system_tx_slot
+	{
+		uint8_t *frame; // The frame buffer to build the command in
+		size_t frame_size; // The size of the frame buffer
+		uint16_t frame_index; // The index of the frame buffer in the frame slab of the System
+	};
+
+	class system_tx_queue
+	{
+	public:
+		/**
+		 * Destructor for system_tx_queue used for destroying objects
+		 */
+		virtual ~system_tx_queue() {}
+
+		/**
+		 * Reserve a frame in the transmit queue to build a command in.
+		 *
+		 * \return 0 on success, -1 if no frame is available.
+		 */
+		virtual int queue_tx_reserve(struct system_tx_slot &slot) = 0;
+
+		/**
+		 * Queue a command built in a reserved frame to be transmitted.
+		 */
+		virtual int queue_tx_commit(struct system_tx_slot &slot, void *notification_id, uint32_t notification_flag, size_t mem_buf_len) = 0;
+
+		/**
+		 * Release a reserved frame without transmitting it.
+		 */
+		virtual void queue_tx_abort(struct system_tx_slot &slot) = 0;
+	};
 }
+
+#endif
@@ -49,6 +49,10 @@ namespace avdecc_lib
 
 		return count.QuadPart;
 #elif defined __linux__
+		struct timespec tp;
+		clock_gettime(CLOCK_MONOTONIC, &tp);
+
+		return (time_type)tp.tv_sec * 1000000000 + tp.tv_nsec;
 #endif
 	}
 
@@ -60,6 +64,38 @@ namespace avdecc_lib
 
 		return (uint32_t)((time_ms * 1000/freq.QuadPart) & 0xfffffff);
 #elif defined __linux__
+		return (uint32_t)((time_ms / 1000000) & 0xfffffff);
+#endif
+	}
+
+	uint64_t timer::clk_monotonic_us(void)
+	{
+#ifdef WIN32
+		LARGE_INTEGER freq;
+		QueryPerformanceFrequency(&freq);
+		time_type count = clk_monotonic();
+
+		return (uint64_t)((count / freq.QuadPart) * 1000000 + (count % freq.QuadPart) * 1000000 / freq.QuadPart);
+#elif defined __linux__
+		return (uint64_t)(clk_monotonic() / 1000);
+#endif
+	}
+
+	uint64_t timer::clk_realtime_ns(void)
+	{
+#ifdef WIN32
+		FILETIME file_time;
+		ULARGE_INTEGER time_100ns;
+		GetSystemTimeAsFileTime(&file_time);
+		time_100ns.LowPart = file_time.dwLowDateTime;
+		time_100ns.HighPart = file_time.dwHighDateTime;
+
+		return (time_100ns.QuadPart - 116444736000000000ULL) * 100; // FILETIME counts 100 ns intervals since 1601
+#elif defined __linux__
+		struct timespec tp;
+		clock_gettime(CLOCK_REALTIME, &tp);
+
+		return (uint64_t)tp.tv_sec * 1000000000 + tp.tv_nsec;
 #endif
 	}
 
@@ -87,7 +123,7 @@ namespace avdecc_lib
 
 			if(elapsed_ms > count)
 			{
-				elapsed = TRUE;
+				elapsed = true;
 			}
 		}
 
@@ -31,15 +31,16 @@
 #ifndef _AVDECC_CONTROLLER_LIB_TIMER_H_
 #define _AVDECC_CONTROLLER_LIB_TIMER_H_
 
+#include <stdint.h>
+
 #ifdef WIN32
 #include <windows.h>
 typedef LONGLONG time_type;
 #elif defined __linux__
+#include <time.h>
 typedef int64_t time_type;
 #endif
 
-#include <stdint.h>
-
 namespace avdecc_lib
 {
 	class timer
@@ -65,6 +66,16 @@ namespace avdecc_lib
 
 		uint32_t clk_convert_to_ms(time_type time_ms);
 
+		/**
+		 * Get the monotonic time in microseconds, which is not changed by adjustments of the wall clock.
+		 */
+		uint64_t clk_monotonic_us(void);
+
+		/**
+		 * Get the wall clock time in nanoseconds since the Unix epoch, the clock network timestamps are taken with.
+		 */
+		uint64_t clk_realtime_ns(void);
+
 		void start(int duration_ms);
 
 		void stop();
@@ -0,0 +1,266 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * timer_wheel.cpp
+ *
+ * Timer wheel implementation
+ */
+
+#ifdef WIN32
+#include <windows.h>
+#elif defined __linux__
+#include <time.h>
+#endif
+#include "timer_wheel.h"
+
+namespace avdecc_lib
+{
+
+	timer_wheel::timer_wheel()
+	{
+		for(uint32_t level = 0; level < TIMER_WHEEL_LEVEL_COUNT; level++)
+		{
+			for(uint32_t slot = 0; slot < TIMER_WHEEL_SLOT_COUNT; slot++)
+			{
+				slots[level][slot].prev = &slots[level][slot];
+				slots[level][slot].next = &slots[level][slot];
+			}
+		}
+
+		current_ms = clk_monotonic_ms();
+		next_expiry_ms = TIMER_WHEEL_NO_EXPIRY;
+		armed_count = 0;
+	}
+
+	timer_wheel::~timer_wheel() {}
+
+	void timer_wheel::init_entry(struct entry *timer, void (*expired)(void *context), void *context)
+	{
+		timer->prev = NULL;
+		timer->next = NULL;
+		timer->expiry_ms = 0;
+		timer->expired = expired;
+		timer->context = context;
+	}
+
+	uint64_t timer_wheel::clk_monotonic_ms()
+	{
+#ifdef WIN32
+		LARGE_INTEGER count;
+		LARGE_INTEGER freq;
+		QueryPerformanceCounter(&count);
+		QueryPerformanceFrequency(&freq);
+
+		return (uint64_t)(count.QuadPart / freq.QuadPart * 1000 + count.QuadPart % freq.QuadPart * 1000 / freq.QuadPart);
+#elif defined __linux__
+		struct timespec tp;
+		clock_gettime(CLOCK_MONOTONIC, &tp);
+
+		return (uint64_t)tp.tv_sec * 1000 + tp.tv_nsec / 1000000;
+#endif
+	}
+
+	void timer_wheel::arm(struct entry *timer, uint32_t duration_ms)
+	{
+		if(is_armed(timer))
+		{
+			unlink(timer);
+			armed_count--;
+		}
+
+		timer->expiry_ms = clk_monotonic_ms() + duration_ms;
+		insert(timer);
+		armed_count++;
+
+		if(timer->expiry_ms < next_expiry_ms)
+		{
+			next_expiry_ms = timer->expiry_ms;
+		}
+	}
+
+	void timer_wheel::cancel(struct entry *timer)
+	{
+		/**
+		 * The next expiry is left as it is, so the wheel may be serviced once for nothing.
+		 */
+		if(is_armed(timer))
+		{
+			unlink(timer);
+			armed_count--;
+		}
+	}
+
+	void timer_wheel::insert(struct entry *timer)
+	{
+		uint64_t expiry_ms = (timer->expiry_ms < current_ms) ? current_ms : timer->expiry_ms;
+		uint64_t delta_ms = expiry_ms - current_ms;
+		uint32_t level = 0;
+		struct entry *head;
+
+		if(delta_ms >= (UINT64_C(1) << (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVEL_COUNT)))
+		{
+			/**
+			 * Beyond the range of the wheel, the timer is cascaded from the highest level until it is in range.
+			 */
+			expiry_ms = current_ms + (UINT64_C(1) << (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVEL_COUNT)) - 1;
+			delta_ms = expiry_ms - current_ms;
+		}
+
+		while(delta_ms >= (UINT64_C(1) << (TIMER_WHEEL_SLOT_BITS * (level + 1))))
+		{
+			level++;
+		}
+
+		head = &slots[level][(expiry_ms >> (TIMER_WHEEL_SLOT_BITS * level)) & TIMER_WHEEL_SLOT_MASK];
+		timer->next = head;
+		timer->prev = head->prev;
+		head->prev->next = timer;
+		head->prev = timer;
+	}
+
+	void timer_wheel::cascade(uint32_t level)
+	{
+		struct entry *head = &slots[level][(current_ms >> (TIMER_WHEEL_SLOT_BITS * level)) & TIMER_WHEEL_SLOT_MASK];
+		struct entry moving;
+
+		if(head->next == head)
+		{
+			return;
+		}
+
+		/**
+		 * Take the whole list first, as a timer beyond the range of the wheel goes back to the same slot.
+		 */
+		moving.next = head->next;
+		moving.prev = head->prev;
+		moving.next->prev = &moving;
+		moving.prev->next = &moving;
+		head->next = head;
+		head->prev = head;
+
+		while(moving.next != &moving)
+		{
+			struct entry *timer = moving.next;
+			unlink(timer);
+			insert(timer);
+		}
+	}
+
+	uint32_t timer_wheel::expire(uint64_t now_ms)
+	{
+		uint32_t expired_count = 0;
+		struct entry expiring;
+
+		while(current_ms <= now_ms)
+		{
+			struct entry *head = &slots[0][current_ms & TIMER_WHEEL_SLOT_MASK];
+
+			if(armed_count == 0)
+			{
+				current_ms = now_ms + 1; // Nothing to cascade, so skip the idle time at once
+				break;
+			}
+
+			/**
+			 * Each time a level wraps around, the timers of the next slot of the level above come down.
+			 */
+			for(uint32_t level = 1; level < TIMER_WHEEL_LEVEL_COUNT; level++)
+			{
+				if(((current_ms >> (TIMER_WHEEL_SLOT_BITS * (level - 1))) & TIMER_WHEEL_SLOT_MASK) != 0)
+				{
+					break;
+				}
+
+				cascade(level);
+			}
+
+			/**
+			 * The expired timers are moved to a list of their own first, so their functions can arm and cancel
+			 * timers in any slot. A timer armed to expire at once is expired by the next pass.
+			 */
+			while(head->next != head)
+			{
+				expiring.next = head->next;
+				expiring.prev = head->prev;
+				expiring.next->prev = &expiring;
+				expiring.prev->next = &expiring;
+				head->next = head;
+				head->prev = head;
+
+				while(expiring.next != &expiring)
+				{
+					struct entry *timer = expiring.next;
+					unlink(timer);
+					armed_count--;
+					expired_count++;
+					timer->expired(timer->context);
+				}
+			}
+
+			current_ms++;
+		}
+
+		next_expiry_ms = find_next_expiry();
+
+		return expired_count;
+	}
+
+	uint64_t timer_wheel::find_next_expiry()
+	{
+		uint64_t next_ms = TIMER_WHEEL_NO_EXPIRY;
+
+		if(armed_count == 0)
+		{
+			return next_ms;
+		}
+
+		/**
+		 * The timers of a level 0 slot expire at the time of the slot, while those of a higher level slot are only
+		 * known to expire after the slot is cascaded.
+		 */
+		for(uint32_t level = 0; level < TIMER_WHEEL_LEVEL_COUNT; level++)
+		{
+			uint32_t shift = TIMER_WHEEL_SLOT_BITS * level;
+			uint64_t first_round = (current_ms + (UINT64_C(1) << shift) - 1) >> shift;
+
+			for(uint32_t round_index = 0; round_index < TIMER_WHEEL_SLOT_COUNT; round_index++)
+			{
+				uint64_t round = first_round + round_index;
+				struct entry *head = &slots[level][round & TIMER_WHEEL_SLOT_MASK];
+
+				if(head->next != head)
+				{
+					if((round << shift) < next_ms)
+					{
+						next_ms = round << shift;
+					}
+
+					break;
+				}
+			}
+		}
+
+		return next_ms;
+	}
+}
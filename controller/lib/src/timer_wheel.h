@@ -0,0 +1,170 @@
+/*
+ * Licensed under the MIT License (MIT)
+ *
+ * Copyright (c) 2013 AudioScience Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * timer_wheel.h
+ *
+ * Timer wheel class, which expires the timers of the engine in batches. The timers are kept in four levels of 64
+ * slots with a resolution of 1 ms, so arming and cancelling a timer takes constant time whatever the number of
+ * timers, and a timer reaches the lowest level through at most three cascades before it expires.
+ */
+
+#pragma once
+#ifndef _AVDECC_CONTROLLER_LIB_TIMER_WHEEL_H_
+#define _AVDECC_CONTROLLER_LIB_TIMER_WHEEL_H_
+
+#include <stdint.h>
+
+#define TIMER_WHEEL_NO_EXPIRY UINT64_C(0xFFFFFFFFFFFFFFFF) // The next expiry when no timer is armed
+
+namespace avdecc_lib
+{
+	class timer_wheel
+	{
+	public:
+		enum timer_wheel_sizes
+		{
+		        TIMER_WHEEL_LEVEL_COUNT = 4,
+		        TIMER_WHEEL_SLOT_BITS = 6,
+		        TIMER_WHEEL_SLOT_COUNT = 1 << TIMER_WHEEL_SLOT_BITS,
+		        TIMER_WHEEL_SLOT_MASK = TIMER_WHEEL_SLOT_COUNT - 1
+		};
+
+		struct entry
+		{
+			struct entry *prev;
+			struct entry *next; // NULL while the timer is not armed
+			uint64_t expiry_ms;
+			void (*expired)(void *context); // Called by expire once the timer has expired
+			void *context;
+		};
+
+	private:
+		struct entry slots[TIMER_WHEEL_LEVEL_COUNT][TIMER_WHEEL_SLOT_COUNT]; // The head of the list of timers in each slot
+		uint64_t current_ms; // The timers expiring before this time have been expired
+		uint64_t next_expiry_ms; // No timer expires before this time
+		uint32_t armed_count;
+
+	public:
+		/**
+		 * An empty constructor for timer_wheel
+		 */
+		timer_wheel();
+
+		/**
+		 * Destructor for timer_wheel used for destroying objects
+		 */
+		~timer_wheel();
+
+		/**
+		 * Set the function called with a context when a timer expires. The timer is left not armed.
+		 */
+		static void init_entry(struct entry *timer, void (*expired)(void *context), void *context);
+
+		/**
+		 * Get the monotonic time in milliseconds the timers are armed and expired with.
+		 */
+		static uint64_t clk_monotonic_ms();
+
+		/**
+		 * Arm a timer to expire after a duration, or re-arm it if it is already armed.
+		 */
+		void arm(struct entry *timer, uint32_t duration_ms);
+
+		/**
+		 * Stop a timer. Nothing is done if the timer is not armed.
+		 */
+		void cancel(struct entry *timer);
+
+		/**
+		 * Check if a timer is armed.
+		 */
+		inline bool is_armed(struct entry *timer)
+		{
+			return timer->next != NULL;
+		}
+
+		/**
+		 * Get the number of timers armed.
+		 */
+		inline uint32_t size()
+		{
+			return armed_count;
+		}
+
+		/**
+		 * Get the time the wheel has to be serviced next, which may be earlier than the first expiry but never later.
+		 *
+		 * \return The time in milliseconds, or TIMER_WHEEL_NO_EXPIRY if no timer is armed.
+		 */
+		inline uint64_t next_expiry()
+		{
+			return next_expiry_ms;
+		}
+
+		/**
+		 * Check if the wheel has to be serviced.
+		 */
+		inline bool is_due(uint64_t now_ms)
+		{
+			return now_ms >= next_expiry_ms;
+		}
+
+		/**
+		 * Expire all the timers due by a time, calling the function of each of them. The functions may arm and
+		 * cancel timers, including the timer expiring.
+		 *
+		 * \return The number of timers expired.
+		 */
+		uint32_t expire(uint64_t now_ms);
+
+	private:
+		/**
+		 * Add a timer to the slot of its expiry time.
+		 */
+		void insert(struct entry *timer);
+
+		/**
+		 * Remove a timer from its list.
+		 */
+		inline void unlink(struct entry *timer)
+		{
+			timer->prev->next = timer->next;
+			timer->next->prev = timer->prev;
+			timer->prev = NULL;
+			timer->next = NULL;
+		}
+
+		/**
+		 * Move the timers of the current slot of a level down to the lower levels.
+		 */
+		void cascade(uint32_t level);
+
+		/**
+		 * Find the earliest time a slot holding timers is expired or cascaded.
+		 */
+		uint64_t find_next_expiry();
+	};
+}
+
+#endif
@@ -35,7 +35,9 @@
 #include <fstream>
 #include <iomanip>
 #include <string>
+#ifdef WIN32
 #include <eh.h>
+#endif
 #include <locale>
 #include <vector>
 #include <map>